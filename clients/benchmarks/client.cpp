@@ -381,6 +381,25 @@ try
          value<int8_t>(&arg.norm_check)->default_value(0),
          "Validate GPU results with CPU? 0 = No, 1 = Yes (default: No)")
 
+        ("verify_method",
+         value<int32_t>(&arg.verify_method)->default_value(0),
+         "Part of D to validate. 0: all of D. 1: verify_count random row blocks crossed with "
+         "verify_count random column blocks. 2: every verify_count-th tile. "
+         "Options: 0, 1, 2. (default: 0)")
+
+        ("verify_tile",
+         value<int32_t>(&arg.verify_tile)->default_value(256),
+         "Rows and columns of the blocks and tiles validated when verify_method is 1 or 2.")
+
+        ("verify_count",
+         value<int32_t>(&arg.verify_count)->default_value(8),
+         "Number of random row and column blocks when verify_method is 1, tile stride when "
+         "verify_method is 2.")
+
+        ("verify_seed",
+         value<int32_t>(&arg.verify_seed)->default_value(0),
+         "Seed of the random blocks validated when verify_method is 1.")
+
         ("iters,i",
          value<int32_t>(&arg.iters)->default_value(10),
          "Iterations to run inside timing loop")
@@ -389,13 +408,29 @@ try
          value<int32_t>(&arg.cold_iters)->default_value(2),
          "Cold Iterations to run before entering the timing loop")
 
+        ("rotating",
+         value<int32_t>(&arg.rotating)->default_value(0),
+         "Also time the calls on rotating copies of all the buffers that take at least this "
+         "many MiB together, so the inputs are not cache resident, with at most 128 copies. "
+         "0 to disable.")
+
+        ("flush",
+         bool_switch(&arg.flush)->default_value(false),
+         "Also time the calls with a cache flushing kernel launched before each call, timing "
+         "each call on its own to leave the flush out")
+
         ("algo",
          value<uint32_t>(&arg.algo)->default_value(0),
          "Reserved.")
 
         ("solution_index",
          value<int32_t>(&arg.solution_index)->default_value(0),
-         "Reserved.")
+         "Solution index to start searching from when algo_method is 2.")
+
+        ("algo_method",
+         value<int32_t>(&arg.algo_method)->default_value(0),
+         "Way of getting the algorithms. 0: heuristic. 1: all algorithms. 2: by solution index. "
+         "Options: 0, 1, 2. (default: 0)")
 
         ("activation_type",
          value<std::string>(&activation_type)->default_value("none"),
@@ -421,6 +456,26 @@ try
          bool_switch(&arg.bias_vector)->default_value(false),
          "Apply bias vector")
 
+        ("scaleA",
+         bool_switch(&arg.scaleA)->default_value(false),
+         "Apply scale for A buffer")
+
+        ("scaleB",
+         bool_switch(&arg.scaleB)->default_value(false),
+         "Apply scale for B buffer")
+
+        ("scaleC",
+         bool_switch(&arg.scaleC)->default_value(false),
+         "Apply scale for C buffer")
+
+        ("scaleD",
+         bool_switch(&arg.scaleD)->default_value(false),
+         "Apply scale for D buffer")
+
+        ("scaleE",
+         bool_switch(&arg.scaleE)->default_value(false),
+         "Apply scale for E buffer")
+
         ("scaleAlpha_vector",
          bool_switch(&arg.scaleAlpha_vector)->default_value(false),
          "Apply scaleAlpha vector")
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Compares the bulk conversions of hipblaslt_convert.hpp with converting one
+// element at a time, as the clients used to, and checks that both give the
+// same bits:
+//
+//   hipblaslt-convert-bench [elements]
+
+#include "hipblaslt_convert.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    template <typename F>
+    double time_ms(F&& f)
+    {
+        f(); // warm up
+        constexpr int iters = 5;
+        auto          start = std::chrono::steady_clock::now();
+        for(int i = 0; i < iters; i++)
+            f();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / iters;
+    }
+
+    template <typename Tdst, typename Tsrc>
+    void bench(const char* name, const std::vector<Tsrc>& src)
+    {
+        size_t            count = src.size();
+        std::vector<Tdst> scalar(count), bulk(count);
+
+        double scalar_ms = time_ms([&] {
+            for(size_t i = 0; i < count; i++)
+                scalar[i] = static_cast<Tdst>(src[i]);
+        });
+        double bulk_ms   = time_ms([&] { convert_n(bulk.data(), src.data(), count); });
+
+        bool same = std::memcmp(scalar.data(), bulk.data(), count * sizeof(Tdst)) == 0;
+        std::printf("%-12s %10.3f %10.3f %8.1fx  %s\n",
+                    name,
+                    scalar_ms,
+                    bulk_ms,
+                    scalar_ms / bulk_ms,
+                    same ? "same" : "DIFFERENT");
+    }
+
+    template <typename T8>
+    std::vector<T8> random_f8(size_t count, std::mt19937& rng)
+    {
+        std::vector<T8> values(count);
+        for(auto& v : values)
+            v.data = static_cast<uint8_t>(rng());
+        return values;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 0) : size_t(1) << 24;
+
+    std::mt19937                          rng(0);
+    std::uniform_real_distribution<float> dist(-300.f, 300.f);
+
+    std::vector<float> floats(count);
+    for(auto& v : floats)
+        v = dist(rng);
+
+    std::vector<hipblasLtHalf> halfs(count);
+    std::vector<hip_bfloat16>  bfloats(count);
+    for(size_t i = 0; i < count; i++)
+    {
+        halfs[i]   = static_cast<hipblasLtHalf>(floats[i]);
+        bfloats[i] = static_cast<hip_bfloat16>(floats[i]);
+    }
+
+    std::printf("%zu elements\n", count);
+    std::printf("%-12s %10s %10s %9s\n", "conversion", "scalar ms", "bulk ms", "speedup");
+
+    bench<float>("f8->f32", random_f8<hipblaslt_f8>(count, rng));
+    bench<float>("bf8->f32", random_f8<hipblaslt_bf8>(count, rng));
+    bench<float>("f16->f32", halfs);
+    bench<float>("bf16->f32", bfloats);
+    bench<hipblaslt_f8>("f32->f8", floats);
+    bench<hipblaslt_bf8>("f32->bf8", floats);
+    bench<hipblasLtHalf>("f32->f16", floats);
+    bench<hip_bfloat16>("f32->bf16", floats);
+
+    return 0;
+}
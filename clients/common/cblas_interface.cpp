@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include "cblas_interface.hpp"
+#include "hipblaslt_convert.hpp"
 #include "hipblaslt_vector.hpp"
 #include "utility.hpp"
 #include <bitset>
@@ -70,12 +71,9 @@ void cblas_gemm<hip_bfloat16, hip_bfloat16, hip_bfloat16, float>(hipblasOperatio
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -97,13 +95,9 @@ void cblas_gemm<hip_bfloat16, hip_bfloat16, hip_bfloat16, float>(hipblasOperatio
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hip_bfloat16>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hip_bfloat16>(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -132,10 +126,8 @@ void cblas_gemm<hip_bfloat16, hip_bfloat16, float, float>(hipblasOperation_t  tr
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -184,10 +176,8 @@ void cblas_gemm<hipblaslt_f8, hipblaslt_f8, float, float>(hipblasOperation_t  tr
 
     host_vector<float> A_float(sizeA), B_float(sizeB);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -235,10 +225,8 @@ void cblas_gemm<hipblaslt_bf8, hipblaslt_f8, float, float>(hipblasOperation_t
 
     host_vector<float> A_float(sizeA), B_float(sizeB);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -286,10 +274,8 @@ void cblas_gemm<hipblaslt_f8, hipblaslt_bf8, float, float>(hipblasOperation_t
 
     host_vector<float> A_float(sizeA), B_float(sizeB);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -338,12 +324,9 @@ void cblas_gemm<hipblaslt_f8, hipblaslt_f8, hipblasLtHalf, float>(hipblasOperati
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -365,13 +348,9 @@ void cblas_gemm<hipblaslt_f8, hipblaslt_f8, hipblasLtHalf, float>(hipblasOperati
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -397,12 +376,9 @@ void cblas_gemm<hipblaslt_bf8, hipblaslt_f8, hipblasLtHalf, float>(hipblasOperat
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -424,13 +400,9 @@ void cblas_gemm<hipblaslt_bf8, hipblaslt_f8, hipblasLtHalf, float>(hipblasOperat
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -456,12 +428,9 @@ void cblas_gemm<hipblaslt_f8, hipblaslt_bf8, hipblasLtHalf, float>(hipblasOperat
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -483,13 +452,9 @@ void cblas_gemm<hipblaslt_f8, hipblaslt_bf8, hipblasLtHalf, float>(hipblasOperat
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -518,12 +483,9 @@ void cblas_gemm<hipblaslt_f8, hipblasLtHalf, hipblaslt_f8, float>(hipblasOperati
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -545,13 +507,9 @@ void cblas_gemm<hipblaslt_f8, hipblasLtHalf, hipblaslt_f8, float>(hipblasOperati
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblaslt_f8>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblaslt_f8>(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -580,12 +538,9 @@ void cblas_gemm<hipblasLtHalf, hipblaslt_f8, hipblaslt_f8, float>(hipblasOperati
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -607,13 +562,9 @@ void cblas_gemm<hipblasLtHalf, hipblaslt_f8, hipblaslt_f8, float>(hipblasOperati
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblaslt_f8>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblaslt_f8>(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -642,12 +593,9 @@ void cblas_gemm<hipblaslt_f8, hipblasLtHalf, hipblasLtHalf, float>(hipblasOperat
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -669,13 +617,9 @@ void cblas_gemm<hipblaslt_f8, hipblasLtHalf, hipblasLtHalf, float>(hipblasOperat
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -704,12 +648,9 @@ void cblas_gemm<hipblasLtHalf, hipblaslt_f8, hipblasLtHalf, float>(hipblasOperat
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -731,13 +672,9 @@ void cblas_gemm<hipblasLtHalf, hipblaslt_f8, hipblasLtHalf, float>(hipblasOperat
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -766,10 +703,8 @@ void cblas_gemm<hipblaslt_f8, hipblasLtHalf, float, float>(hipblasOperation_t
 
     host_vector<float> A_float(sizeA), B_float(sizeB);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -821,10 +756,8 @@ void cblas_gemm<hipblasLtHalf, hipblaslt_f8, float, float>(hipblasOperation_t
 
     host_vector<float> A_float(sizeA), B_float(sizeB);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(A_float.data(), A, sizeA);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -887,12 +820,9 @@ void cblas_gemm<hipblasLtHalf, hipblasLtHalf, hipblasLtHalf, float>(hipblasOpera
     }
     else
     {
-        for(size_t i = 0; i < sizeA; i++)
-            A_float[i] = A[i];
-        for(size_t i = 0; i < sizeB; i++)
-            B_float[i] = B[i];
-        for(size_t i = 0; i < sizeC; i++)
-            C_float[i] = C[i];
+        convert_n(A_float.data(), A, sizeA);
+        convert_n(B_float.data(), B, sizeB);
+        convert_n(C_float.data(), C, sizeC);
     }
 
     // just directly cast, since transA, transB are integers in the enum
@@ -915,13 +845,9 @@ void cblas_gemm<hipblasLtHalf, hipblasLtHalf, hipblasLtHalf, float>(hipblasOpera
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = hipblasLtHalf(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -959,10 +885,8 @@ void cblas_gemm<hipblasLtHalf, hipblasLtHalf, float, float>(hipblasOperation_t
     }
     else
     {
-        for(size_t i = 0; i < sizeA; i++)
-            A_float[i] = A[i];
-        for(size_t i = 0; i < sizeB; i++)
-            B_float[i] = B[i];
+        convert_n(A_float.data(), A, sizeA);
+        convert_n(B_float.data(), B, sizeB);
     }
 
     // just directly cast, since transA, transB are integers in the enum
@@ -1107,12 +1031,9 @@ void cblas_gemm<int8_t, int8_t, int32_t, int32_t>(hipblasOperation_t transA,
     host_vector<double> B_double(sizeB);
     host_vector<double> C_double(sizeC);
 
-    for(size_t i = 0; i < sizeA; i++)
-        A_double[i] = static_cast<double>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_double[i] = static_cast<double>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_double[i] = static_cast<double>(C[i]);
+    convert_n(A_double.data(), A, sizeA);
+    convert_n(B_double.data(), B, sizeB);
+    convert_n(C_double.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1134,13 +1055,9 @@ void cblas_gemm<int8_t, int8_t, int32_t, int32_t>(hipblasOperation_t transA,
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<int32_t>(C_double[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<int32_t>(C_double[i]);
+            C_double[i] *= scaleD;
     }
+    convert_n(C, C_double.data(), sizeC);
 }
 
 // AlphaVec gemm
@@ -1172,15 +1089,11 @@ void cblas_gemm_alphascale<hip_bfloat16, hip_bfloat16, hip_bfloat16, float>(
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1202,13 +1115,9 @@ void cblas_gemm_alphascale<hip_bfloat16, hip_bfloat16, hip_bfloat16, float>(
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hip_bfloat16>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hip_bfloat16>(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -1238,13 +1147,10 @@ void cblas_gemm_alphascale<hip_bfloat16, hip_bfloat16, float, float>(hipblasOper
 
     host_vector<float> A_float(sizeA), B_float(sizeB);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1294,13 +1200,10 @@ void cblas_gemm_alphascale<hipblaslt_f8, hipblaslt_f8, float, float>(hipblasOper
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1350,13 +1253,10 @@ void cblas_gemm_alphascale<hipblaslt_bf8, hipblaslt_f8, float, float>(hipblasOpe
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1406,13 +1306,10 @@ void cblas_gemm_alphascale<hipblaslt_f8, hipblaslt_bf8, float, float>(hipblasOpe
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1462,15 +1359,11 @@ void cblas_gemm_alphascale<hipblaslt_f8, hipblaslt_f8, hipblasLtHalf, float>(
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     //printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1492,13 +1385,9 @@ void cblas_gemm_alphascale<hipblaslt_f8, hipblaslt_f8, hipblasLtHalf, float>(
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = hipblasLtHalf(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -1526,15 +1415,11 @@ void cblas_gemm_alphascale<hipblaslt_bf8, hipblaslt_f8, hipblasLtHalf, float>(
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     //printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1556,13 +1441,9 @@ void cblas_gemm_alphascale<hipblaslt_bf8, hipblaslt_f8, hipblasLtHalf, float>(
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = hipblasLtHalf(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -1590,15 +1471,11 @@ void cblas_gemm_alphascale<hipblaslt_f8, hipblaslt_bf8, hipblasLtHalf, float>(
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     //printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1620,13 +1497,9 @@ void cblas_gemm_alphascale<hipblaslt_f8, hipblaslt_bf8, hipblasLtHalf, float>(
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = hipblasLtHalf(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -1657,15 +1530,11 @@ void cblas_gemm_alphascale<hipblasLtHalf, hipblaslt_f8, hipblaslt_f8, float>(
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     //printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1687,13 +1556,9 @@ void cblas_gemm_alphascale<hipblasLtHalf, hipblaslt_f8, hipblaslt_f8, float>(
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblaslt_f8>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblaslt_f8>(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -1724,15 +1589,11 @@ void cblas_gemm_alphascale<hipblaslt_f8, hipblasLtHalf, hipblaslt_f8, float>(
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     //printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1754,13 +1615,9 @@ void cblas_gemm_alphascale<hipblaslt_f8, hipblasLtHalf, hipblaslt_f8, float>(
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblaslt_f8>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblaslt_f8>(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -1791,15 +1648,11 @@ void cblas_gemm_alphascale<hipblasLtHalf, hipblaslt_f8, hipblasLtHalf, float>(
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     //printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1821,13 +1674,9 @@ void cblas_gemm_alphascale<hipblasLtHalf, hipblaslt_f8, hipblasLtHalf, float>(
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = hipblasLtHalf(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -1858,15 +1707,11 @@ void cblas_gemm_alphascale<hipblaslt_f8, hipblasLtHalf, hipblasLtHalf, float>(
 
     host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
+    convert_n(B_float.data(), B, sizeB);
+    convert_n(C_float.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     //printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1888,13 +1733,9 @@ void cblas_gemm_alphascale<hipblaslt_f8, hipblasLtHalf, hipblasLtHalf, float>(
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = hipblasLtHalf(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -1924,13 +1765,10 @@ void cblas_gemm_alphascale<hipblasLtHalf, hipblaslt_f8, float, float>(hipblasOpe
 
     host_vector<float> A_float(sizeA), B_float(sizeB);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     //printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -1983,13 +1821,10 @@ void cblas_gemm_alphascale<hipblaslt_f8, hipblasLtHalf, float, float>(hipblasOpe
 
     host_vector<float> A_float(sizeA), B_float(sizeB);
 
+    convert_n(A_float.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_float[i] = static_cast<float>(A[i]);
         A_float[i] *= AlphaVec[i % m];
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
+    convert_n(B_float.data(), B, sizeB);
 
     // just directly cast, since transA, transB are integers in the enum
     //printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -2054,15 +1889,11 @@ void cblas_gemm_alphascale<hipblasLtHalf, hipblasLtHalf, hipblasLtHalf, float>(
     }
     else
     {
+        convert_n(A_float.data(), A, sizeA);
         for(size_t i = 0; i < sizeA; i++)
-        {
-            A_float[i] = A[i];
             A_float[i] *= AlphaVec[i % m];
-        }
-        for(size_t i = 0; i < sizeB; i++)
-            B_float[i] = B[i];
-        for(size_t i = 0; i < sizeC; i++)
-            C_float[i] = C[i];
+        convert_n(B_float.data(), B, sizeB);
+        convert_n(C_float.data(), C, sizeC);
     }
 
     // just directly cast, since transA, transB are integers in the enum
@@ -2085,13 +1916,9 @@ void cblas_gemm_alphascale<hipblasLtHalf, hipblasLtHalf, hipblasLtHalf, float>(
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<hipblasLtHalf>(C_float[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = hipblasLtHalf(C_float[i]);
+            C_float[i] *= scaleD;
     }
+    convert_n(C, C_float.data(), sizeC);
 }
 
 template <>
@@ -2130,13 +1957,10 @@ void cblas_gemm_alphascale<hipblasLtHalf, hipblasLtHalf, float, float>(hipblasOp
     }
     else
     {
+        convert_n(A_float.data(), A, sizeA);
         for(size_t i = 0; i < sizeA; i++)
-        {
-            A_float[i] = A[i];
             A_float[i] *= AlphaVec[i % m];
-        }
-        for(size_t i = 0; i < sizeB; i++)
-            B_float[i] = B[i];
+        convert_n(B_float.data(), B, sizeB);
     }
 
     // just directly cast, since transA, transB are integers in the enum
@@ -2297,15 +2121,11 @@ void cblas_gemm_alphascale<int8_t, int8_t, int32_t, int32_t>(hipblasOperation_t
     host_vector<double> B_double(sizeB);
     host_vector<double> C_double(sizeC);
 
+    convert_n(A_double.data(), A, sizeA);
     for(size_t i = 0; i < sizeA; i++)
-    {
-        A_double[i] = static_cast<double>(A[i]);
         A_double[i] *= static_cast<double>(AlphaVec[i % m]);
-    }
-    for(size_t i = 0; i < sizeB; i++)
-        B_double[i] = static_cast<double>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_double[i] = static_cast<double>(C[i]);
+    convert_n(B_double.data(), B, sizeB);
+    convert_n(C_double.data(), C, sizeC);
 
     // just directly cast, since transA, transB are integers in the enum
     // printf("transA: hipblaslt =%d, cblas=%d\n", transA, HIPOperationToCBLASTanspose(transA) );
@@ -2327,11 +2147,7 @@ void cblas_gemm_alphascale<int8_t, int8_t, int32_t, int32_t>(hipblasOperation_t
     if(scaleD != 1)
     {
         for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<int32_t>(C_double[i] * scaleD);
-    }
-    else
-    {
-        for(size_t i = 0; i < sizeC; i++)
-            C[i] = static_cast<int32_t>(C_double[i]);
+            C_double[i] *= scaleD;
     }
+    convert_n(C, C_double.data(), sizeC);
 }
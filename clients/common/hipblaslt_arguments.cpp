@@ -148,6 +148,14 @@ void Arguments::init()
     use_ext_setproblem = false;
     algo_method        = 0;
     use_user_args      = false;
+
+    verify_method = 0;
+    verify_tile   = 256;
+    verify_count  = 8;
+    verify_seed   = 0;
+
+    rotating = 0;
+    flush    = false;
 }
 
 // Function to print Arguments out to stream in YAML format
@@ -0,0 +1,137 @@
+#!/usr/bin/python3
+# ########################################################################
+# Copyright (C) 2023 Advanced Micro Devices, Inc.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+# ########################################################################
+
+"""Decode a binary hipBLASLt log written with HIPBLASLT_LOG_FORMAT=binary into
+the text format of the synchronous logger"""
+
+import argparse
+import struct
+import sys
+import time
+
+MAGIC = b"HIPBLASLT_BLOG\0\0"
+VERSION = 1
+
+# rocblaslt_layer_mode
+LAYERS = {
+    0: "None",
+    1: "Error",
+    2: "Trace",
+    4: "Hints",
+    8: "Info",
+    16: "Api",
+    32: "Bench",
+    64: "Profile",
+}
+
+# AsyncLogger::ArgTag
+ARG_INT, ARG_UINT, ARG_FLOAT, ARG_POINTER, ARG_STRING = range(1, 6)
+
+
+def format_float(value):
+    # std::ostream default formatting, i.e. %g with 6 significant digits.
+    return "%g" % value
+
+
+def format_arg(data, pos):
+    tag = data[pos]
+    pos += 1
+    if tag == ARG_INT:
+        return str(struct.unpack_from("<q", data, pos)[0]), pos + 8
+    if tag == ARG_UINT:
+        return str(struct.unpack_from("<Q", data, pos)[0]), pos + 8
+    if tag == ARG_FLOAT:
+        return format_float(struct.unpack_from("<d", data, pos)[0]), pos + 8
+    if tag == ARG_POINTER:
+        value = struct.unpack_from("<Q", data, pos)[0]
+        return ("0x%x" % value if value else "0"), pos + 8
+    if tag == ARG_STRING:
+        length = struct.unpack_from("<I", data, pos)[0]
+        pos += 4
+        return data[pos:pos + length].decode(errors="replace"), pos + length
+    raise ValueError("unknown argument tag %d" % tag)
+
+
+def format_record(data, pid, show_tid):
+    time_ns, tid, layer, func_len = struct.unpack_from("<QQIH", data, 0)
+    pos = 22
+    func = data[pos:pos + func_len].decode(errors="replace")
+    pos += func_len
+    argc = struct.unpack_from("<H", data, pos)[0]
+    pos += 2
+
+    stamp = time.strftime("%Y-%m-%d %H:%M:%S", time.localtime(time_ns // 1000000000))
+    line = "[%s][HIPBLASLT][%d][%s][%s] " % (stamp, pid, LAYERS.get(layer, "Invalid"), func)
+    if show_tid:
+        line = "[%d.%09d][%d]" % (time_ns // 1000000000, time_ns % 1000000000, tid) + line
+
+    # Arguments alternate between names and values, as in log_arguments.
+    for i in range(argc):
+        value, pos = format_arg(data, pos)
+        if i % 2 == 1:
+            line += "=" + value + " "
+        else:
+            line += value
+    return line
+
+
+def decode(stream, out, show_tid):
+    header = stream.read(len(MAGIC) + 8)
+    if header[:len(MAGIC)] != MAGIC:
+        raise ValueError("not a binary hipBLASLt log")
+    version, pid = struct.unpack_from("<II", header, len(MAGIC))
+    if version != VERSION:
+        raise ValueError("unsupported binary log version %d" % version)
+
+    while True:
+        size = stream.read(4)
+        if len(size) < 4:
+            break
+        size = struct.unpack("<I", size)[0]
+        record = stream.read(size)
+        if len(record) < size:
+            print("truncated record at end of log", file=sys.stderr)
+            break
+        out.write(format_record(record, pid, show_tid) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("log", help="binary log file")
+    parser.add_argument("-o", "--output", help="output file, default stdout")
+    parser.add_argument("--tid",
+                        action="store_true",
+                        help="prefix each line with the exact time and the thread id")
+    args = parser.parse_args()
+
+    with open(args.log, "rb") as stream:
+        if args.output:
+            with open(args.output, "w") as out:
+                decode(stream, out, args.tid)
+        else:
+            decode(stream, sys.stdout, args.tid)
+
+
+if __name__ == "__main__":
+    main()
@@ -114,6 +114,26 @@ namespace
                 testing_aux_matmul_pref_init_bad_arg(arg);
             else if(!strcmp(arg.function, "aux_matmul_plan_init"))
                 testing_aux_matmul_pref_init(arg);
+            else if(!strcmp(arg.function, "aux_solution_cache"))
+                testing_aux_solution_cache(arg);
+            else if(!strcmp(arg.function, "aux_preload"))
+                testing_aux_preload(arg);
+            else if(!strcmp(arg.function, "aux_get_best_algos_batched"))
+                testing_aux_get_best_algos_batched(arg);
+            else if(!strcmp(arg.function, "aux_matmul_pref_limits"))
+                testing_aux_matmul_pref_limits<TiA, TiB, To, Tc>(arg);
+            else if(!strcmp(arg.function, "aux_heuristic_plan"))
+                testing_aux_heuristic_plan(arg);
+            else if(!strcmp(arg.function, "aux_virtual_device"))
+                testing_aux_virtual_device(arg);
+            else if(!strcmp(arg.function, "aux_gemm_update_inputs"))
+                testing_aux_gemm_update_inputs<TiA, TiB, To, Tc>(arg);
+            else if(!strcmp(arg.function, "aux_grouped_gemm_update_inputs"))
+                testing_aux_grouped_gemm_update_inputs<TiA, TiB, To, Tc>(arg);
+            else if(!strcmp(arg.function, "aux_launch_plan"))
+                testing_aux_launch_plan<TiA, TiB, To, Tc>(arg);
+            else if(!strcmp(arg.function, "aux_gsu_launch"))
+                testing_aux_gsu_launch<TiA, TiB, To, Tc>(arg);
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
@@ -149,7 +169,17 @@ namespace
                    || !strcmp(arg.function, "aux_matmul_alg_set_attr_bad_arg")
                    || !strcmp(arg.function, "aux_matmul_alg_get_attr_bad_arg")
                    || !strcmp(arg.function, "aux_matmul_plan_init_bad_arg")
-                   || !strcmp(arg.function, "aux_matmul_plan_init");
+                   || !strcmp(arg.function, "aux_matmul_plan_init")
+                   || !strcmp(arg.function, "aux_solution_cache")
+                   || !strcmp(arg.function, "aux_preload")
+                   || !strcmp(arg.function, "aux_get_best_algos_batched")
+                   || !strcmp(arg.function, "aux_matmul_pref_limits")
+                   || !strcmp(arg.function, "aux_heuristic_plan")
+                   || !strcmp(arg.function, "aux_virtual_device")
+                   || !strcmp(arg.function, "aux_gemm_update_inputs")
+                   || !strcmp(arg.function, "aux_grouped_gemm_update_inputs")
+                   || !strcmp(arg.function, "aux_launch_plan")
+                   || !strcmp(arg.function, "aux_gsu_launch");
         }
 
         // Google Test name suffix based on parameters
@@ -186,6 +186,15 @@ namespace
                     name << "_APIFindAllAlgo";
                 if(arg.use_user_args)
                     name << "_UserArgs";
+                if(arg.verify_method)
+                    name << "_Verify" << arg.verify_method << '_' << arg.verify_tile << '_'
+                         << arg.verify_count;
+                if(arg.verify_method == 1 && arg.verify_seed)
+                    name << "_Seed" << arg.verify_seed;
+                if(arg.timing && arg.rotating)
+                    name << "_Rotating" << arg.rotating;
+                if(arg.timing && arg.flush)
+                    name << "_Flush";
             }
 
             return std::move(name);
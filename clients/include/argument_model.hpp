@@ -61,7 +61,8 @@ public:
                   double                      norm1,
                   double                      norm2,
                   double                      norm3,
-                  double                      norm4)
+                  double                      norm4,
+                  double                      cold_gpu_us)
     {
         constexpr bool has_batch_count = has(e_batch_count);
         int64_t        batch_count     = has_batch_count ? arg.batch_count : 1;
@@ -92,6 +93,22 @@ public:
         name_line << ",us";
         val_line << ", " << gpu_us;
 
+        // time of the same calls with cold caches, see hipblaslt_rotating.hpp
+        if(cold_gpu_us != ArgumentLogging::NA_value)
+        {
+            if(hot_calls > 1)
+                cold_gpu_us /= hot_calls;
+
+            if(gflops != ArgumentLogging::NA_value)
+            {
+                name_line << ",cold-Gflops";
+                val_line << ", " << gflops * batch_count / cold_gpu_us * 1e6;
+            }
+
+            name_line << ",cold-us";
+            val_line << ", " << cold_gpu_us;
+        }
+
         if(arg.unit_check || arg.norm_check)
         {
             if(cpu_us != ArgumentLogging::NA_value)
@@ -137,12 +154,13 @@ public:
                   const Arguments&            arg,
                   double                      gpu_us,
                   double                      gflops,
-                  double                      gpu_bytes = ArgumentLogging::NA_value,
-                  double                      cpu_us    = ArgumentLogging::NA_value,
-                  double                      norm1     = ArgumentLogging::NA_value,
-                  double                      norm2     = ArgumentLogging::NA_value,
-                  double                      norm3     = ArgumentLogging::NA_value,
-                  double                      norm4     = ArgumentLogging::NA_value)
+                  double                      gpu_bytes   = ArgumentLogging::NA_value,
+                  double                      cpu_us      = ArgumentLogging::NA_value,
+                  double                      norm1       = ArgumentLogging::NA_value,
+                  double                      norm2       = ArgumentLogging::NA_value,
+                  double                      norm3       = ArgumentLogging::NA_value,
+                  double                      norm4       = ArgumentLogging::NA_value,
+                  double                      cold_gpu_us = ArgumentLogging::NA_value)
     {
         hipblaslt_internal_ostream name_list;
         hipblaslt_internal_ostream value_list;
@@ -180,7 +198,8 @@ public:
                      norm1,
                      norm2,
                      norm3,
-                     norm4);
+                     norm4,
+                     cold_gpu_us);
 
         str << name_list << "\n" << value_list << std::endl;
     }
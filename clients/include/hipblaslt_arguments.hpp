@@ -144,6 +144,16 @@ struct Arguments
     int  algo_method; // 0 for getheuristic, 1 for get all algos, 2 for algo index
     bool use_user_args;
 
+    // Sampled verification, see hipblaslt_sample.hpp
+    int32_t verify_method; // 0 for all of D, 1 for random blocks, 2 for every verify_count-th tile
+    int32_t verify_tile;
+    int32_t verify_count;
+    int32_t verify_seed; // picks the random blocks, with the index of the GEMM
+
+    // Timing with cold caches, see hipblaslt_rotating.hpp
+    int32_t rotating; // MiB taken by the rotating copies of the buffers, 0 to disable
+    bool    flush;
+
     /*************************************************************************
      *                     End Of Arguments                                  *
      *************************************************************************/
@@ -219,7 +229,13 @@ struct Arguments
     OPER(use_ext) SEP                \
     OPER(use_ext_setproblem) SEP     \
     OPER(algo_method) SEP            \
-    OPER(use_user_args) SEP
+    OPER(use_user_args) SEP          \
+    OPER(verify_method) SEP          \
+    OPER(verify_tile) SEP            \
+    OPER(verify_count) SEP           \
+    OPER(verify_seed) SEP            \
+    OPER(rotating) SEP               \
+    OPER(flush) SEP
 
     // clang-format on
 
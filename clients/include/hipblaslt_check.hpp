@@ -0,0 +1,303 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include "hipblaslt_math.hpp"
+#include "hipblaslt_vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <hipblaslt/hipblaslt.h>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/* ============================================================================================ */
+/*! \brief  Compares a CPU reference with a GPU result in one pass.
+
+    hipblaslt_check walks batch_count column-major M x N matrices, splitting the
+    columns between OpenMP threads, and returns the mismatch count, the largest
+    absolute and relative errors and the Frobenius norm error used by
+    norm_check_general. Elements are equal under the same rules as the
+    ASSERT_*_EQ macros of unit.hpp: integers exactly, double within 4 ULPs and
+    the other floating point types within 4 float ULPs. A NaN reference only
+    matches a NaN result. */
+
+//! Position and values of an element that differs.
+struct hipblaslt_check_failure
+{
+    int64_t batch;
+    int64_t row;
+    int64_t col;
+    double  expected;
+    double  actual;
+};
+
+struct hipblaslt_check_result
+{
+    int64_t elements      = 0; //!< elements compared
+    int64_t mismatches    = 0;
+    double  max_abs_error = 0; //!< max |CPU - GPU|
+    double  max_rel_error = 0; //!< max |CPU - GPU| / |CPU| over the nonzero CPU elements
+    double  norm_error    = 0; //!< sum over the batches of ||CPU - GPU||_F / ||CPU||_F
+    bool    stopped_early = false; //!< the counts and errors only cover part of the matrices
+
+    //! The first mismatches by position, or the first ones found when stopped early.
+    std::vector<hipblaslt_check_failure> failures;
+
+    bool passed() const
+    {
+        return mismatches == 0;
+    }
+};
+
+struct hipblaslt_check_options
+{
+    int64_t max_failures = 10; //!< mismatches kept in hipblaslt_check_result::failures
+    bool    early_exit   = false; //!< stop once max_failures mismatches are found
+
+    //! Rows of each column that count as compared elements, all M if null. The other
+    //! rows must be padding that matches.
+    const int64_t* column_rows = nullptr;
+};
+
+template <typename T>
+inline double hipblaslt_check_value(const T& x)
+{
+    if constexpr(std::is_integral<T>{} || std::is_floating_point<T>{})
+        return static_cast<double>(x);
+    else
+        return static_cast<double>(static_cast<float>(x));
+}
+
+//! Equality within 4 ULPs, like testing::internal::FloatingPoint::AlmostEquals.
+template <typename F, typename U>
+inline bool hipblaslt_check_almost_equal(F a, F b)
+{
+    if(std::isnan(a) || std::isnan(b))
+        return false;
+
+    constexpr U sign = U(1) << (sizeof(U) * 8 - 1);
+    auto biased = [](F f) {
+        U u;
+        std::memcpy(&u, &f, sizeof(U));
+        return (u & sign) ? ~u + 1 : sign | u;
+    };
+    U x = biased(a), y = biased(b);
+    return (x >= y ? x - y : y - x) <= 4;
+}
+
+template <typename Tref, typename T>
+inline bool hipblaslt_check_equal(const Tref& ref, const T& out)
+{
+    if constexpr(std::is_integral<T>{})
+        return ref == out;
+    else if constexpr(std::is_same<T, double>{})
+        return hipblaslt_check_almost_equal<double, uint64_t>(double(ref), out);
+    else if constexpr(std::is_same<T, hip_bfloat16>{} && std::is_same<Tref, float>{})
+        // The GPU may round or truncate a float accumulator to bfloat16
+        return hipblaslt_check_almost_equal<float, uint32_t>(
+                   float(out), float(float_to_bfloat16_truncate(ref)))
+               || hipblaslt_check_almost_equal<float, uint32_t>(float(out),
+                                                                float(hip_bfloat16(ref)));
+    else
+        return hipblaslt_check_almost_equal<float, uint32_t>(float(ref), float(out));
+}
+
+//! A NaN reference only matches a NaN result.
+template <typename Tref, typename T>
+inline bool hipblaslt_check_match(const Tref& ref, const T& out)
+{
+    double expected = hipblaslt_check_value(ref);
+    return std::isnan(expected) ? std::isnan(hipblaslt_check_value(out))
+                                : hipblaslt_check_equal(ref, out);
+}
+
+/*! \brief  hipblaslt_check with the matrices of batch k at ref(k) and out(k). */
+template <typename Tref, typename T, typename RefBatch, typename OutBatch>
+hipblaslt_check_result hipblaslt_check_batches(int64_t                        M,
+                                               int64_t                        N,
+                                               int64_t                        lda,
+                                               RefBatch&&                     ref,
+                                               OutBatch&&                     out,
+                                               int64_t                        batch_count,
+                                               const hipblaslt_check_options& options)
+{
+    int64_t              max_failures = std::max<int64_t>(options.max_failures, 0);
+    int64_t              columns      = N * batch_count;
+    std::atomic<int64_t> found{0};
+    std::atomic<bool>    stop{false};
+    int64_t              stop_after = std::max<int64_t>(max_failures, 1);
+
+    hipblaslt_check_result result;
+    std::vector<double>    error_sq(batch_count), ref_sq(batch_count);
+
+#pragma omp parallel
+    {
+        hipblaslt_check_result local;
+        std::vector<double>    local_error_sq(batch_count), local_ref_sq(batch_count);
+
+#pragma omp for schedule(static) nowait
+        for(int64_t c = 0; c < columns; c++)
+        {
+            if(stop.load(std::memory_order_relaxed))
+                continue;
+
+            int64_t     k = c / N, j = c % N;
+            const Tref* r = ref(k) + j * size_t(lda);
+            const T*    o = out(k) + j * size_t(lda);
+
+            // Errors and mismatch count, without branches so the loop can be vectorized
+            double  col_error_sq = 0, col_ref_sq = 0, col_abs = 0, col_rel = 0;
+            int64_t col_mismatches = 0;
+#pragma omp simd reduction(+ : col_error_sq, col_ref_sq, col_mismatches) \
+    reduction(max : col_abs, col_rel)
+            for(int64_t i = 0; i < M; i++)
+            {
+                double expected = hipblaslt_check_value(r[i]);
+                double actual   = hipblaslt_check_value(o[i]);
+                double error    = std::abs(expected - actual);
+
+                col_error_sq += error * error;
+                col_ref_sq += expected * expected;
+                col_abs = std::max(col_abs, error);
+                col_rel = std::max(col_rel, expected != 0 ? error / std::abs(expected) : 0.0);
+                col_mismatches += !hipblaslt_check_match(r[i], o[i]);
+            }
+
+            for(int64_t i = 0; col_mismatches && i < M
+                               && int64_t(local.failures.size()) < max_failures;
+                i++)
+                if(!hipblaslt_check_match(r[i], o[i]))
+                    local.failures.push_back(
+                        {k, i, j, hipblaslt_check_value(r[i]), hipblaslt_check_value(o[i])});
+
+            local_error_sq[k] += col_error_sq;
+            local_ref_sq[k] += col_ref_sq;
+            local.elements += options.column_rows ? options.column_rows[j] : M;
+            local.mismatches += col_mismatches;
+            local.max_abs_error = std::max(local.max_abs_error, col_abs);
+            local.max_rel_error = std::max(local.max_rel_error, col_rel);
+
+            if(col_mismatches && options.early_exit
+               && found.fetch_add(col_mismatches) + col_mismatches >= stop_after)
+                stop.store(true, std::memory_order_relaxed);
+        }
+
+#pragma omp critical
+        {
+            result.elements += local.elements;
+            result.mismatches += local.mismatches;
+            result.max_abs_error = std::max(result.max_abs_error, local.max_abs_error);
+            result.max_rel_error = std::max(result.max_rel_error, local.max_rel_error);
+            result.failures.insert(
+                result.failures.end(), local.failures.begin(), local.failures.end());
+            for(int64_t k = 0; k < batch_count; k++)
+            {
+                error_sq[k] += local_error_sq[k];
+                ref_sq[k] += local_ref_sq[k];
+            }
+        }
+    }
+
+    std::sort(result.failures.begin(),
+              result.failures.end(),
+              [](const hipblaslt_check_failure& a, const hipblaslt_check_failure& b) {
+                  return std::tie(a.batch, a.col, a.row) < std::tie(b.batch, b.col, b.row);
+              });
+    if(int64_t(result.failures.size()) > max_failures)
+        result.failures.resize(max_failures);
+
+    for(int64_t k = 0; k < batch_count; k++)
+        result.norm_error += std::sqrt(error_sq[k]) / std::sqrt(ref_sq[k]);
+
+    result.stopped_early = stop.load();
+    return result;
+}
+
+//! Strided batched matrices.
+template <typename Tref, typename T>
+hipblaslt_check_result hipblaslt_check(int64_t                        M,
+                                       int64_t                        N,
+                                       int64_t                        lda,
+                                       int64_t                        stride,
+                                       const Tref*                    hCPU,
+                                       const T*                       hGPU,
+                                       int64_t                        batch_count,
+                                       const hipblaslt_check_options& options = {})
+{
+    return hipblaslt_check_batches<Tref, T>(
+        M,
+        N,
+        lda,
+        [=](int64_t k) { return hCPU + k * stride; },
+        [=](int64_t k) { return hGPU + k * stride; },
+        batch_count,
+        options);
+}
+
+//! Batched matrices in host vectors.
+template <typename Tref, typename T>
+hipblaslt_check_result hipblaslt_check(int64_t                        M,
+                                       int64_t                        N,
+                                       int64_t                        lda,
+                                       const host_vector<Tref>        hCPU[],
+                                       const host_vector<T>           hGPU[],
+                                       int64_t                        batch_count,
+                                       const hipblaslt_check_options& options = {})
+{
+    return hipblaslt_check_batches<Tref, T>(
+        M,
+        N,
+        lda,
+        [=](int64_t k) { return hCPU[k].data(); },
+        [=](int64_t k) { return hGPU[k].data(); },
+        batch_count,
+        options);
+}
+
+//! Batched matrices behind arrays of pointers.
+template <typename Tref, typename T>
+hipblaslt_check_result hipblaslt_check(int64_t                        M,
+                                       int64_t                        N,
+                                       int64_t                        lda,
+                                       const Tref* const              hCPU[],
+                                       const T* const                 hGPU[],
+                                       int64_t                        batch_count,
+                                       const hipblaslt_check_options& options = {})
+{
+    return hipblaslt_check_batches<Tref, T>(
+        M,
+        N,
+        lda,
+        [=](int64_t k) { return hCPU[k]; },
+        [=](int64_t k) { return hGPU[k]; },
+        batch_count,
+        options);
+}
@@ -0,0 +1,176 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <hipblaslt/hipblaslt.h>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+/* ============================================================================================ */
+/*! \brief  Bulk conversions between the host types used by the clients.
+
+    convert_n(dst, src, count) gives the same results as
+    dst[i] = static_cast<Tdst>(src[i]) for every element. Conversions from
+    8-bit floats use lookup tables, half conversions use F16C when the client
+    is built with it, and large buffers are split between OpenMP threads.
+    Conversions to 8-bit floats saturate, like the hipblaslt_f8 and
+    hipblaslt_bf8 constructors. */
+
+//! Elements converted by one thread at a time.
+constexpr size_t hipblaslt_convert_block = 16384;
+
+template <typename F>
+inline void hipblaslt_convert_blocks(size_t count, F&& convert)
+{
+    if(count <= hipblaslt_convert_block)
+    {
+        convert(size_t(0), count);
+        return;
+    }
+
+#pragma omp parallel for schedule(static)
+    for(size_t begin = 0; begin < count; begin += hipblaslt_convert_block)
+        convert(begin, std::min(count, begin + hipblaslt_convert_block));
+}
+
+//! The float values of all 256 encodings of an 8-bit float type.
+template <typename T8>
+inline const std::array<float, 256>& hipblaslt_f8_decode_table()
+{
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> values;
+        for(int i = 0; i < 256; i++)
+        {
+            T8 value;
+            value.data = static_cast<uint8_t>(i);
+            values[i]  = static_cast<float>(value);
+        }
+        return values;
+    }();
+    return table;
+}
+
+template <typename Tdst, typename Tsrc>
+inline void convert_n(Tdst* dst, const Tsrc* src, size_t count)
+{
+    hipblaslt_convert_blocks(count, [=](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; i++)
+            dst[i] = static_cast<Tdst>(src[i]);
+    });
+}
+
+template <typename T8>
+inline void hipblaslt_convert_from_f8(float* dst, const T8* src, size_t count)
+{
+    const float* table = hipblaslt_f8_decode_table<T8>().data();
+    hipblaslt_convert_blocks(count, [=](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; i++)
+            dst[i] = table[src[i].data];
+    });
+}
+
+inline void convert_n(float* dst, const hipblaslt_f8* src, size_t count)
+{
+    hipblaslt_convert_from_f8(dst, src, count);
+}
+
+inline void convert_n(float* dst, const hipblaslt_bf8* src, size_t count)
+{
+    hipblaslt_convert_from_f8(dst, src, count);
+}
+
+inline void convert_n(float* dst, const hip_bfloat16* src, size_t count)
+{
+    hipblaslt_convert_blocks(count, [=](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; i++)
+        {
+            uint32_t bits = uint32_t(src[i].data) << 16;
+            std::memcpy(dst + i, &bits, sizeof(float));
+        }
+    });
+}
+
+inline void convert_n(float* dst, const hipblasLtHalf* src, size_t count)
+{
+    hipblaslt_convert_blocks(count, [=](size_t begin, size_t end) {
+        size_t i = begin;
+#if defined(__F16C__)
+        for(; i + 8 <= end; i += 8)
+            _mm256_storeu_ps(dst + i,
+                             _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(src + i))));
+#endif
+        for(; i < end; i++)
+            dst[i] = static_cast<float>(src[i]);
+    });
+}
+
+inline void convert_n(hipblasLtHalf* dst, const float* src, size_t count)
+{
+    hipblaslt_convert_blocks(count, [=](size_t begin, size_t end) {
+        size_t i = begin;
+#if defined(__F16C__)
+        for(; i + 8 <= end; i += 8)
+            _mm_storeu_si128(
+                (__m128i*)(dst + i),
+                _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+#endif
+        for(; i < end; i++)
+            dst[i] = static_cast<hipblasLtHalf>(src[i]);
+    });
+}
+
+//! The random number used to round element i with seed, whichever thread converts it.
+inline uint32_t hipblaslt_convert_rng(uint32_t seed, size_t i)
+{
+    uint64_t x = (uint64_t(seed) << 32) ^ i;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return static_cast<uint32_t>(x);
+}
+
+/*! \brief  Converts to hipblaslt_f8 or hipblaslt_bf8 with stochastic rounding. The
+    result only depends on seed and the position of each element. */
+template <typename T8>
+inline void convert_n_stochastic(T8* dst, const float* src, size_t count, uint32_t seed)
+{
+    hipblaslt_convert_blocks(count, [=](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; i++)
+            dst[i] = T8(src[i],
+                        T8::hipblaslt_hip_f8_rounding_mode::stochastic,
+                        hipblaslt_convert_rng(seed, i));
+    });
+}
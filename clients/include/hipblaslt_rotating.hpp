@@ -0,0 +1,232 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <hip/hip_runtime.h>
+#include <unordered_map>
+#include <vector>
+
+/* ============================================================================================ */
+/*! \brief  Timing with cold caches.
+
+    Timing loops that call a GEMM back to back on the same buffers leave the inputs
+    of small and medium problems in the L2 and MALL caches, while in applications
+    they usually come from HBM. hipblaslt_rotating_buffers gives each call of a
+    timing loop its own copy of the buffers, and hipblaslt_cache_flush evicts the
+    caches before a call. */
+
+//! Distinct copies of device buffers, copy 0 being the buffers themselves.
+class hipblaslt_rotating_buffers
+{
+public:
+    //! Most copies that are allocated. Each copy costs an allocation and, for grouped gemms,
+    //! its own arguments, while small buffers would otherwise need many thousands of copies.
+    static constexpr size_t max_copies = 128;
+
+    hipblaslt_rotating_buffers() = default;
+
+    hipblaslt_rotating_buffers(const hipblaslt_rotating_buffers&) = delete;
+    hipblaslt_rotating_buffers& operator=(const hipblaslt_rotating_buffers&) = delete;
+
+    ~hipblaslt_rotating_buffers()
+    {
+        for(void* slab : m_slabs)
+            (void)hipFree(slab);
+    }
+
+    //! Registers a device buffer. Null and already registered buffers are ignored.
+    void add(const void* buffer, size_t bytes)
+    {
+        if(buffer == nullptr || bytes == 0)
+            return;
+        if(m_index.emplace(buffer, m_buffers.size()).second)
+        {
+            m_buffers.push_back({buffer, bytes, m_bytes});
+            // Each copy starts as aligned as hipMalloc would have left it
+            m_bytes += (bytes + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    /*! \brief  Copies the registered buffers until all the copies take at least size_mb MiB,
+        or into max_copies copies if that takes more. Each copy is one allocation, in which
+        the buffers are at fixed offsets. */
+    hipError_t allocate(size_t size_mb)
+    {
+        size_t total  = size_mb << 20;
+        size_t copies = m_bytes ? std::max<size_t>((total + m_bytes - 1) / m_bytes, 1) : 1;
+        m_capped      = copies > max_copies;
+        copies        = std::min(copies, max_copies);
+
+        m_slabs.reserve(copies - 1);
+        for(size_t c = 1; c < copies; c++)
+        {
+            void* memory = nullptr;
+            if(auto err = hipMalloc(&memory, m_bytes))
+                return err;
+            char* slab = static_cast<char*>(memory);
+            m_slabs.push_back(slab);
+            for(const auto& buffer : m_buffers)
+                if(auto err = hipMemcpy(
+                       slab + buffer.offset, buffer.ptr, buffer.bytes, hipMemcpyDeviceToDevice))
+                    return err;
+        }
+
+        m_count = copies;
+        return hipSuccess;
+    }
+
+    size_t copies() const
+    {
+        return m_count;
+    }
+
+    //! Whether allocate() made fewer copies than size_mb MiB asked for.
+    bool capped() const
+    {
+        return m_capped;
+    }
+
+    //! Bytes of one copy of the registered buffers.
+    size_t bytes() const
+    {
+        return m_bytes;
+    }
+
+    //! The copy of a registered buffer, or the buffer itself for copy 0 and other buffers.
+    template <typename T>
+    T* get(size_t copy, T* buffer) const
+    {
+        auto it = m_index.find(buffer);
+        if(copy % m_count == 0 || it == m_index.end())
+            return buffer;
+        return reinterpret_cast<T*>(m_slabs[copy % m_count - 1] + m_buffers[it->second].offset);
+    }
+
+private:
+    static constexpr size_t alignment = 256;
+
+    struct buffer_t
+    {
+        const void* ptr;
+        size_t      bytes;
+        size_t      offset; //!< in each copy
+    };
+
+    std::vector<buffer_t>                   m_buffers;
+    std::unordered_map<const void*, size_t> m_index;
+    std::vector<char*>                      m_slabs;
+    size_t                                  m_bytes  = 0;
+    size_t                                  m_count  = 1;
+    bool                                    m_capped = false;
+};
+
+//! Invalidates the instruction cache of the compute unit and writes through the buffer.
+template <typename T>
+__global__ void hipblaslt_flush_kernel(T* buffer, size_t count)
+{
+#if defined(__GFX9__) || defined(__GFX10__) || defined(__GFX11__)
+    if(threadIdx.x == 0)
+        asm volatile("s_icache_inv\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t"
+                     "s_nop 0\n\t");
+#endif
+    size_t stride = size_t(gridDim.x) * blockDim.x;
+    for(size_t i = size_t(blockIdx.x) * blockDim.x + threadIdx.x; i < count; i += stride)
+        buffer[i]++;
+}
+
+/*! \brief  Evicts the caches of the current device by writing through a buffer larger than
+    its L2 cache and MALL, and invalidates the instruction caches. */
+class hipblaslt_cache_flush
+{
+public:
+    hipblaslt_cache_flush()
+    {
+        int             device;
+        hipDeviceProp_t props;
+        if((m_error = hipGetDevice(&device)) || (m_error = hipGetDeviceProperties(&props, device)))
+            return;
+
+        // The MALL is not reported, 256 MiB covers it on current devices
+        size_t bytes = std::max<size_t>(size_t(4) * props.l2CacheSize, size_t(256) << 20);
+        m_count      = bytes / sizeof(uint32_t);
+        m_blocks     = std::max(props.multiProcessorCount, 1) * 4;
+        m_error      = hipMalloc(&m_buffer, bytes);
+        if(m_error == hipSuccess)
+            m_error = hipMemset(m_buffer, 0, bytes);
+    }
+
+    hipblaslt_cache_flush(const hipblaslt_cache_flush&) = delete;
+    hipblaslt_cache_flush& operator=(const hipblaslt_cache_flush&) = delete;
+
+    ~hipblaslt_cache_flush()
+    {
+        if(m_buffer)
+            (void)hipFree(m_buffer);
+    }
+
+    //! The error of the allocation, hipSuccess if the flush can be used.
+    hipError_t memcheck() const
+    {
+        return m_error;
+    }
+
+    hipError_t operator()(hipStream_t stream) const
+    {
+        hipLaunchKernelGGL(hipblaslt_flush_kernel<uint32_t>,
+                           dim3(m_blocks),
+                           dim3(256),
+                           0,
+                           stream,
+                           m_buffer,
+                           m_count);
+        return hipGetLastError();
+    }
+
+private:
+    uint32_t*  m_buffer = nullptr;
+    size_t     m_count  = 0;
+    int        m_blocks = 1;
+    hipError_t m_error  = hipSuccess;
+};
@@ -0,0 +1,307 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include "cblas_interface.hpp"
+#include "hipblaslt_check.hpp"
+#include "hipblaslt_ostream.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/* ============================================================================================ */
+/*! \brief  Sampled verification of large matrices.
+
+    Instead of computing and comparing all of D, the reference is only computed
+    in a sample of tiles of D, and only those tiles are compared:
+
+    verify_method 1: verify_count random row blocks crossed with verify_count
+                     random column blocks, picked by verify_seed and the index of
+                     the GEMM
+    verify_method 2: every verify_count-th tile of each row of tiles, shifted by
+                     one tile from one row to the next so that every row block and
+                     column block is sampled; the same tiles on every run
+
+    Tiles are verify_tile x verify_tile, smaller at the edges of D. */
+
+//! Rows [row, row + rows) and columns [col, col + cols) of a matrix.
+struct hipblaslt_tile
+{
+    int64_t row;
+    int64_t col;
+    int64_t rows;
+    int64_t cols;
+};
+
+/*! \brief  Tiles of an M x N matrix to verify, or none when the whole matrix is verified.
+    The random blocks of method 1 depend on both seed and gemm, so that each GEMM of a
+    grouped GEMM gets its own. With full_rows the tiles span all the columns, for
+    references that reduce whole rows of D such as the bias gradient. */
+inline std::vector<hipblaslt_tile> hipblaslt_sample_tiles(int64_t  M,
+                                                          int64_t  N,
+                                                          int32_t  method,
+                                                          int64_t  tile,
+                                                          int64_t  count,
+                                                          uint32_t seed,
+                                                          uint32_t gemm,
+                                                          bool     full_rows)
+{
+    std::vector<hipblaslt_tile> tiles;
+    if(method == 0 || M <= 0 || N <= 0)
+        return tiles;
+
+    tile  = std::max<int64_t>(tile, 1);
+    count = std::max<int64_t>(count, 1);
+
+    int64_t row_blocks = (M + tile - 1) / tile;
+    int64_t col_blocks = full_rows ? 1 : (N + tile - 1) / tile;
+    auto    add        = [&](int64_t i, int64_t j) {
+        int64_t row = i * tile, col = full_rows ? 0 : j * tile;
+        tiles.push_back({row,
+                         col,
+                         std::min(tile, M - row),
+                         full_rows ? N : std::min(tile, N - col)});
+    };
+
+    if(method == 1)
+    {
+        // Picks count distinct blocks of each dimension
+        std::seed_seq seq{seed, gemm};
+        std::mt19937  rng(seq);
+        auto          pick = [&](int64_t blocks) {
+            std::vector<int64_t> picked(blocks);
+            std::iota(picked.begin(), picked.end(), 0);
+            int64_t n = std::min(count, blocks);
+            for(int64_t i = 0; i < n; i++)
+                std::swap(picked[i], picked[i + rng() % (blocks - i)]);
+            picked.resize(n);
+            std::sort(picked.begin(), picked.end());
+            return picked;
+        };
+
+        auto rows = pick(row_blocks);
+        auto cols = pick(col_blocks);
+        for(int64_t i : rows)
+            for(int64_t j : cols)
+                add(i, j);
+    }
+    else if(full_rows)
+    {
+        for(int64_t i = 0; i < row_blocks; i += count)
+            add(i, 0);
+    }
+    else
+    {
+        for(int64_t i = 0; i < row_blocks; i++)
+            for(int64_t j = i % count; j < col_blocks; j += count)
+                add(i, j);
+    }
+
+    return tiles;
+}
+
+/*! \brief  cblas_gemm, or cblas_gemm_alphascale when AlphaVec is set, restricted to a tile
+    of C. The rows of op(A) and columns of op(B) that the tile needs are packed first, so
+    the cost is that of a GEMM of the size of the tile. */
+template <typename TiA, typename TiB, typename To, typename Tc>
+void cblas_gemm_tile(const hipblaslt_tile& t,
+                     hipblasOperation_t    transA,
+                     hipblasOperation_t    transB,
+                     int64_t               m,
+                     int64_t               n,
+                     int64_t               k,
+                     Tc                    alpha,
+                     const TiA*            A,
+                     int64_t               lda,
+                     const TiB*            B,
+                     int64_t               ldb,
+                     Tc                    beta,
+                     To*                   C,
+                     int64_t               ldc,
+                     const Tc*             AlphaVec,
+                     Tc                    scaleD)
+{
+    if(t.row == 0 && t.col == 0 && t.rows == m && t.cols == n)
+    {
+        if(AlphaVec)
+            cblas_gemm_alphascale<TiA, TiB, To, Tc>(
+                transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, AlphaVec, scaleD);
+        else
+            cblas_gemm<TiA, TiB, To, Tc>(
+                transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, scaleD);
+        return;
+    }
+
+    bool    transposeA = transA != HIPBLAS_OP_N;
+    bool    transposeB = transB != HIPBLAS_OP_N;
+    int64_t lda_t      = transposeA ? k : t.rows;
+    int64_t ldb_t      = transposeB ? t.cols : k;
+
+    host_vector<TiA> A_t(t.rows * k);
+    host_vector<TiB> B_t(k * t.cols);
+    host_vector<To>  C_t(t.rows * t.cols);
+
+#pragma omp parallel for
+    for(int64_t l = 0; l < k; l++)
+    {
+        for(int64_t i = 0; i < t.rows; i++)
+            if(transposeA)
+                A_t[l + i * lda_t] = A[l + (t.row + i) * lda];
+            else
+                A_t[i + l * lda_t] = A[t.row + i + l * lda];
+        for(int64_t j = 0; j < t.cols; j++)
+            if(transposeB)
+                B_t[j + l * ldb_t] = B[t.col + j + l * ldb];
+            else
+                B_t[l + j * ldb_t] = B[l + (t.col + j) * ldb];
+    }
+
+    for(int64_t j = 0; j < t.cols; j++)
+        std::copy_n(C + t.row + (t.col + j) * ldc, t.rows, C_t.begin() + j * t.rows);
+
+    if(AlphaVec)
+        cblas_gemm_alphascale<TiA, TiB, To, Tc>(transA,
+                                                transB,
+                                                t.rows,
+                                                t.cols,
+                                                k,
+                                                alpha,
+                                                A_t,
+                                                lda_t,
+                                                B_t,
+                                                ldb_t,
+                                                beta,
+                                                C_t,
+                                                t.rows,
+                                                AlphaVec + t.row,
+                                                scaleD);
+    else
+        cblas_gemm<TiA, TiB, To, Tc>(transA,
+                                     transB,
+                                     t.rows,
+                                     t.cols,
+                                     k,
+                                     alpha,
+                                     A_t,
+                                     lda_t,
+                                     B_t,
+                                     ldb_t,
+                                     beta,
+                                     C_t,
+                                     t.rows,
+                                     scaleD);
+
+    for(int64_t j = 0; j < t.cols; j++)
+        std::copy_n(C_t.begin() + j * t.rows, t.rows, C + t.row + (t.col + j) * ldc);
+}
+
+/*! \brief  hipblaslt_check of the tiles of strided batched matrices. The tiles of each batch
+    are gathered side by side, so the norm error is that of all the sampled elements of a
+    batch, summed over the batches, and the failures are reported at their position in the
+    matrices. */
+template <typename Tref, typename T>
+hipblaslt_check_result hipblaslt_check_tiles(const std::vector<hipblaslt_tile>& tiles,
+                                             int64_t                            lda,
+                                             int64_t                            stride,
+                                             const Tref*                        hCPU,
+                                             const T*                           hGPU,
+                                             int64_t                            batch_count,
+                                             const hipblaslt_check_options&     options = {})
+{
+    std::vector<int64_t> first_col(tiles.size() + 1, 0), col_rows;
+    int64_t              rows = 0;
+    for(size_t t = 0; t < tiles.size(); t++)
+    {
+        rows             = std::max(rows, tiles[t].rows);
+        first_col[t + 1] = first_col[t] + tiles[t].cols;
+        col_rows.insert(col_rows.end(), tiles[t].cols, tiles[t].rows);
+    }
+    int64_t cols = first_col.back();
+
+    // Rows of the shorter tiles are padded with zeros, which always match and are
+    // not counted as compared elements
+    host_vector<Tref> ref(rows * cols * batch_count);
+    host_vector<T>    out(rows * cols * batch_count);
+
+#pragma omp parallel for collapse(2)
+    for(int64_t b = 0; b < batch_count; b++)
+        for(size_t t = 0; t < tiles.size(); t++)
+            for(int64_t j = 0; j < tiles[t].cols; j++)
+            {
+                size_t from = tiles[t].row + (tiles[t].col + j) * size_t(lda) + b * stride;
+                size_t to   = (first_col[t] + j) * size_t(rows) + b * rows * cols;
+                std::copy_n(hCPU + from, tiles[t].rows, ref.begin() + to);
+                std::copy_n(hGPU + from, tiles[t].rows, out.begin() + to);
+            }
+
+    hipblaslt_check_options tile_options = options;
+    tile_options.column_rows             = col_rows.data();
+
+    auto check = hipblaslt_check(
+        rows, cols, rows, rows * cols, ref.data(), out.data(), batch_count, tile_options);
+
+    for(auto& f : check.failures)
+    {
+        size_t t
+            = std::upper_bound(first_col.begin(), first_col.end(), f.col) - first_col.begin() - 1;
+        f.row += tiles[t].row;
+        f.col = tiles[t].col + f.col - first_col[t];
+    }
+
+    return check;
+}
+
+/*! \brief  Prints how much of a matrix a sampled check covered. The errors of the elements
+    of a tile are correlated, so the mismatch rate is that of the sampled elements only.
+    The random blocks of method 1 are what is sampled: when none of n of them has a
+    mismatch, at most 3/n of the blocks of the matrix have one, with 95% confidence (the
+    rule of three). The tiles of method 2 are fixed by the stride, so they give no bound. */
+inline void hipblaslt_sample_report(hipblaslt_internal_ostream&   os,
+                                    const char*                   name,
+                                    int64_t                       gemm,
+                                    int32_t                       method,
+                                    int64_t                       total,
+                                    size_t                        tiles,
+                                    const hipblaslt_check_result& check)
+{
+    double sampled = double(check.elements);
+    os << "verify " << name << " of gemm " << gemm << ": " << check.elements << " of " << total
+       << " elements (" << 100.0 * sampled / double(total) << "%) in " << tiles
+       << " tiles, " << (check.stopped_early ? "at least " : "") << check.mismatches
+       << " mismatches, max absolute error " << check.max_abs_error
+       << ", max relative error " << check.max_rel_error;
+    if(!check.stopped_early && sampled > 0)
+        os << ", mismatch rate of the sample " << double(check.mismatches) / sampled;
+    if(method == 1 && check.passed() && tiles > 0)
+        os << ", at most " << 100.0 * std::min(3.0 / double(tiles), 1.0)
+           << "% of the blocks mismatch (95% confidence)";
+    else if(method == 2)
+        os << ", deterministic tiles, no bound on the rest";
+    os << std::endl;
+}
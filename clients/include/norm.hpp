@@ -27,6 +27,7 @@
 #pragma once
 
 #include "cblas.h"
+#include "hipblaslt_check.hpp"
 #include "hipblaslt_vector.hpp"
 #include "norm.hpp"
 #include "utility.hpp"
@@ -239,6 +240,10 @@ double norm_check_general(char        norm_type,
     // use triangle inequality ||a+b|| <= ||a|| + ||b|| to calculate upper limit for Frobenius norm
     // of strided batched matrix
 
+    // The Frobenius norms of all the batches are computed in one parallel pass
+    if(norm_type == 'F' || norm_type == 'f')
+        return hipblaslt_check(M, N, lda, stride_a, (T_hpa*)hCPU, hGPU, batch_count).norm_error;
+
     double cumulative_error = 0.0;
 
     for(size_t i = 0; i < batch_count; i++)
@@ -273,6 +278,9 @@ double norm_check_general(
     // use triangle inequality ||a+b|| <= ||a|| + ||b|| to calculate upper limit for Frobenius norm
     // of strided batched matrix
 
+    if(norm_type == 'F' || norm_type == 'f')
+        return hipblaslt_check(M, N, lda, hCPU, hGPU, batch_count).norm_error;
+
     double cumulative_error = 0.0;
 
     for(int64_t i = 0; i < batch_count; i++)
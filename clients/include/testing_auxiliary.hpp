@@ -35,7 +35,14 @@
 #include "hipblaslt_vector.hpp"
 #include "unit.hpp"
 #include "utility.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <hipblaslt/hipblaslt-ext.hpp>
 #include <hipblaslt/hipblaslt.h>
+#include <set>
+#include <sstream>
+#include <unistd.h>
 
 void testing_aux_handle_init_bad_arg(const Arguments& arg)
 {
@@ -302,3 +309,883 @@ void testing_aux_matmul_pref_init(const Arguments& arg)
     hipblaslt_local_preference pref;
     EXPECT_HIPBLAS_STATUS(pref.status(), HIPBLAS_STATUS_SUCCESS);
 }
+
+void testing_aux_solution_cache(const Arguments& arg)
+{
+    hipblaslt_local_handle                 handle{arg};
+    hipblaslt_ext::SolutionCacheStatistics stats, before;
+    hipblaslt_local_matmul_descr           matmul(
+        HIPBLAS_OP_N, HIPBLAS_OP_N, arg.compute_type, arg.scale_type);
+    hipblaslt_local_preference pref;
+
+    auto getHeuristic = [&](int64_t m) {
+        const int64_t                 n = 256, k = 256;
+        hipblaslt_local_matrix_layout matA(m, k, m, arg.a_type);
+        hipblaslt_local_matrix_layout matB(k, n, k, arg.b_type);
+        hipblaslt_local_matrix_layout matC(m, n, m, arg.c_type);
+        hipblaslt_local_matrix_layout matD(m, n, m, arg.d_type);
+        hipblasLtMatmulHeuristicResult_t result;
+        int                              returnedAlgoCount = 0;
+        EXPECT_HIPBLAS_STATUS(hipblasLtMatmulAlgoGetHeuristic(handle,
+                                                              matmul,
+                                                              matA,
+                                                              matB,
+                                                              matC,
+                                                              matD,
+                                                              pref,
+                                                              1,
+                                                              &result,
+                                                              &returnedAlgoCount),
+                              HIPBLAS_STATUS_SUCCESS);
+    };
+
+    // The capacity is the one that was set, also when it is not a multiple of
+    // the number of shards.
+    for(size_t capacity : {1, 20, 64})
+    {
+        EXPECT_HIPBLAS_STATUS(hipblaslt_ext::setSolutionCacheCapacity(handle, capacity),
+                              HIPBLAS_STATUS_SUCCESS);
+        EXPECT_HIPBLAS_STATUS(hipblaslt_ext::getSolutionCacheStatistics(handle, stats),
+                              HIPBLAS_STATUS_SUCCESS);
+        EXPECT_EQ(stats.capacity, capacity);
+    }
+    EXPECT_LE(stats.hits, stats.lookups);
+
+    // A repeated query hits the cache.
+    getHeuristic(512);
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::getSolutionCacheStatistics(handle, before),
+                          HIPBLAS_STATUS_SUCCESS);
+    getHeuristic(512);
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::getSolutionCacheStatistics(handle, stats),
+                          HIPBLAS_STATUS_SUCCESS);
+    EXPECT_GT(stats.hits, before.hits);
+
+    // More distinct problems than the 16 entries of each cache evict some.
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::setSolutionCacheCapacity(handle, 16),
+                          HIPBLAS_STATUS_SUCCESS);
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::getSolutionCacheStatistics(handle, before),
+                          HIPBLAS_STATUS_SUCCESS);
+    for(int64_t i = 0; i < 40; i++)
+        getHeuristic(128 + 16 * i);
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::getSolutionCacheStatistics(handle, stats),
+                          HIPBLAS_STATUS_SUCCESS);
+    EXPECT_GT(stats.evictions, before.evictions);
+    EXPECT_LE(stats.entries, 3 * stats.capacity);
+
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::setSolutionCacheCapacity(handle, 0),
+                          HIPBLAS_STATUS_SUCCESS);
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::getSolutionCacheStatistics(handle, stats),
+                          HIPBLAS_STATUS_SUCCESS);
+    EXPECT_EQ(stats.capacity, 0);
+}
+
+void testing_aux_preload(const Arguments& arg)
+{
+    hipblaslt_local_handle handle{arg};
+
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::preload(handle, "("), HIPBLAS_STATUS_INVALID_VALUE);
+
+    // Loading is idempotent, so repeating it must succeed as well.
+    for(int i = 0; i < 2; i++)
+        EXPECT_HIPBLAS_STATUS(hipblaslt_ext::preload(handle, "TensileLibrary_.*", true),
+                              HIPBLAS_STATUS_SUCCESS);
+
+    std::vector<hipblaslt_ext::GemmProblemType> problemTypes{{HIPBLAS_OP_N,
+                                                              HIPBLAS_OP_N,
+                                                              arg.a_type,
+                                                              arg.b_type,
+                                                              arg.c_type,
+                                                              arg.d_type,
+                                                              arg.compute_type}};
+    EXPECT_HIPBLAS_STATUS(
+        hipblaslt_ext::preload(handle, hipblaslt_ext::GemmType::HIPBLASLT_GEMM, problemTypes, true),
+        HIPBLAS_STATUS_SUCCESS);
+
+    // Without waiting, the call only starts the loads.
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::preload(handle, ".*"), HIPBLAS_STATUS_SUCCESS);
+}
+
+void testing_aux_get_best_algos_batched(const Arguments& arg)
+{
+    const hipblasOperation_t opA                = HIPBLAS_OP_N;
+    const hipblasOperation_t opB                = HIPBLAS_OP_N;
+    const int                requestedAlgoCount = 4;
+    size_t                   workspaceSize      = 32 * 1024 * 1024;
+
+    hipblaslt_local_handle       handle{arg};
+    hipblaslt_local_matmul_descr matmul(opA, opB, arg.compute_type, arg.scale_type);
+    hipblaslt_local_preference   pref;
+    EXPECT_HIPBLAS_STATUS(
+        hipblasLtMatmulPreferenceSetAttribute(
+            pref, HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES, &workspaceSize, sizeof(workspaceSize)),
+        HIPBLAS_STATUS_SUCCESS);
+
+    // The repeated size is only searched once, but must get the same results.
+    std::vector<std::array<int64_t, 3>> sizes{
+        {128, 128, 64}, {1024, 512, 256}, {128, 128, 64}, {77, 333, 129}};
+
+    std::vector<std::unique_ptr<hipblaslt_local_matrix_layout>> layouts;
+    auto layout = [&](int64_t row, int64_t col, hipblasltDatatype_t type) {
+        layouts.push_back(std::make_unique<hipblaslt_local_matrix_layout>(row, col, row, type));
+        return static_cast<hipblasLtMatrixLayout_t>(*layouts.back());
+    };
+
+    std::vector<hipblaslt_ext::MatmulProblem> problems;
+    for(auto [m, n, k] : sizes)
+        problems.push_back({matmul,
+                            layout(m, k, arg.a_type),
+                            layout(k, n, arg.b_type),
+                            layout(m, n, arg.c_type),
+                            layout(m, n, arg.d_type)});
+
+    std::vector<std::vector<hipblasLtMatmulHeuristicResult_t>> results;
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::getBestAlgosBatched(handle, problems, pref, 0, results),
+                          HIPBLAS_STATUS_INVALID_VALUE);
+    EXPECT_HIPBLAS_STATUS(
+        hipblaslt_ext::getBestAlgosBatched(handle, problems, pref, requestedAlgoCount, results),
+        HIPBLAS_STATUS_SUCCESS);
+    ASSERT_EQ(results.size(), problems.size());
+
+    for(size_t i = 0; i < problems.size(); i++)
+    {
+        auto const& problem = problems[i];
+
+        std::vector<hipblasLtMatmulHeuristicResult_t> expected(requestedAlgoCount);
+        int                                           returnedAlgoCount = 0;
+        EXPECT_HIPBLAS_STATUS(hipblasLtMatmulAlgoGetHeuristic(handle,
+                                                              problem.matmulDesc,
+                                                              problem.Adesc,
+                                                              problem.Bdesc,
+                                                              problem.Cdesc,
+                                                              problem.Ddesc,
+                                                              pref,
+                                                              requestedAlgoCount,
+                                                              expected.data(),
+                                                              &returnedAlgoCount),
+                              HIPBLAS_STATUS_SUCCESS);
+
+        ASSERT_EQ(results[i].size(), returnedAlgoCount);
+        for(int j = 0; j < returnedAlgoCount; j++)
+        {
+            EXPECT_EQ(hipblaslt_ext::getIndexFromAlgo(results[i][j].algo),
+                      hipblaslt_ext::getIndexFromAlgo(expected[j].algo));
+            EXPECT_EQ(results[i][j].workspaceSize, expected[j].workspaceSize);
+        }
+    }
+}
+
+// An extension Gemm of an m x n x k problem in the types of the test with all
+// ones in A and B, so that every element of D is alpha * k. The inputs start
+// offsetBytes into their buffers, so that they are only aligned to that many bytes.
+template <typename TiA, typename TiB, typename To, typename Tc>
+struct aux_ones_gemm
+{
+    static constexpr size_t workspaceSize = 32 * 1024 * 1024;
+
+    aux_ones_gemm(const Arguments&  arg,
+                  hipblasLtHandle_t handle,
+                  int64_t           m_,
+                  int64_t           n_,
+                  int64_t           k_,
+                  size_t            offsetBytes = 0)
+        : m(m_)
+        , n(n_)
+        , k(k_)
+        , dA(m_ * k_ + offsetBytes / sizeof(TiA))
+        , dB(k_ * n_ + offsetBytes / sizeof(TiB))
+        , dC(m_ * n_ + offsetBytes / sizeof(To))
+        , dD(m_ * n_ + offsetBytes / sizeof(To))
+        , dD2(m_ * n_ + offsetBytes / sizeof(To))
+        , dWorkspace(workspaceSize)
+        , gemm(handle,
+               HIPBLAS_OP_N,
+               HIPBLAS_OP_N,
+               arg.a_type,
+               arg.b_type,
+               arg.c_type,
+               arg.d_type,
+               arg.compute_type)
+    {
+        CHECK_DEVICE_ALLOCATION(dA.memcheck());
+        CHECK_DEVICE_ALLOCATION(dB.memcheck());
+        CHECK_DEVICE_ALLOCATION(dC.memcheck());
+        CHECK_DEVICE_ALLOCATION(dD.memcheck());
+        CHECK_DEVICE_ALLOCATION(dD2.memcheck());
+        CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+
+        host_vector<TiA> hA(dA.n(), static_cast<TiA>(1.0f));
+        host_vector<TiB> hB(dB.n(), static_cast<TiB>(1.0f));
+        CHECK_HIP_ERROR(dA.transfer_from(hA));
+        CHECK_HIP_ERROR(dB.transfer_from(hB));
+
+        inputs.a     = static_cast<TiA*>(dA) + offsetBytes / sizeof(TiA);
+        inputs.b     = static_cast<TiB*>(dB) + offsetBytes / sizeof(TiB);
+        inputs.c     = static_cast<To*>(dC) + offsetBytes / sizeof(To);
+        inputs.d     = static_cast<To*>(dD) + offsetBytes / sizeof(To);
+        inputs.alpha = &alpha;
+        inputs.beta  = &beta;
+        EXPECT_HIPBLAS_STATUS(gemm.setProblem(m, n, k, 1, epilogue, inputs),
+                              HIPBLAS_STATUS_SUCCESS);
+    }
+
+    //! The number of elements of \p d that differ from \p value.
+    size_t mismatches(const void* d, float value) const
+    {
+        host_vector<To> hD(m * n);
+        if(hipMemcpy(hD.data(), d, m * n * sizeof(To), hipMemcpyDeviceToHost) != hipSuccess)
+            return hD.size();
+        return std::count_if(
+            hD.begin(), hD.end(), [&](To x) { return static_cast<float>(x) != value; });
+    }
+
+    int64_t                     m, n, k;
+    device_vector<TiA>          dA;
+    device_vector<TiB>          dB;
+    device_vector<To>           dC, dD, dD2;
+    device_vector<char>         dWorkspace;
+    Tc                          alpha = 1, beta = 0;
+    hipblaslt_ext::GemmEpilogue epilogue;
+    hipblaslt_ext::GemmInputs   inputs;
+    hipblaslt_ext::Gemm         gemm;
+};
+
+template <typename TiA, typename TiB, typename To, typename Tc>
+void testing_aux_matmul_pref_limits(const Arguments& arg)
+{
+    const int64_t m = 1024, n = 512, k = 2048;
+    const int     requestedAlgoCount = 8;
+
+    hipblaslt_local_handle        handle{arg};
+    hipblaslt_local_matmul_descr  matmul(
+        HIPBLAS_OP_N, HIPBLAS_OP_N, arg.compute_type, arg.scale_type);
+    hipblaslt_local_matrix_layout matA(m, k, m, arg.a_type);
+    hipblaslt_local_matrix_layout matB(k, n, k, arg.b_type);
+    hipblaslt_local_matrix_layout matC(m, n, m, arg.c_type);
+    hipblaslt_local_matrix_layout matD(m, n, m, arg.d_type);
+    hipblaslt_local_preference    pref;
+
+    uint32_t value   = 0;
+    size_t   written = 0;
+    EXPECT_HIPBLAS_STATUS(
+        hipblasLtMatmulPreferenceGetAttribute(
+            pref, HIPBLASLT_MATMUL_PREF_MIN_ALIGNMENT_C_BYTES, &value, sizeof(value), &written),
+        HIPBLAS_STATUS_SUCCESS);
+    EXPECT_EQ(value, 256);
+    EXPECT_EQ(written, sizeof(value));
+
+    // The largest workspace that the returned algorithms may ask for.
+    size_t   workspaceSize = 1024 * 1024;
+    uint32_t alignment     = 16;
+    uint32_t maxGSU        = 1;
+    uint32_t deterministic = 1;
+    EXPECT_HIPBLAS_STATUS(
+        hipblasLtMatmulPreferenceSetAttribute(
+            pref, HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES, &workspaceSize, sizeof(workspaceSize)),
+        HIPBLAS_STATUS_SUCCESS);
+    for(auto attribute : {HIPBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES,
+                          HIPBLASLT_MATMUL_PREF_MIN_ALIGNMENT_B_BYTES,
+                          HIPBLASLT_MATMUL_PREF_MIN_ALIGNMENT_C_BYTES,
+                          HIPBLASLT_MATMUL_PREF_MIN_ALIGNMENT_D_BYTES})
+        EXPECT_HIPBLAS_STATUS(
+            hipblasLtMatmulPreferenceSetAttribute(pref, attribute, &alignment, sizeof(alignment)),
+            HIPBLAS_STATUS_SUCCESS);
+    EXPECT_HIPBLAS_STATUS(hipblasLtMatmulPreferenceSetAttribute(
+                              pref, HIPBLASLT_MATMUL_PREF_MAX_GSU, &maxGSU, sizeof(maxGSU)),
+                          HIPBLAS_STATUS_SUCCESS);
+    EXPECT_HIPBLAS_STATUS(
+        hipblasLtMatmulPreferenceSetAttribute(
+            pref, HIPBLASLT_MATMUL_PREF_DETERMINISTIC, &deterministic, sizeof(deterministic)),
+        HIPBLAS_STATUS_SUCCESS);
+
+    EXPECT_HIPBLAS_STATUS(
+        hipblasLtMatmulPreferenceGetAttribute(
+            pref, HIPBLASLT_MATMUL_PREF_MIN_ALIGNMENT_B_BYTES, &value, sizeof(value), &written),
+        HIPBLAS_STATUS_SUCCESS);
+    EXPECT_EQ(value, alignment);
+    EXPECT_HIPBLAS_STATUS(
+        hipblasLtMatmulPreferenceGetAttribute(
+            pref, HIPBLASLT_MATMUL_PREF_MAX_GSU, &value, sizeof(value), &written),
+        HIPBLAS_STATUS_SUCCESS);
+    EXPECT_EQ(value, maxGSU);
+
+    std::vector<hipblasLtMatmulHeuristicResult_t> results(requestedAlgoCount);
+    int                                           returnedAlgoCount = 0;
+    EXPECT_HIPBLAS_STATUS(hipblasLtMatmulAlgoGetHeuristic(handle,
+                                                          matmul,
+                                                          matA,
+                                                          matB,
+                                                          matC,
+                                                          matD,
+                                                          pref,
+                                                          requestedAlgoCount,
+                                                          results.data(),
+                                                          &returnedAlgoCount),
+                          HIPBLAS_STATUS_SUCCESS);
+
+    // Every returned algorithm must run within the limits.
+    for(int i = 0; i < returnedAlgoCount; i++)
+        EXPECT_LE(results[i].workspaceSize, workspaceSize);
+
+    // The same limits can be set through the extension API.
+    hipblaslt_ext::GemmPreference gemmPref;
+    gemmPref.setMaxWorkspaceBytes(workspaceSize);
+    gemmPref.setMinAlignmentBytes(alignment, alignment, alignment, alignment);
+    gemmPref.setMaxGSU(maxGSU);
+    gemmPref.setDeterministic(deterministic != 0);
+    EXPECT_EQ(gemmPref.getMinAlignmentBytes()[3], alignment);
+
+    hipblaslt_ext::Gemm gemm(handle,
+                             HIPBLAS_OP_N,
+                             HIPBLAS_OP_N,
+                             arg.a_type,
+                             arg.b_type,
+                             arg.c_type,
+                             arg.d_type,
+                             arg.compute_type);
+    hipblaslt_ext::GemmEpilogue epilogue;
+    hipblaslt_ext::GemmInputs   inputs;
+    float                       alpha = 1, beta = 0;
+    inputs.alpha                      = &alpha;
+    inputs.beta                       = &beta;
+    EXPECT_HIPBLAS_STATUS(gemm.setProblem(m, n, k, 1, epilogue, inputs), HIPBLAS_STATUS_SUCCESS);
+
+    std::vector<hipblasLtMatmulHeuristicResult_t> extResults;
+    EXPECT_HIPBLAS_STATUS(gemm.algoGetHeuristic(requestedAlgoCount, gemmPref, extResults),
+                          HIPBLAS_STATUS_SUCCESS);
+    EXPECT_LE(extResults.size(), requestedAlgoCount);
+    for(auto const& result : extResults)
+        EXPECT_LE(result.workspaceSize, workspaceSize);
+
+    // On a long summation, where splitting it pays off, the algorithms returned
+    // under the limits must run on inputs aligned to only `alignment` bytes and
+    // must not split the summation, which needs workspace without an epilogue.
+    aux_ones_gemm<TiA, TiB, To, Tc> test(arg, handle, 64, 64, 4096, alignment);
+    hipblaslt_ext::GemmPreference   openPref;
+    openPref.setMaxWorkspaceBytes(test.workspaceSize);
+    gemmPref.setMaxWorkspaceBytes(test.workspaceSize);
+
+    auto getIndices = [&](hipblaslt_ext::GemmPreference const& queryPref) {
+        std::vector<hipblasLtMatmulHeuristicResult_t> queryResults;
+        EXPECT_HIPBLAS_STATUS(
+            test.gemm.algoGetHeuristic(requestedAlgoCount, queryPref, queryResults),
+            HIPBLAS_STATUS_SUCCESS);
+        std::vector<int> indices;
+        for(auto const& result : queryResults)
+            indices.push_back(hipblaslt_ext::getIndexFromAlgo(result.algo));
+        return indices;
+    };
+
+    auto                                          openIndices = getIndices(openPref);
+    std::vector<hipblasLtMatmulHeuristicResult_t> limited;
+    EXPECT_HIPBLAS_STATUS(test.gemm.algoGetHeuristic(requestedAlgoCount, gemmPref, limited),
+                          HIPBLAS_STATUS_SUCCESS);
+    CHECK_SOLUTION_FOUND(limited.size());
+
+    hipStream_t stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+    for(auto const& result : limited)
+    {
+        EXPECT_EQ(result.workspaceSize, 0);
+        CHECK_HIP_ERROR(hipMemsetAsync(test.inputs.d, 0, test.m * test.n * sizeof(To), stream));
+        EXPECT_HIPBLAS_STATUS(test.gemm.initialize(result.algo, test.dWorkspace, false, stream),
+                              HIPBLAS_STATUS_SUCCESS);
+        EXPECT_HIPBLAS_STATUS(test.gemm.run(stream), HIPBLAS_STATUS_SUCCESS);
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        EXPECT_EQ(test.mismatches(test.inputs.d, test.k), 0)
+            << "algorithm " << hipblaslt_ext::getIndexFromAlgo(result.algo);
+    }
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+
+    // The limits apply to their query only, a later query without them returns
+    // the same algorithms as before.
+    EXPECT_EQ(getIndices(openPref), openIndices);
+}
+
+void testing_aux_heuristic_plan(const Arguments& arg)
+{
+    const int64_t m = 1024, n = 512, k = 256;
+    const int     requestedAlgoCount = 4;
+    size_t        workspaceSize      = 32 * 1024 * 1024;
+
+    hipblaslt_local_handle        handle{arg};
+    hipblaslt_local_matmul_descr  matmul(
+        HIPBLAS_OP_N, HIPBLAS_OP_N, arg.compute_type, arg.scale_type);
+    hipblaslt_local_matrix_layout matA(m, k, m, arg.a_type);
+    hipblaslt_local_matrix_layout matB(k, n, k, arg.b_type);
+    hipblaslt_local_matrix_layout matC(m, n, m, arg.c_type);
+    hipblaslt_local_matrix_layout matD(m, n, m, arg.d_type);
+    hipblaslt_local_preference    pref;
+    EXPECT_HIPBLAS_STATUS(
+        hipblasLtMatmulPreferenceSetAttribute(
+            pref, HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES, &workspaceSize, sizeof(workspaceSize)),
+        HIPBLAS_STATUS_SUCCESS);
+
+    auto getHeuristic = [&](hipblasLtHandle_t queryHandle, int count) {
+        std::vector<hipblasLtMatmulHeuristicResult_t> results(count);
+        int                                           returnedAlgoCount = 0;
+        EXPECT_HIPBLAS_STATUS(hipblasLtMatmulAlgoGetHeuristic(queryHandle,
+                                                              matmul,
+                                                              matA,
+                                                              matB,
+                                                              matC,
+                                                              matD,
+                                                              pref,
+                                                              count,
+                                                              results.data(),
+                                                              &returnedAlgoCount),
+                              HIPBLAS_STATUS_SUCCESS);
+        results.resize(returnedAlgoCount);
+        return results;
+    };
+
+    std::string                               planFile = hipblaslt_tempname();
+    std::vector<hipblaslt_ext::MatmulProblem> problems{{matmul, matA, matB, matC, matD}};
+    EXPECT_HIPBLAS_STATUS(
+        hipblaslt_ext::exportHeuristicPlan(handle, problems, pref, 0, planFile),
+        HIPBLAS_STATUS_INVALID_VALUE);
+    EXPECT_HIPBLAS_STATUS(
+        hipblaslt_ext::exportHeuristicPlan(handle, problems, pref, requestedAlgoCount, planFile),
+        HIPBLAS_STATUS_SUCCESS);
+
+    // The handle the plan is loaded into returns the planned algorithms.
+    hipblaslt_local_handle planned{arg};
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::loadHeuristicPlan(planned, planFile + ".missing"),
+                          HIPBLAS_STATUS_INVALID_VALUE);
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::loadHeuristicPlan(planned, planFile),
+                          HIPBLAS_STATUS_SUCCESS);
+
+    auto expected = getHeuristic(handle, requestedAlgoCount);
+    auto results  = getHeuristic(planned, requestedAlgoCount);
+    ASSERT_EQ(results.size(), expected.size());
+    for(size_t i = 0; i < results.size(); i++)
+    {
+        EXPECT_EQ(hipblaslt_ext::getIndexFromAlgo(results[i].algo),
+                  hipblaslt_ext::getIndexFromAlgo(expected[i].algo));
+        EXPECT_EQ(results[i].workspaceSize, expected[i].workspaceSize);
+    }
+
+    // Asking for more algorithms than were planned falls back to the search.
+    EXPECT_EQ(getHeuristic(planned, 2 * requestedAlgoCount).size(),
+              getHeuristic(handle, 2 * requestedAlgoCount).size());
+
+    // Rewrites the planned index, fallback flag and workspace size of each
+    // algorithm of the one problem in the plan.
+    auto editPlan = [&](auto&& edit) {
+        std::ifstream in(planFile);
+        std::string   header[3], key, entry;
+        for(auto& line : header)
+            std::getline(in, line);
+        std::getline(in, entry);
+        in.close();
+
+        std::istringstream record(entry);
+        int                planRequested = 0;
+        size_t             count         = 0;
+        record >> key >> planRequested >> count;
+        std::vector<std::array<int64_t, 3>> algos(count);
+        for(auto& algo : algos)
+            record >> algo[0] >> algo[1] >> algo[2];
+        edit(algos);
+
+        std::ofstream out(planFile);
+        for(auto const& line : header)
+            out << line << "\n";
+        out << key << " " << planRequested << " " << algos.size();
+        for(auto const& algo : algos)
+            out << " " << algo[0] << " " << algo[1] << " " << algo[2];
+        out << "\n";
+    };
+
+    // The plan is used as written: planned in reverse, the algorithms are
+    // returned in reverse rather than in the order of the search.
+    if(expected.size() > 1)
+    {
+        editPlan([](auto& algos) { std::reverse(algos.begin(), algos.end()); });
+        hipblaslt_local_handle reversed{arg};
+        EXPECT_HIPBLAS_STATUS(hipblaslt_ext::loadHeuristicPlan(reversed, planFile),
+                              HIPBLAS_STATUS_SUCCESS);
+        results = getHeuristic(reversed, requestedAlgoCount);
+        ASSERT_EQ(results.size(), expected.size());
+        for(size_t i = 0; i < results.size(); i++)
+            EXPECT_EQ(hipblaslt_ext::getIndexFromAlgo(results[i].algo),
+                      hipblaslt_ext::getIndexFromAlgo(expected[expected.size() - 1 - i].algo));
+    }
+
+    // A planned algorithm that does not exist falls back to the search.
+    editPlan([](auto& algos) { algos[0][0] = -1; });
+    hipblaslt_local_handle corrupted{arg};
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::loadHeuristicPlan(corrupted, planFile),
+                          HIPBLAS_STATUS_SUCCESS);
+    results = getHeuristic(corrupted, requestedAlgoCount);
+    ASSERT_EQ(results.size(), expected.size());
+    for(size_t i = 0; i < results.size(); i++)
+        EXPECT_EQ(hipblaslt_ext::getIndexFromAlgo(results[i].algo),
+                  hipblaslt_ext::getIndexFromAlgo(expected[i].algo));
+
+    std::remove(planFile.c_str());
+}
+
+// Sets an environment variable, or unsets it for nullptr, until the end of
+// the scope.
+class aux_scoped_env
+{
+    std::string m_name, m_value;
+    bool        m_was_set;
+
+public:
+    aux_scoped_env(const char* name, const char* value)
+        : m_name(name)
+    {
+        const char* old = getenv(name);
+        m_was_set       = old != nullptr;
+        m_value         = old ? old : "";
+        if(value)
+            setenv(name, value, 1);
+        else
+            unsetenv(name);
+    }
+
+    ~aux_scoped_env()
+    {
+        if(m_was_set)
+            setenv(m_name.c_str(), m_value.c_str(), 1);
+        else
+            unsetenv(m_name.c_str());
+    }
+};
+
+// Exits with 0 if a new handle is for the device arch with cus CUs, as the
+// device line of a plan exported with it shows, and preloading every
+// sub-library, if asked to, succeeds. Run in a death test child.
+[[noreturn]] inline void
+    aux_exit_if_handle_device(const Arguments& arg, const std::string& arch, int cus, bool preload)
+{
+    hipblaslt_local_handle       handle{arg};
+    hipblaslt_local_matmul_descr matmul(
+        HIPBLAS_OP_N, HIPBLAS_OP_N, arg.compute_type, arg.scale_type);
+    hipblaslt_local_matrix_layout matA(128, 64, 128, arg.a_type);
+    hipblaslt_local_matrix_layout matB(64, 128, 64, arg.b_type);
+    hipblaslt_local_matrix_layout matC(128, 128, 128, arg.c_type);
+    hipblaslt_local_matrix_layout matD(128, 128, 128, arg.d_type);
+    hipblaslt_local_preference    pref;
+
+    std::string                               planFile = hipblaslt_tempname();
+    std::vector<hipblaslt_ext::MatmulProblem> problems{{matmul, matA, matB, matC, matD}};
+    std::string                               magic, tag, planArch;
+    int                                       planCus = 0;
+    if(hipblaslt_ext::exportHeuristicPlan(handle, problems, pref, 1, planFile)
+       == HIPBLAS_STATUS_SUCCESS)
+    {
+        std::ifstream in(planFile);
+        std::getline(in, magic);
+        in >> tag >> planArch >> planCus;
+    }
+    std::remove(planFile.c_str());
+
+    if(planArch != arch || planCus != cus)
+    {
+        hipblaslt_cerr << "handle is for " << planArch << ":" << planCus << ", expected " << arch
+                       << ":" << cus << std::endl;
+        hipblaslt_cerr.flush();
+        std::exit(1);
+    }
+
+    if(preload && hipblaslt_ext::preload(handle, ".*", true) != HIPBLAS_STATUS_SUCCESS)
+        std::exit(1);
+    std::exit(0);
+}
+
+void testing_aux_virtual_device(const Arguments& arg)
+{
+    int             device;
+    hipDeviceProp_t prop;
+    CHECK_HIP_ERROR(hipGetDevice(&device));
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&prop, device));
+    std::string gcnArchName(prop.gcnArchName);
+    std::string arch = gcnArchName.substr(0, gcnArchName.find(':'));
+    int         cus  = prop.multiProcessorCount;
+
+    // HIPBLASLT_VIRTUAL_DEVICE is read once per process, so each value is
+    // tried in a child process, which runs this test again up to its
+    // EXPECT_EXIT. The child inherits the environment set here before it
+    // started; its own setenv calls come after the library read it. The log
+    // file is named after the parent so that the child does not create one,
+    // and it is read once no child runs this test any more.
+    std::string deathTestStyle            = testing::FLAGS_gtest_death_test_style;
+    testing::FLAGS_gtest_death_test_style = "threadsafe";
+    std::string logFile = "/tmp/hipblaslt-virtual-device-" + std::to_string(getpid()) + ".log";
+
+    {
+        // The arch is parsed with its features, and one CU more than the
+        // present device has tells the virtual device from it.
+        std::string    spec = gcnArchName + ":" + std::to_string(cus + 1);
+        aux_scoped_env virtualDevice("HIPBLASLT_VIRTUAL_DEVICE", spec.c_str());
+        aux_scoped_env logLevel("HIPBLASLT_LOG_LEVEL", "4");
+        aux_scoped_env logFileEnv("HIPBLASLT_LOG_FILE", logFile.c_str());
+        EXPECT_EXIT(aux_exit_if_handle_device(arg, arch, cus + 1, true),
+                    testing::ExitedWithCode(0),
+                    "");
+    }
+
+    {
+        // A value without a CU count is reported, and the present device used.
+        aux_scoped_env virtualDevice("HIPBLASLT_VIRTUAL_DEVICE", arch.c_str());
+        EXPECT_EXIT(aux_exit_if_handle_device(arg, arch, cus, false),
+                    testing::ExitedWithCode(0),
+                    "HIPBLASLT_VIRTUAL_DEVICE is .*, expected <arch>:<CU count>");
+    }
+
+    testing::FLAGS_gtest_death_test_style = deathTestStyle;
+
+    // No code object is loaded for the virtual device, neither when the
+    // library is set up nor by the preload.
+    std::ifstream     in(logFile);
+    std::stringstream log;
+    log << in.rdbuf();
+    in.close();
+    std::remove(logFile.c_str());
+    EXPECT_NE(log.str().find("no code objects are loaded for virtual device"), std::string::npos);
+    EXPECT_EQ(log.str().find("could not load"), std::string::npos);
+}
+
+template <typename TiA, typename TiB, typename To, typename Tc>
+void testing_aux_gemm_update_inputs(const Arguments& arg)
+{
+    hipblaslt_local_handle          handle{arg};
+    aux_ones_gemm<TiA, TiB, To, Tc> test(arg, handle, 128, 128, 64);
+
+    // Nothing to update before the arguments are created.
+    EXPECT_HIPBLAS_STATUS(test.gemm.updateInputs(test.inputs), HIPBLAS_STATUS_NOT_INITIALIZED);
+
+    hipblaslt_ext::GemmPreference pref;
+    pref.setMaxWorkspaceBytes(test.workspaceSize);
+    std::vector<hipblasLtMatmulHeuristicResult_t> heuristicResult;
+    EXPECT_HIPBLAS_STATUS(test.gemm.algoGetHeuristic(1, pref, heuristicResult),
+                          HIPBLAS_STATUS_SUCCESS);
+    CHECK_SOLUTION_FOUND(heuristicResult.size());
+
+    hipStream_t stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+    EXPECT_HIPBLAS_STATUS(
+        test.gemm.initialize(heuristicResult[0].algo, test.dWorkspace, false, stream),
+        HIPBLAS_STATUS_SUCCESS);
+    EXPECT_HIPBLAS_STATUS(test.gemm.run(stream), HIPBLAS_STATUS_SUCCESS);
+
+    // Write to another D with a new alpha through the same arguments.
+    test.alpha    = 2;
+    test.inputs.d = test.dD2;
+    EXPECT_HIPBLAS_STATUS(test.gemm.updateInputs(test.inputs), HIPBLAS_STATUS_SUCCESS);
+    EXPECT_HIPBLAS_STATUS(test.gemm.run(stream), HIPBLAS_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+
+    EXPECT_EQ(test.mismatches(test.dD, test.k), 0);
+    EXPECT_EQ(test.mismatches(test.dD2, 2.0f * test.k), 0);
+}
+
+template <typename TiA, typename TiB, typename To, typename Tc>
+void testing_aux_grouped_gemm_update_inputs(const Arguments& arg)
+{
+    constexpr size_t gemmCount     = 3;
+    constexpr size_t workspaceSize = 32 * 1024 * 1024;
+
+    int64_t m = 128, n = 128, k = 64;
+
+    hipblaslt_local_handle handle{arg};
+
+    device_vector<TiA>  dA(m * k);
+    device_vector<TiB>  dB(k * n);
+    device_vector<To>   dC(m * n), dD2(m * n);
+    device_vector<char> dWorkspace(workspaceSize);
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dB.memcheck());
+    CHECK_DEVICE_ALLOCATION(dC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dD2.memcheck());
+    CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+
+    std::vector<device_vector<To>> dD;
+    for(size_t i = 0; i < gemmCount; i++)
+    {
+        dD.emplace_back(m * n);
+        CHECK_DEVICE_ALLOCATION(dD.back().memcheck());
+    }
+
+    host_vector<TiA> hA(m * k, static_cast<TiA>(1.0f));
+    host_vector<TiB> hB(k * n, static_cast<TiB>(1.0f));
+    CHECK_HIP_ERROR(dA.transfer_from(hA));
+    CHECK_HIP_ERROR(dB.transfer_from(hB));
+
+    // Every gemm multiplies the same ones, so D is alpha * k everywhere.
+    std::vector<Tc>                          alpha(gemmCount, 1), beta(gemmCount, 0);
+    std::vector<int64_t>                     ms(gemmCount, m), ns(gemmCount, n), ks(gemmCount, k);
+    std::vector<int64_t>                     batch(gemmCount, 1);
+    std::vector<hipblaslt_ext::GemmEpilogue> epilogue(gemmCount);
+    std::vector<hipblaslt_ext::GemmInputs>   inputs(gemmCount);
+    for(size_t i = 0; i < gemmCount; i++)
+    {
+        inputs[i].a     = dA;
+        inputs[i].b     = dB;
+        inputs[i].c     = dC;
+        inputs[i].d     = dD[i];
+        inputs[i].alpha = &alpha[i];
+        inputs[i].beta  = &beta[i];
+    }
+
+    hipblaslt_ext::GroupedGemm gemm(handle,
+                                    HIPBLAS_OP_N,
+                                    HIPBLAS_OP_N,
+                                    arg.a_type,
+                                    arg.b_type,
+                                    arg.c_type,
+                                    arg.d_type,
+                                    arg.compute_type);
+    EXPECT_HIPBLAS_STATUS(gemm.setProblem(ms, ns, ks, batch, epilogue, inputs),
+                          HIPBLAS_STATUS_SUCCESS);
+
+    hipStream_t stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+
+    // Nothing to update before the arguments are created.
+    EXPECT_HIPBLAS_STATUS(gemm.updateInputs(inputs, stream), HIPBLAS_STATUS_NOT_INITIALIZED);
+
+    hipblaslt_ext::GemmPreference pref;
+    pref.setMaxWorkspaceBytes(workspaceSize);
+    std::vector<hipblasLtMatmulHeuristicResult_t> heuristicResult;
+    EXPECT_HIPBLAS_STATUS(gemm.algoGetHeuristic(1, pref, heuristicResult),
+                          HIPBLAS_STATUS_SUCCESS);
+    CHECK_SOLUTION_FOUND(heuristicResult.size());
+
+    EXPECT_HIPBLAS_STATUS(gemm.initialize(heuristicResult[0].algo, dWorkspace, false, stream),
+                          HIPBLAS_STATUS_SUCCESS);
+    EXPECT_HIPBLAS_STATUS(gemm.run(stream), HIPBLAS_STATUS_SUCCESS);
+
+    // The inputs of every gemm are required.
+    std::vector<hipblaslt_ext::GemmInputs> fewer(inputs.begin(), inputs.end() - 1);
+    EXPECT_HIPBLAS_STATUS(gemm.updateInputs(fewer, stream), HIPBLAS_STATUS_INVALID_VALUE);
+
+    // Unchanged inputs are not sent again.
+    size_t updatedCount = gemmCount;
+    EXPECT_HIPBLAS_STATUS(gemm.updateInputs(inputs, stream, &updatedCount),
+                          HIPBLAS_STATUS_SUCCESS);
+    EXPECT_EQ(updatedCount, 0);
+
+    // Only the entry of the gemm that writes to another D with a new alpha is.
+    alpha[1]    = 2;
+    inputs[1].d = dD2;
+    EXPECT_HIPBLAS_STATUS(gemm.updateInputs(inputs, stream, &updatedCount),
+                          HIPBLAS_STATUS_SUCCESS);
+    EXPECT_EQ(updatedCount, 1);
+
+    CHECK_HIP_ERROR(hipMemsetAsync(dD[0], 0, m * n * sizeof(To), stream));
+    EXPECT_HIPBLAS_STATUS(gemm.run(stream), HIPBLAS_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+
+    auto mismatches = [&](const void* d, float value) {
+        host_vector<To> hD(m * n);
+        if(hipMemcpy(hD.data(), d, m * n * sizeof(To), hipMemcpyDeviceToHost) != hipSuccess)
+            return static_cast<std::ptrdiff_t>(hD.size());
+        return std::count_if(
+            hD.begin(), hD.end(), [&](To x) { return static_cast<float>(x) != value; });
+    };
+    EXPECT_EQ(mismatches(dD[0], k), 0);
+    EXPECT_EQ(mismatches(dD[1], k), 0);
+    EXPECT_EQ(mismatches(dD2, 2.0f * k), 0);
+    EXPECT_EQ(mismatches(dD[2], k), 0);
+}
+
+template <typename TiA, typename TiB, typename To, typename Tc>
+void testing_aux_launch_plan(const Arguments& arg)
+{
+    hipblaslt_local_handle          handle{arg};
+    aux_ones_gemm<TiA, TiB, To, Tc> test(arg, handle, 128, 128, 64);
+
+    hipblaslt_ext::LaunchPlan plan(handle);
+    size_t                    index;
+
+    // Only initialized instances can be recorded.
+    EXPECT_HIPBLAS_STATUS(plan.add(test.gemm, index), HIPBLAS_STATUS_NOT_INITIALIZED);
+    EXPECT_HIPBLAS_STATUS(plan.updateInputs(0, test.inputs), HIPBLAS_STATUS_NOT_INITIALIZED);
+
+    hipblaslt_ext::GemmPreference pref;
+    pref.setMaxWorkspaceBytes(test.workspaceSize);
+    std::vector<hipblasLtMatmulHeuristicResult_t> heuristicResult;
+    EXPECT_HIPBLAS_STATUS(test.gemm.algoGetHeuristic(1, pref, heuristicResult),
+                          HIPBLAS_STATUS_SUCCESS);
+    CHECK_SOLUTION_FOUND(heuristicResult.size());
+
+    hipStream_t stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+    EXPECT_HIPBLAS_STATUS(
+        test.gemm.initialize(heuristicResult[0].algo, test.dWorkspace, false, stream),
+        HIPBLAS_STATUS_SUCCESS);
+    EXPECT_HIPBLAS_STATUS(plan.add(test.gemm, index), HIPBLAS_STATUS_SUCCESS);
+    EXPECT_EQ(index, 0);
+    EXPECT_HIPBLAS_STATUS(plan.updateInputs(1, test.inputs), HIPBLAS_STATUS_INVALID_VALUE);
+
+    EXPECT_HIPBLAS_STATUS(plan.run(stream), HIPBLAS_STATUS_SUCCESS);
+
+    // Replaying the graph after an update captures the new arguments.
+    test.alpha    = 2;
+    test.inputs.d = test.dD2;
+    EXPECT_HIPBLAS_STATUS(plan.run(stream, true), HIPBLAS_STATUS_SUCCESS);
+    EXPECT_HIPBLAS_STATUS(plan.updateInputs(index, test.inputs), HIPBLAS_STATUS_SUCCESS);
+    EXPECT_HIPBLAS_STATUS(plan.run(stream, true), HIPBLAS_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+
+    EXPECT_EQ(test.mismatches(test.dD, test.k), 0);
+    EXPECT_EQ(test.mismatches(test.dD2, 2.0f * test.k), 0);
+}
+
+template <typename TiA, typename TiB, typename To, typename Tc>
+void testing_aux_gsu_launch(const Arguments& arg)
+{
+    // A long summation into a small D, for which the summation is split across workgroups
+    // and a second kernel converts the partial sums.
+    const int requestedAlgoCount = 32;
+
+    hipblaslt_local_handle          handle{arg};
+    aux_ones_gemm<TiA, TiB, To, Tc> test(arg, handle, 64, 64, 4096);
+
+    // The algorithms that are dropped when the summation may not be split.
+    hipblaslt_ext::GemmPreference pref;
+    pref.setMaxWorkspaceBytes(test.workspaceSize);
+    std::vector<hipblasLtMatmulHeuristicResult_t> heuristicResult, unsplit;
+    EXPECT_HIPBLAS_STATUS(test.gemm.algoGetHeuristic(requestedAlgoCount, pref, heuristicResult),
+                          HIPBLAS_STATUS_SUCCESS);
+    pref.setMaxGSU(1);
+    EXPECT_HIPBLAS_STATUS(test.gemm.algoGetHeuristic(requestedAlgoCount, pref, unsplit),
+                          HIPBLAS_STATUS_SUCCESS);
+
+    std::set<int> unsplitIndex;
+    for(auto const& result : unsplit)
+        unsplitIndex.insert(hipblaslt_ext::getIndexFromAlgo(result.algo));
+    heuristicResult.erase(std::remove_if(heuristicResult.begin(),
+                                         heuristicResult.end(),
+                                         [&](auto const& result) {
+                                             return unsplitIndex.count(
+                                                 hipblaslt_ext::getIndexFromAlgo(result.algo));
+                                         }),
+                          heuristicResult.end());
+    if(heuristicResult.empty())
+        GTEST_SKIP() << "No algorithm splits the summation of this problem";
+
+    hipStream_t stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+    for(auto const& result : heuristicResult)
+    {
+        // Both launches must run each kernel of the algorithm, the second one through the
+        // handles resolved by the first.
+        CHECK_HIP_ERROR(hipMemset(test.dD, 0, test.m * test.n * sizeof(To)));
+        EXPECT_HIPBLAS_STATUS(test.gemm.initialize(result.algo, test.dWorkspace, false, stream),
+                              HIPBLAS_STATUS_SUCCESS);
+        for(int i = 0; i < 2; i++)
+            EXPECT_HIPBLAS_STATUS(test.gemm.run(stream), HIPBLAS_STATUS_SUCCESS);
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+
+        EXPECT_EQ(test.mismatches(test.dD, test.k), 0)
+            << "algorithm " << hipblaslt_ext::getIndexFromAlgo(result.algo);
+    }
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
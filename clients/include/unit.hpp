@@ -31,48 +31,56 @@
 
 #pragma once
 
+#include "hipblaslt_check.hpp"
 #include "hipblaslt_math.hpp"
 #include "hipblaslt_test.hpp"
 #include "hipblaslt_vector.hpp"
 #include <hipblaslt/hipblaslt.h>
+#include <iomanip>
 
 #ifndef GOOGLE_TEST
 #define UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)
 #define UNIT_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)
+
+//! Whether unit checks report anything in this client.
+constexpr bool hipblaslt_unit_check_enabled = false;
+
+inline void hipblaslt_unit_report(const hipblaslt_check_result&) {}
 #else
-#define UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)                \
-    do                                                                                         \
-    {                                                                                          \
-        for(size_t k = 0; k < batch_count; k++)                                                \
-            for(size_t j = 0; j < N; j++)                                                      \
-                for(size_t i = 0; i < M; i++)                                                  \
-                    if(hipblaslt_isnan(hCPU[i + j * size_t(lda) + k * strideA]))               \
-                    {                                                                          \
-                        ASSERT_TRUE(hipblaslt_isnan(hGPU[i + j * size_t(lda) + k * strideA])); \
-                    }                                                                          \
-                    else                                                                       \
-                    {                                                                          \
-                        UNIT_ASSERT_EQ(hCPU[i + j * size_t(lda) + k * strideA],                \
-                                       hGPU[i + j * size_t(lda) + k * strideA]);               \
-                    }                                                                          \
-    } while(0)
+constexpr bool hipblaslt_unit_check_enabled = true;
 
-#define UNIT_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)            \
-    do                                                                              \
-    {                                                                               \
-        for(size_t k = 0; k < batch_count; k++)                                     \
-            for(size_t j = 0; j < N; j++)                                           \
-                for(size_t i = 0; i < M; i++)                                       \
-                    if(hipblaslt_isnan(hCPU[k][i + j * size_t(lda)]))               \
-                    {                                                               \
-                        ASSERT_TRUE(hipblaslt_isnan(hGPU[k][i + j * size_t(lda)])); \
-                    }                                                               \
-                    else                                                            \
-                    {                                                               \
-                        UNIT_ASSERT_EQ(hCPU[k][i + j * size_t(lda)],                \
-                                       hGPU[k][i + j * size_t(lda)]);               \
-                    }                                                               \
-    } while(0)
+//! Unit checks only need to know whether the matrices match.
+inline hipblaslt_check_options hipblaslt_unit_check_options()
+{
+    hipblaslt_check_options options;
+    options.early_exit = true;
+    return options;
+}
+
+/*! \brief  Reports the failures kept by hipblaslt_check to gtest, followed by the number of
+    mismatches when there may be more. */
+inline void hipblaslt_unit_report(const hipblaslt_check_result& check)
+{
+    for(const auto& f : check.failures)
+        ADD_FAILURE() << "batch " << f.batch << ", row " << f.row << ", column " << f.col
+                      << ": expected " << std::setprecision(17) << f.expected << ", got "
+                      << f.actual;
+
+    if(check.stopped_early || check.mismatches > int64_t(check.failures.size()))
+        ADD_FAILURE() << (check.stopped_early ? "at least " : "") << check.mismatches << " of "
+                      << check.elements << " elements differ, max absolute error "
+                      << check.max_abs_error << ", max relative error " << check.max_rel_error;
+}
+
+// The element comparison matching UNIT_ASSERT_EQ is picked from the element types by
+// hipblaslt_check_equal.
+#define UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ) \
+    hipblaslt_unit_report(hipblaslt_check(                                       \
+        M, N, lda, strideA, hCPU, hGPU, batch_count, hipblaslt_unit_check_options()))
+
+#define UNIT_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ) \
+    hipblaslt_unit_report(                                                \
+        hipblaslt_check(M, N, lda, hCPU, hGPU, batch_count, hipblaslt_unit_check_options()))
 
 #define ASSERT_HALF_EQ(a, b) ASSERT_FLOAT_EQ(float(a), float(b))
 #define ASSERT_BF16_EQ(a, b) ASSERT_FLOAT_EQ(float(a), float(b))
@@ -40,7 +40,9 @@
 #pragma once
 #include "hipblaslt/hipblaslt.h"
 
+#include <array>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace hipblaslt_ext
@@ -78,8 +80,72 @@ namespace hipblaslt_ext
          */
         HIPBLASLT_EXPORT const size_t getMaxWorkspaceBytes() const;
 
+        /*! \ingroup library_module
+         *  \brief This function sets the alignment of the matrices.
+         *
+         *  \details
+         *  The pointers and leading dimensions of A, B, C and D are promised to
+         *  be aligned to the given number of bytes. Algorithms that need a
+         *  stricter alignment are not returned. The default is 256 bytes.
+         *
+         *  @param[in]
+         *  a, b, c, d  The alignment of each matrix in bytes.
+         */
+        HIPBLASLT_EXPORT void setMinAlignmentBytes(uint32_t a, uint32_t b, uint32_t c, uint32_t d);
+
+        /*! \ingroup library_module
+         *  \brief This function returns the set alignment of A, B, C and D in bytes.
+         */
+        HIPBLASLT_EXPORT std::array<uint32_t, 4> getMinAlignmentBytes() const;
+
+        /*! \ingroup library_module
+         *  \brief This function sets the largest global split-U of the returned algorithms.
+         *
+         *  @param[in]
+         *  gsu  The largest number of parts the summation may be split into, 0 for no limit.
+         */
+        HIPBLASLT_EXPORT void setMaxGSU(uint32_t gsu);
+
+        /*! \ingroup library_module
+         *  \brief This function returns the set largest global split-U.
+         */
+        HIPBLASLT_EXPORT uint32_t getMaxGSU() const;
+
+        /*! \ingroup library_module
+         *  \brief This function sets whether only deterministic algorithms are returned.
+         *
+         *  @param[in]
+         *  deterministic  If true, algorithms whose results depend on the order of
+         *  atomic updates are not returned.
+         */
+        HIPBLASLT_EXPORT void setDeterministic(bool deterministic);
+
+        /*! \ingroup library_module
+         *  \brief This function returns whether only deterministic algorithms are returned.
+         */
+        HIPBLASLT_EXPORT bool getDeterministic() const;
+
     private:
-        size_t m_workspace_bytes;
+        size_t                  m_workspace_bytes;
+        std::array<uint32_t, 4> m_min_alignment_bytes = {256, 256, 256, 256};
+        uint32_t                m_max_gsu             = 0;
+        bool                    m_deterministic       = false;
+    };
+
+    /*! \ingroup types_module
+     *  \brief Live counters of the solution selection caches.
+     *
+     * \details Returned by \ref getSolutionCacheStatistics. The counters are
+     * summed over all caches of the library used by the handle's device, which
+     * all have the same capacity.
+     */
+    struct SolutionCacheStatistics
+    {
+        int64_t lookups   = 0; //!< Number of cache lookups.
+        int64_t hits      = 0; //!< Number of lookups that found a cached solution.
+        int64_t evictions = 0; //!< Number of entries dropped to stay within capacity.
+        size_t  entries   = 0; //!< Number of entries currently cached.
+        size_t  capacity  = 0; //!< Maximum number of entries of each cache, 0 if unbounded.
     };
 
     /*! \ingroup types_module
@@ -98,6 +164,21 @@ namespace hipblaslt_ext
         hipblasLtComputeType_t type_compute; //!< The compute datatype.
     };
 
+    /*! \ingroup types_module
+     *  \brief hipblasLt extension matmul problem for batched heuristic queries.
+     *
+     * \details This structure holds the descriptors that hipblasLtMatmulAlgoGetHeuristic()
+     * takes for one problem. See \ref getBestAlgosBatched.
+     */
+    struct MatmulProblem
+    {
+        hipblasLtMatmulDesc_t   matmulDesc; //!< The matrix multiplication descriptor.
+        hipblasLtMatrixLayout_t Adesc; //!< The A matrix layout.
+        hipblasLtMatrixLayout_t Bdesc; //!< The B matrix layout.
+        hipblasLtMatrixLayout_t Cdesc; //!< The C matrix layout.
+        hipblasLtMatrixLayout_t Ddesc; //!< The D matrix layout.
+    };
+
     /*! \ingroup types_module
      *  \brief hipblasLt extension Epilogue for gemm problems.
      *
@@ -298,6 +379,8 @@ namespace hipblaslt_ext
 
         hipblasLtHandle_t     m_handle;
         std::shared_ptr<void> m_data;
+
+        friend class LaunchPlan;
     };
 
     /*! \ingroup types_module
@@ -502,6 +585,28 @@ namespace hipblaslt_ext
                                                     void*                   D,
                                                     hipblasLtMatrixLayout_t matD);
 
+        /*! \ingroup library_module
+        *  \brief Updates the inputs of the kernel arguments created by initialize().
+        *
+        *  \details
+        *  This function replaces the matrix, scale, bias and aux pointers and the
+        * alpha and beta values inside the kernel arguments stored in the instance,
+        * without building the arguments again. The problem and the algorithm are
+        * unchanged. Bias, aux and scaleAlphaVec are only replaced if the epilogue
+        * set by setProblem() uses them. If the new inputs need different kernels,
+        * e.g. a scale pointer that was NULL is now set, the arguments are created
+        * again as initialize() does.
+        *
+        *  @param[in]
+        *  inputs                     The new inputs of the problem.
+        *
+        *  \retval HIPBLAS_STATUS_SUCCESS           If the operation completed
+        * successfully. \retval HIPBLAS_STATUS_INVALID_VALUE If the problem is not set
+        * or the initialized algorithm is not found.
+        *  \retval HIPBLAS_STATUS_NOT_INITIALIZED    If initialize() has not been called.
+        */
+        HIPBLASLT_EXPORT hipblasStatus_t updateInputs(GemmInputs& inputs);
+
         HIPBLASLT_EXPORT GemmProblemType getProblemTypes();
     };
 
@@ -711,6 +816,37 @@ namespace hipblaslt_ext
 
         HIPBLASLT_EXPORT std::vector<GemmProblemType> getProblemTypes();
 
+        /*! \ingroup library_module
+        *  \brief Updates the inputs of the kernel arguments created by initialize().
+        *
+        *  \details
+        *  This function replaces the matrix, scale, bias and aux pointers and the
+        * alpha and beta values of every gemm, as Gemm::updateInputs() does. Only the
+        * arguments of the gemms whose inputs changed are encoded again and copied to
+        * the workspace, so updating one gemm of a large group is cheap. If the new
+        * inputs need different kernels, the arguments of every gemm are created again
+        * as initialize() does. Not supported when initialize() was called with
+        * useUserArgs = true; update the DeviceUserArguments instead.
+        *
+        *  @param[in]
+        *  inputs                     The new inputs, one per gemm.
+        *  @param[in]
+        *  stream                     The HIP stream where the copy to the workspace
+        * is submitted. Use the stream the gemms run on.
+        *  @param[out]
+        *  updatedCount               If not NULL, receives the number of gemms whose
+        * arguments were copied again.
+        *
+        *  \retval HIPBLAS_STATUS_SUCCESS           If the operation completed
+        * successfully. \retval HIPBLAS_STATUS_INVALID_VALUE If the number of inputs
+        * does not match the gemm count, the initialized algorithm is not found or
+        * useUserArgs was set.
+        *  \retval HIPBLAS_STATUS_NOT_INITIALIZED    If initialize() has not been called.
+        */
+        HIPBLASLT_EXPORT hipblasStatus_t updateInputs(std::vector<GemmInputs>& inputs,
+                                                      hipStream_t              stream,
+                                                      size_t* updatedCount = nullptr);
+
         /*! \ingroup library_module
         *  \brief A helper function to initialize DeviceUserArguments using the set problem(s)
         * saved in the gemm object.
@@ -742,6 +878,86 @@ namespace hipblaslt_ext
         HIPBLASLT_EXPORT hipblasStatus_t run(void* deviceUserArgs, hipStream_t stream);
     };
 
+    /*! \ingroup types_module
+     *  \brief Replayable sequence of the kernels of initialized gemm instances.
+     *
+     * \details A launch plan records the kernel arguments that initialize() created
+     * for one or more hipblaslt_ext::GemmInstance, and launches all of them in the
+     * order they were added. The kernels are looked up once when an instance is
+     * added, so run() skips the library lookup and argument validation of
+     * GemmInstance::run(). run() does not synchronize or allocate, so it can be
+     * called while the stream is captured into a graph.
+     */
+    class LaunchPlan
+    {
+    public:
+        /*! \ingroup library_module
+        *  \brief Constructor
+        *
+        *  @param[in]
+        *  handle                     The handle from hipBLASLt.
+        */
+        HIPBLASLT_EXPORT explicit LaunchPlan(hipblasLtHandle_t handle);
+
+        /*! \ingroup library_module
+        *  \brief Records the kernel arguments of an initialized gemm instance.
+        *
+        *  \details
+        *  The plan keeps a copy of the arguments, so later calls to setProblem() or
+        * initialize() on the instance do not change the plan. The instance must
+        * not be destroyed while the plan is in use.
+        *
+        *  @param[in]
+        *  instance                   The gemm instance, after initialize().
+        *  @param[out]
+        *  index                      The index of the instance in the plan.
+        *
+        *  \retval HIPBLAS_STATUS_SUCCESS           If the operation completed
+        * successfully. \retval HIPBLAS_STATUS_NOT_INITIALIZED If initialize() has not
+        * been called, or a grouped gemm was initialized with useUserArgs = true.
+        * \retval HIPBLAS_STATUS_INVALID_VALUE If the instance uses another device.
+        */
+        HIPBLASLT_EXPORT hipblasStatus_t add(GemmInstance& instance, size_t& index);
+
+        /*! \ingroup library_module
+        *  \brief Updates the inputs of a gemm recorded in the plan.
+        *
+        *  \details
+        *  This function calls Gemm::updateInputs() on the instance recorded at
+        * index, then copies its updated arguments into the plan. Only instances of
+        * hipblaslt_ext::Gemm are supported.
+        *
+        *  @param[in]
+        *  index                      The index returned by add().
+        *  @param[in]
+        *  inputs                     The new inputs of the problem.
+        *
+        *  \retval HIPBLAS_STATUS_SUCCESS           If the operation completed
+        * successfully. \retval HIPBLAS_STATUS_INVALID_VALUE If index is out of range.
+        */
+        HIPBLASLT_EXPORT hipblasStatus_t updateInputs(size_t index, GemmInputs& inputs);
+
+        /*! \ingroup library_module
+        *  \brief Launches every recorded kernel.
+        *
+        *  @param[in]
+        *  stream                  The HIP stream where all the GPU work will be
+        * submitted.
+        *  @param[in]
+        *  useGraph                Capture the plan into a HIP graph on the first
+        * call and replay the graph afterwards. The graph is captured again after
+        * add() or updateInputs(). stream must not be the null stream.
+        *
+        *  \retval HIPBLAS_STATUS_SUCCESS           If the operation completed
+        * successfully.
+        */
+        HIPBLASLT_EXPORT hipblasStatus_t run(hipStream_t stream, bool useGraph = false);
+
+    private:
+        hipblasLtHandle_t     m_handle;
+        std::shared_ptr<void> m_data;
+    };
+
     /*******************************************************************************
      * Ext APIs
      ******************************************************************************/
@@ -869,4 +1085,201 @@ namespace hipblaslt_ext
                                           hipblasLtMatrixLayout_t Ddesc,
                                           hipblasLtMatmulAlgo_t&  algo,
                                           size_t&                 workspaceSizeInBytes);
+
+    /*! \ingroup library_module
+     *  \brief Retrieve the best algorithms for many problems
+     *
+     *  \details
+     *  This function returns for each problem the algorithms that
+     * hipblasLtMatmulAlgoGetHeuristic() returns for it, without changing the
+     * matmul descriptors. The library is looked up once for the whole batch,
+     * problems that are the same are searched once, and the others are
+     * searched in parallel. heuristicResults[i] holds up to
+     * \p requestedAlgoCount algorithms for problems[i], in the order of
+     * increasing estimated compute time; it is empty if none was found.
+     *
+     *  @param[in]
+     *  handle                  Pointer to the allocated hipBLASLt handle for the
+     * hipBLASLt context. See \ref hipblasLtHandle_t .
+     *  @param[in]
+     *  problems                The descriptors of each problem.
+     *  @param[in]
+     *  pref                    Pointer to the structure holding the heuristic
+     * search preferences, used for all problems.
+     *  @param[in]
+     *  requestedAlgoCount      The maximum number of algorithms to return per problem.
+     *  @param[out]
+     *  heuristicResults        The algorithm heuristic vector of each problem.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the query was successful.
+     *  \retval HIPBLAS_STATUS_INVALID_VALUE     If \p requestedAlgoCount is less than 1, or
+     * a descriptor of a problem is nullptr.
+     *  \retval HIPBLAS_STATUS_INTERNAL_ERROR    If the types of a problem are not supported.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t getBestAlgosBatched(
+        hipblasLtHandle_t                                           handle,
+        const std::vector<MatmulProblem>&                           problems,
+        hipblasLtMatmulPreference_t                                 pref,
+        int                                                         requestedAlgoCount,
+        std::vector<std::vector<hipblasLtMatmulHeuristicResult_t>>& heuristicResults);
+
+    /*! \ingroup library_module
+     *  \brief Write the best algorithms for many problems to a plan file
+     *
+     *  \details
+     *  This function finds the algorithms of each problem as \ref getBestAlgosBatched
+     * does, and writes their indices and required workspace sizes to
+     * \p planFile. Loading the file with \ref loadHeuristicPlan lets another
+     * process answer heuristic queries for these problems without a search.
+     * Together with the HIPBLASLT_VIRTUAL_DEVICE environment variable, plans can
+     * be made on hosts without a GPU.
+     *
+     *  @param[in]
+     *  handle                  Pointer to the allocated hipBLASLt handle for the
+     * hipBLASLt context. See \ref hipblasLtHandle_t .
+     *  @param[in]
+     *  problems                The descriptors of each problem.
+     *  @param[in]
+     *  pref                    Pointer to the structure holding the heuristic
+     * search preferences, used for all problems.
+     *  @param[in]
+     *  requestedAlgoCount      The maximum number of algorithms to store per problem.
+     *  @param[in]
+     *  planFile                Path of the plan file to write.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the plan was written.
+     *  \retval HIPBLAS_STATUS_INVALID_VALUE     If \p requestedAlgoCount is less than 1, or
+     * a descriptor of a problem is nullptr.
+     *  \retval HIPBLAS_STATUS_INTERNAL_ERROR    If the types of a problem are not supported, or
+     * the file could not be written.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t exportHeuristicPlan(hipblasLtHandle_t                 handle,
+                                        const std::vector<MatmulProblem>& problems,
+                                        hipblasLtMatmulPreference_t       pref,
+                                        int                               requestedAlgoCount,
+                                        const std::string&                planFile);
+
+    /*! \ingroup library_module
+     *  \brief Answer heuristic queries from a plan file
+     *
+     *  \details
+     *  This function reads a plan written by \ref exportHeuristicPlan into the
+     * handle. Afterwards, hipblasLtMatmulAlgoGetHeuristic(), \ref getBestAlgosBatched
+     * and Gemm::algoGetHeuristic() return the planned algorithms for problems in
+     * the plan, without a search, as long as no more algorithms are requested
+     * than were planned. Other problems are searched as before. A plan replaces
+     * the one previously loaded into the handle.
+     *
+     *  @param[in]
+     *  handle                  Pointer to the allocated hipBLASLt handle for the
+     * hipBLASLt context. See \ref hipblasLtHandle_t .
+     *  @param[in]
+     *  planFile                Path of the plan file to read.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the plan was loaded.
+     *  \retval HIPBLAS_STATUS_INVALID_VALUE     If the file is not a valid plan, or was made
+     * for another GPU architecture, CU count or library version.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t loadHeuristicPlan(hipblasLtHandle_t handle, const std::string& planFile);
+
+    /*! \ingroup library_module
+     *  \brief Retrieve the solution cache counters
+     *
+     *  \details
+     *  This function returns the current lookup, hit and eviction counts and
+     * the size of the caches that hold the algorithms selected for previously
+     * seen problems.
+     *
+     *  @param[in]
+     *  handle                  Pointer to the allocated hipBLASLt handle for the
+     * hipBLASLt context. See \ref hipblasLtHandle_t .
+     *  @param[out]
+     *  statistics              The cache counters.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the query was successful.
+     *  \retval HIPBLAS_STATUS_INTERNAL_ERROR    If the library has no solution cache.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t getSolutionCacheStatistics(hipblasLtHandle_t        handle,
+                                               SolutionCacheStatistics& statistics);
+
+    /*! \ingroup library_module
+     *  \brief Bound the solution caches
+     *
+     *  \details
+     *  This function bounds each solution cache to \p capacity entries.
+     * A cache is split into 16 shards by key hash, whose capacities add up to
+     * \p capacity. Once a shard is full, its least recently hit entries are
+     * evicted, which may happen before the whole cache is full. A capacity of 0
+     * makes the caches unbounded, which is the default unless the
+     * TENSILE_SOLUTION_CACHE_SIZE environment variable is set.
+     *
+     *  @param[in]
+     *  handle                  Pointer to the allocated hipBLASLt handle for the
+     * hipBLASLt context. See \ref hipblasLtHandle_t .
+     *  @param[in]
+     *  capacity                The number of entries per cache, split between its shards.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the capacity was set.
+     *  \retval HIPBLAS_STATUS_INTERNAL_ERROR    If the library has no solution cache.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t setSolutionCacheCapacity(hipblasLtHandle_t handle, size_t capacity);
+
+    /*! \ingroup library_module
+     *  \brief Load solution sub-libraries ahead of use
+     *
+     *  \details
+     *  When the library is built with lazy loading, each sub-library and its
+     * code object is only read when the first problem that needs it is seen,
+     * which delays that call. This function loads the sub-libraries whose file
+     * name (e.g. TensileLibrary_HH_SH_... without extension) matches \p pattern,
+     * and their code objects, on background threads. Sub-libraries that are
+     * already loaded are skipped, and calls using them are not held up while
+     * others load.
+     *
+     *  @param[in]
+     *  handle                  Pointer to the allocated hipBLASLt handle for the
+     * hipBLASLt context. See \ref hipblasLtHandle_t .
+     *  @param[in]
+     *  pattern                 ECMAScript regular expression searched for in the
+     * sub-library names. ".*" loads everything.
+     *  @param[in]
+     *  wait                    If true, return once loading has finished.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If loading was started, or with \p wait,
+     * completed.
+     *  \retval HIPBLAS_STATUS_INVALID_VALUE     If \p pattern is not a valid regular expression.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t preload(hipblasLtHandle_t handle, const std::string& pattern, bool wait = false);
+
+    /*! \ingroup library_module
+     *  \brief Load the solution sub-libraries for problem types ahead of use
+     *
+     *  \details
+     *  Same as the pattern overload, but loads the sub-libraries that serve the
+     * given problem types.
+     *
+     *  @param[in]
+     *  handle                  Pointer to the allocated hipBLASLt handle for the
+     * hipBLASLt context. See \ref hipblasLtHandle_t .
+     *  @param[in]
+     *  typeGemm                Gemm type. ex. GEMM, GROUPED_GEMM.
+     *  @param[in]
+     *  problemTypes            The problem types to load solutions for.
+     *  @param[in]
+     *  wait                    If true, return once loading has finished.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If loading was started, or with \p wait,
+     * completed.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t preload(hipblasLtHandle_t                   handle,
+                            GemmType                            typeGemm,
+                            const std::vector<GemmProblemType>& problemTypes,
+                            bool                                wait = false);
 } // End of namespace hipblasltext
@@ -201,7 +201,13 @@ typedef enum {
 typedef enum {
   HIPBLASLT_MATMUL_PREF_SEARCH_MODE = 0,          /**<Search mode. Data Type: uint32_t*/
   HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES = 1,  /**<Maximum allowed workspace memory. Default is 0 (no workspace memory allowed). Data Type: uint64_t*/
-  HIPBLASLT_MATMUL_PREF_MAX = 2
+  HIPBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES = 2, /**<Minimum alignment of the A pointer and leading dimension in bytes. Algorithms that need a stricter alignment are not returned. Default is 256. Data Type: uint32_t*/
+  HIPBLASLT_MATMUL_PREF_MIN_ALIGNMENT_B_BYTES = 3, /**<Minimum alignment of the B pointer and leading dimension in bytes. Default is 256. Data Type: uint32_t*/
+  HIPBLASLT_MATMUL_PREF_MIN_ALIGNMENT_C_BYTES = 4, /**<Minimum alignment of the C pointer and leading dimension in bytes. Default is 256. Data Type: uint32_t*/
+  HIPBLASLT_MATMUL_PREF_MIN_ALIGNMENT_D_BYTES = 5, /**<Minimum alignment of the D pointer and leading dimension in bytes. Default is 256. Data Type: uint32_t*/
+  HIPBLASLT_MATMUL_PREF_MAX_GSU = 6,              /**<Largest global split-U (number of parts the summation is split into) of the returned algorithms. Default is 0 (no limit). Data Type: uint32_t*/
+  HIPBLASLT_MATMUL_PREF_DETERMINISTIC = 7,        /**<Only return algorithms whose results do not depend on the order of atomic updates. Default is 0 (disabled). Data Type: uint32_t*/
+  HIPBLASLT_MATMUL_PREF_MAX = 8
 } hipblasLtMatmulPreferenceAttributes_t;
 
 /** Enum for data ordering */
@@ -27,6 +27,8 @@
 #include "hipblaslt-ext.hpp"
 #include "exceptions.hpp"
 #include "hipblaslt_internal.hpp"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <rocblaslt.h>
 
@@ -42,6 +44,36 @@ namespace hipblaslt_ext
         return m_workspace_bytes;
     }
 
+    void GemmPreference::setMinAlignmentBytes(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+    {
+        m_min_alignment_bytes = {a, b, c, d};
+    }
+
+    std::array<uint32_t, 4> GemmPreference::getMinAlignmentBytes() const
+    {
+        return m_min_alignment_bytes;
+    }
+
+    void GemmPreference::setMaxGSU(uint32_t gsu)
+    {
+        m_max_gsu = gsu;
+    }
+
+    uint32_t GemmPreference::getMaxGSU() const
+    {
+        return m_max_gsu;
+    }
+
+    void GemmPreference::setDeterministic(bool deterministic)
+    {
+        m_deterministic = deterministic;
+    }
+
+    bool GemmPreference::getDeterministic() const
+    {
+        return m_deterministic;
+    }
+
     GemmInstance::GemmInstance(hipblasLtHandle_t handle, GemmType type)
         : m_gemm_type(type)
         , m_handle(handle)
@@ -69,11 +101,19 @@ namespace hipblaslt_ext
         auto results
             = reinterpret_cast<std::vector<rocblaslt_matmul_heuristic_result>*>(&heuristicResults);
         results->clear();
+
+        rocblaslt_matmul_search_limits limits;
+        auto                           alignment = pref.getMinAlignmentBytes();
+        std::copy(alignment.begin(), alignment.end(), limits.min_alignment_bytes);
+        limits.max_gsu       = pref.getMaxGSU();
+        limits.deterministic = pref.getDeterministic();
+
         return RocBlasLtStatusToHIPStatus(
             rocblaslt_algo_get_heuristic_cpp((rocblaslt_handle)m_handle,
                                              gemmType,
                                              m_data,
                                              pref.getMaxWorkspaceBytes(),
+                                             limits,
                                              requestedAlgoCount,
                                              *results));
     }
@@ -283,6 +323,21 @@ namespace hipblaslt_ext
                                       m_gemm_count));
     }
 
+    hipblasStatus_t Gemm::updateInputs(GemmInputs& inputs)
+    try
+    {
+        if(m_gemm_count == 0)
+            return HIPBLAS_STATUS_INVALID_VALUE;
+        auto gemmType  = static_cast<rocblaslt::RocGemmType>(m_gemm_type);
+        auto rocinputs = reinterpret_cast<rocblaslt::RocGemmInputs*>(&inputs);
+        return RocBlasLtStatusToHIPStatus(
+            rocblaslt_update_inputs_cpp((rocblaslt_handle)m_handle, gemmType, *rocinputs, m_data));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
     GemmProblemType Gemm::getProblemTypes()
     {
         return m_problem_types[0];
@@ -469,6 +524,26 @@ namespace hipblaslt_ext
         return m_problem_types;
     }
 
+    hipblasStatus_t GroupedGemm::updateInputs(std::vector<GemmInputs>& inputs,
+                                              hipStream_t              stream,
+                                              size_t*                  updatedCount)
+    try
+    {
+        if(m_gemm_count == 0)
+            return HIPBLAS_STATUS_INVALID_VALUE;
+        auto gemmType = static_cast<rocblaslt::RocGemmType>(m_gemm_type);
+        std::vector<rocblaslt::RocGemmInputs> rocinputs;
+        rocinputs.reserve(inputs.size());
+        for(auto& input : inputs)
+            rocinputs.push_back(*reinterpret_cast<rocblaslt::RocGemmInputs*>(&input));
+        return RocBlasLtStatusToHIPStatus(rocblaslt_update_grouped_inputs_cpp(
+            (rocblaslt_handle)m_handle, gemmType, rocinputs, stream, m_data, updatedCount));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
     HIPBLASLT_EXPORT hipblasStatus_t
         GroupedGemm::getDefaultValueForDeviceUserArguments(void* hostDeviceUserArgs)
     {
@@ -515,6 +590,47 @@ namespace hipblaslt_ext
         return exception_to_hipblas_status();
     }
 
+    LaunchPlan::LaunchPlan(hipblasLtHandle_t handle)
+        : m_handle(handle)
+    {
+    }
+
+    hipblasStatus_t LaunchPlan::add(GemmInstance& instance, size_t& index)
+    try
+    {
+        if(instance.m_gemm_count == 0)
+            return HIPBLAS_STATUS_INVALID_VALUE;
+        auto gemmType = static_cast<rocblaslt::RocGemmType>(instance.m_gemm_type);
+        return RocBlasLtStatusToHIPStatus(rocblaslt_launch_plan_append_cpp(
+            (rocblaslt_handle)instance.m_handle, gemmType, instance.m_data, m_data, index));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t LaunchPlan::updateInputs(size_t index, GemmInputs& inputs)
+    try
+    {
+        auto rocinputs = reinterpret_cast<rocblaslt::RocGemmInputs*>(&inputs);
+        return RocBlasLtStatusToHIPStatus(rocblaslt_launch_plan_update_inputs_cpp(
+            (rocblaslt_handle)m_handle, m_data, index, *rocinputs));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t LaunchPlan::run(hipStream_t stream, bool useGraph)
+    try
+    {
+        return RocBlasLtStatusToHIPStatus(rocblaslt_launch_plan_run_cpp(m_data, useGraph, stream));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
     std::string gemmType2String(GemmType type)
     {
         switch(type)
@@ -558,6 +674,103 @@ namespace hipblaslt_ext
         return exception_to_hipblas_status();
     }
 
+    namespace
+    {
+        hipblasLtMatmulHeuristicResult_t
+            toHipResult(rocblaslt_matmul_heuristic_result const& result)
+        {
+            static_assert(sizeof(hipblasLtMatmulAlgo_t) == sizeof(rocblaslt_matmul_algo),
+                          "hipblasLtMatmulAlgo_t must hold a rocblaslt_matmul_algo");
+
+            hipblasLtMatmulHeuristicResult_t rv;
+            std::memcpy(&rv.algo, &result.algo, sizeof(rv.algo));
+            rv.workspaceSize = result.workspaceSize;
+            rv.state         = RocBlasLtStatusToHIPStatus(result.state);
+            rv.wavesCount    = result.wavesCount;
+            std::copy(std::begin(result.reserved), std::end(result.reserved), rv.reserved);
+            return rv;
+        }
+    } // namespace
+
+    hipblasStatus_t getBestAlgosBatched(
+        hipblasLtHandle_t                                           handle,
+        const std::vector<MatmulProblem>&                           problems,
+        hipblasLtMatmulPreference_t                                 pref,
+        int                                                         requestedAlgoCount,
+        std::vector<std::vector<hipblasLtMatmulHeuristicResult_t>>& heuristicResults)
+    try
+    {
+        std::vector<rocblaslt_matmul_problem> rocProblems;
+        rocProblems.reserve(problems.size());
+        for(auto const& problem : problems)
+            rocProblems.push_back({(rocblaslt_matmul_desc)problem.matmulDesc,
+                                   (rocblaslt_matrix_layout)problem.Adesc,
+                                   (rocblaslt_matrix_layout)problem.Bdesc,
+                                   (rocblaslt_matrix_layout)problem.Cdesc,
+                                   (rocblaslt_matrix_layout)problem.Ddesc});
+
+        std::vector<std::vector<rocblaslt_matmul_heuristic_result>> results;
+        auto status = rocblaslt_matmul_algo_get_heuristic_batched_cpp(
+            (rocblaslt_handle)handle,
+            rocProblems,
+            (rocblaslt_matmul_preference)pref,
+            requestedAlgoCount,
+            results);
+
+        heuristicResults.clear();
+        heuristicResults.resize(results.size());
+        for(size_t i = 0; i < results.size(); i++)
+        {
+            heuristicResults[i].reserve(results[i].size());
+            for(auto const& result : results[i])
+                heuristicResults[i].push_back(toHipResult(result));
+        }
+        return RocBlasLtStatusToHIPStatus(status);
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t exportHeuristicPlan(hipblasLtHandle_t                 handle,
+                                        const std::vector<MatmulProblem>& problems,
+                                        hipblasLtMatmulPreference_t       pref,
+                                        int                               requestedAlgoCount,
+                                        const std::string&                planFile)
+    try
+    {
+        std::vector<rocblaslt_matmul_problem> rocProblems;
+        rocProblems.reserve(problems.size());
+        for(auto const& problem : problems)
+            rocProblems.push_back({(rocblaslt_matmul_desc)problem.matmulDesc,
+                                   (rocblaslt_matrix_layout)problem.Adesc,
+                                   (rocblaslt_matrix_layout)problem.Bdesc,
+                                   (rocblaslt_matrix_layout)problem.Cdesc,
+                                   (rocblaslt_matrix_layout)problem.Ddesc});
+
+        return RocBlasLtStatusToHIPStatus(
+            rocblaslt_export_heuristic_plan_cpp((rocblaslt_handle)handle,
+                                                rocProblems,
+                                                (rocblaslt_matmul_preference)pref,
+                                                requestedAlgoCount,
+                                                planFile));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t loadHeuristicPlan(hipblasLtHandle_t handle, const std::string& planFile)
+    try
+    {
+        return RocBlasLtStatusToHIPStatus(
+            rocblaslt_load_heuristic_plan_cpp((rocblaslt_handle)handle, planFile));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
     int getIndexFromAlgo(hipblasLtMatmulAlgo_t& algo)
     {
         int* algo_ptr = (int*)algo.data;
@@ -580,4 +793,54 @@ namespace hipblaslt_ext
             (rocblaslt_handle)handle, algoIndex, *results));
     }
 
+
+    hipblasStatus_t getSolutionCacheStatistics(hipblasLtHandle_t        handle,
+                                               SolutionCacheStatistics& statistics)
+    {
+        auto stats = reinterpret_cast<rocblaslt_solution_cache_statistics*>(&statistics);
+        return RocBlasLtStatusToHIPStatus(
+            rocblaslt_get_solution_cache_statistics_cpp((rocblaslt_handle)handle, *stats));
+    }
+
+    hipblasStatus_t setSolutionCacheCapacity(hipblasLtHandle_t handle, size_t capacity)
+    {
+        return RocBlasLtStatusToHIPStatus(
+            rocblaslt_set_solution_cache_capacity_cpp((rocblaslt_handle)handle, capacity));
+    }
+
+    hipblasStatus_t preload(hipblasLtHandle_t handle, const std::string& pattern, bool wait)
+    try
+    {
+        return RocBlasLtStatusToHIPStatus(
+            rocblaslt_preload_cpp((rocblaslt_handle)handle, pattern, wait));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t preload(hipblasLtHandle_t                   handle,
+                            GemmType                            typeGemm,
+                            const std::vector<GemmProblemType>& problemTypes,
+                            bool                                wait)
+    try
+    {
+        std::vector<rocblaslt_gemm_problem_type> types;
+        types.reserve(problemTypes.size());
+        for(auto const& problemType : problemTypes)
+            types.push_back({problemType.op_a,
+                             problemType.op_b,
+                             problemType.type_a,
+                             problemType.type_b,
+                             problemType.type_c,
+                             problemType.type_d,
+                             (rocblaslt_compute_type)problemType.type_compute});
+
+        return RocBlasLtStatusToHIPStatus(rocblaslt_preload_problem_types_cpp(
+            (rocblaslt_handle)handle, static_cast<rocblaslt::RocGemmType>(typeGemm), types, wait));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
 } // End of namespace hipblasltext
@@ -68,6 +68,8 @@ hipblasStatus_t RocBlasLtStatusToHIPStatus(rocblaslt_status_ status)
         return HIPBLAS_STATUS_SUCCESS;
     case rocblaslt_status_invalid_handle:
         return HIPBLAS_STATUS_NOT_INITIALIZED;
+    case rocblaslt_status_not_initialized:
+        return HIPBLAS_STATUS_NOT_INITIALIZED;
     case rocblaslt_status_not_implemented:
         return HIPBLAS_STATUS_INTERNAL_ERROR;
     case rocblaslt_status_invalid_pointer:
@@ -123,7 +125,7 @@ try
     hipblasStatus_t retval = HIPBLAS_STATUS_SUCCESS;
 
     err = hipGetDevice(&deviceId);
-    if(err == hipSuccess)
+    if(err == hipSuccess || rocblaslt_internal_get_virtual_device())
     {
         retval = RocBlasLtStatusToHIPStatus(rocblaslt_create((rocblaslt_handle*)handle));
     }
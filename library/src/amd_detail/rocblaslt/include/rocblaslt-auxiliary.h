@@ -380,16 +380,53 @@ rocblaslt_status rocblaslt_is_algo_supported_cpp(rocblaslt_handle       handle,
                                                  size_t&                workspaceSizeInBytes);
 
 rocblaslt_status
-    rocblaslt_algo_get_heuristic_cpp(rocblaslt_handle       handle,
-                                     rocblaslt::RocGemmType gemmType,
-                                     std::shared_ptr<void>  gemmData,
-                                     const int              workspaceBytes,
-                                     const int              requestedAlgoCount,
+    rocblaslt_algo_get_heuristic_cpp(rocblaslt_handle                      handle,
+                                     rocblaslt::RocGemmType                gemmType,
+                                     std::shared_ptr<void>                 gemmData,
+                                     const int                             workspaceBytes,
+                                     const rocblaslt_matmul_search_limits& limits,
+                                     const int                             requestedAlgoCount,
                                      std::vector<rocblaslt_matmul_heuristic_result>& results);
 
+rocblaslt_status rocblaslt_matmul_algo_get_heuristic_batched_cpp(
+    rocblaslt_handle                                             handle,
+    const std::vector<rocblaslt_matmul_problem>&                 problems,
+    rocblaslt_matmul_preference                                  pref,
+    int                                                          requestedAlgoCount,
+    std::vector<std::vector<rocblaslt_matmul_heuristic_result>>& heuristicResults);
+
+rocblaslt_status rocblaslt_export_heuristic_plan_cpp(
+    rocblaslt_handle                             handle,
+    const std::vector<rocblaslt_matmul_problem>& problems,
+    rocblaslt_matmul_preference                  pref,
+    int                                          requestedAlgoCount,
+    const std::string&                           planFile);
+
+rocblaslt_status rocblaslt_load_heuristic_plan_cpp(rocblaslt_handle   handle,
+                                                   const std::string& planFile);
+
+rocblaslt_status
+    rocblaslt_get_solution_cache_statistics_cpp(rocblaslt_handle                     handle,
+                                                rocblaslt_solution_cache_statistics& statistics);
+
+rocblaslt_status rocblaslt_set_solution_cache_capacity_cpp(rocblaslt_handle handle,
+                                                           size_t           capacity);
+
+rocblaslt_status
+    rocblaslt_preload_cpp(rocblaslt_handle handle, const std::string& pattern, bool wait);
+
+rocblaslt_status
+    rocblaslt_preload_problem_types_cpp(rocblaslt_handle                                handle,
+                                        rocblaslt::RocGemmType                          typeGemm,
+                                        const std::vector<rocblaslt_gemm_problem_type>& types,
+                                        bool                                            wait);
+
 // for internal use during testing, fetch arch name
 std::string rocblaslt_internal_get_arch_name();
 
+// The device described by HIPBLASLT_VIRTUAL_DEVICE, or nullptr if it is not set
+const hipDeviceProp_t* rocblaslt_internal_get_virtual_device();
+
 // for internal use of testing existence of path
 bool rocblaslt_internal_test_path(const std::string &);
 
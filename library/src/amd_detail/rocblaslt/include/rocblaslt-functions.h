@@ -205,6 +205,34 @@ rocblaslt_status rocblaslt_makeArgument_cpp(rocblaslt_handle             handle,
                                             hipStream_t                  stream,
                                             std::shared_ptr<void>        gemmData);
 
+rocblaslt_status rocblaslt_update_inputs_cpp(rocblaslt_handle                handle,
+                                             const rocblaslt::RocGemmType    gemmType,
+                                             const rocblaslt::RocGemmInputs& inputs,
+                                             std::shared_ptr<void>           gemmData);
+
+rocblaslt_status
+    rocblaslt_update_grouped_inputs_cpp(rocblaslt_handle                             handle,
+                                        const rocblaslt::RocGemmType                 gemmType,
+                                        const std::vector<rocblaslt::RocGemmInputs>& inputs,
+                                        hipStream_t                                  stream,
+                                        std::shared_ptr<void>                        gemmData,
+                                        size_t*                                      updatedCount);
+
+rocblaslt_status rocblaslt_launch_plan_append_cpp(rocblaslt_handle             handle,
+                                                  const rocblaslt::RocGemmType gemmType,
+                                                  std::shared_ptr<void>        gemmData,
+                                                  std::shared_ptr<void>&       planData,
+                                                  size_t&                      index);
+
+rocblaslt_status rocblaslt_launch_plan_update_inputs_cpp(rocblaslt_handle                handle,
+                                                         std::shared_ptr<void>           planData,
+                                                         size_t                          index,
+                                                         const rocblaslt::RocGemmInputs& inputs);
+
+rocblaslt_status rocblaslt_launch_plan_run_cpp(std::shared_ptr<void> planData,
+                                               bool                  useGraph,
+                                               hipStream_t           stream);
+
 rocblaslt_status rocblaslt_get_default_user_args(rocblaslt_handle       handle,
                                                  rocblaslt::RocGemmType gemmType,
                                                  std::shared_ptr<void>  gemmData,
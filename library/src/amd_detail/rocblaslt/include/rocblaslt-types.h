@@ -190,12 +190,14 @@ typedef enum rocblaslt_pointer_mode_
  */
 typedef enum rocblaslt_layer_mode
 {
-    rocblaslt_layer_mode_none      = 0, /**< layer is not active. */
-    rocblaslt_layer_mode_log_error = 1, /**< layer is in error mode. */
-    rocblaslt_layer_mode_log_trace = 2, /**< layer is in trace mode. */
-    rocblaslt_layer_mode_log_hints = 4, /**< layer is in hints mode. */
-    rocblaslt_layer_mode_log_info  = 8, /**< layer is in info mode. */
-    rocblaslt_layer_mode_log_api   = 16, /**< layer is in api mode. */
+    rocblaslt_layer_mode_none        = 0, /**< layer is not active. */
+    rocblaslt_layer_mode_log_error   = 1, /**< layer is in error mode. */
+    rocblaslt_layer_mode_log_trace   = 2, /**< layer is in trace mode. */
+    rocblaslt_layer_mode_log_hints   = 4, /**< layer is in hints mode. */
+    rocblaslt_layer_mode_log_info    = 8, /**< layer is in info mode. */
+    rocblaslt_layer_mode_log_api     = 16, /**< layer is in api mode. */
+    rocblaslt_layer_mode_log_bench   = 32, /**< layer is in bench mode. */
+    rocblaslt_layer_mode_log_profile = 64, /**< layer is in profile mode. */
 } rocblaslt_layer_mode;
 
 /*! \ingroup types_module
@@ -329,9 +331,15 @@ typedef enum rocblaslt_matmul_desc_attributes_
  */
 typedef enum rocblaslt_matmul_preference_attributes_
 {
-    ROCBLASLT_MATMUL_PREF_SEARCH_MODE         = 0,
-    ROCBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES = 1,
-    ROCBLASLT_MATMUL_PREF_MAX                 = 2
+    ROCBLASLT_MATMUL_PREF_SEARCH_MODE           = 0,
+    ROCBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES   = 1,
+    ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES = 2,
+    ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_B_BYTES = 3,
+    ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_C_BYTES = 4,
+    ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_D_BYTES = 5,
+    ROCBLASLT_MATMUL_PREF_MAX_GSU               = 6,
+    ROCBLASLT_MATMUL_PREF_DETERMINISTIC         = 7,
+    ROCBLASLT_MATMUL_PREF_MAX                   = 8
 } rocblaslt_matmul_preference_attributes;
 
 /********************************************************************************
@@ -364,6 +372,57 @@ typedef struct _rocblaslt_solutions
     int                                algoCount;
 } rocblaslt_solutions;
 
+/********************************************************************************
+ * \brief rocblaslt_solution_cache_statistics holds the live counters of the
+ * solution selection caches.
+ *******************************************************************************/
+typedef struct _rocblaslt_solution_cache_statistics
+{
+    int64_t lookups   = 0;
+    int64_t hits      = 0;
+    int64_t evictions = 0;
+    size_t  entries   = 0;
+    size_t  capacity  = 0;
+} rocblaslt_solution_cache_statistics;
+
+/********************************************************************************
+ * \brief rocblaslt_gemm_problem_type describes a gemm problem without its sizes.
+ *******************************************************************************/
+typedef struct _rocblaslt_gemm_problem_type
+{
+    hipblasOperation_t     op_a;
+    hipblasOperation_t     op_b;
+    hipblasltDatatype_t    type_a;
+    hipblasltDatatype_t    type_b;
+    hipblasltDatatype_t    type_c;
+    hipblasltDatatype_t    type_d;
+    rocblaslt_compute_type type_compute;
+} rocblaslt_gemm_problem_type;
+
+/********************************************************************************
+ * \brief rocblaslt_matmul_problem describes a matmul problem by the descriptors
+ * that rocblaslt_matmul_algo_get_heuristic takes for it.
+ *******************************************************************************/
+typedef struct _rocblaslt_matmul_problem
+{
+    rocblaslt_matmul_desc   matmul_desc;
+    rocblaslt_matrix_layout matA;
+    rocblaslt_matrix_layout matB;
+    rocblaslt_matrix_layout matC;
+    rocblaslt_matrix_layout matD;
+} rocblaslt_matmul_problem;
+
+/********************************************************************************
+ * \brief rocblaslt_matmul_search_limits holds the preferences that restrict
+ * which algorithms the heuristic search may return.
+ *******************************************************************************/
+typedef struct _rocblaslt_matmul_search_limits
+{
+    uint32_t min_alignment_bytes[4] = {256, 256, 256, 256}; //!< For A, B, C and D.
+    uint32_t max_gsu                = 0; //!< 0 for no limit.
+    bool     deterministic          = false;
+} rocblaslt_matmul_search_limits;
+
 typedef struct _rocblaslt_matrix_transform_desc
 {
     hipblasltDatatype_t    scaleType;
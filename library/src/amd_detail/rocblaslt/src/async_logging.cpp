@@ -0,0 +1,460 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "async_logging.h"
+#include "utility.hpp"
+
+#include <chrono>
+#include <sys/syscall.h>
+
+namespace rocblaslt
+{
+    namespace
+    {
+        constexpr uint32_t RecordAlign = 8;
+        constexpr uint32_t WrapMarker  = UINT32_MAX;
+
+        // Record payload, shared by the rings and the binary log:
+        //   uint64_t time in ns since the epoch, uint64_t thread id, uint32_t layer,
+        //   uint16_t function name length, the function name, uint16_t argument
+        //   count, then per argument a tag byte and its value.
+        constexpr size_t RecordHeaderBytes = 2 * sizeof(uint64_t) + sizeof(uint32_t);
+
+        std::atomic<uint64_t> nextLoggerId{1};
+
+        template <typename T>
+        void append(std::string& record, T value)
+        {
+            record.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <typename T>
+        T read(const char*& data)
+        {
+            T value;
+            memcpy(&value, data, sizeof(value));
+            data += sizeof(value);
+            return value;
+        }
+
+        uint64_t now_ns()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                .count();
+        }
+
+        void appendHeader(std::string& record,
+                          uint64_t     time,
+                          uint64_t     tid,
+                          uint32_t     layer,
+                          const char*  func,
+                          size_t       argc)
+        {
+            uint16_t funcLen = static_cast<uint16_t>(std::min<size_t>(strlen(func), UINT16_MAX));
+            append(record, time);
+            append(record, tid);
+            append(record, layer);
+            append(record, funcLen);
+            record.append(func, funcLen);
+            append(record, static_cast<uint16_t>(argc));
+        }
+    }
+
+    /*! \brief Byte ring written by one thread and read by the background thread.
+     *
+     * Records are a uint32_t payload size followed by the payload, padded to
+     * RecordAlign. A record that does not fit before the end of the buffer is
+     * preceded by a WrapMarker and written at the start instead.
+     */
+    struct AsyncLogger::Ring
+    {
+        explicit Ring(size_t bytes)
+            : data(bytes)
+        {
+        }
+
+        bool push(std::string const& record)
+        {
+            size_t capacity = data.size();
+            size_t bytes
+                = (sizeof(uint32_t) + record.size() + RecordAlign - 1) / RecordAlign * RecordAlign;
+
+            uint64_t h    = head.load(std::memory_order_relaxed);
+            uint64_t t    = tail.load(std::memory_order_acquire);
+            size_t   pos  = h % capacity;
+            size_t   skip = pos + bytes > capacity ? capacity - pos : 0;
+
+            if(bytes > capacity / 2 || h + skip + bytes - t > capacity)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            if(skip)
+            {
+                memcpy(&data[pos], &WrapMarker, sizeof(uint32_t));
+                pos = 0;
+            }
+
+            uint32_t size = static_cast<uint32_t>(record.size());
+            memcpy(&data[pos], &size, sizeof(size));
+            memcpy(&data[pos + sizeof(size)], record.data(), record.size());
+
+            head.store(h + skip + bytes, std::memory_order_release);
+            return true;
+        }
+
+        //! Calls f(record, size) for every record pushed so far.
+        template <typename F>
+        bool pop(F&& f)
+        {
+            size_t   capacity = data.size();
+            uint64_t h        = head.load(std::memory_order_acquire);
+            uint64_t t        = tail.load(std::memory_order_relaxed);
+            bool     any      = t != h;
+
+            while(t != h)
+            {
+                size_t   pos = t % capacity;
+                uint32_t size;
+                memcpy(&size, &data[pos], sizeof(size));
+
+                if(size == WrapMarker)
+                {
+                    t += capacity - pos;
+                    continue;
+                }
+
+                f(&data[pos + sizeof(size)], size);
+                t += (sizeof(uint32_t) + size + RecordAlign - 1) / RecordAlign * RecordAlign;
+            }
+
+            tail.store(t, std::memory_order_release);
+            return any;
+        }
+
+        bool empty() const
+        {
+            return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+        }
+
+        std::vector<char>     data;
+        std::atomic<uint64_t> head{0};
+        std::atomic<uint64_t> tail{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<bool>     closed{false};
+    };
+
+    //! Rings of the calling thread, closed when the thread exits.
+    struct AsyncLogger::LocalRing
+    {
+        ~LocalRing()
+        {
+            for(auto& entry : rings)
+                entry.second->closed.store(true, std::memory_order_release);
+        }
+
+        std::vector<std::pair<uint64_t, std::shared_ptr<Ring>>> rings;
+    };
+
+    AsyncLogger::AsyncLogger(std::ostream& os, Format format, size_t ringBytes)
+        : m_os(os)
+        , m_format(format)
+        , m_ringBytes((std::max<size_t>(ringBytes, 4096) + RecordAlign - 1) / RecordAlign
+                      * RecordAlign)
+        , m_id(nextLoggerId.fetch_add(1))
+    {
+        if(m_format == Format::Binary)
+        {
+            uint32_t pid = getpid();
+            m_os.write(BinaryMagic, sizeof(BinaryMagic));
+            m_os.write(reinterpret_cast<const char*>(&BinaryVersion), sizeof(BinaryVersion));
+            m_os.write(reinterpret_cast<const char*>(&pid), sizeof(pid));
+        }
+
+        m_thread = std::thread([this]() { run(); });
+    }
+
+    AsyncLogger::~AsyncLogger()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        m_thread.join();
+
+        // Threads that are still alive keep their ring, but never find it
+        // again once the id of this logger is gone.
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        for(auto& ring : m_rings)
+            ring->closed.store(true, std::memory_order_release);
+    }
+
+    void AsyncLogger::flush()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        uint64_t                     ticket = ++m_flushRequests;
+        m_wake.notify_all();
+        m_flushed.wait(lock, [&]() { return m_flushDone >= ticket || m_stop; });
+    }
+
+    AsyncLogger::LocalRing& AsyncLogger::localRing()
+    {
+        thread_local LocalRing local;
+        return local;
+    }
+
+    std::string& AsyncLogger::beginRecord(uint32_t layer, const char* func, size_t argc)
+    {
+        thread_local std::string record;
+        thread_local uint64_t    tid = syscall(SYS_gettid);
+
+        record.clear();
+        appendHeader(record, now_ns(), tid, layer, func, argc);
+        return record;
+    }
+
+    void AsyncLogger::push(std::string const& record)
+    {
+        auto& rings = localRing().rings;
+
+        Ring* ring = nullptr;
+        for(auto it = rings.begin(); it != rings.end();)
+        {
+            if(it->first == m_id)
+            {
+                ring = it->second.get();
+                break;
+            }
+            // Ring of a logger that has been destroyed.
+            if(it->second->closed.load(std::memory_order_relaxed))
+                it = rings.erase(it);
+            else
+                ++it;
+        }
+
+        if(!ring)
+        {
+            auto created = std::make_shared<Ring>(m_ringBytes);
+            {
+                std::lock_guard<std::mutex> lock(m_ringsMutex);
+                m_rings.push_back(created);
+            }
+            rings.emplace_back(m_id, created);
+            ring = created.get();
+        }
+
+        ring->push(record);
+
+        // Pairs with the fence in run(): either the background thread sees
+        // the new head of the ring, or this thread sees m_pending cleared and
+        // wakes it up. Only the first producer after a drain pays for the
+        // notification.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(!m_pending.load(std::memory_order_relaxed)
+           && !m_pending.exchange(true, std::memory_order_relaxed))
+        {
+            // Taking the mutex orders the notification after the predicate
+            // check of a background thread that is about to wait.
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+            }
+            m_wake.notify_one();
+        }
+    }
+
+    void AsyncLogger::encodeString(std::string& record, const char* data, size_t size)
+    {
+        record.push_back(static_cast<char>(ArgString));
+        append(record, static_cast<uint32_t>(size));
+        record.append(data, size);
+    }
+
+    void AsyncLogger::run()
+    {
+        while(true)
+        {
+            uint64_t ticket;
+            bool     stop;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this]() {
+                    return m_stop || m_flushRequests != m_flushDone
+                           || m_pending.load(std::memory_order_relaxed);
+                });
+                ticket = m_flushRequests;
+                stop   = m_stop;
+            }
+
+            // Cleared before draining, so that a record pushed from here on
+            // either gets drained below or sets m_pending again.
+            m_pending.store(false, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // Keep going until the rings are empty, so that a flush also
+            // covers records pushed while it was being served.
+            while(drain())
+            {
+            }
+
+            try
+            {
+                m_os.flush();
+            }
+            catch(std::ios_base::failure const&)
+            {
+                m_os.clear();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_flushDone = ticket;
+            }
+            m_flushed.notify_all();
+
+            if(stop)
+                return;
+        }
+    }
+
+    bool AsyncLogger::drain()
+    {
+        std::vector<std::shared_ptr<Ring>> rings;
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            rings = m_rings;
+        }
+
+        bool any = false;
+        for(auto& ring : rings)
+        {
+            // Read before draining, so that a closed ring is only dropped
+            // once its last record has been written.
+            bool closed = ring->closed.load(std::memory_order_acquire);
+
+            any |= ring->pop([this](const char* record, size_t size) { write(record, size); });
+
+            if(uint64_t dropped = ring->dropped.exchange(0, std::memory_order_relaxed))
+            {
+                std::string record;
+                appendHeader(
+                    record, now_ns(), 0, rocblaslt_layer_mode_log_error, "AsyncLogger", 2);
+                encodeString(record, "dropped_records", strlen("dropped_records"));
+                encodeValue(record, ArgUInt, dropped);
+                write(record.data(), record.size());
+            }
+
+            if(closed && ring->empty())
+            {
+                std::lock_guard<std::mutex> lock(m_ringsMutex);
+                m_rings.erase(std::find(m_rings.begin(), m_rings.end(), ring));
+            }
+        }
+
+        return any;
+    }
+
+    void AsyncLogger::write(const char* record, size_t size)
+    {
+        // The log file is set to throw on errors. The record is lost, but the
+        // background thread keeps running.
+        try
+        {
+            if(m_format == Format::Binary)
+            {
+                uint32_t size32 = static_cast<uint32_t>(size);
+                m_os.write(reinterpret_cast<const char*>(&size32), sizeof(size32));
+                m_os.write(record, size);
+            }
+            else
+                writeText(record, size);
+        }
+        catch(std::ios_base::failure const&)
+        {
+            m_os.clear();
+        }
+    }
+
+    // Prints the record exactly as log_arguments does for the synchronous logger.
+    void AsyncLogger::writeText(const char* record, size_t size)
+    {
+        const char* end = record + size;
+        if(size < RecordHeaderBytes)
+            return;
+
+        uint64_t time = read<uint64_t>(record);
+        record += sizeof(uint64_t); // thread id, only kept in binary logs
+        uint32_t layer   = read<uint32_t>(record);
+        uint16_t funcLen = read<uint16_t>(record);
+
+        std::string func(record, funcLen);
+        record += funcLen;
+        uint16_t argc = read<uint16_t>(record);
+
+        m_os << prefix(rocblaslt_layer_mode2string(static_cast<rocblaslt_layer_mode>(layer)),
+                       func.c_str(),
+                       static_cast<time_t>(time / 1000000000))
+             << " ";
+
+        for(uint16_t i = 0; i < argc && record < end; i++)
+        {
+            if(i > 0 && i % 2 == 1)
+                m_os << "=";
+
+            switch(static_cast<ArgTag>(*record++))
+            {
+            case ArgInt:
+                m_os << read<int64_t>(record);
+                break;
+            case ArgUInt:
+                m_os << read<uint64_t>(record);
+                break;
+            case ArgFloat:
+                m_os << read<double>(record);
+                break;
+            case ArgPointer:
+                m_os << reinterpret_cast<const void*>(read<uint64_t>(record));
+                break;
+            case ArgString:
+            {
+                uint32_t length = read<uint32_t>(record);
+                m_os.write(record, length);
+                record += length;
+                break;
+            }
+            default:
+                record = end;
+                break;
+            }
+
+            if(i % 2 == 1)
+                m_os << " ";
+        }
+
+        m_os << "\n";
+    }
+} // namespace rocblaslt
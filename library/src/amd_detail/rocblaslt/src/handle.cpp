@@ -37,9 +37,18 @@ ROCBLASLT_KERNEL void init_kernel(){};
  ******************************************************************************/
 _rocblaslt_handle::_rocblaslt_handle()
 {
-    // Default device is active device
-    THROW_IF_HIP_ERROR(hipGetDevice(&device));
-    THROW_IF_HIP_ERROR(hipGetDeviceProperties(&properties, device));
+    if(auto virtualDevice = rocblaslt_internal_get_virtual_device())
+    {
+        // Heuristic queries only, there is no device to run on
+        device     = 0;
+        properties = *virtualDevice;
+    }
+    else
+    {
+        // Default device is active device
+        THROW_IF_HIP_ERROR(hipGetDevice(&device));
+        THROW_IF_HIP_ERROR(hipGetDeviceProperties(&properties, device));
+    }
 
     // Device wavefront size
     wavefront_size = properties.warpSize;
@@ -0,0 +1,188 @@
+/*! \file */
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef ASYNC_LOGGING_H
+#define ASYNC_LOGGING_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace rocblaslt
+{
+    /*! \brief Logging backend that moves formatting and I/O off the calling thread.
+     *
+     * \details
+     * Each thread that logs writes binary records into its own lock-free single
+     * producer ring buffer. A background thread drains the rings into the log
+     * stream, either formatted as the synchronous logger prints them or as
+     * binary records to be decoded offline with hipblaslt_log_decode.py. When a
+     * ring is full the record is dropped and counted instead of blocking the
+     * caller, and the number of dropped records is logged as an error.
+     *
+     * Records of one thread are written in order. Records of different threads
+     * may be interleaved out of order, but keep the time they were logged at.
+     */
+    class AsyncLogger
+    {
+    public:
+        enum class Format
+        {
+            Text,
+            Binary
+        };
+
+        //! Argument tags of binary records. Part of the binary log format.
+        enum ArgTag : uint8_t
+        {
+            ArgInt     = 1, //!< int64_t
+            ArgUInt    = 2, //!< uint64_t
+            ArgFloat   = 3, //!< double
+            ArgPointer = 4, //!< uint64_t address
+            ArgString  = 5, //!< uint32_t length, then the characters
+        };
+
+        static constexpr char     BinaryMagic[16]  = "HIPBLASLT_BLOG";
+        static constexpr uint32_t BinaryVersion    = 1;
+        static constexpr size_t   DefaultRingBytes = 1 << 20;
+
+        AsyncLogger(std::ostream& os, Format format, size_t ringBytes = DefaultRingBytes);
+
+        //! Writes every record logged so far, then stops the background thread.
+        ~AsyncLogger();
+
+        AsyncLogger(const AsyncLogger&)            = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        //! Queues a record with the layer, the calling function and the arguments.
+        template <typename... Ts>
+        void log(uint32_t layer, const char* func, Ts&&... xs)
+        {
+            std::string& record = beginRecord(layer, func, sizeof...(xs));
+            (encode(record, xs), ...);
+            push(record);
+        }
+
+        //! Waits until every record queued before the call has been written.
+        void flush();
+
+    private:
+        struct Ring;
+        struct LocalRing;
+
+        LocalRing&   localRing();
+        std::string& beginRecord(uint32_t layer, const char* func, size_t argc);
+        void         push(std::string const& record);
+
+        void run();
+        bool drain();
+        void write(const char* record, size_t size);
+        void writeText(const char* record, size_t size);
+
+        static void encodeString(std::string& record, const char* data, size_t size);
+
+        template <typename T>
+        static void encodeValue(std::string& record, ArgTag tag, T value)
+        {
+            record.push_back(static_cast<char>(tag));
+            record.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <typename T>
+        static constexpr bool is_char_v
+            = std::is_same_v<std::remove_cv_t<T>, char>
+              || std::is_same_v<std::remove_cv_t<T>, signed char>
+              || std::is_same_v<std::remove_cv_t<T>, unsigned char>;
+
+        // Anything std::ostream does not print as a plain number, pointer or
+        // string is formatted by the calling thread, as the synchronous logger
+        // would.
+        template <typename T>
+        static void encode(std::string& record, T const& x)
+        {
+            using U = std::decay_t<T>;
+            if constexpr(std::is_same_v<U, std::string>)
+                encodeString(record, x.data(), x.size());
+            else if constexpr(std::is_pointer_v<U> && is_char_v<std::remove_pointer_t<U>>)
+            {
+                const char* str = reinterpret_cast<const char*>(x);
+                encodeString(record, str ? str : "(null)", str ? strlen(str) : 6);
+            }
+            else if constexpr(std::is_pointer_v<U>)
+                encodeValue(record,
+                            ArgPointer,
+                            static_cast<uint64_t>(reinterpret_cast<uintptr_t>(
+                                reinterpret_cast<const volatile void*>(x))));
+            else if constexpr(std::is_floating_point_v<U>)
+                encodeValue(record, ArgFloat, static_cast<double>(x));
+            else if constexpr(std::is_integral_v<U> && !is_char_v<U> && std::is_signed_v<U>)
+                encodeValue(record, ArgInt, static_cast<int64_t>(x));
+            else if constexpr(std::is_integral_v<U> && !is_char_v<U>)
+                encodeValue(record, ArgUInt, static_cast<uint64_t>(x));
+            else
+            {
+                thread_local std::ostringstream os;
+                os.str(std::string());
+                os << x;
+                std::string const& str = os.str();
+                encodeString(record, str.data(), str.size());
+            }
+        }
+
+        std::ostream& m_os;
+        Format        m_format;
+        size_t        m_ringBytes;
+        uint64_t      m_id;
+
+        std::mutex                         m_ringsMutex;
+        std::vector<std::shared_ptr<Ring>> m_rings;
+
+        std::mutex              m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_flushed;
+        bool                    m_stop          = false;
+        uint64_t                m_flushRequests = 0;
+        uint64_t                m_flushDone     = 0;
+        std::thread             m_thread;
+
+        //! Set by a producer that found it clear, cleared by the background
+        //! thread before it drains the rings.
+        std::atomic<bool> m_pending{false};
+    };
+} // namespace rocblaslt
+
+#endif // ASYNC_LOGGING_H
@@ -34,6 +34,7 @@
 #include <fstream>
 #include <hip/hip_runtime_api.h>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 struct _rocblaslt_attribute
@@ -94,6 +95,8 @@ struct _rocblaslt_handle
 
     // pointer mode ; default mode is host
     rocblaslt_pointer_mode pointer_mode = rocblaslt_pointer_mode_host;
+
+    std::shared_ptr<void> heuristic_plan; // Set by loadHeuristicPlan()
 };
 
 /********************************************************************************
@@ -178,6 +181,8 @@ struct _rocblaslt_matmul_preference
     uint32_t search_mode         = 0;
     uint64_t max_workspace_bytes = 0;
 
+    rocblaslt_matmul_search_limits limits;
+
     int64_t alg_config_id     = 0;
     int64_t alg_max_id        = 0;
     int64_t search_iterations = 0;
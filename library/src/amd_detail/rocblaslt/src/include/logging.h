@@ -29,7 +29,13 @@
 #ifndef LOGGING_H
 #define LOGGING_H
 
+#include "async_logging.h"
+
+#include <cstdlib>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <sys/types.h>
 #include <unistd.h>
@@ -50,6 +56,10 @@
  *                              Name of environment variable that contains
  *                              the full logfile path.
  *
+ *  @param[in]
+ *  mode        std::ios_base::openmode
+ *              Mode the logfile is opened with.
+ *
  *  @parm[out]
  *  log_os      std::ostream**
  *              Output stream. Stream to std:err if environment_variable_name
@@ -61,9 +71,10 @@
  *              will stream to log_ofs. Else it will stream to std::cerr.
  */
 
-inline void open_log_stream(std::ostream** log_os,
-                            std::ofstream* log_ofs,
-                            std::string    environment_variable_name)
+inline void open_log_stream(std::ostream**          log_os,
+                            std::ofstream*          log_ofs,
+                            std::string             environment_variable_name,
+                            std::ios_base::openmode mode = std::ofstream::out)
 {
     *log_os = &std::cerr;
 
@@ -81,7 +92,7 @@ inline void open_log_stream(std::ostream** log_os,
             size_t pos = logfile_pathname.find("%i");
             if(pos != std::string::npos)
                 logfile_pathname.replace(pos, 2, std::to_string(getpid()));
-            log_ofs->open(logfile_pathname);
+            log_ofs->open(logfile_pathname, mode);
 
             // if log_ofs is open, then stream to log_ofs, else log_os is already
             // set equal to std::cerr
@@ -101,13 +112,25 @@ inline void open_log_stream(std::ostream** log_os,
 class LoggerSingleton
 {
 public:
-    std::ostream*           log_os         = nullptr;
-    uint32_t                env_layer_mode = 0;
+    std::ostream*                           log_os         = nullptr;
+    uint32_t                                env_layer_mode = 0;
+    std::unique_ptr<rocblaslt::AsyncLogger> async_logger;
+
+    // bench and profile modes
+    std::ostream*                 bench_os          = nullptr;
+    std::ostream*                 profile_os        = nullptr;
+    bool                          bench_format_yaml = false;
+    std::mutex                    bench_mutex;
+    std::map<std::string, size_t> profile;
+
     static LoggerSingleton& getInstance()
     {
         return gInstance;
     }
 
+    // Writes the calls counted by the profile mode, most frequent first.
+    void write_profile();
+
     // copy contructor
     LoggerSingleton(const LoggerSingleton&) = delete;
     // assignment operator
@@ -118,6 +141,8 @@ private:
 
     // logging streams
     std::ofstream log_file_ofs;
+    std::ofstream bench_file_ofs;
+    std::ofstream profile_file_ofs;
 
     LoggerSingleton()
     {
@@ -154,16 +179,74 @@ private:
         // Open log file
         if(env_layer_mode != rocblaslt_layer_mode_none)
         {
-            open_log_stream(&log_os, &log_file_ofs, "HIPBLASLT_LOG_FILE");
+            // Formatting and writing move to a background thread if requested.
+            // Binary logs are always written asynchronously.
+            const char* str_async  = getenv("HIPBLASLT_LOG_ASYNC");
+            const char* str_format = getenv("HIPBLASLT_LOG_FORMAT");
+            bool        binary     = str_format && std::string(str_format) == "binary";
+
+            open_log_stream(&log_os,
+                            &log_file_ofs,
+                            "HIPBLASLT_LOG_FILE",
+                            binary ? std::ofstream::out | std::ofstream::binary
+                                   : std::ofstream::out);
+
+            if(binary || (str_async && atoi(str_async)))
+            {
+                async_logger = std::make_unique<rocblaslt::AsyncLogger>(
+                    *log_os,
+                    binary ? rocblaslt::AsyncLogger::Format::Binary
+                           : rocblaslt::AsyncLogger::Format::Text);
+                // quick_exit skips the destructor, which drains the queue.
+                std::at_quick_exit([]() { getInstance().async_logger->flush(); });
+            }
+
+            // Bench and profile output go to the log file unless they have
+            // their own.
+            bench_os   = log_os;
+            profile_os = log_os;
+            if((env_layer_mode & rocblaslt_layer_mode_log_bench)
+               && getenv("HIPBLASLT_LOG_BENCH_FILE"))
+                open_log_stream(&bench_os, &bench_file_ofs, "HIPBLASLT_LOG_BENCH_FILE");
+            if((env_layer_mode & rocblaslt_layer_mode_log_profile)
+               && getenv("HIPBLASLT_LOG_PROFILE_FILE"))
+                open_log_stream(&profile_os, &profile_file_ofs, "HIPBLASLT_LOG_PROFILE_FILE");
+
+            const char* str_bench_format = getenv("HIPBLASLT_LOG_BENCH_FORMAT");
+            bench_format_yaml = str_bench_format && std::string(str_bench_format) == "yaml";
+
+            // The log file is owned by the background thread of the
+            // asynchronous logger, so the output moves to stderr, as
+            // documented next to HIPBLASLT_LOG_BENCH_FILE.
+            if(async_logger && bench_os == log_os)
+                bench_os = &std::cerr;
+            if(async_logger && profile_os == log_os)
+                profile_os = &std::cerr;
         }
     }
 
     ~LoggerSingleton()
     {
+        // Writes the records still queued before the file is closed.
+        async_logger.reset();
+
+        if(env_layer_mode & rocblaslt_layer_mode_log_profile)
+        {
+            write_profile();
+        }
+
         if(log_file_ofs.is_open())
         {
             log_file_ofs.close();
         }
+        if(bench_file_ofs.is_open())
+        {
+            bench_file_ofs.close();
+        }
+        if(profile_file_ofs.is_open())
+        {
+            profile_file_ofs.close();
+        }
     }
 };
 /**
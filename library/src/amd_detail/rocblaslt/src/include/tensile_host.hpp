@@ -43,6 +43,7 @@
 //#include "tuple_helper.hpp"
 #include "utility.hpp"
 #include <atomic>
+#include <functional>
 #include <Tensile/DataTypes.hpp>
 
 // Return the value category for a value, as a double precision value, such
@@ -267,6 +268,39 @@ rocblaslt_status makeArgument(rocblaslt_handle             handle,
                               hipStream_t                  stream,
                               std::shared_ptr<void>        gemmData);
 
+// Replace the pointers, alpha and beta in the arguments created by makeArgument
+rocblaslt_status updateArgument(rocblaslt_handle                handle,
+                                const rocblaslt::RocGemmType    gemmType,
+                                const rocblaslt::RocGemmInputs& inputs,
+                                std::shared_ptr<void>           gemmData);
+
+// Same for every gemm of a grouped gemm. Only the arguments of the gemms whose
+// inputs changed are copied to the workspace again, on stream, and their number
+// is returned in updatedCount if it is not null.
+rocblaslt_status updateArgument(rocblaslt_handle                             handle,
+                                const rocblaslt::RocGemmType                 gemmType,
+                                const std::vector<rocblaslt::RocGemmInputs>& inputs,
+                                hipStream_t                                  stream,
+                                std::shared_ptr<void>                        gemmData,
+                                size_t*                                      updatedCount);
+
+// Record the arguments created by makeArgument into a launch plan, created on
+// first use, and return the index of the entry
+rocblaslt_status launchPlanAppend(rocblaslt_handle             handle,
+                                  const rocblaslt::RocGemmType gemmType,
+                                  std::shared_ptr<void>        gemmData,
+                                  std::shared_ptr<void>&       planData,
+                                  size_t&                      index);
+
+// Update the inputs of a gemm recorded in a launch plan, and of the gemm itself
+rocblaslt_status launchPlanUpdateInputs(rocblaslt_handle                handle,
+                                        std::shared_ptr<void>           planData,
+                                        size_t                          index,
+                                        const rocblaslt::RocGemmInputs& inputs);
+
+// Launch every kernel recorded in a launch plan
+rocblaslt_status launchPlanRun(std::shared_ptr<void> planData, bool useGraph, hipStream_t stream);
+
 // Run gemm only, without creating args, problems,...
 rocblaslt_status runKernelFromInvocation(rocblaslt_handle       handle,
                                          rocblaslt::RocGemmType gemmType,
@@ -348,17 +382,78 @@ rocblaslt_status getBestSolutions(RocblasltContractionProblem<TiA, TiB, To, Tc>
                                   rocblaslt_handle                              handle,
                                   std::shared_ptr<void>                         gemmData,
                                   int                                           requestedAlgoCount,
-                                  rocblaslt_matmul_heuristic_result heuristicResultsArray[],
-                                  int*                              returnAlgoCount,
-                                  size_t                            maxWorkSpaceBytes);
-
-rocblaslt_status getBestSolutions(rocblaslt_handle       handle,
-                                  rocblaslt::RocGemmType gemmType,
-                                  std::shared_ptr<void>  gemmData,
-                                  const int              workspaceBytes,
-                                  const int              requestedAlgoCount,
+                                  rocblaslt_matmul_heuristic_result     heuristicResultsArray[],
+                                  int*                                  returnAlgoCount,
+                                  size_t                                maxWorkSpaceBytes,
+                                  const rocblaslt_matmul_search_limits& limits);
+
+rocblaslt_status getBestSolutions(rocblaslt_handle                      handle,
+                                  rocblaslt::RocGemmType                gemmType,
+                                  std::shared_ptr<void>                 gemmData,
+                                  const int                             workspaceBytes,
+                                  const rocblaslt_matmul_search_limits& limits,
+                                  const int                             requestedAlgoCount,
                                   std::vector<rocblaslt_matmul_heuristic_result>& heuristicResults);
 
+/*******************************************************************************
+ * prepareHeuristicQuery() builds the Tensile problem that getBestSolutions()  *
+ * searches for prob into a new queryData, starting from the gemmData of the   *
+ * matmul descriptor but leaving it unchanged.                                 *
+ *******************************************************************************/
+template <typename TiA, typename TiB = TiA, typename To = TiB, typename Tc = To>
+rocblaslt_status prepareHeuristicQuery(const RocblasltContractionProblem<TiA, TiB, To, Tc>& prob,
+                                       const std::shared_ptr<void>& gemmData,
+                                       std::shared_ptr<void>&       queryData);
+
+/*******************************************************************************
+ * getBestSolutionsBatched() finds the solutions of many prepared queries on a *
+ * thread pool. The library and hardware are looked up once for the batch,    *
+ * and queries that are bound to get the same solutions are searched once.    *
+ *******************************************************************************/
+rocblaslt_status getBestSolutionsBatched(
+    rocblaslt_handle                                             handle,
+    const std::vector<std::shared_ptr<void>>&                    queryData,
+    int                                                          requestedAlgoCount,
+    size_t                                                       maxWorkSpaceBytes,
+    const rocblaslt_matmul_search_limits&                        limits,
+    std::vector<std::vector<rocblaslt_matmul_heuristic_result>>& heuristicResults);
+
+/*******************************************************************************
+ * exportHeuristicPlan() writes the solutions that getBestSolutionsBatched()   *
+ * finds for prepared queries to planFile, along with their workspace sizes.  *
+ * loadHeuristicPlan() reads such a file into the handle, which then answers  *
+ * heuristic queries for the same problems from it without a search. A plan   *
+ * is only loaded for the device and library that it was made for.           *
+ *******************************************************************************/
+rocblaslt_status exportHeuristicPlan(rocblaslt_handle                          handle,
+                                     const std::vector<std::shared_ptr<void>>& queryData,
+                                     int                                       requestedAlgoCount,
+                                     size_t                                    maxWorkSpaceBytes,
+                                     const rocblaslt_matmul_search_limits&     limits,
+                                     const std::string&                        planFile);
+
+rocblaslt_status loadHeuristicPlan(rocblaslt_handle handle, const std::string& planFile);
+
+/*******************************************************************************
+ * Query and bound the solution selection caches of the Tensile library        *
+ *******************************************************************************/
+rocblaslt_status getSolutionCacheStatistics(rocblaslt_handle                     handle,
+                                            rocblaslt_solution_cache_statistics& statistics);
+
+rocblaslt_status setSolutionCacheCapacity(rocblaslt_handle handle, size_t capacity);
+
+/*******************************************************************************
+ * Load lazily loaded sub-libraries and their code objects on background       *
+ * threads: those whose file name matches pattern, or those that serve the     *
+ * problems looked up by the selectors. Loading is idempotent. If wait is      *
+ * false, returns without waiting for the loads to finish.                     *
+ *******************************************************************************/
+rocblaslt_status preloadLibraries(rocblaslt_handle handle, std::string const& pattern, bool wait);
+
+rocblaslt_status preloadLibraries(rocblaslt_handle                          handle,
+                                  std::vector<std::function<void()>> const& selectors,
+                                  bool                                      wait);
+
 /******************************************************
  * Map a hipblaslt data type to a corresponding Tensile type *
  ******************************************************/
@@ -0,0 +1,125 @@
+/* ************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef ROCBLASLT_THREAD_POOL_HPP
+#define ROCBLASLT_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rocblaslt
+{
+    /*! \brief Fixed set of worker threads running queued tasks in FIFO order.
+     *
+     * Threads are started on the first submit(). Tasks still queued when the
+     * pool is destroyed are dropped; running tasks are waited for.
+     */
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(size_t numThreads)
+            : m_numThreads(numThreads > 0 ? numThreads : 1)
+        {
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+                m_tasks.clear();
+            }
+            m_condition.notify_all();
+
+            for(auto& thread : m_threads)
+                thread.join();
+        }
+
+        ThreadPool(ThreadPool const&)            = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        size_t size() const
+        {
+            return m_numThreads;
+        }
+
+        /*! \brief Queues task, returning a future that becomes ready when it has
+         * run. Exceptions thrown by the task are rethrown by future::get(). */
+        template <typename Task>
+        std::future<void> submit(Task&& task)
+        {
+            auto packaged = std::make_shared<std::packaged_task<void()>>(std::forward<Task>(task));
+            auto future   = packaged->get_future();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if(m_threads.empty())
+                {
+                    for(size_t i = 0; i < m_numThreads; i++)
+                        m_threads.emplace_back([this]() { run(); });
+                }
+                m_tasks.emplace_back([packaged]() { (*packaged)(); });
+            }
+            m_condition.notify_one();
+
+            return future;
+        }
+
+    private:
+        void run()
+        {
+            while(true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+                    if(m_stop)
+                        return;
+
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+        size_t                            m_numThreads;
+        bool                              m_stop = false;
+        std::mutex                        m_mutex;
+        std::condition_variable           m_condition;
+        std::deque<std::function<void()>> m_tasks;
+        std::vector<std::thread>          m_threads;
+    };
+} // namespace rocblaslt
+
+#endif
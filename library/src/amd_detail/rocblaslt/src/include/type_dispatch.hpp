@@ -0,0 +1,343 @@
+/* ************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef ROCBLASLT_TYPE_DISPATCH_HPP
+#define ROCBLASLT_TYPE_DISPATCH_HPP
+
+#include "rocblaslt-types.h"
+#include "utility.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+/*! \brief Every supported combination of matrix and compute types.
+ *
+ * Each line lists TiA, TiB, To, Tc, the hipblasltDatatype_t of A, B, C and D,
+ * and the compute types accepted for them. The heuristic, support check, run
+ * and create paths dispatch through this list, and tensile_host.cpp
+ * instantiates its entry points from it, so a new combination is added here
+ * only.
+ */
+// clang-format off
+#define FOR_EACH_GEMM_TYPES(OPER, SEP)                                                             \
+    OPER(float, float, float, float,                                                               \
+         HIPBLASLT_R_32F, HIPBLASLT_R_32F, HIPBLASLT_R_32F, HIPBLASLT_R_32F,                       \
+         rocblaslt_compute_f32, rocblaslt_compute_f32_fast_xf32) SEP                               \
+    OPER(double, double, double, double,                                                           \
+         HIPBLASLT_R_64F, HIPBLASLT_R_64F, HIPBLASLT_R_64F, HIPBLASLT_R_64F,                       \
+         rocblaslt_compute_f64) SEP                                                                \
+    OPER(rocblaslt_half, rocblaslt_half, rocblaslt_half, float,                                    \
+         HIPBLASLT_R_16F, HIPBLASLT_R_16F, HIPBLASLT_R_16F, HIPBLASLT_R_16F,                       \
+         rocblaslt_compute_f32) SEP                                                                \
+    OPER(rocblaslt_half, rocblaslt_half, float, float,                                             \
+         HIPBLASLT_R_16F, HIPBLASLT_R_16F, HIPBLASLT_R_32F, HIPBLASLT_R_32F,                       \
+         rocblaslt_compute_f32) SEP                                                                \
+    OPER(rocblaslt_bfloat16, rocblaslt_bfloat16, rocblaslt_bfloat16, float,                        \
+         HIPBLASLT_R_16B, HIPBLASLT_R_16B, HIPBLASLT_R_16B, HIPBLASLT_R_16B,                       \
+         rocblaslt_compute_f32) SEP                                                                \
+    OPER(rocblaslt_f8, rocblaslt_f8, float, float,                                                 \
+         HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_32F, HIPBLASLT_R_32F,               \
+         rocblaslt_compute_f32) SEP                                                                \
+    OPER(rocblaslt_f8, rocblaslt_bf8, float, float,                                                \
+         HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_8F_E5M2, HIPBLASLT_R_32F, HIPBLASLT_R_32F,               \
+         rocblaslt_compute_f32) SEP                                                                \
+    OPER(rocblaslt_bf8, rocblaslt_f8, float, float,                                                \
+         HIPBLASLT_R_8F_E5M2, HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_32F, HIPBLASLT_R_32F,               \
+         rocblaslt_compute_f32) SEP                                                                \
+    OPER(rocblaslt_f8, rocblaslt_f8, rocblaslt_half, float,                                        \
+         HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_16F, HIPBLASLT_R_16F,               \
+         rocblaslt_compute_f32) SEP                                                                \
+    OPER(rocblaslt_f8, rocblaslt_bf8, rocblaslt_half, float,                                       \
+         HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_8F_E5M2, HIPBLASLT_R_16F, HIPBLASLT_R_16F,               \
+         rocblaslt_compute_f32) SEP                                                                \
+    OPER(rocblaslt_bf8, rocblaslt_f8, rocblaslt_half, float,                                       \
+         HIPBLASLT_R_8F_E5M2, HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_16F, HIPBLASLT_R_16F,               \
+         rocblaslt_compute_f32) SEP                                                                \
+    OPER(rocblasltInt8, rocblasltInt8, int32_t, int32_t,                                           \
+         HIPBLASLT_R_8I, HIPBLASLT_R_8I, HIPBLASLT_R_32I, HIPBLASLT_R_32I,                         \
+         rocblaslt_compute_i32) SEP                                                                \
+    OPER(rocblasltInt8, rocblasltInt8, rocblasltInt8, int32_t,                                     \
+         HIPBLASLT_R_8I, HIPBLASLT_R_8I, HIPBLASLT_R_8I, HIPBLASLT_R_8I,                           \
+         rocblaslt_compute_i32) SEP                                                                \
+    OPER(rocblaslt_f8, rocblaslt_half, rocblaslt_f8, float,                                        \
+         HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_16F, HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_8F_E4M3,           \
+         rocblaslt_compute_f32_fast_f16) SEP                                                       \
+    OPER(rocblaslt_half, rocblaslt_f8, rocblaslt_f8, float,                                        \
+         HIPBLASLT_R_16F, HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_8F_E4M3,           \
+         rocblaslt_compute_f32_fast_f16) SEP                                                       \
+    OPER(rocblaslt_f8, rocblaslt_half, rocblaslt_half, float,                                      \
+         HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_16F, HIPBLASLT_R_16F, HIPBLASLT_R_16F,                   \
+         rocblaslt_compute_f32_fast_f16) SEP                                                       \
+    OPER(rocblaslt_half, rocblaslt_f8, rocblaslt_half, float,                                      \
+         HIPBLASLT_R_16F, HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_16F, HIPBLASLT_R_16F,                   \
+         rocblaslt_compute_f32_fast_f16) SEP                                                       \
+    OPER(rocblaslt_f8, rocblaslt_half, float, float,                                               \
+         HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_16F, HIPBLASLT_R_32F, HIPBLASLT_R_32F,                   \
+         rocblaslt_compute_f32_fast_f16) SEP                                                       \
+    OPER(rocblaslt_half, rocblaslt_f8, float, float,                                               \
+         HIPBLASLT_R_16F, HIPBLASLT_R_8F_E4M3, HIPBLASLT_R_32F, HIPBLASLT_R_32F,                   \
+         rocblaslt_compute_f32_fast_f16)
+// clang-format on
+
+namespace rocblaslt
+{
+    /*! \brief One line of FOR_EACH_GEMM_TYPES. */
+    template <typename TiA_,
+              typename TiB_,
+              typename To_,
+              typename Tc_,
+              hipblasltDatatype_t A,
+              hipblasltDatatype_t B,
+              hipblasltDatatype_t C,
+              hipblasltDatatype_t D,
+              rocblaslt_compute_type... Computes>
+    struct GemmTypeEntry
+    {
+        using TiA = TiA_;
+        using TiB = TiB_;
+        using To  = To_;
+        using Tc  = Tc_;
+
+        static constexpr hipblasltDatatype_t    types[]        = {A, B, C, D};
+        static constexpr rocblaslt_compute_type computeTypes[] = {Computes...};
+    };
+
+#define ROCBLASLT_GEMM_TYPE_ENTRY(...) GemmTypeEntry<__VA_ARGS__>
+#define ROCBLASLT_GEMM_TYPE_SEP ,
+    using GemmTypeTable
+        = std::tuple<FOR_EACH_GEMM_TYPES(ROCBLASLT_GEMM_TYPE_ENTRY, ROCBLASLT_GEMM_TYPE_SEP)>;
+#undef ROCBLASLT_GEMM_TYPE_ENTRY
+#undef ROCBLASLT_GEMM_TYPE_SEP
+
+    namespace detail
+    {
+        struct GemmTypeKey
+        {
+            int types[4];
+            int compute;
+            int entry;
+        };
+
+        /*! \brief Dense lookup from (A, B, C, D, compute) to the entry of
+         * GemmTypeTable, built at compile time.
+         *
+         * Each datatype and compute type used by the table is mapped to a small
+         * ordinal, and the ordinals index a flat array holding the entry. A
+         * combination listed twice fails to compile.
+         */
+        template <typename Table, typename = std::make_index_sequence<std::tuple_size_v<Table>>>
+        struct GemmTypeLookup;
+
+        template <typename Table, size_t... I>
+        struct GemmTypeLookup<Table, std::index_sequence<I...>>
+        {
+            static constexpr size_t keyCount
+                = (std::size(std::tuple_element_t<I, Table>::computeTypes) + ...);
+
+            static constexpr std::array<GemmTypeKey, keyCount> keys = [] {
+                std::array<GemmTypeKey, keyCount> keys{};
+                size_t                            n = 0;
+                (
+                    [&] {
+                        using Entry = std::tuple_element_t<I, Table>;
+                        for(auto compute : Entry::computeTypes)
+                            keys[n++] = {{Entry::types[0],
+                                          Entry::types[1],
+                                          Entry::types[2],
+                                          Entry::types[3]},
+                                         compute,
+                                         int(I)};
+                    }(),
+                    ...);
+                return keys;
+            }();
+
+            // Smallest and largest datatype and compute type used by the table.
+            static constexpr std::array<int, 4> bounds = [] {
+                std::array<int, 4> bounds{
+                    keys[0].types[0], keys[0].types[0], keys[0].compute, keys[0].compute};
+                for(auto const& key : keys)
+                {
+                    for(int type : key.types)
+                    {
+                        bounds[0] = std::min(bounds[0], type);
+                        bounds[1] = std::max(bounds[1], type);
+                    }
+                    bounds[2] = std::min(bounds[2], key.compute);
+                    bounds[3] = std::max(bounds[3], key.compute);
+                }
+                return bounds;
+            }();
+
+            static constexpr int typeMin    = bounds[0];
+            static constexpr int typeMax    = bounds[1];
+            static constexpr int computeMin = bounds[2];
+            static constexpr int computeMax = bounds[3];
+
+            // Ordinal of each value in [Min, Max], or -1 if the table does not use
+            // it, followed by the number of values used.
+            template <int Min, int Max, bool Compute>
+            static constexpr std::pair<std::array<int8_t, Max - Min + 1>, int> makeOrdinals()
+            {
+                std::array<int8_t, Max - Min + 1> ordinals{};
+                for(auto& ordinal : ordinals)
+                    ordinal = -1;
+
+                int  count = 0;
+                auto add   = [&](int value) {
+                    if(ordinals[value - Min] < 0)
+                        ordinals[value - Min] = count++;
+                };
+                for(auto const& key : keys)
+                {
+                    if constexpr(Compute)
+                        add(key.compute);
+                    else
+                        for(int type : key.types)
+                            add(type);
+                }
+                return {ordinals, count};
+            }
+
+            static constexpr auto typeOrdinals    = makeOrdinals<typeMin, typeMax, false>();
+            static constexpr auto computeOrdinals = makeOrdinals<computeMin, computeMax, true>();
+
+            static constexpr int typeCount    = typeOrdinals.second;
+            static constexpr int computeCount = computeOrdinals.second;
+
+            static constexpr size_t slot(int a, int b, int c, int d, int compute)
+            {
+                return (((size_t(a) * typeCount + b) * typeCount + c) * typeCount + d)
+                           * computeCount
+                       + compute;
+            }
+
+            using Entries = std::array<int8_t,
+                                       size_t(typeCount) * typeCount * typeCount * typeCount
+                                           * computeCount>;
+
+            static constexpr Entries entries = [] {
+                static_assert(std::tuple_size_v<Table> < 128, "entry does not fit in int8_t");
+
+                Entries entries{};
+                for(auto& entry : entries)
+                    entry = -1;
+
+                for(auto const& key : keys)
+                {
+                    auto& entry = entries[slot(typeOrdinals.first[key.types[0] - typeMin],
+                                               typeOrdinals.first[key.types[1] - typeMin],
+                                               typeOrdinals.first[key.types[2] - typeMin],
+                                               typeOrdinals.first[key.types[3] - typeMin],
+                                               computeOrdinals.first[key.compute - computeMin])];
+                    if(entry >= 0)
+                        throw std::logic_error("duplicate gemm type combination");
+                    entry = key.entry;
+                }
+                return entries;
+            }();
+
+            static int typeOrdinal(hipblasltDatatype_t type)
+            {
+                int value = type;
+                if(value < typeMin || value > typeMax)
+                    return -1;
+                return typeOrdinals.first[value - typeMin];
+            }
+
+            /*! \brief Index into Table of the combination, or -1. */
+            static int find(hipblasltDatatype_t    a,
+                            hipblasltDatatype_t    b,
+                            hipblasltDatatype_t    c,
+                            hipblasltDatatype_t    d,
+                            rocblaslt_compute_type compute)
+            {
+                int ordA = typeOrdinal(a), ordB = typeOrdinal(b), ordC = typeOrdinal(c),
+                    ordD = typeOrdinal(d);
+                int ordCompute = compute < computeMin || compute > computeMax
+                                     ? -1
+                                     : computeOrdinals.first[compute - computeMin];
+                if(ordA < 0 || ordB < 0 || ordC < 0 || ordD < 0 || ordCompute < 0)
+                    return -1;
+
+                return entries[slot(ordA, ordB, ordC, ordD, ordCompute)];
+            }
+        };
+
+        template <typename Entry, typename Func>
+        rocblaslt_status invokeGemmTypeEntry(Func& func)
+        {
+            return func.template operator()<typename Entry::TiA,
+                                            typename Entry::TiB,
+                                            typename Entry::To,
+                                            typename Entry::Tc>();
+        }
+
+        template <typename Func, size_t... I>
+        constexpr auto makeGemmTypeDispatchTable(std::index_sequence<I...>)
+        {
+            return std::array<rocblaslt_status (*)(Func&), sizeof...(I)>{
+                &invokeGemmTypeEntry<std::tuple_element_t<I, GemmTypeTable>, Func>...};
+        }
+
+        template <typename Func>
+        inline constexpr auto gemmTypeDispatchTable = makeGemmTypeDispatchTable<Func>(
+            std::make_index_sequence<std::tuple_size_v<GemmTypeTable>>{});
+    }
+
+    /*! \brief Calls func.template operator()<TiA, TiB, To, Tc>() with the types
+     * FOR_EACH_GEMM_TYPES lists for the combination, usually a lambda of the form
+     * []<typename TiA, typename TiB, typename To, typename Tc>() { ... }.
+     *
+     * Unsupported combinations are logged as an error of caller and return
+     * rocblaslt_status_not_implemented.
+     */
+    template <typename Func>
+    rocblaslt_status dispatchGemmTypes(const char*            caller,
+                                       hipblasltDatatype_t    a,
+                                       hipblasltDatatype_t    b,
+                                       hipblasltDatatype_t    c,
+                                       hipblasltDatatype_t    d,
+                                       rocblaslt_compute_type compute,
+                                       Func&&                 func)
+    {
+        int entry = detail::GemmTypeLookup<GemmTypeTable>::find(a, b, c, d, compute);
+        if(entry < 0)
+        {
+            log_error(caller, "No such template.");
+            return rocblaslt_status_not_implemented;
+        }
+
+        return detail::gemmTypeDispatchTable<std::remove_reference_t<Func>>[entry](func);
+    }
+} // namespace rocblaslt
+
+#endif
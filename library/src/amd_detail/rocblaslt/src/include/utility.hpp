@@ -33,6 +33,7 @@
 #include "logging.h"
 #include <algorithm>
 #include <exception>
+#include <vector>
 
 #pragma STDC CX_LIMITED_RANGE ON
 
@@ -138,6 +139,7 @@ template <>
 static constexpr char rocblaslt_precision_string<uint32_t>[] = "u32_r";
 
 std::string prefix(const char* layer, const char* caller);
+std::string prefix(const char* layer, const char* caller, time_t now);
 
 const char* hipblasltDatatype_to_string(hipblasltDatatype_t type);
 
@@ -169,14 +171,25 @@ static inline rocblaslt_int rocblaslt_clz(rocblaslt_int n)
     return 32 - __builtin_clz(n);
 }
 #endif
-std::ostream* get_logger_os();
-uint32_t      get_logger_layer_mode();
+std::ostream*           get_logger_os();
+uint32_t                get_logger_layer_mode();
+rocblaslt::AsyncLogger* get_async_logger();
+
+// Writes the records queued by the asynchronous logger, if any. Called on the
+// abort and quick_exit paths, which skip the destructor of the logger.
+void rocblaslt_log_flush();
 
 template <typename H, typename... Ts>
 void log_base(rocblaslt_layer_mode layer_mode, const char* func, H head, Ts&&... xs)
 {
     if(get_logger_layer_mode() & layer_mode)
     {
+        if(rocblaslt::AsyncLogger* async = get_async_logger())
+        {
+            async->log(layer_mode, func, head, std::forward<Ts>(xs)...);
+            return;
+        }
+
         std::string comma_separator = " ";
 
         std::ostream* os = get_logger_os();
@@ -236,30 +249,60 @@ void log_api(const char* func, H head, Ts&&... xs)
 {
     log_base(rocblaslt_layer_mode_log_api, func, head, std::forward<Ts>(xs)...);
 }
-// if bench logging is turned on with
-// (handle->layer_mode & rocblaslt_layer_mode_log_bench) == true
-// then
-// log_bench will call log_arguments to log a string that
-// can be input to the executable rocblaslt-bench.
-template <typename H, typename... Ts>
-void log_bench(const char* func, H head, std::string precision, Ts&&... xs)
+/*! \brief A gemm described by the arguments of the hipblaslt-bench run that
+ * reproduces it. Filled in by the library for the bench and profile logging
+ * modes. */
+struct rocblaslt_bench_problem
 {
-    // TODO
-    // if(nullptr != handle && nullptr != handle->log_bench_os)
-    //{
-    //    if(handle->log_bench)
-    //    {
-    //        std::string comma_separator = " ";
-
-    //        std::ostream* os = handle->log_bench_os;
+    bool                   ext    = false; //!< Run through the hipblaslt_ext API.
+    hipblasOperation_t     transA = HIPBLAS_OP_N;
+    hipblasOperation_t     transB = HIPBLAS_OP_N;
+    int64_t                m = 0, n = 0, k = 0, batch_count = 1;
+    int64_t                lda = 0, ldb = 0, ldc = 0, ldd = 0, lde = 0;
+    int64_t                stride_a = 0, stride_b = 0, stride_c = 0, stride_d = 0, stride_e = 0;
+    double                 alpha        = 1;
+    double                 beta         = 0;
+    hipblasltDatatype_t    a_type       = HIPBLASLT_R_32F;
+    hipblasltDatatype_t    b_type       = HIPBLASLT_R_32F;
+    hipblasltDatatype_t    c_type       = HIPBLASLT_R_32F;
+    hipblasltDatatype_t    d_type       = HIPBLASLT_R_32F;
+    rocblaslt_compute_type compute_type = rocblaslt_compute_f32;
+    const char*            activation_type   = "none";
+    bool                   bias_vector       = false;
+    hipblasltDatatype_t    bias_type         = HIPBLASLT_R_32F;
+    char                   bias_source       = 'd';
+    bool                   scaleA            = false;
+    bool                   scaleB            = false;
+    bool                   scaleC            = false;
+    bool                   scaleD            = false;
+    bool                   scaleE            = false;
+    bool                   scaleAlpha_vector = false;
+    bool                   use_e             = false;
+    bool                   gradient          = false;
+    bool                   c_noalias_d       = false;
+    int32_t                grouped_gemm      = 0;
+    int32_t                solution_index    = -1;
+};
 
-    //        std::string prefix_str = prefix("Bench", func);
+// if bench logging is turned on with
+// (get_logger_layer_mode() & rocblaslt_layer_mode_log_bench) == true
+// then
+// log_bench will write a hipblaslt-bench command line, or a YAML entry that can
+// be run with hipblaslt-bench --yaml, reproducing the problems.
+// if profile logging is turned on with
+// (get_logger_layer_mode() & rocblaslt_layer_mode_log_profile) == true
+// then
+// log_bench will count the calls per unique problem, and the counts are written
+// as YAML entries when the library is unloaded.
+// The problems of a grouped gemm are logged as one grouped gemm if they are
+// all the same, else each of them is logged as its own grouped gemm.
+void log_bench(const char* func, std::vector<rocblaslt_bench_problem> const& problems);
 
-    //        log_arguments(*os, comma_separator, prefix_str, head,
-    //        std::forward<Ts>(xs)...);
-    //    }
-    //}
+inline void log_bench(const char* func, rocblaslt_bench_problem const& problem)
+{
+    log_bench(func, std::vector<rocblaslt_bench_problem>{problem});
 }
+
 // Convert the current C++ exception to rocblaslt_status
 // This allows extern "C" functions to return this function in a catch(...)
 // block while converting all C++ exceptions to an equivalent rocblaslt_status
@@ -343,6 +386,12 @@ inline bool rocblaslt_enum_utils::is_invalid(rocblaslt_matmul_preference_attribu
     {
     case ROCBLASLT_MATMUL_PREF_SEARCH_MODE:
     case ROCBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES:
+    case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES:
+    case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_B_BYTES:
+    case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_C_BYTES:
+    case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_D_BYTES:
+    case ROCBLASLT_MATMUL_PREF_MAX_GSU:
+    case ROCBLASLT_MATMUL_PREF_DETERMINISTIC:
         return false;
     default:
         return true;
@@ -29,6 +29,7 @@
 #include "rocblaslt.h"
 #include "rocblaslt_mat_utils.hpp"
 #include "tensile_host.hpp"
+#include "type_dispatch.hpp"
 #include "utility.hpp"
 
 #ifndef WIN32
@@ -37,6 +38,9 @@
 
 #include <unistd.h>
 #include <hip/hip_runtime_api.h>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
 #include <utility>
 
 #define TO_STR2(x) #x
@@ -1000,6 +1004,55 @@ rocblaslt_status
                     "data",
                     pref->max_workspace_bytes);
             break;
+        case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES:
+        case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_B_BYTES:
+        case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_C_BYTES:
+        case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_D_BYTES:
+        {
+            auto& alignment = pref->limits.min_alignment_bytes
+                                  [attribute - ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES];
+            alignment = *(uint32_t*)data;
+            log_api(__func__,
+                    "matmulPref",
+                    pref,
+                    "attr",
+                    attribute,
+                    "buf",
+                    data,
+                    "sizeInBytes",
+                    dataSize,
+                    "data",
+                    alignment);
+            break;
+        }
+        case ROCBLASLT_MATMUL_PREF_MAX_GSU:
+            pref->limits.max_gsu = *(uint32_t*)data;
+            log_api(__func__,
+                    "matmulPref",
+                    pref,
+                    "attr",
+                    attribute,
+                    "buf",
+                    data,
+                    "sizeInBytes",
+                    dataSize,
+                    "data",
+                    pref->limits.max_gsu);
+            break;
+        case ROCBLASLT_MATMUL_PREF_DETERMINISTIC:
+            pref->limits.deterministic = *(uint32_t*)data != 0;
+            log_api(__func__,
+                    "matmulPref",
+                    pref,
+                    "attr",
+                    attribute,
+                    "buf",
+                    data,
+                    "sizeInBytes",
+                    dataSize,
+                    "data",
+                    pref->limits.deterministic);
+            break;
         default:
             log_error(__func__, "invalid attribute", attribute);
             return rocblaslt_status_invalid_value;
@@ -1064,6 +1117,55 @@ rocblaslt_status
                     "data[out]",
                     pref->max_workspace_bytes);
             break;
+        case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES:
+        case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_B_BYTES:
+        case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_C_BYTES:
+        case ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_D_BYTES:
+            *sizeWritten     = sizeof(uint32_t);
+            *(uint32_t*)data = pref->limits.min_alignment_bytes
+                                   [attribute - ROCBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES];
+            log_api(__func__,
+                    "matmulPref",
+                    pref,
+                    "attr",
+                    attribute,
+                    "buf",
+                    data,
+                    "sizeInBytes",
+                    sizeInBytes,
+                    "data[out]",
+                    *(uint32_t*)data);
+            break;
+        case ROCBLASLT_MATMUL_PREF_MAX_GSU:
+            *sizeWritten     = sizeof(uint32_t);
+            *(uint32_t*)data = pref->limits.max_gsu;
+            log_api(__func__,
+                    "matmulPref",
+                    pref,
+                    "attr",
+                    attribute,
+                    "buf",
+                    data,
+                    "sizeInBytes",
+                    sizeInBytes,
+                    "data[out]",
+                    pref->limits.max_gsu);
+            break;
+        case ROCBLASLT_MATMUL_PREF_DETERMINISTIC:
+            *sizeWritten     = sizeof(uint32_t);
+            *(uint32_t*)data = pref->limits.deterministic ? 1 : 0;
+            log_api(__func__,
+                    "matmulPref",
+                    pref,
+                    "attr",
+                    attribute,
+                    "buf",
+                    data,
+                    "sizeInBytes",
+                    sizeInBytes,
+                    "data[out]",
+                    pref->limits.deterministic);
+            break;
         default:
             return rocblaslt_status_invalid_value;
             break;
@@ -1105,432 +1207,27 @@ rocblaslt_status rocblaslt_matmul_is_algo_supported(rocblaslt_handle        hand
     rocblaslt_status status = rocblaslt_status_success;
     try
     {
-        hipblasltDatatype_t    a_type       = matA->type;
-        hipblasltDatatype_t    b_type       = matB->type;
-        hipblasltDatatype_t    c_type       = matC->type;
-        hipblasltDatatype_t    d_type       = matD->type;
-        rocblaslt_compute_type compute_type = matmul_descr->compute_type;
-        auto&                  gemmData     = matmul_descr->m_data;
-        if(a_type == HIPBLASLT_R_32F && b_type == HIPBLASLT_R_32F)
-        {
-            if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32
-                   || compute_type == rocblaslt_compute_f32_fast_xf32)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<float, float, float, float>(
-                        matmul_descr,
-                        matA,
-                        matB,
-                        matC,
-                        matD,
-                        alphaf,
-                        betaf,
-                        algo->max_workspace_bytes);
-                    status = isSolutionSupported<float, float, float, float>(
-                        handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_16F && b_type == HIPBLASLT_R_16F)
-        {
-            if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<rocblaslt_half,
-                                                            rocblaslt_half,
-                                                            rocblaslt_half,
-                                                            float>(matmul_descr,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   alphaf,
-                                                                   betaf,
-                                                                   algo->max_workspace_bytes);
-                    status        = isSolutionSupported<rocblaslt_half,
-                                                 rocblaslt_half,
-                                                 rocblaslt_half,
-                                                 float>(
-                        handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob
-                        = construct_rocblaslt_problem<rocblaslt_half, rocblaslt_half, float, float>(
-                            matmul_descr,
-                            matA,
-                            matB,
-                            matC,
-                            matD,
-                            alphaf,
-                            betaf,
-                            algo->max_workspace_bytes);
-                    status = isSolutionSupported<rocblaslt_half, rocblaslt_half, float, float>(
-                        handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_16B && b_type == HIPBLASLT_R_16B)
-        {
-            if(c_type == HIPBLASLT_R_16B && d_type == HIPBLASLT_R_16B)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<rocblaslt_bfloat16,
-                                                            rocblaslt_bfloat16,
-                                                            rocblaslt_bfloat16,
-                                                            float>(matmul_descr,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   alphaf,
-                                                                   betaf,
-                                                                   algo->max_workspace_bytes);
-                    status        = isSolutionSupported<rocblaslt_bfloat16,
-                                                 rocblaslt_bfloat16,
-                                                 rocblaslt_bfloat16,
-                                                 float>(
-                        handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_8F_E4M3 && b_type == HIPBLASLT_R_8F_E4M3)
-        {
-            if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob
-                        = construct_rocblaslt_problem<rocblaslt_f8, rocblaslt_f8, float, float>(
-                            matmul_descr,
-                            matA,
-                            matB,
-                            matC,
-                            matD,
-                            alphaf,
-                            betaf,
-                            algo->max_workspace_bytes);
-                    status = isSolutionSupported<rocblaslt_f8, rocblaslt_f8, float, float>(
-                        handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            float>(matmul_descr,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   alphaf,
-                                                                   betaf,
-                                                                   algo->max_workspace_bytes);
-                    status = isSolutionSupported<rocblaslt_f8, rocblaslt_f8, rocblaslt_half, float>(
-                        handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_8F_E4M3 && b_type == HIPBLASLT_R_8F_E5M2)
-        {
-            if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob
-                        = construct_rocblaslt_problem<rocblaslt_f8, rocblaslt_bf8, float, float>(
-                            matmul_descr,
-                            matA,
-                            matB,
-                            matC,
-                            matD,
-                            alphaf,
-                            betaf,
-                            algo->max_workspace_bytes);
-                    status = isSolutionSupported<rocblaslt_f8, rocblaslt_bf8, float, float>(
-                        handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_bf8,
-                                                            rocblaslt_half,
-                                                            float>(matmul_descr,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   alphaf,
-                                                                   betaf,
-                                                                   algo->max_workspace_bytes);
-                    status
-                        = isSolutionSupported<rocblaslt_f8, rocblaslt_bf8, rocblaslt_half, float>(
-                            handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_8F_E5M2 && b_type == HIPBLASLT_R_8F_E4M3)
-        {
-            if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob
-                        = construct_rocblaslt_problem<rocblaslt_bf8, rocblaslt_f8, float, float>(
-                            matmul_descr,
-                            matA,
-                            matB,
-                            matC,
-                            matD,
-                            alphaf,
-                            betaf,
-                            algo->max_workspace_bytes);
-                    status = isSolutionSupported<rocblaslt_bf8, rocblaslt_f8, float, float>(
-                        handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<rocblaslt_bf8,
-                                                            rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            float>(matmul_descr,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   alphaf,
-                                                                   betaf,
-                                                                   algo->max_workspace_bytes);
-                    status
-                        = isSolutionSupported<rocblaslt_bf8, rocblaslt_f8, rocblaslt_half, float>(
-                            handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_8I && b_type == HIPBLASLT_R_8I) //INT8
-        {
-            if(c_type == HIPBLASLT_R_8I && d_type == HIPBLASLT_R_8I)
-            {
-                if(compute_type == rocblaslt_compute_i32)
-                {
-                    int32_t* alphaf = (int32_t*)alpha;
-                    int32_t* betaf  = (int32_t*)beta;
-                    auto     prob   = construct_rocblaslt_problem<hipblasLtInt8,
-                                                            hipblasLtInt8,
-                                                            hipblasLtInt8,
-                                                            int32_t>(matmul_descr,
-                                                                     matA,
-                                                                     matB,
-                                                                     matC,
-                                                                     matD,
-                                                                     alphaf,
-                                                                     betaf,
-                                                                     algo->max_workspace_bytes);
-                    status
-                        = isSolutionSupported<hipblasLtInt8, hipblasLtInt8, hipblasLtInt8, int32_t>(
-                            handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_32I && d_type == HIPBLASLT_R_32I)
-            {
-                if(compute_type == rocblaslt_compute_i32)
-                {
-                    int32_t* alphaf = (int32_t*)alpha;
-                    int32_t* betaf  = (int32_t*)beta;
-                    auto     prob   = construct_rocblaslt_problem<hipblasLtInt8,
-                                                            hipblasLtInt8,
-                                                            int32_t,
-                                                            int32_t>(matmul_descr,
-                                                                     matA,
-                                                                     matB,
-                                                                     matC,
-                                                                     matD,
-                                                                     alphaf,
-                                                                     betaf,
-                                                                     algo->max_workspace_bytes);
-                    status = isSolutionSupported<hipblasLtInt8, hipblasLtInt8, int32_t, int32_t>(
-                        handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_16F && b_type == HIPBLASLT_R_8F_E4M3) // mix types
-        {
-            if(c_type == HIPBLASLT_R_8F_E4M3 && d_type == HIPBLASLT_R_8F_E4M3)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<rocblaslt_half,
-                                                            rocblaslt_f8,
-                                                            rocblaslt_f8,
-                                                            float>(matmul_descr,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   alphaf,
-                                                                   betaf,
-                                                                   algo->max_workspace_bytes);
-                    status
-                        = isSolutionSupported<rocblaslt_half, rocblaslt_f8, rocblaslt_f8, float>(
-                            handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<rocblaslt_half,
-                                                            rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            float>(matmul_descr,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   alphaf,
-                                                                   betaf,
-                                                                   algo->max_workspace_bytes);
-                    status
-                        = isSolutionSupported<rocblaslt_half, rocblaslt_f8, rocblaslt_half, float>(
-                            handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<rocblaslt_half,
-                                                            rocblaslt_f8,
-                                                            float,
-                                                            float>(matmul_descr,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   alphaf,
-                                                                   betaf,
-                                                                   algo->max_workspace_bytes);
-                    status
-                        = isSolutionSupported<rocblaslt_half, rocblaslt_f8, float, float>(
-                            handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_8F_E4M3 && b_type == HIPBLASLT_R_16F) // mix types
-        {
-            if(c_type == HIPBLASLT_R_8F_E4M3 && d_type == HIPBLASLT_R_8F_E4M3)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            rocblaslt_f8,
-                                                            float>(matmul_descr,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   alphaf,
-                                                                   betaf,
-                                                                   algo->max_workspace_bytes);
-                    status
-                        = isSolutionSupported<rocblaslt_f8, rocblaslt_half, rocblaslt_f8, float>(
-                            handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            rocblaslt_half,
-                                                            float>(matmul_descr,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   alphaf,
-                                                                   betaf,
-                                                                   algo->max_workspace_bytes);
-                    status
-                        = isSolutionSupported<rocblaslt_f8, rocblaslt_half, rocblaslt_half, float>(
-                            handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float* alphaf = (float*)alpha;
-                    float* betaf  = (float*)beta;
-                    auto   prob   = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            float,
-                                                            float>(matmul_descr,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   alphaf,
-                                                                   betaf,
-                                                                   algo->max_workspace_bytes);
-                    status
-                        = isSolutionSupported<rocblaslt_f8, rocblaslt_half, float, float>(
-                            handle, prob, gemmData, algo, workspaceSizeInBytes);
-                }
-            }
-        }
-        else
-        {
-            log_error(__func__, "No such template.");
-            status = rocblaslt_status_not_implemented;
-        }
+        auto& gemmData = matmul_descr->m_data;
+        status         = rocblaslt::dispatchGemmTypes(
+            __func__,
+            matA->type,
+            matB->type,
+            matC->type,
+            matD->type,
+            matmul_descr->compute_type,
+            [&]<typename TiA, typename TiB, typename To, typename Tc>() {
+                auto prob = construct_rocblaslt_problem<TiA, TiB, To, Tc>(
+                    matmul_descr,
+                    matA,
+                    matB,
+                    matC,
+                    matD,
+                    static_cast<const Tc*>(alpha),
+                    static_cast<const Tc*>(beta),
+                    algo->max_workspace_bytes);
+                return isSolutionSupported<TiA, TiB, To, Tc>(
+                    handle, prob, gemmData, algo, workspaceSizeInBytes);
+            });
 
         if(status != rocblaslt_status_success)
         {
@@ -1575,583 +1272,28 @@ rocblaslt_status
     rocblaslt_status status = rocblaslt_status_success;
     try
     {
-        hipblasltDatatype_t    a_type       = matA->type;
-        hipblasltDatatype_t    b_type       = matB->type;
-        hipblasltDatatype_t    c_type       = matC->type;
-        hipblasltDatatype_t    d_type       = matD->type;
-        rocblaslt_compute_type compute_type = matmul_desc->compute_type;
-        auto&                  tensile_data = matmul_desc->m_data;
-        if(a_type == HIPBLASLT_R_32F && b_type == HIPBLASLT_R_32F)
-        {
-            if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32
-                   || compute_type == rocblaslt_compute_f32_fast_xf32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<float, float, float, float>(
-                        matmul_desc,
-                        matA,
-                        matB,
-                        matC,
-                        matD,
-                        &alpha,
-                        &beta,
-                        pref->max_workspace_bytes);
-                    status
-                        = getBestSolutions<float, float, float, float>(prob,
-                                                                       handle,
-                                                                       tensile_data,
-                                                                       requestedAlgoCount,
-                                                                       heuristicResultsArray,
-                                                                       returnAlgoCount,
-                                                                       pref->max_workspace_bytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_16F && b_type == HIPBLASLT_R_16F)
-        {
-            if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_half,
-                                                            rocblaslt_half,
-                                                            rocblaslt_half,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status
-                        = getBestSolutions<rocblaslt_half, rocblaslt_half, rocblaslt_half, float>(
-                            prob,
-                            handle,
-                            tensile_data,
-                            requestedAlgoCount,
-                            heuristicResultsArray,
-                            returnAlgoCount,
-                            pref->max_workspace_bytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob
-                        = construct_rocblaslt_problem<rocblaslt_half, rocblaslt_half, float, float>(
-                            matmul_desc,
-                            matA,
-                            matB,
-                            matC,
-                            matD,
-                            &alpha,
-                            &beta,
-                            pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_half, rocblaslt_half, float, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_16B && b_type == HIPBLASLT_R_16B)
-        {
-            if(c_type == HIPBLASLT_R_16B && d_type == HIPBLASLT_R_16B)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_bfloat16,
-                                                            rocblaslt_bfloat16,
-                                                            rocblaslt_bfloat16,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status      = getBestSolutions<rocblaslt_bfloat16,
-                                              rocblaslt_bfloat16,
-                                              rocblaslt_bfloat16,
-                                              float>(prob,
-                                                     handle,
-                                                     tensile_data,
-                                                     requestedAlgoCount,
-                                                     heuristicResultsArray,
-                                                     returnAlgoCount,
-                                                     pref->max_workspace_bytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_8F_E4M3 && b_type == HIPBLASLT_R_8F_E4M3)
-        {
-            if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob
-                        = construct_rocblaslt_problem<rocblaslt_f8, rocblaslt_f8, float, float>(
-                            matmul_desc,
-                            matA,
-                            matB,
-                            matC,
-                            matD,
-                            &alpha,
-                            &beta,
-                            pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_f8, rocblaslt_f8, float, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_f8, rocblaslt_f8, rocblaslt_half, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_8F_E4M3 && b_type == HIPBLASLT_R_8F_E5M2)
-        {
-            if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob
-                        = construct_rocblaslt_problem<rocblaslt_f8, rocblaslt_bf8, float, float>(
-                            matmul_desc,
-                            matA,
-                            matB,
-                            matC,
-                            matD,
-                            &alpha,
-                            &beta,
-                            pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_f8, rocblaslt_bf8, float, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_bf8,
-                                                            rocblaslt_half,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_f8, rocblaslt_bf8, rocblaslt_half, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_64F && b_type == HIPBLASLT_R_64F)
-        {
-            if(c_type == HIPBLASLT_R_64F && d_type == HIPBLASLT_R_64F)
-            {
-                if(compute_type == rocblaslt_compute_f64)
-                {
-                    double alpha = 1.0;
-                    double beta  = 1.0;
-                    auto   prob  = construct_rocblaslt_problem<double, double, double, double>(
-                        matmul_desc,
-                        matA,
-                        matB,
-                        matC,
-                        matD,
-                        &alpha,
-                        &beta,
-                        pref->max_workspace_bytes);
-                    status = getBestSolutions<double, double, double, double>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_bf8,
-                                                            rocblaslt_half,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_f8, rocblaslt_bf8, rocblaslt_half, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_8F_E5M2 && b_type == HIPBLASLT_R_8F_E4M3)
-        {
-            if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob
-                        = construct_rocblaslt_problem<rocblaslt_bf8, rocblaslt_f8, float, float>(
-                            matmul_desc,
-                            matA,
-                            matB,
-                            matC,
-                            matD,
-                            &alpha,
-                            &beta,
-                            pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_bf8, rocblaslt_f8, float, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_bf8,
-                                                            rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_bf8, rocblaslt_f8, rocblaslt_half, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_8I && b_type == HIPBLASLT_R_8I) //int8 support
-        {
-            if(c_type == HIPBLASLT_R_32I && d_type == HIPBLASLT_R_32I)
-            {
-                if(compute_type == rocblaslt_compute_i32)
-                {
-                    int32_t alpha = 1;
-                    int32_t beta  = 1;
-                    auto    prob  = construct_rocblaslt_problem<hipblasLtInt8,
-                                                            hipblasLtInt8,
-                                                            int32_t,
-                                                            int32_t>(matmul_desc,
-                                                                     matA,
-                                                                     matB,
-                                                                     matC,
-                                                                     matD,
-                                                                     &alpha,
-                                                                     &beta,
-                                                                     pref->max_workspace_bytes);
-                    status = getBestSolutions<hipblasLtInt8, hipblasLtInt8, int32_t, int32_t>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_8I && d_type == HIPBLASLT_R_8I)
-            {
-                if(compute_type == rocblaslt_compute_i32)
-                {
-                    int32_t alpha = 1;
-                    int32_t beta  = 1;
-                    auto    prob  = construct_rocblaslt_problem<hipblasLtInt8,
-                                                            hipblasLtInt8,
-                                                            hipblasLtInt8,
-                                                            int32_t>(matmul_desc,
-                                                                     matA,
-                                                                     matB,
-                                                                     matC,
-                                                                     matD,
-                                                                     &alpha,
-                                                                     &beta,
-                                                                     pref->max_workspace_bytes);
-                    status = getBestSolutions<hipblasLtInt8, hipblasLtInt8, hipblasLtInt8, int32_t>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_16F && b_type == HIPBLASLT_R_8F_E4M3) // mix types
-        {
-            if(c_type == HIPBLASLT_R_8F_E4M3 && d_type == HIPBLASLT_R_8F_E4M3)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_half,
-                                                            rocblaslt_f8,
-                                                            rocblaslt_f8,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_half, rocblaslt_f8, rocblaslt_f8, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_half,
-                                                            rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_half, rocblaslt_f8, rocblaslt_half, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_half,
-                                                            rocblaslt_f8,
-                                                            float,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_half, rocblaslt_f8, float, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-        }
-        else if(a_type == HIPBLASLT_R_8F_E4M3 && b_type == HIPBLASLT_R_16F) // mix types
-        {
-            if(c_type == HIPBLASLT_R_8F_E4M3 && d_type == HIPBLASLT_R_8F_E4M3)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            rocblaslt_f8,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_f8, rocblaslt_half, rocblaslt_f8, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            rocblaslt_half,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_f8, rocblaslt_half, rocblaslt_half, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-            else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-            {
-                if(compute_type == rocblaslt_compute_f32_fast_f16)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            float,
-                                                            float>(matmul_desc,
-                                                                   matA,
-                                                                   matB,
-                                                                   matC,
-                                                                   matD,
-                                                                   &alpha,
-                                                                   &beta,
-                                                                   pref->max_workspace_bytes);
-                    status = getBestSolutions<rocblaslt_f8, rocblaslt_half, float, float>(
-                        prob,
-                        handle,
-                        tensile_data,
-                        requestedAlgoCount,
-                        heuristicResultsArray,
-                        returnAlgoCount,
-                        pref->max_workspace_bytes);
-                }
-            }
-        }
-        else
-        {
-            log_error(__func__, "No such template.");
-            status = rocblaslt_status_not_implemented;
-        }
+        auto& tensile_data = matmul_desc->m_data;
+        status             = rocblaslt::dispatchGemmTypes(
+            __func__,
+            matA->type,
+            matB->type,
+            matC->type,
+            matD->type,
+            matmul_desc->compute_type,
+            [&]<typename TiA, typename TiB, typename To, typename Tc>() {
+                Tc   alpha = 1;
+                Tc   beta  = 1;
+                auto prob  = construct_rocblaslt_problem<TiA, TiB, To, Tc>(
+                    matmul_desc, matA, matB, matC, matD, &alpha, &beta, pref->max_workspace_bytes);
+                return getBestSolutions<TiA, TiB, To, Tc>(prob,
+                                                          handle,
+                                                          tensile_data,
+                                                          requestedAlgoCount,
+                                                          heuristicResultsArray,
+                                                          returnAlgoCount,
+                                                          pref->max_workspace_bytes,
+                                                          pref->limits);
+            });
 
         log_api(__func__, "returnAlogCount", *returnAlgoCount);
         if(status != rocblaslt_status_success)
@@ -2236,456 +1378,34 @@ rocblaslt_status rocblaslt_matmul_get_all_algos_cpp(
     size_t           maxWorkspaceSize = std::numeric_limits<size_t>::max();
     try
     {
-        if(typeA == HIPBLASLT_R_32F && typeB == HIPBLASLT_R_32F)
+        if(typeGemm != rocblaslt::RocGemmType::ROCBLASLT_GEMM
+           && typeGemm != rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
         {
-            if(typeC == HIPBLASLT_R_32F && typeD == HIPBLASLT_R_32F)
-            {
-                if(typeCompute == rocblaslt_compute_f32
-                   || typeCompute == rocblaslt_compute_f32_fast_xf32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<float, float, float, float>(
-                        &matmul_desc, &matA, &matB, &matC, &matD, &alpha, &beta, maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status = getAllSolutions<float, float, float, float>(
-                            prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<RocblasltContractionProblem<float, float, float, float>> probs
-                            = {prob};
-                        status = getAllSolutions<float, float, float, float>(
-                            probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-        }
-        else if(typeA == HIPBLASLT_R_16F && typeB == HIPBLASLT_R_16F)
-        {
-            if(typeC == HIPBLASLT_R_16F && typeD == HIPBLASLT_R_16F)
-            {
-                if(typeCompute == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_half,
-                                                            rocblaslt_half,
-                                                            rocblaslt_half,
-                                                            float>(
-                        &matmul_desc, &matA, &matB, &matC, &matD, &alpha, &beta, maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status = getAllSolutions<rocblaslt_half,
-                                                 rocblaslt_half,
-                                                 rocblaslt_half,
-                                                 float>(
-                            prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<RocblasltContractionProblem<rocblaslt_half,
-                                                                rocblaslt_half,
-                                                                rocblaslt_half,
-                                                                float>>
-                            probs = {prob};
-                        status    = getAllSolutions<rocblaslt_half,
-                                                 rocblaslt_half,
-                                                 rocblaslt_half,
-                                                 float>(
-                            probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-            else if(typeC == HIPBLASLT_R_32F && typeD == HIPBLASLT_R_32F)
-            {
-                if(typeCompute == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob
-                        = construct_rocblaslt_problem<rocblaslt_half, rocblaslt_half, float, float>(
-                            &matmul_desc,
-                            &matA,
-                            &matB,
-                            &matC,
-                            &matD,
-                            &alpha,
-                            &beta,
-                            maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status = getAllSolutions<rocblaslt_half, rocblaslt_half, float, float>(
-                            prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<RocblasltContractionProblem<rocblaslt_half,
-                                                                rocblaslt_half,
-                                                                float,
-                                                                float>>
-                            probs = {prob};
-                        status    = getAllSolutions<rocblaslt_half, rocblaslt_half, float, float>(
-                            probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-        }
-        else if(typeA == HIPBLASLT_R_16B && typeB == HIPBLASLT_R_16B)
-        {
-            if(typeC == HIPBLASLT_R_16B && typeD == HIPBLASLT_R_16B)
-            {
-                if(typeCompute == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_bfloat16,
-                                                            rocblaslt_bfloat16,
-                                                            rocblaslt_bfloat16,
-                                                            float>(
-                        &matmul_desc, &matA, &matB, &matC, &matD, &alpha, &beta, maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status = getAllSolutions<rocblaslt_bfloat16,
-                                                 rocblaslt_bfloat16,
-                                                 rocblaslt_bfloat16,
-                                                 float>(
-                            prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<RocblasltContractionProblem<rocblaslt_bfloat16,
-                                                                rocblaslt_bfloat16,
-                                                                rocblaslt_bfloat16,
-                                                                float>>
-                            probs = {prob};
-                        status    = getAllSolutions<rocblaslt_bfloat16,
-                                                 rocblaslt_bfloat16,
-                                                 rocblaslt_bfloat16,
-                                                 float>(
-                            probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-        }
-        else if(typeA == HIPBLASLT_R_8F_E4M3 && typeB == HIPBLASLT_R_8F_E4M3)
-        {
-            if(typeC == HIPBLASLT_R_32F && typeD == HIPBLASLT_R_32F)
-            {
-                if(typeCompute == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob
-                        = construct_rocblaslt_problem<rocblaslt_f8, rocblaslt_f8, float, float>(
-                            &matmul_desc,
-                            &matA,
-                            &matB,
-                            &matC,
-                            &matD,
-                            &alpha,
-                            &beta,
-                            maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status = getAllSolutions<rocblaslt_f8, rocblaslt_f8, float, float>(
-                            prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<
-                            RocblasltContractionProblem<rocblaslt_f8, rocblaslt_f8, float, float>>
-                            probs = {prob};
-                        status    = getAllSolutions<rocblaslt_f8, rocblaslt_f8, float, float>(
-                            probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-            else if(typeC == HIPBLASLT_R_16F && typeD == HIPBLASLT_R_16F)
-            {
-                if(typeCompute == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            float>(
-                        &matmul_desc, &matA, &matB, &matC, &matD, &alpha, &beta, maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status = getAllSolutions<rocblaslt_f8, rocblaslt_f8, rocblaslt_half, float>(
-                            prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<RocblasltContractionProblem<rocblaslt_f8,
-                                                                rocblaslt_f8,
-                                                                rocblaslt_half,
-                                                                float>>
-                            probs = {prob};
-                        status = getAllSolutions<rocblaslt_f8, rocblaslt_f8, rocblaslt_half, float>(
-                            probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-        }
-        else if(typeA == HIPBLASLT_R_8F_E4M3 && typeB == HIPBLASLT_R_8F_E5M2)
-        {
-            if(typeC == HIPBLASLT_R_32F && typeD == HIPBLASLT_R_32F)
-            {
-                if(typeCompute == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob
-                        = construct_rocblaslt_problem<rocblaslt_f8, rocblaslt_bf8, float, float>(
-                            &matmul_desc,
-                            &matA,
-                            &matB,
-                            &matC,
-                            &matD,
-                            &alpha,
-                            &beta,
-                            maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status = getAllSolutions<rocblaslt_f8, rocblaslt_bf8, float, float>(
-                            prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<
-                            RocblasltContractionProblem<rocblaslt_f8, rocblaslt_bf8, float, float>>
-                            probs = {prob};
-                        status    = getAllSolutions<rocblaslt_f8, rocblaslt_bf8, float, float>(
-                            probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-            else if(typeC == HIPBLASLT_R_16F && typeD == HIPBLASLT_R_16F)
-            {
-                if(typeCompute == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_f8,
-                                                            rocblaslt_bf8,
-                                                            rocblaslt_half,
-                                                            float>(
-                        &matmul_desc, &matA, &matB, &matC, &matD, &alpha, &beta, maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status
-                            = getAllSolutions<rocblaslt_f8, rocblaslt_bf8, rocblaslt_half, float>(
-                                prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<RocblasltContractionProblem<rocblaslt_f8,
-                                                                rocblaslt_bf8,
-                                                                rocblaslt_half,
-                                                                float>>
-                            probs = {prob};
-                        status
-                            = getAllSolutions<rocblaslt_f8, rocblaslt_bf8, rocblaslt_half, float>(
-                                probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-        }
-        else if(typeA == HIPBLASLT_R_8F_E5M2 && typeB == HIPBLASLT_R_8F_E4M3)
-        {
-            if(typeC == HIPBLASLT_R_32F && typeD == HIPBLASLT_R_32F)
-            {
-                if(typeCompute == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob
-                        = construct_rocblaslt_problem<rocblaslt_bf8, rocblaslt_f8, float, float>(
-                            &matmul_desc,
-                            &matA,
-                            &matB,
-                            &matC,
-                            &matD,
-                            &alpha,
-                            &beta,
-                            maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status = getAllSolutions<rocblaslt_bf8, rocblaslt_f8, float, float>(
-                            prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<
-                            RocblasltContractionProblem<rocblaslt_bf8, rocblaslt_f8, float, float>>
-                            probs = {prob};
-                        status    = getAllSolutions<rocblaslt_bf8, rocblaslt_f8, float, float>(
-                            probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-            else if(typeC == HIPBLASLT_R_16F && typeD == HIPBLASLT_R_16F)
-            {
-                if(typeCompute == rocblaslt_compute_f32)
-                {
-                    float alpha = 1.0;
-                    float beta  = 1.0;
-                    auto  prob  = construct_rocblaslt_problem<rocblaslt_bf8,
-                                                            rocblaslt_f8,
-                                                            rocblaslt_half,
-                                                            float>(
-                        &matmul_desc, &matA, &matB, &matC, &matD, &alpha, &beta, maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status
-                            = getAllSolutions<rocblaslt_bf8, rocblaslt_f8, rocblaslt_half, float>(
-                                prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<RocblasltContractionProblem<rocblaslt_bf8,
-                                                                rocblaslt_f8,
-                                                                rocblaslt_half,
-                                                                float>>
-                            probs = {prob};
-                        status
-                            = getAllSolutions<rocblaslt_bf8, rocblaslt_f8, rocblaslt_half, float>(
-                                probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-        }
-        else if(typeA == HIPBLASLT_R_8I && typeB == HIPBLASLT_R_8I) //int8
-        {
-            if(typeC == HIPBLASLT_R_32I && typeD == HIPBLASLT_R_32I)
-            {
-                if(typeCompute == rocblaslt_compute_i32)
-                {
-                    int32_t alpha = 1;
-                    int32_t beta  = 1;
-                    auto    prob  = construct_rocblaslt_problem<hipblasLtInt8,
-                                                            hipblasLtInt8,
-                                                            int32_t,
-                                                            int32_t>(
-                        &matmul_desc, &matA, &matB, &matC, &matD, &alpha, &beta, maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status = getAllSolutions<hipblasLtInt8, hipblasLtInt8, int32_t, int32_t>(
-                            prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<RocblasltContractionProblem<hipblasLtInt8,
-                                                                hipblasLtInt8,
-                                                                int32_t,
-                                                                int32_t>>
-                            probs = {prob};
-                        status    = getAllSolutions<hipblasLtInt8, hipblasLtInt8, int32_t, int32_t>(
-                            probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-            else if(typeC == HIPBLASLT_R_8I && typeD == HIPBLASLT_R_8I)
-            {
-                if(typeCompute == rocblaslt_compute_i32)
-                {
-                    int32_t alpha = 1;
-                    int32_t beta  = 1;
-                    auto    prob  = construct_rocblaslt_problem<hipblasLtInt8,
-                                                            hipblasLtInt8,
-                                                            hipblasLtInt8,
-                                                            int32_t>(
-                        &matmul_desc, &matA, &matB, &matC, &matD, &alpha, &beta, maxWorkspaceSize);
-                    if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
-                    {
-                        status
-                            = getAllSolutions<hipblasLtInt8, hipblasLtInt8, hipblasLtInt8, int32_t>(
-                                prob, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
-                    {
-                        std::vector<RocblasltContractionProblem<hipblasLtInt8,
-                                                                hipblasLtInt8,
-                                                                hipblasLtInt8,
-                                                                int32_t>>
-                            probs = {prob};
-                        status
-                            = getAllSolutions<hipblasLtInt8, hipblasLtInt8, hipblasLtInt8, int32_t>(
-                                probs, handle, heuristicResults, maxWorkspaceSize);
-                    }
-                    else
-                    {
-                        log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
-                        status = rocblaslt_status_not_implemented;
-                    }
-                }
-            }
-        }
-        else
-        {
-            log_error(__func__, "No such template.");
-            status = rocblaslt_status_not_implemented;
+            log_api(__func__, "Invalid gemm type", static_cast<int>(typeGemm));
+            throw rocblaslt_status_not_implemented;
         }
 
+        status = rocblaslt::dispatchGemmTypes(
+            __func__,
+            typeA,
+            typeB,
+            typeC,
+            typeD,
+            typeCompute,
+            [&]<typename TiA, typename TiB, typename To, typename Tc>() {
+                Tc   alpha = 1;
+                Tc   beta  = 1;
+                auto prob  = construct_rocblaslt_problem<TiA, TiB, To, Tc>(
+                    &matmul_desc, &matA, &matB, &matC, &matD, &alpha, &beta, maxWorkspaceSize);
+                if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
+                    return getAllSolutions<TiA, TiB, To, Tc>(
+                        prob, handle, heuristicResults, maxWorkspaceSize);
+
+                std::vector<RocblasltContractionProblem<TiA, TiB, To, Tc>> probs = {prob};
+                return getAllSolutions<TiA, TiB, To, Tc>(
+                    probs, handle, heuristicResults, maxWorkspaceSize);
+            });
+
         if(status != rocblaslt_status_success)
         {
             throw status;
@@ -2722,6 +1442,81 @@ rocblaslt_status rocblaslt_matmul_get_algos_from_index_cpp(
     return rocblaslt_status_success;
 }
 
+rocblaslt_status
+    rocblaslt_get_solution_cache_statistics_cpp(rocblaslt_handle                     handle,
+                                                rocblaslt_solution_cache_statistics& statistics)
+{
+    if(handle == nullptr)
+    {
+        log_error(__func__, "invalid handle pointer", handle);
+        return rocblaslt_status_invalid_handle;
+    }
+    return getSolutionCacheStatistics(handle, statistics);
+}
+
+rocblaslt_status rocblaslt_set_solution_cache_capacity_cpp(rocblaslt_handle handle,
+                                                           size_t           capacity)
+{
+    if(handle == nullptr)
+    {
+        log_error(__func__, "invalid handle pointer", handle);
+        return rocblaslt_status_invalid_handle;
+    }
+    log_api(__func__, "capacity", capacity);
+    return setSolutionCacheCapacity(handle, capacity);
+}
+
+rocblaslt_status
+    rocblaslt_preload_cpp(rocblaslt_handle handle, const std::string& pattern, bool wait)
+{
+    if(handle == nullptr)
+    {
+        log_error(__func__, "invalid handle pointer", handle);
+        return rocblaslt_status_invalid_handle;
+    }
+    log_api(__func__, "pattern", pattern, "wait", wait);
+    return preloadLibraries(handle, pattern, wait);
+}
+
+rocblaslt_status
+    rocblaslt_preload_problem_types_cpp(rocblaslt_handle                                handle,
+                                        rocblaslt::RocGemmType                          typeGemm,
+                                        const std::vector<rocblaslt_gemm_problem_type>& types,
+                                        bool                                            wait)
+{
+    if(handle == nullptr)
+    {
+        log_error(__func__, "invalid handle pointer", handle);
+        return rocblaslt_status_invalid_handle;
+    }
+    log_api(__func__, "types", types.size(), "wait", wait);
+
+    // Looking up all solutions of a problem type loads the sub-libraries that
+    // serve it. The lookups run after this returns, so they must not refer to
+    // the caller's handle.
+    auto handleCopy = std::make_shared<_rocblaslt_handle>(*handle);
+
+    std::vector<std::function<void()>> selectors;
+    for(auto const& type : types)
+    {
+        selectors.push_back([handleCopy, typeGemm, type]() {
+            std::vector<rocblaslt_matmul_heuristic_result> results;
+            static_cast<void>(rocblaslt_matmul_get_all_algos_cpp(handleCopy.get(),
+                                                                 typeGemm,
+                                                                 type.op_a,
+                                                                 type.op_b,
+                                                                 type.type_a,
+                                                                 type.type_b,
+                                                                 type.type_c,
+                                                                 type.type_d,
+                                                                 type.type_compute,
+                                                                 results));
+        });
+    }
+
+    return preloadLibraries(handle, selectors, wait);
+}
+
 rocblaslt_status rocblaslt_is_algo_supported_cpp(rocblaslt_handle       handle,
                                                  rocblaslt::RocGemmType gemmType,
                                                  std::shared_ptr<void>  gemmData,
@@ -2732,11 +1527,12 @@ rocblaslt_status rocblaslt_is_algo_supported_cpp(rocblaslt_handle       handle,
 }
 
 rocblaslt_status
-    rocblaslt_algo_get_heuristic_cpp(rocblaslt_handle       handle,
-                                     rocblaslt::RocGemmType gemmType,
-                                     std::shared_ptr<void>  gemmData,
-                                     const int              workspaceBytes,
-                                     const int              requestedAlgoCount,
+    rocblaslt_algo_get_heuristic_cpp(rocblaslt_handle                      handle,
+                                     rocblaslt::RocGemmType                gemmType,
+                                     std::shared_ptr<void>                 gemmData,
+                                     const int                             workspaceBytes,
+                                     const rocblaslt_matmul_search_limits& limits,
+                                     const int                             requestedAlgoCount,
                                      std::vector<rocblaslt_matmul_heuristic_result>& results)
 {
     if(requestedAlgoCount < 1)
@@ -2748,7 +1544,7 @@ rocblaslt_status
     try
     {
         status = getBestSolutions(
-            handle, gemmType, gemmData, workspaceBytes, requestedAlgoCount, results);
+            handle, gemmType, gemmData, workspaceBytes, limits, requestedAlgoCount, results);
 
         log_api(__func__, "returnAlogCount", results.size());
         if(status != rocblaslt_status_success)
@@ -2763,6 +1559,142 @@ rocblaslt_status
     return rocblaslt_status_success;
 }
 
+namespace
+{
+    // The problems are prepared here, where their types are dispatched, and
+    // searched together.
+    rocblaslt_status
+        prepare_heuristic_queries(const char*                                  caller,
+                                  const std::vector<rocblaslt_matmul_problem>& problems,
+                                  rocblaslt_matmul_preference                  pref,
+                                  std::vector<std::shared_ptr<void>>&          queries)
+    {
+        queries.resize(problems.size());
+        for(size_t i = 0; i < problems.size(); i++)
+        {
+            auto const& problem = problems[i];
+            if(problem.matmul_desc == nullptr || problem.matA == nullptr
+               || problem.matB == nullptr || problem.matC == nullptr || problem.matD == nullptr)
+            {
+                log_error(caller, "invalid pointer in problem", i);
+                return rocblaslt_status_invalid_pointer;
+            }
+
+            auto status = rocblaslt::dispatchGemmTypes(
+                caller,
+                problem.matA->type,
+                problem.matB->type,
+                problem.matC->type,
+                problem.matD->type,
+                problem.matmul_desc->compute_type,
+                [&]<typename TiA, typename TiB, typename To, typename Tc>() {
+                    Tc   alpha = 1;
+                    Tc   beta  = 1;
+                    auto prob  = construct_rocblaslt_problem<TiA, TiB, To, Tc>(
+                        problem.matmul_desc,
+                        problem.matA,
+                        problem.matB,
+                        problem.matC,
+                        problem.matD,
+                        &alpha,
+                        &beta,
+                        pref->max_workspace_bytes);
+                    return prepareHeuristicQuery<TiA, TiB, To, Tc>(
+                        prob, problem.matmul_desc->m_data, queries[i]);
+                });
+
+            if(status != rocblaslt_status_success)
+                return status;
+        }
+
+        return rocblaslt_status_success;
+    }
+} // namespace
+
+rocblaslt_status rocblaslt_matmul_algo_get_heuristic_batched_cpp(
+    rocblaslt_handle                                             handle,
+    const std::vector<rocblaslt_matmul_problem>&                 problems,
+    rocblaslt_matmul_preference                                  pref,
+    int                                                          requestedAlgoCount,
+    std::vector<std::vector<rocblaslt_matmul_heuristic_result>>& heuristicResults)
+{
+    // Check if handle is valid
+    if(handle == nullptr || pref == nullptr)
+    {
+        log_error(__func__, "invalid pointer");
+        return rocblaslt_status_invalid_handle;
+    }
+
+    if(requestedAlgoCount < 1)
+    {
+        log_error(__func__, "invalid requested count", requestedAlgoCount);
+        return rocblaslt_status_invalid_value;
+    }
+
+    log_api(__func__, "problems", problems.size(), "requestedAlgoCount", requestedAlgoCount);
+
+    std::vector<std::shared_ptr<void>> queries;
+    auto status = prepare_heuristic_queries(__func__, problems, pref, queries);
+    if(status != rocblaslt_status_success)
+        return status;
+
+    return getBestSolutionsBatched(handle,
+                                   queries,
+                                   requestedAlgoCount,
+                                   pref->max_workspace_bytes,
+                                   pref->limits,
+                                   heuristicResults);
+}
+
+rocblaslt_status rocblaslt_export_heuristic_plan_cpp(
+    rocblaslt_handle                             handle,
+    const std::vector<rocblaslt_matmul_problem>& problems,
+    rocblaslt_matmul_preference                  pref,
+    int                                          requestedAlgoCount,
+    const std::string&                           planFile)
+{
+    // Check if handle is valid
+    if(handle == nullptr || pref == nullptr)
+    {
+        log_error(__func__, "invalid pointer");
+        return rocblaslt_status_invalid_handle;
+    }
+
+    if(requestedAlgoCount < 1)
+    {
+        log_error(__func__, "invalid requested count", requestedAlgoCount);
+        return rocblaslt_status_invalid_value;
+    }
+
+    log_api(__func__, "problems", problems.size(), "planFile", planFile);
+
+    std::vector<std::shared_ptr<void>> queries;
+    auto status = prepare_heuristic_queries(__func__, problems, pref, queries);
+    if(status != rocblaslt_status_success)
+        return status;
+
+    return exportHeuristicPlan(handle,
+                               queries,
+                               requestedAlgoCount,
+                               pref->max_workspace_bytes,
+                               pref->limits,
+                               planFile);
+}
+
+rocblaslt_status rocblaslt_load_heuristic_plan_cpp(rocblaslt_handle   handle,
+                                                   const std::string& planFile)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        log_error(__func__, "invalid handle");
+        return rocblaslt_status_invalid_handle;
+    }
+
+    log_api(__func__, "planFile", planFile);
+    return loadHeuristicPlan(handle, planFile);
+}
+
 /*******************************************************************************
  * GPU architecture-related functions
  ******************************************************************************/
@@ -2778,9 +1710,63 @@ struct ArchName
     }
 };
 
+// exported. Get the device set by HIPBLASLT_VIRTUAL_DEVICE=<arch>:<CU count>,
+// e.g. gfx942:304. With a virtual device, handles are created and heuristic
+// queries are answered for that device without a HIP device being present.
+const hipDeviceProp_t* rocblaslt_internal_get_virtual_device()
+{
+    static const std::unique_ptr<hipDeviceProp_t> virtualDevice
+        = []() -> std::unique_ptr<hipDeviceProp_t> {
+        const char* env = getenv("HIPBLASLT_VIRTUAL_DEVICE");
+        if(!env || !*env)
+            return nullptr;
+
+        // The arch may carry features, e.g. gfx90a:sramecc+:xnack-:104
+        std::string spec(env);
+        size_t      colon = spec.rfind(':');
+        char*       end   = nullptr;
+        long        cus   = colon == std::string::npos ? 0 : strtol(&spec[colon + 1], &end, 10);
+
+        auto prop = std::make_unique<hipDeviceProp_t>();
+        if(colon == 0 || cus <= 0 || *end != '\0' || colon >= sizeof(prop->gcnArchName))
+        {
+            std::cerr << "\nrocblaslt error: HIPBLASLT_VIRTUAL_DEVICE is " << spec
+                      << ", expected <arch>:<CU count>" << std::endl;
+            return nullptr;
+        }
+
+        spec.copy(prop->gcnArchName, colon);
+        spec.copy(prop->name, std::min(colon, sizeof(prop->name) - 1));
+        prop->multiProcessorCount = cus;
+
+        // The wavefront size of a present device of the same arch, else the
+        // default of the arch, which is wave32 from gfx10 on
+        std::string arch = ArchName{}(*prop);
+        prop->warpSize   = arch.compare(0, 4, "gfx1") == 0 ? 32 : 64;
+        int count        = 0;
+        if(hipGetDeviceCount(&count) == hipSuccess)
+            for(int device = 0; device < count; device++)
+            {
+                hipDeviceProp_t deviceProp;
+                if(hipGetDeviceProperties(&deviceProp, device) == hipSuccess
+                   && ArchName{}(deviceProp) == arch)
+                {
+                    prop->warpSize = deviceProp.warpSize;
+                    break;
+                }
+            }
+        return prop;
+    }();
+
+    return virtualDevice.get();
+}
+
 // exported. Get architecture name
 std::string rocblaslt_internal_get_arch_name()
 {
+    if(auto virtualDevice = rocblaslt_internal_get_virtual_device())
+        return ArchName{}(*virtualDevice);
+
     int deviceId;
     static_cast<void>(hipGetDevice(&deviceId));
     hipDeviceProp_t deviceProperties;
@@ -742,7 +742,7 @@ rocblaslt_status rocblaslt_matmul(rocblaslt_handle             handle,
         return rocblaslt_status_type_mismatch;
     }
 
-    if(get_logger_layer_mode() != rocblaslt_layer_mode_none)
+    if(get_logger_layer_mode() & rocblaslt_layer_mode_log_api)
     {
         log_api(__func__,
                 "A",
@@ -773,7 +773,7 @@ rocblaslt_status rocblaslt_matmul(rocblaslt_handle             handle,
                 stream);
     }
 
-    if(get_logger_layer_mode() != rocblaslt_layer_mode_none)
+    if(get_logger_layer_mode() & rocblaslt_layer_mode_log_trace)
     {
         log_trace(__func__,
                   "A",
@@ -1050,3 +1050,46 @@ rocblaslt_status rocblaslt_makeArgument_cpp(rocblaslt_handle             handle,
 {
     return makeArgument(handle, gemmType, algo, workspace, useUserArgs, stream, gemmData);
 }
+
+rocblaslt_status rocblaslt_update_inputs_cpp(rocblaslt_handle                handle,
+                                             const rocblaslt::RocGemmType    gemmType,
+                                             const rocblaslt::RocGemmInputs& inputs,
+                                             std::shared_ptr<void>           gemmData)
+{
+    return updateArgument(handle, gemmType, inputs, gemmData);
+}
+
+rocblaslt_status
+    rocblaslt_update_grouped_inputs_cpp(rocblaslt_handle                             handle,
+                                        const rocblaslt::RocGemmType                 gemmType,
+                                        const std::vector<rocblaslt::RocGemmInputs>& inputs,
+                                        hipStream_t                                  stream,
+                                        std::shared_ptr<void>                        gemmData,
+                                        size_t*                                      updatedCount)
+{
+    return updateArgument(handle, gemmType, inputs, stream, gemmData, updatedCount);
+}
+
+rocblaslt_status rocblaslt_launch_plan_append_cpp(rocblaslt_handle             handle,
+                                                  const rocblaslt::RocGemmType gemmType,
+                                                  std::shared_ptr<void>        gemmData,
+                                                  std::shared_ptr<void>&       planData,
+                                                  size_t&                      index)
+{
+    return launchPlanAppend(handle, gemmType, gemmData, planData, index);
+}
+
+rocblaslt_status rocblaslt_launch_plan_update_inputs_cpp(rocblaslt_handle                handle,
+                                                         std::shared_ptr<void>           planData,
+                                                         size_t                          index,
+                                                         const rocblaslt::RocGemmInputs& inputs)
+{
+    return launchPlanUpdateInputs(handle, planData, index, inputs);
+}
+
+rocblaslt_status rocblaslt_launch_plan_run_cpp(std::shared_ptr<void> planData,
+                                               bool                  useGraph,
+                                               hipStream_t           stream)
+{
+    return launchPlanRun(planData, useGraph, stream);
+}
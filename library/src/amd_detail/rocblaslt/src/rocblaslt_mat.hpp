@@ -31,6 +31,7 @@
 #include "handle.h"
 
 #include "tensile_host.hpp"
+#include "type_dispatch.hpp"
 
 template <typename TiA, typename TiB, typename To, typename Tc>
 rocblaslt_status rocblaslt_batched_template(rocblaslt_handle             handle,
@@ -645,8 +646,6 @@ inline rocblaslt_status rocblaslt_matmul_template(rocblaslt_handle             h
                                                   std::shared_ptr<void>        gemmData,
                                                   hipStream_t                  stream)
 {
-    rocblaslt_status rs_status = rocblaslt_status_not_implemented;
-
 #define EX_TYPECASTING_PARM                                                                       \
     handle, trans_a, trans_b, m, n, k, alpha, a, ld_a, batch_stride_a, b, ld_b, batch_stride_b,   \
         beta, c, ld_c, batch_stride_c, d, ld_d, batch_stride_d, e, ld_e, batch_stride_e,          \
@@ -654,232 +653,16 @@ inline rocblaslt_status rocblaslt_matmul_template(rocblaslt_handle             h
         workspaceSizeInBytes, bias, scaleA, scaleB, scaleC, scaleD, scaleE, scaleAlphaVec,        \
         bias_type, epilogue, gemmData, stream
 
-    if(a_type == HIPBLASLT_R_32F && b_type == HIPBLASLT_R_32F)
-    {
-        if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32
-               || compute_type == rocblaslt_compute_f32_fast_xf32)
-            {
-                rs_status
-                    = rocblaslt_matmul_typecasting<float, float, float, float>(EX_TYPECASTING_PARM);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_16F && b_type == HIPBLASLT_R_16F)
-    {
-        if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_half,
-                                                         rocblaslt_half,
-                                                         rocblaslt_half,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status
-                    = rocblaslt_matmul_typecasting<rocblaslt_half, rocblaslt_half, float, float>(
-                        EX_TYPECASTING_PARM);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_16B && b_type == HIPBLASLT_R_16B)
-    {
-        if(c_type == HIPBLASLT_R_16B && d_type == HIPBLASLT_R_16B)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_bfloat16,
-                                                         rocblaslt_bfloat16,
-                                                         rocblaslt_bfloat16,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_8F_E4M3 && b_type == HIPBLASLT_R_8F_E4M3)
-    {
-        if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_f8, rocblaslt_f8, float, float>(
-                    EX_TYPECASTING_PARM);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_f8,
-                                                         rocblaslt_f8,
-                                                         rocblaslt_half,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_8F_E4M3 && b_type == HIPBLASLT_R_8F_E5M2)
-    {
-        if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_f8, rocblaslt_bf8, float, float>(
-                    EX_TYPECASTING_PARM);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_f8,
-                                                         rocblaslt_bf8,
-                                                         rocblaslt_half,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_64F && b_type == HIPBLASLT_R_64F)
-    {
-        if(c_type == HIPBLASLT_R_64F && d_type == HIPBLASLT_R_64F)
-        {
-            if(compute_type == rocblaslt_compute_f64)
-            {
-                rs_status = rocblaslt_matmul_typecasting<double, double, double, double>(
-                    EX_TYPECASTING_PARM);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_f8,
-                                                         rocblaslt_bf8,
-                                                         rocblaslt_half,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_8F_E5M2 && b_type == HIPBLASLT_R_8F_E4M3)
-    {
-        if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_bf8, rocblaslt_f8, float, float>(
-                    EX_TYPECASTING_PARM);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_bf8,
-                                                         rocblaslt_f8,
-                                                         rocblaslt_half,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_8I && b_type == HIPBLASLT_R_8I) //int8
-    {
-        if(c_type == HIPBLASLT_R_8I && d_type == HIPBLASLT_R_8I)
-        {
-            if(compute_type == rocblaslt_compute_i32)
-            {
-                rs_status = rocblaslt_matmul_typecasting<hipblasLtInt8,
-                                                         hipblasLtInt8,
-                                                         hipblasLtInt8,
-                                                         int32_t>(EX_TYPECASTING_PARM);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32I && d_type == HIPBLASLT_R_32I)
-        {
-            if(compute_type == rocblaslt_compute_i32)
-            {
-                rs_status
-                    = rocblaslt_matmul_typecasting<hipblasLtInt8, hipblasLtInt8, int32_t, int32_t>(
-                        EX_TYPECASTING_PARM);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_16F && b_type == HIPBLASLT_R_8F_E4M3) // mix types
-    {
-        if(c_type == HIPBLASLT_R_8F_E4M3 && d_type == HIPBLASLT_R_8F_E4M3)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_half,
-                                                         rocblaslt_f8,
-                                                         rocblaslt_f8,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_half,
-                                                         rocblaslt_f8,
-                                                         rocblaslt_half,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_half,
-                                                         rocblaslt_f8,
-                                                         float,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_8F_E4M3 && b_type == HIPBLASLT_R_16F) // mix types
-    {
-        if(c_type == HIPBLASLT_R_8F_E4M3 && d_type == HIPBLASLT_R_8F_E4M3)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_f8,
-                                                         rocblaslt_half,
-                                                         rocblaslt_f8,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_f8,
-                                                         rocblaslt_half,
-                                                         rocblaslt_half,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_matmul_typecasting<rocblaslt_f8,
-                                                         rocblaslt_half,
-                                                         float,
-                                                         float>(EX_TYPECASTING_PARM);
-            }
-        }
-    }
-    else
-    {
-        log_error(__func__, "No such template.");
-        rs_status = rocblaslt_status_not_implemented;
-    }
-
-    return rs_status;
+    return rocblaslt::dispatchGemmTypes(
+        __func__,
+        a_type,
+        b_type,
+        c_type,
+        d_type,
+        compute_type,
+        [&]<typename TiA, typename TiB, typename To, typename Tc>() {
+            return rocblaslt_matmul_typecasting<TiA, TiB, To, Tc>(EX_TYPECASTING_PARM);
+        });
 }
 
 inline rocblaslt_status rocblaslt_gemm_create_template_cpp(hipblasOperation_t     trans_a,
@@ -925,171 +708,23 @@ inline rocblaslt_status rocblaslt_gemm_create_template_cpp(hipblasOperation_t
                                                            std::shared_ptr<void>& gemmData,
                                                            size_t&                gemmCount)
 {
-    rocblaslt_status rs_status = rocblaslt_status_not_implemented;
-
 #define EX_TYPECASTING_PARM_GEMM_CPP                                                              \
     trans_a, trans_b, m, n, k, alpha, a, ld_a, batch_stride_a, b, ld_b, batch_stride_b, beta, c,  \
         ld_c, batch_stride_c, d, ld_d, batch_stride_d, e, ld_e, batch_stride_e, batch_count,      \
         strided_batch, grouped_gemm, gradient, compute_type, bias, scaleA, scaleB, scaleC, scaleD,\
         scaleE, scaleAlphaVec, bias_type, epilogue, gemmData, gemmCount
 
-    if(a_type == HIPBLASLT_R_32F && b_type == HIPBLASLT_R_32F)
-    {
-        if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32
-               || compute_type == rocblaslt_compute_f32_fast_xf32)
-            {
-                rs_status = rocblaslt_gemm_create_typecasting<float, float, float, float>(
-                    EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_16F && b_type == HIPBLASLT_R_16F)
-    {
-        if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_gemm_create_typecasting<rocblaslt_half,
-                                                              rocblaslt_half,
-                                                              rocblaslt_half,
-                                                              float>(EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_gemm_create_typecasting<rocblaslt_half,
-                                                              rocblaslt_half,
-                                                              float,
-                                                              float>(EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_16B && b_type == HIPBLASLT_R_16B)
-    {
-        if(c_type == HIPBLASLT_R_16B && d_type == HIPBLASLT_R_16B)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_gemm_create_typecasting<rocblaslt_bfloat16,
-                                                              rocblaslt_bfloat16,
-                                                              rocblaslt_bfloat16,
-                                                              float>(EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_64F && b_type == HIPBLASLT_R_64F)
-    {
-        if(c_type == HIPBLASLT_R_64F && d_type == HIPBLASLT_R_64F)
-        {
-            if(compute_type == rocblaslt_compute_f64)
-            {
-                rs_status = rocblaslt_gemm_create_typecasting<double, double, double, double>(
-                    EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_8I && b_type == HIPBLASLT_R_8I) //int8
-    {
-        if(c_type == HIPBLASLT_R_8I && d_type == HIPBLASLT_R_8I)
-        {
-            if(compute_type == rocblaslt_compute_i32)
-            {
-                rs_status
-                    = rocblaslt_gemm_create_typecasting<hipblasLtInt8,
-                                                        hipblasLtInt8,
-                                                        hipblasLtInt8,
-                                                        int32_t>(EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32I && d_type == HIPBLASLT_R_32I)
-        {
-            if(compute_type == rocblaslt_compute_i32)
-            {
-                rs_status
-                    = rocblaslt_gemm_create_typecasting<hipblasLtInt8,
-                                                        hipblasLtInt8,
-                                                        int32_t,
-                                                        int32_t>(EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_16F && b_type == HIPBLASLT_R_8F_E4M3) // mix types
-    {
-        if(c_type == HIPBLASLT_R_8F_E4M3 && d_type == HIPBLASLT_R_8F_E4M3)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_gemm_create_typecasting<rocblaslt_half,
-                                                              rocblaslt_f8,
-                                                              rocblaslt_f8,
-                                                              float>(EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_gemm_create_typecasting<rocblaslt_half,
-                                                              rocblaslt_f8,
-                                                              rocblaslt_half,
-                                                              float>(EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_gemm_create_typecasting<rocblaslt_half,
-                                                              rocblaslt_f8,
-                                                              float,
-                                                              float>(EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_8F_E4M3 && b_type == HIPBLASLT_R_16F) // mix types
-    {
-        if(c_type == HIPBLASLT_R_8F_E4M3 && d_type == HIPBLASLT_R_8F_E4M3)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_gemm_create_typecasting<rocblaslt_f8,
-                                                              rocblaslt_half,
-                                                              rocblaslt_f8,
-                                                              float>(EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_gemm_create_typecasting<rocblaslt_f8,
-                                                              rocblaslt_half,
-                                                              rocblaslt_half,
-                                                              float>(EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_gemm_create_typecasting<rocblaslt_f8,
-                                                              rocblaslt_half,
-                                                              float,
-                                                              float>(EX_TYPECASTING_PARM_GEMM_CPP);
-            }
-        }
-    }
-    else
-    {
-        log_error(__func__, "No such template.");
-        rs_status = rocblaslt_status_not_implemented;
-    }
-
-    return rs_status;
+    return rocblaslt::dispatchGemmTypes(
+        __func__,
+        a_type,
+        b_type,
+        c_type,
+        d_type,
+        compute_type,
+        [&]<typename TiA, typename TiB, typename To, typename Tc>() {
+            return rocblaslt_gemm_create_typecasting<TiA, TiB, To, Tc>(
+                EX_TYPECASTING_PARM_GEMM_CPP);
+        });
 }
 
 inline rocblaslt_status
@@ -1136,182 +771,22 @@ inline rocblaslt_status
                                               std::shared_ptr<void>&            gemmData,
                                               size_t&                           gemmCount)
 {
-    rocblaslt_status rs_status = rocblaslt_status_not_implemented;
-
 #define EX_TYPECASTING_PARM_GroupedGemm_CPP                                                       \
     trans_a, trans_b, m, n, k, alpha, a, ld_a, batch_stride_a, b, ld_b, batch_stride_b, beta, c,  \
         ld_c, batch_stride_c, d, ld_d, batch_stride_d, e, ld_e, batch_stride_e, batch_count,      \
         strided_batch, grouped_gemm, compute_type, gradient, bias, scaleA, scaleB, scaleC, scaleD,\
         scaleE, scaleAlphaVec, bias_type, epilogue, gemmData, gemmCount
 
-    if(a_type == HIPBLASLT_R_32F && b_type == HIPBLASLT_R_32F)
-    {
-        if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32
-               || compute_type == rocblaslt_compute_f32_fast_xf32)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<float, float, float, float>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_16F && b_type == HIPBLASLT_R_16F)
-    {
-        if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<rocblaslt_half,
-                                                                     rocblaslt_half,
-                                                                     rocblaslt_half,
-                                                                     float>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<rocblaslt_half,
-                                                                     rocblaslt_half,
-                                                                     float,
-                                                                     float>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_16B && b_type == HIPBLASLT_R_16B)
-    {
-        if(c_type == HIPBLASLT_R_16B && d_type == HIPBLASLT_R_16B)
-        {
-            if(compute_type == rocblaslt_compute_f32)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<rocblaslt_bfloat16,
-                                                                     rocblaslt_bfloat16,
-                                                                     rocblaslt_bfloat16,
-                                                                     float>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_64F && b_type == HIPBLASLT_R_64F)
-    {
-        if(c_type == HIPBLASLT_R_64F && d_type == HIPBLASLT_R_64F)
-        {
-            if(compute_type == rocblaslt_compute_f64)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<rocblaslt_bfloat16,
-                                                                     rocblaslt_bfloat16,
-                                                                     rocblaslt_bfloat16,
-                                                                     float>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_8I && b_type == HIPBLASLT_R_8I) //int8
-    {
-        if(c_type == HIPBLASLT_R_8I && d_type == HIPBLASLT_R_8I)
-        {
-            if(compute_type == rocblaslt_compute_i32)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<hipblasLtInt8,
-                                                                     hipblasLtInt8,
-                                                                     hipblasLtInt8,
-                                                                     int32_t>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32I && d_type == HIPBLASLT_R_32I)
-        {
-            if(compute_type == rocblaslt_compute_i32)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<hipblasLtInt8,
-                                                                     hipblasLtInt8,
-                                                                     int32_t,
-                                                                     int32_t>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_16F && b_type == HIPBLASLT_R_8F_E4M3) // mix types
-    {
-        if(c_type == HIPBLASLT_R_8F_E4M3 && d_type == HIPBLASLT_R_8F_E4M3)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<rocblaslt_half,
-                                                                     rocblaslt_f8,
-                                                                     rocblaslt_f8,
-                                                                     float>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<rocblaslt_half,
-                                                                     rocblaslt_f8,
-                                                                     rocblaslt_half,
-                                                                     float>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<rocblaslt_half,
-                                                                     rocblaslt_f8,
-                                                                     float,
-                                                                     float>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-    }
-    else if(a_type == HIPBLASLT_R_8F_E4M3 && b_type == HIPBLASLT_R_16F) // mix types
-    {
-        if(c_type == HIPBLASLT_R_8F_E4M3 && d_type == HIPBLASLT_R_8F_E4M3)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<rocblaslt_f8,
-                                                                     rocblaslt_half,
-                                                                     rocblaslt_f8,
-                                                                     float>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_16F && d_type == HIPBLASLT_R_16F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<rocblaslt_f8,
-                                                                     rocblaslt_half,
-                                                                     rocblaslt_half,
-                                                                     float>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-        else if(c_type == HIPBLASLT_R_32F && d_type == HIPBLASLT_R_32F)
-        {
-            if(compute_type == rocblaslt_compute_f32_fast_f16)
-            {
-                rs_status = rocblaslt_groupedgemm_create_typecasting<rocblaslt_f8,
-                                                                     rocblaslt_half,
-                                                                     float,
-                                                                     float>(
-                    EX_TYPECASTING_PARM_GroupedGemm_CPP);
-            }
-        }
-    }
-    else
-    {
-        log_error(__func__, "No such template.");
-        rs_status = rocblaslt_status_not_implemented;
-    }
-
-    return rs_status;
+    return rocblaslt::dispatchGemmTypes(
+        __func__,
+        a_type,
+        b_type,
+        c_type,
+        d_type,
+        compute_type,
+        [&]<typename TiA, typename TiB, typename To, typename Tc>() {
+            return rocblaslt_groupedgemm_create_typecasting<TiA, TiB, To, Tc>(
+                EX_TYPECASTING_PARM_GroupedGemm_CPP);
+        });
 }
 #endif
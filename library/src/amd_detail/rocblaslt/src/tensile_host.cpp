@@ -36,25 +36,36 @@
 #include "rocblaslt-types.h"
 #include "rocblaslt_mat_utils.hpp"
 #include "tensile_host.hpp"
+#include "thread_pool.hpp"
+#include "type_dispatch.hpp"
 
 //#include <Tensile/AMDGPU.hpp>
+#include <Tensile/CachingLibrary.hpp>
 #include <Tensile/Contractions.hpp>
 #include <Tensile/EmbeddedLibrary.hpp>
 #include <Tensile/MasterSolutionLibrary.hpp>
 #include <Tensile/Tensile.hpp>
 #include <Tensile/TensorDescriptor.hpp>
 #include <Tensile/Utils.hpp>
+#include <Tensile/hip/HipArgumentRing.hpp>
 #include <Tensile/hip/HipHardware.hpp>
+#include <Tensile/hip/HipLaunchPlan.hpp>
 #include <Tensile/hip/HipSolutionAdapter.hpp>
 #include <Tensile/hip/HipUtils.hpp>
+#include <array>
 #include <atomic>
 #include <complex>
 #include <exception>
+#include <fstream>
 #include <iomanip>
 #include <memory>
 #include <mutex>
+#include <regex>
+#include <sstream>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <glob.h>
@@ -68,8 +79,6 @@
 #include <roctracer/roctx.h>
 #endif
 
-#define INTERNAL_HIPHOSTMEM_SIZE 32768
-
 namespace
 {
     std::string getHipblasltSoPath()
@@ -818,6 +827,102 @@ namespace
         return inputs;
     }
 
+    /*****************************************************************
+ * Describe a Tensile problem as the arguments of hipblaslt-bench *
+ *****************************************************************/
+    rocblaslt_bench_problem benchProblem(Tensile::ContractionProblemGemm const& problem,
+                                         Tensile::ContractionInputs const&      inputs,
+                                         bool                                   scaleE,
+                                         int                                    algoIndex,
+                                         bool                                   ext)
+    {
+        using TENSOR = Tensile::ContractionProblemGemm::TENSOR;
+
+        auto const& a = problem.a();
+        auto const& b = problem.b();
+        auto const& c = problem.c();
+        auto const& d = problem.d();
+
+        rocblaslt_bench_problem bench;
+        bench.ext         = ext;
+        bench.transA      = problem.transA() ? HIPBLAS_OP_T : HIPBLAS_OP_N;
+        bench.transB      = problem.transB() ? HIPBLAS_OP_T : HIPBLAS_OP_N;
+        bench.m           = d.sizes()[0];
+        bench.n           = d.sizes()[1];
+        bench.k           = problem.boundSize(0);
+        bench.batch_count = d.sizes()[2];
+        bench.lda         = a.strides()[1];
+        bench.ldb         = b.strides()[1];
+        bench.ldc         = c.strides()[1];
+        bench.ldd         = d.strides()[1];
+        bench.stride_a    = a.strides()[2];
+        bench.stride_b    = b.strides()[2];
+        bench.stride_c    = c.strides()[2];
+        bench.stride_d    = d.strides()[2];
+        bench.a_type      = tensile2HipType(a.dataType());
+        bench.b_type      = tensile2HipType(b.dataType());
+        bench.c_type      = tensile2HipType(c.dataType());
+        bench.d_type      = tensile2HipType(d.dataType());
+
+        if(problem.f32XdlMathOp() == Tensile::DataType::XFloat32)
+            bench.compute_type = rocblaslt_compute_f32_fast_xf32;
+        else if(problem.computeType() == Tensile::DataType::Double)
+            bench.compute_type = rocblaslt_compute_f64;
+        else if(problem.computeType() == Tensile::DataType::Int32)
+            bench.compute_type = rocblaslt_compute_i32;
+        else if(problem.computeInputType() == Tensile::DataType::Half
+                && (a.dataType() != Tensile::DataType::Half
+                    || b.dataType() != Tensile::DataType::Half))
+            bench.compute_type = rocblaslt_compute_f32_fast_f16;
+
+        bench.alpha = Tensile::constVariantCast<double>(inputs.alpha);
+        bench.beta  = Tensile::constVariantCast<double>(inputs.beta);
+
+        switch(problem.activationEnumArg())
+        {
+        case Tensile::ActivationType::Relu:
+            bench.activation_type = "relu";
+            break;
+        case Tensile::ActivationType::Gelu:
+        case Tensile::ActivationType::DGelu:
+            // DGelu is gelu with --gradient
+            bench.activation_type = "gelu";
+            break;
+        default:
+            break;
+        }
+
+        if(problem.useBias() && inputs.bias)
+        {
+            bench.bias_vector = true;
+            bench.bias_type   = tensile2HipType(problem.biasType());
+            bench.bias_source = problem.biasSrc() == TENSOR::A   ? 'a'
+                                : problem.biasSrc() == TENSOR::B ? 'b'
+                                                                 : 'd';
+        }
+
+        if(problem.useE())
+        {
+            auto const& e  = problem.tensor(TENSOR::E);
+            bench.use_e    = true;
+            bench.lde      = e.strides()[1];
+            bench.stride_e = e.strides()[2];
+        }
+
+        bench.scaleA            = inputs.scaleA != nullptr;
+        bench.scaleB            = inputs.scaleB != nullptr;
+        bench.scaleC            = inputs.scaleC != nullptr;
+        bench.scaleD            = inputs.scaleD != nullptr;
+        bench.scaleE            = scaleE;
+        bench.scaleAlpha_vector = problem.useScaleAlphaVec() && inputs.scaleAlphaVec;
+        bench.gradient          = problem.useGradient();
+        bench.c_noalias_d       = !problem.cEqualsD();
+        bench.grouped_gemm      = problem.groupedGemm() ? 1 : 0;
+        bench.solution_index    = algoIndex;
+
+        return bench;
+    }
+
     /**************************************************
  * The TensileHost struct interfaces with Tensile *
  **************************************************/
@@ -825,14 +930,17 @@ namespace
     {
         // The library object
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> m_library;
-        std::shared_ptr<hipDeviceProp_t> m_deviceProp;
 
         // The adapter object. mutable is used to allow adapters to be modified
-        // even when they are stored in a const vector which is immutable in size
+        // even when they are stored in a const vector which is immutable in size.
+        // deviceProp and hardware are set once, before adapter is published, and
+        // are immutable afterwards so the per-call path does not rebuild them.
         struct adapter_s
         {
             mutable std::atomic<Tensile::hip::SolutionAdapter*> adapter{nullptr};
             mutable std::mutex                                  mutex;
+            mutable std::shared_ptr<hipDeviceProp_t>            deviceProp;
+            mutable std::shared_ptr<Tensile::Hardware>          hardware;
         };
 
         // Each device contains an adapter
@@ -840,7 +948,7 @@ namespace
 
     public:
         TensileHost()
-            : m_adapters(GetDeviceCount())
+            : m_adapters(rocblaslt_internal_get_virtual_device() ? 1 : GetDeviceCount())
         {
             // We mark TensileHost as initialized. This is so that CI tests can
             // verify that the initialization occurs in the "multiheaded" tests
@@ -876,11 +984,6 @@ namespace
             return m_library;
         }
 
-        auto& get_device_property() const
-        {
-            return m_deviceProp;
-        }
-
         auto& get_adapters() const
         {
             return m_adapters;
@@ -898,7 +1001,9 @@ namespace
    * Initialize adapter and library according to environment variables *
    * and default paths based on librocblaslt.so location and GPU         *
    *********************************************************************/
-        void initialize(Tensile::hip::SolutionAdapter& adapter, int32_t deviceId)
+        void initialize(Tensile::hip::SolutionAdapter& adapter,
+                        adapter_s const&               entry,
+                        int32_t                        deviceId)
         {
             std::string path;
 #ifndef WIN32
@@ -939,6 +1044,88 @@ namespace
                     path += "/" + processor;
             }
 
+            // We initialize a local static variable with a lambda function call to
+            // avoid race conditions when multiple threads with different device IDs try
+            // to initialize library. This ensures that only one thread initializes
+            // library, and other threads trying to initialize library wait for it to
+            // complete.
+            static int once = [&] {
+#ifdef TENSILE_YAML
+                std::string libraryFile = path + "/TensileLibrary.yaml";
+#else
+                std::string libraryFile = path + "/TensileLibrary.dat";
+#endif
+                if(!TestPath(libraryFile))
+                {
+                    std::cerr << "\nrocblaslt error: Cannot read " << libraryFile << ": "
+                              << strerror(errno) << std::endl;
+                    // rocblaslt_abort();
+                }
+
+                auto lib = Tensile::LoadLibraryFile<Tensile::ContractionProblemGemm>(libraryFile);
+                if(!lib)
+                    std::cerr << "\nrocblaslt error: Could not load " << libraryFile << std::endl;
+                else
+                {
+                    using MSL = Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>;
+                    m_library = std::dynamic_pointer_cast<MSL>(lib);
+                }
+
+                // Opt-in: keep heuristic results on disk across runs
+                const char* cacheFile = getenv("HIPBLASLT_SOLUTION_CACHE_FILE");
+                if(m_library && cacheFile && *cacheFile)
+                {
+                    auto cache = std::dynamic_pointer_cast<
+                        Tensile::CachingLibrary<Tensile::ContractionProblemGemm>>(
+                        m_library->library);
+                    if(cache)
+                        cache->setPersistentCache(
+                            std::make_shared<Tensile::PersistentSolutionCache>(
+                                cacheFile, libraryFile, m_library->version));
+                }
+                return 0;
+            }();
+
+            if(!m_library && once != 0)
+            {
+                std::cerr << "\nrocblaslt error: Could not initialize Tensile library" << std::endl;
+                // rocblaslt_abort();
+            }
+
+            // A virtual device only answers heuristic queries, so no code
+            // objects are loaded for it.
+            if(auto virtualDevice = rocblaslt_internal_get_virtual_device())
+            {
+                entry.deviceProp = std::make_shared<hipDeviceProp_t>(*virtualDevice);
+                entry.hardware   = Tensile::hip::GetDevice(*virtualDevice);
+                log_info(__func__,
+                         "no code objects are loaded for virtual device",
+                         virtualDevice->gcnArchName);
+                return;
+            }
+
+            // With lazy loading, the code object of a sub-library is loaded
+            // together with the sub-library, on first use or by preloadLibraries.
+            std::unordered_set<std::string> lazyCodeObjects;
+            if(m_library)
+            {
+                std::vector<Tensile::LazyLoadedLibrary const*> lazyLibraries;
+                m_library->getLazyLoadedLibraries(lazyLibraries);
+                for(auto lazyLibrary : lazyLibraries)
+                    lazyCodeObjects.insert(lazyLibrary->codeObjectFile());
+            }
+
+            auto isLazyCodeObject = [&](std::string file) {
+                file = file.substr(file.find_last_of("/\\") + 1);
+                for(auto xnack : {"-xnack-", "-xnack+"})
+                {
+                    size_t loc = file.find(xnack);
+                    if(loc != std::string::npos)
+                        file.erase(loc, strlen(xnack));
+                }
+                return lazyCodeObjects.count(file) != 0;
+            };
+
             // only load modules for the current architecture
             auto dir = path + "/*" + processor + "*co";
 
@@ -952,7 +1139,8 @@ namespace
                 do
                 {
                     std::string codeObjectFile = path + "\\" + finddata.cFileName;
-                    static_cast<void>(adapter.loadCodeObjectFile(codeObjectFile.c_str()));
+                    if(!isLazyCodeObject(codeObjectFile))
+                        static_cast<void>(adapter.loadCodeObjectFile(codeObjectFile.c_str()));
                 } while(FindNextFileA(hfine, &finddata));
             }
             else
@@ -966,7 +1154,10 @@ namespace
             if(!g)
             {
                 for(size_t i = 0; i < glob_result.gl_pathc; ++i)
-                    static_cast<void>(adapter.loadCodeObjectFile(glob_result.gl_pathv[i]));
+                {
+                    if(!isLazyCodeObject(glob_result.gl_pathv[i]))
+                        static_cast<void>(adapter.loadCodeObjectFile(glob_result.gl_pathv[i]));
+                }
             }
             else if(g == GLOB_NOMATCH)
             {
@@ -996,45 +1187,14 @@ namespace
                           << std::endl;
             }
 
-            // We initialize a local static variable with a lambda function call to
-            // avoid race conditions when multiple threads with different device IDs try
-            // to initialize library. This ensures that only one thread initializes
-            // library, and other threads trying to initialize library wait for it to
-            // complete.
-            static int once = [&] {
-#ifdef TENSILE_YAML
-                path += "/TensileLibrary.yaml";
-#else
-                path += "/TensileLibrary.dat";
-#endif
-                if(!TestPath(path))
-                {
-                    std::cerr << "\nrocblaslt error: Cannot read " << path << ": "
-                              << strerror(errno) << std::endl;
-                    // rocblaslt_abort();
-                }
-
-                auto lib = Tensile::LoadLibraryFile<Tensile::ContractionProblemGemm>(path);
-                if(!lib)
-                    std::cerr << "\nrocblaslt error: Could not load " << path << std::endl;
-                else
-                {
-                    using MSL = Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>;
-                    m_library = std::dynamic_pointer_cast<MSL>(lib);
-                }
-                return 0;
-            }();
-
-            if(!m_library && once != 0)
-            {
-                std::cerr << "\nrocblaslt error: Could not initialize Tensile library" << std::endl;
-                // rocblaslt_abort();
-            }
+            if(!lazyCodeObjects.empty())
+                static_cast<void>(adapter.initializeLazyLoading(processor, path));
 
             hipDeviceProp_t prop;
             HIP_CHECK_EXC(hipGetDeviceProperties(&prop, deviceId));
 
-            m_deviceProp = std::make_shared<hipDeviceProp_t>(prop);
+            entry.deviceProp = std::make_shared<hipDeviceProp_t>(prop);
+            entry.hardware   = Tensile::hip::GetDevice(prop);
         }
     };
 
@@ -1042,14 +1202,17 @@ namespace
     Tensile::hip::SolutionAdapter* get_library_and_adapter(
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>>* library
         = nullptr,
-        std::shared_ptr<hipDeviceProp_t>* deviceProp = nullptr,
-        int                               device     = -1)
+        std::shared_ptr<hipDeviceProp_t>*   deviceProp = nullptr,
+        int                                 device     = -1,
+        std::shared_ptr<Tensile::Hardware>* hardware   = nullptr)
     try
     {
         // TensileHost is initialized on the first call
         static TensileHost host;
 
-        if(device == -1)
+        if(device == -1 && rocblaslt_internal_get_virtual_device())
+            device = 0;
+        else if(device == -1)
             static_cast<void>(hipGetDevice(&device));
 
         // Adapter entry for the current HIP device ID
@@ -1069,7 +1232,7 @@ namespace
                 adapter = new Tensile::hip::SolutionAdapter;
 
                 // Initialize the adapter and possibly the library
-                host.initialize(*adapter, device);
+                host.initialize(*adapter, a, device);
 
                 // Atomically change the adapter stored for this device ID
                 a.adapter.store(adapter, std::memory_order_release);
@@ -1080,7 +1243,9 @@ namespace
         if(library)
             *library = host.get_library();
         if(deviceProp)
-            *deviceProp = host.get_device_property();
+            *deviceProp = a.deviceProp;
+        if(hardware)
+            *hardware = a.hardware;
 
         return adapter;
     }
@@ -1128,6 +1293,8 @@ struct TensileDataGemm
     Tensile::ContractionInputs             inputs;
     std::vector<Tensile::KernelInvocation> kernels;
     int                                    algoIndex = std::numeric_limits<int>::max();
+    // Tensile has no scale for E, it is only kept for the bench log.
+    bool                                   scaleE    = false;
 };
 
 struct TensileDataGroupedGemm
@@ -1135,12 +1302,66 @@ struct TensileDataGroupedGemm
     Tensile::ContractionProblemGroupedGemm problem;
     Tensile::ContractionGroupedInputs      inputs;
     std::vector<Tensile::KernelInvocation> kernels;
-    int                                    algoIndex = std::numeric_limits<int>::max();
-    std::shared_ptr<void>                  hipHostMemory;
-    size_t                                 hipHostMemorySize;
+    int                                    algoIndex   = std::numeric_limits<int>::max();
     bool                                   useUserArgs = false;
+    // Per gemm, see TensileDataGemm::scaleE.
+    std::vector<bool>                      scaleE;
+};
+
+struct TensileLaunchPlan
+{
+    struct Entry
+    {
+        rocblaslt::RocGemmType gemmType;
+        std::shared_ptr<void>  gemmData;
+    };
+
+    int                      device = -1;
+    Tensile::hip::LaunchPlan plan;
+    std::vector<Entry>       entries;
 };
 
+namespace
+{
+    bool benchLogEnabled()
+    {
+        return get_logger_layer_mode()
+               & (rocblaslt_layer_mode_log_bench | rocblaslt_layer_mode_log_profile);
+    }
+
+    // Logging must not fail the gemm it describes.
+    void logBench(const char*                       func,
+                  TensileDataGemm const&            data,
+                  Tensile::ContractionInputs const& inputs,
+                  int                               algoIndex,
+                  bool                              ext)
+    try
+    {
+        log_bench(func, benchProblem(data.problem, inputs, data.scaleE, algoIndex, ext));
+    }
+    catch(const std::exception& e)
+    {
+        log_error(__func__, e.what());
+    }
+
+    void logBench(const char* func, TensileDataGroupedGemm const& data, int algoIndex)
+    try
+    {
+        std::vector<rocblaslt_bench_problem> problems;
+        for(size_t i = 0; i < data.problem.gemms.size(); i++)
+            problems.push_back(benchProblem(data.problem.gemms[i],
+                                            data.inputs.grouped[i],
+                                            i < data.scaleE.size() && data.scaleE[i],
+                                            algoIndex,
+                                            true));
+        log_bench(func, problems);
+    }
+    catch(const std::exception& e)
+    {
+        log_error(__func__, e.what());
+    }
+} // namespace
+
 void initTensileGemmData(rocblaslt_handle       handle,
                          rocblaslt::RocGemmType gemmType,
                          hipblasOperation_t     opA,
@@ -1191,12 +1412,6 @@ void initTensileGemmData(rocblaslt_handle       handle,
                                                            maxWorkspaceBytes));
         groupedInputs.grouped.resize(1);
 
-        void* tmp = nullptr;
-        static_cast<void>(hipHostMalloc(&tmp, INTERNAL_HIPHOSTMEM_SIZE, 0));
-        data.hipHostMemory
-            = std::shared_ptr<void>(tmp, [](auto p) { static_cast<void>(hipFree(p)); });
-        data.hipHostMemorySize = INTERNAL_HIPHOSTMEM_SIZE;
-
         gemmData = std::static_pointer_cast<void>(std::make_shared<TensileDataGroupedGemm>(data));
         return;
     }
@@ -1221,14 +1436,14 @@ rocblaslt_status runContractionProblem(rocblaslt_handle
         std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
         std::shared_ptr<Tensile::Hardware>                                               hardware;
 
-        auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
-        hardware     = Tensile::hip::GetDevice(*deviceProp);
+        auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device, &hardware);
 
         std::shared_ptr<TensileDataGemm> data = std::static_pointer_cast<TensileDataGemm>(gemmData);
         updateTensileProblem(algo->fallback, prob, data->problem);
 
         int* solutionIndex = (int*)algo->data;
         data->algoIndex    = *solutionIndex;
+        data->scaleE       = prob.scaleE != nullptr;
 
         auto solution = library->getSolutionByIndex(data->problem, *hardware, *solutionIndex);
         if(!solution)
@@ -1241,12 +1456,13 @@ rocblaslt_status runContractionProblem(rocblaslt_handle
         }
         else
         {
+            auto inputs = GetTensileInputs(prob);
             static_cast<void>(adapter->launchKernels(
-                solution->solve(data->problem, GetTensileInputs(prob), *hardware),
-                prob.stream,
-                nullptr,
-                nullptr));
+                solution->solve(data->problem, inputs, *hardware), prob.stream, nullptr, nullptr));
             status = rocblaslt_status_success;
+
+            if(benchLogEnabled())
+                logBench("hipblasLtMatmul", *data, inputs, data->algoIndex, false);
         }
     }
     catch(const std::exception& e)
@@ -1291,12 +1507,14 @@ rocblaslt_status gemmCreate(RocblasltContractionProblem<TiA, TiB, To, Tc> const&
                 = std::static_pointer_cast<TensileDataGemm>(gemmData);
             updateTensileProblem(false, problem, data->problem);
             data->inputs = GetTensileInputs(problem);
+            data->scaleE = problem.scaleE != nullptr;
         }
         else
         {
             TensileDataGemm data;
             data.problem = ConstructTensileProblem(problem);
             data.inputs  = GetTensileInputs(problem);
+            data.scaleE  = problem.scaleE != nullptr;
 
             gemmData = std::static_pointer_cast<void>(std::make_shared<TensileDataGemm>(data));
         }
@@ -1344,6 +1562,7 @@ rocblaslt_status
             Tensile::ContractionGroupedInputs&      groupedInputs = data->inputs;
 
             groupedInputs.grouped.clear();
+            data->scaleE.clear();
             if(tensile_probs.gemms.size() != probs.size())
                 tensile_probs.gemms.clear();
 
@@ -1365,6 +1584,7 @@ rocblaslt_status
                 else
                     updateTensileProblem(false, probs[i], tensile_probs.gemms[i]);
                 groupedInputs.grouped.push_back(GetTensileInputs(probs[i]));
+                data->scaleE.push_back(probs[i].scaleE != nullptr);
             }
         }
         else
@@ -1388,6 +1608,7 @@ rocblaslt_status
                 }
                 tensile_probs.gemms.push_back(ConstructTensileProblem(probs[i]));
                 groupedInputs.grouped.push_back(GetTensileInputs(probs[i]));
+                data.scaleE.push_back(probs[i].scaleE != nullptr);
             }
 
             gemmData
@@ -1415,6 +1636,35 @@ rocblaslt_status
     return status;
 }
 
+namespace
+{
+    // Solves with the epilogue settings of the solution, which may differ from
+    // the problem's, e.g. a solution with bias running a problem without.
+    std::vector<Tensile::KernelInvocation> solveGemm(Tensile::ContractionSolution const& solution,
+                                                     TensileDataGemm&                    data,
+                                                     Tensile::Hardware const&            hardware)
+    {
+        // Backup and restore settings
+        bool                    useBias          = data.problem.useBias();
+        Tensile::ActivationType actType          = data.problem.activationType();
+        bool                    useScaleAlphaVec = data.problem.useScaleAlphaVec();
+        bool                    useE             = data.problem.useE();
+        bool                    useGrad          = data.problem.useGradient();
+        data.problem.setUseBias(solution.problemType.useBias);
+        data.problem.setActivationType(solution.problemType.activationType);
+        data.problem.setUseScaleAlphaVec(solution.problemType.useScaleAlphaVec);
+        data.problem.setUseE(solution.problemType.useE);
+        data.problem.setUseGradient(solution.problemType.useGradient);
+        auto kernels = solution.solve(data.problem, data.inputs, hardware);
+        data.problem.setUseBias(useBias);
+        data.problem.setActivationType(actType);
+        data.problem.setUseScaleAlphaVec(useScaleAlphaVec);
+        data.problem.setUseE(useE);
+        data.problem.setUseGradient(useGrad);
+        return kernels;
+    }
+}
+
 rocblaslt_status makeArgument(rocblaslt_handle             handle,
                               const rocblaslt::RocGemmType gemmType,
                               const rocblaslt_matmul_algo& algo,
@@ -1430,8 +1680,7 @@ rocblaslt_status makeArgument(rocblaslt_handle             handle,
         std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
         std::shared_ptr<Tensile::Hardware>                                               hardware;
 
-        auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
-        hardware     = Tensile::hip::GetDevice(*deviceProp);
+        auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device, &hardware);
 
         int* solutionIndex = (int*)algo.data;
         if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
@@ -1443,24 +1692,7 @@ rocblaslt_status makeArgument(rocblaslt_handle             handle,
             auto solution   = library->getSolutionByIndex(data->problem, *hardware, *solutionIndex);
 
             data->inputs.ws = workspace;
-
-            // Backup and restore settings
-            bool                    useBias          = data->problem.useBias();
-            Tensile::ActivationType actType          = data->problem.activationType();
-            bool                    useScaleAlphaVec = data->problem.useScaleAlphaVec();
-            bool                    useE             = data->problem.useE();
-            bool                    useGrad          = data->problem.useGradient();
-            data->problem.setUseBias(solution->problemType.useBias);
-            data->problem.setActivationType(solution->problemType.activationType);
-            data->problem.setUseScaleAlphaVec(solution->problemType.useScaleAlphaVec);
-            data->problem.setUseE(solution->problemType.useE);
-            data->problem.setUseGradient(solution->problemType.useGradient);
-            data->kernels = solution->solve(data->problem, data->inputs, *hardware);
-            data->problem.setUseBias(useBias);
-            data->problem.setActivationType(actType);
-            data->problem.setUseScaleAlphaVec(useScaleAlphaVec);
-            data->problem.setUseE(useE);
-            data->problem.setUseGradient(useGrad);
+            data->kernels   = solveGemm(*solution, *data, *hardware);
         }
         else if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
         {
@@ -1498,23 +1730,15 @@ rocblaslt_status makeArgument(rocblaslt_handle             handle,
                         solution->problemType.useScaleAlphaVec);
                 }
 
-                size_t requiedHostSize
-                    = solution->requiredHostWorkspaceSizePerProblem * data->problem.gemms.size();
-                if(requiedHostSize > data->hipHostMemorySize)
-                {
-                    void* tmp = nullptr;
-                    static_cast<void>(hipHostMalloc(&tmp, requiedHostSize, 0));
-                    data->hipHostMemory
-                        = std::shared_ptr<void>(tmp, [](auto p) { static_cast<void>(hipFree(p)); });
-                    data->hipHostMemorySize = requiedHostSize;
-                }
-
-                data->kernels = solution->solveGroupedGemm(data->problem.gemms,
-                                                           data->inputs,
-                                                           *hardware,
-                                                           data->hipHostMemory.get(),
-                                                           data->hipHostMemorySize,
-                                                           stream);
+                // The arguments are staged in a pinned slot shared by all the
+                // grouped gemms on this device, which is only reused once the
+                // copy out of it has completed.
+                data->kernels = solution->solveGroupedGemm(
+                    data->problem.gemms,
+                    data->inputs,
+                    *hardware,
+                    Tensile::hip::ArgumentRing::ForDevice(handle->device),
+                    stream);
                 for(int i = 0; i < data->problem.gemms.size(); i++)
                 {
                     data->problem.gemms[i].setUseBias(useBias[i]);
@@ -1545,134 +1769,531 @@ rocblaslt_status makeArgument(rocblaslt_handle             handle,
     return status;
 }
 
-rocblaslt_status runKernelFromInvocation(rocblaslt_handle       handle,
-                                         rocblaslt::RocGemmType gemmType,
-                                         std::shared_ptr<void>  gemmData,
-                                         hipStream_t            stream)
+namespace
+{
+    // The inputs makeArgument created for problem with the pointers, alpha and
+    // beta replaced by the new ones.
+    Tensile::ContractionInputs updatedInputs(Tensile::ContractionProblemGemm const& problem,
+                                             Tensile::ContractionInputs const&      previous,
+                                             const rocblaslt::RocGemmInputs&        inputs)
+    {
+        Tensile::ContractionInputs next = previous;
+
+        next.a      = inputs.a;
+        next.b      = inputs.b;
+        next.c      = inputs.c;
+        next.d      = inputs.d;
+        next.scaleA = inputs.scaleA;
+        next.scaleB = inputs.scaleB;
+        next.scaleC = inputs.scaleC;
+        next.scaleD = inputs.scaleD;
+        // The epilogue decided which of these the problem uses when it was
+        // created, so only the pointers it kept are replaced.
+        if(next.e)
+            next.e = inputs.aux;
+        if(next.bias)
+            next.bias = inputs.bias;
+        if(next.scaleAlphaVec)
+            next.scaleAlphaVec = inputs.scaleAlphaVec;
+
+        // alpha and beta keep the type GetTensileInputs gave them.
+        bool zeroK = false;
+        for(size_t i = 0; i < problem.boundIndices().size(); i++)
+            zeroK = zeroK || problem.boundSize(i) == 0;
+        std::visit(
+            [&](auto value) {
+                next.alpha = zeroK ? decltype(value){}
+                                   : *static_cast<decltype(value) const*>(inputs.alpha);
+            },
+            previous.alpha);
+        std::visit(
+            [&](auto value) { next.beta = *static_cast<decltype(value) const*>(inputs.beta); },
+            previous.beta);
+
+        return next;
+    }
+}
+
+rocblaslt_status updateArgument(rocblaslt_handle                handle,
+                                const rocblaslt::RocGemmType    gemmType,
+                                const rocblaslt::RocGemmInputs& inputs,
+                                std::shared_ptr<void>           gemmData)
 {
+    if(gemmType != rocblaslt::RocGemmType::ROCBLASLT_GEMM)
+    {
+        log_error(__func__, "A grouped gemm takes the inputs of every gemm.");
+        return rocblaslt_status_invalid_value;
+    }
+
+    if(inputs.alpha == nullptr || inputs.beta == nullptr || inputs.a == nullptr
+       || inputs.b == nullptr || inputs.c == nullptr || inputs.d == nullptr)
+    {
+        log_error(__func__, "invalid data pointer");
+        return rocblaslt_status_invalid_pointer;
+    }
+
     rocblaslt_status status = rocblaslt_status_internal_error;
     try
     {
+        std::shared_ptr<TensileDataGemm> data = std::static_pointer_cast<TensileDataGemm>(gemmData);
+        if(data->kernels.empty())
+        {
+            log_error(__func__, "Arguments are not created, call makeArgument first.");
+            return rocblaslt_status_not_initialized;
+        }
+
+        Tensile::ContractionInputs next = updatedInputs(data->problem, data->inputs, inputs);
+
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
         std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
         std::shared_ptr<Tensile::Hardware>                                               hardware;
 
-        auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
-
-        if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
+        auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device, &hardware);
+        auto solution = library->getSolutionByIndex(data->problem, *hardware, data->algoIndex);
+        if(!solution)
         {
-            std::shared_ptr<TensileDataGemm> data
-                = std::static_pointer_cast<TensileDataGemm>(gemmData);
-            static_cast<void>(adapter->launchKernels(data->kernels, stream, nullptr, nullptr));
+            log_error(__func__, "solution not found", data->algoIndex);
+            return rocblaslt_status_invalid_value;
         }
-        else if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
+
+        // Patch the existing kernel arguments in place when the new inputs
+        // allow it, otherwise build them again as makeArgument does.
+        if(!solution->updateInputs(data->kernels, data->problem, data->inputs, next))
         {
-            std::shared_ptr<TensileDataGroupedGemm> data
-                = std::static_pointer_cast<TensileDataGroupedGemm>(gemmData);
-            if(data->useUserArgs)
+            auto previous = std::move(data->inputs);
+            data->inputs  = next;
+            try
             {
-                log_error(__func__,
-                          "GG is initialized with useUserArgs = true, workspace has no arguments.");
-                return rocblaslt_status_not_initialized;
+                data->kernels = solveGemm(*solution, *data, *hardware);
+            }
+            catch(...)
+            {
+                data->inputs = std::move(previous);
+                throw;
             }
-            static_cast<void>(adapter->launchKernels(data->kernels, stream, nullptr, nullptr));
         }
         else
         {
-            return rocblaslt_status_invalid_value;
+            data->inputs = next;
         }
 
         status = rocblaslt_status_success;
     }
     catch(const std::exception& e)
     {
-#if 0
-        std::ostream msg;
-        print_once(msg << "\nrocblaslt error: " << (solution ? "" : "No ")
-                       << "Tensile solution found, but exception thrown for " << prob << e.what());
-#endif
+        log_error(__func__, e.what());
     }
     catch(...)
     {
-#if 0
-        std::ostream msg;
-        print_once(msg << "\nrocblaslt error: " << (solution ? "" : "No ")
-                       << "Tensile solution found, but unknown exception thrown for " << prob);
-#endif
+        log_error(__func__, "Unknown exception while updating the inputs.");
     }
 
     return status;
 }
 
-rocblaslt_status getDeviceUserArgumentsValuesFromContractionProblem(rocblaslt_handle       handle,
-                                                                    rocblaslt::RocGemmType gemmType,
-                                                                    std::shared_ptr<void>  gemmData,
-                                                                    void* hostDeviceUserArgs)
+rocblaslt_status updateArgument(rocblaslt_handle                             handle,
+                                const rocblaslt::RocGemmType                 gemmType,
+                                const std::vector<rocblaslt::RocGemmInputs>& inputs,
+                                hipStream_t                                  stream,
+                                std::shared_ptr<void>                        gemmData,
+                                size_t*                                      updatedCount)
 {
+    if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
+    {
+        if(inputs.size() != 1)
+        {
+            log_error(__func__, "A gemm takes exactly one set of inputs.");
+            return rocblaslt_status_invalid_value;
+        }
+
+        auto status = updateArgument(handle, gemmType, inputs[0], gemmData);
+        if(status == rocblaslt_status_success && updatedCount)
+            *updatedCount = 1;
+        return status;
+    }
+
+    for(auto const& input : inputs)
+    {
+        if(input.alpha == nullptr || input.beta == nullptr || input.a == nullptr
+           || input.b == nullptr || input.c == nullptr || input.d == nullptr)
+        {
+            log_error(__func__, "invalid data pointer");
+            return rocblaslt_status_invalid_pointer;
+        }
+    }
+
     rocblaslt_status status = rocblaslt_status_internal_error;
     try
     {
+        std::shared_ptr<TensileDataGroupedGemm> data
+            = std::static_pointer_cast<TensileDataGroupedGemm>(gemmData);
+        if(data->kernels.empty())
+        {
+            log_error(__func__, "Arguments are not created, call makeArgument first.");
+            return rocblaslt_status_not_initialized;
+        }
+        if(data->useUserArgs)
+        {
+            log_error(__func__,
+                      "GG is initialized with useUserArgs = true, update the user arguments.");
+            return rocblaslt_status_invalid_value;
+        }
+        if(inputs.size() != data->problem.gemms.size())
+        {
+            log_error(__func__, "The number of inputs does not match the gemm count.");
+            return rocblaslt_status_invalid_value;
+        }
+
+        Tensile::ContractionGroupedInputs next = data->inputs;
+        for(size_t i = 0; i < inputs.size(); i++)
+            next.grouped[i]
+                = updatedInputs(data->problem.gemms[i], data->inputs.grouped[i], inputs[i]);
+
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
         std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
         std::shared_ptr<Tensile::Hardware>                                               hardware;
 
-        auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
+        auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device, &hardware);
+        auto solution
+            = library->getSolutionByIndex(data->problem.gemms[0], *hardware, data->algoIndex);
+        if(!solution)
+        {
+            log_error(__func__, "solution not found", data->algoIndex);
+            return rocblaslt_status_invalid_value;
+        }
 
-        if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
+        // The arguments were encoded with the epilogue of the solution, as in
+        // makeArgument.
+        auto& gemms = data->problem.gemms;
+        std::vector<bool>                    useBias, useScaleAlphaVec;
+        std::vector<Tensile::ActivationType> actType;
+        for(auto& gemm : gemms)
         {
-            std::shared_ptr<TensileDataGroupedGemm> data
-                = std::static_pointer_cast<TensileDataGroupedGemm>(gemmData);
-            auto  solution = library->getSolutionByIndex(data->algoIndex);
-            auto& problem  = data->problem.gemms[0];
-            if(problem.activationComputeType() == Tensile::DataType::Float)
+            useBias.push_back(gemm.useBias());
+            actType.push_back(gemm.activationType());
+            useScaleAlphaVec.push_back(gemm.useScaleAlphaVec());
+            gemm.setUseBias(solution->problemType.useBias);
+            gemm.setActivationType(solution->problemType.activationType);
+            gemm.setUseScaleAlphaVec(solution->problemType.useScaleAlphaVec);
+        }
+        auto restore = [&]() {
+            for(size_t i = 0; i < gemms.size(); i++)
             {
-                setDeviceUserArgs(data->problem.gemms,
-                                  data->inputs,
-                                  (Tensile::DeviceUserArguments<float>*)hostDeviceUserArgs);
+                gemms[i].setUseBias(useBias[i]);
+                gemms[i].setActivationType(actType[i]);
+                gemms[i].setUseScaleAlphaVec(useScaleAlphaVec[i]);
+            }
+        };
+
+        try
+        {
+            // Only the entries of the gemms whose inputs changed are encoded
+            // and copied to the workspace again, unless the new inputs need
+            // other kernels.
+            auto&               ring = Tensile::hip::ArgumentRing::ForDevice(handle->device);
+            std::vector<size_t> updated;
+            if(solution->updateGroupedGemmInputs(gemms, data->inputs, next, ring, stream, updated))
+            {
+                if(updatedCount)
+                    *updatedCount = updated.size();
             }
             else
             {
-                throw std::runtime_error("Currently only supports DeviceUserArguments<float>");
+                data->kernels = solution->solveGroupedGemm(gemms, next, *hardware, ring, stream);
+                if(updatedCount)
+                    *updatedCount = gemms.size();
             }
         }
-        else
+        catch(...)
         {
-            return rocblaslt_status_not_implemented;
+            restore();
+            throw;
         }
-        status = rocblaslt_status_success;
+        restore();
+
+        data->inputs = next;
+        status       = rocblaslt_status_success;
     }
     catch(const std::exception& e)
     {
-#if 0
-        std::ostream msg;
-        print_once(msg << "\nrocblaslt error: "
-                       << "Is hostDeviceUserArgs not match the size of the problem type? " << prob << e.what());
-#endif
+        log_error(__func__, e.what());
     }
     catch(...)
     {
-#if 0
-        std::ostream msg;
-        print_once(msg << "\nrocblaslt error: "
-                       << "Is hostDeviceUserArgs not match the size of the problem type? " << prob);
-#endif
+        log_error(__func__, "Unknown exception while updating the inputs.");
     }
 
     return status;
 }
 
-rocblaslt_status runKernelFromNewDeviceUserArguments(rocblaslt_handle       handle,
-                                                     rocblaslt::RocGemmType gemmType,
-                                                     std::shared_ptr<void>  gemmData,
-                                                     void*                  deviceUserArgs,
-                                                     hipStream_t            stream)
+rocblaslt_status launchPlanAppend(rocblaslt_handle             handle,
+                                  const rocblaslt::RocGemmType gemmType,
+                                  std::shared_ptr<void>        gemmData,
+                                  std::shared_ptr<void>&       planData,
+                                  size_t&                      index)
 {
     rocblaslt_status status = rocblaslt_status_internal_error;
     try
     {
-        std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
-        std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
-        std::shared_ptr<Tensile::Hardware>                                               hardware;
+        std::vector<Tensile::KernelInvocation>* kernels = nullptr;
+        if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
+        {
+            kernels = &std::static_pointer_cast<TensileDataGemm>(gemmData)->kernels;
+        }
+        else if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
+        {
+            auto data = std::static_pointer_cast<TensileDataGroupedGemm>(gemmData);
+            if(data->useUserArgs)
+            {
+                log_error(__func__,
+                          "GG is initialized with useUserArgs = true, workspace has no arguments.");
+                return rocblaslt_status_not_initialized;
+            }
+            kernels = &data->kernels;
+        }
+        else
+        {
+            return rocblaslt_status_invalid_value;
+        }
+
+        if(kernels->empty())
+        {
+            log_error(__func__, "Arguments are not created, call makeArgument first.");
+            return rocblaslt_status_not_initialized;
+        }
+
+        if(!planData)
+            planData = std::static_pointer_cast<void>(std::make_shared<TensileLaunchPlan>());
+        auto plan = std::static_pointer_cast<TensileLaunchPlan>(planData);
+
+        // Functions are resolved for one device, so a plan cannot mix them.
+        if(plan->device == -1)
+            plan->device = handle->device;
+        else if(plan->device != handle->device)
+        {
+            log_error(__func__, "All the instances of a launch plan must use the same device.");
+            return rocblaslt_status_invalid_value;
+        }
+
+        auto adapter = get_library_and_adapter(nullptr, nullptr, handle->device);
+        index        = plan->plan.append(*adapter, *kernels);
+        plan->entries.push_back({gemmType, gemmData});
+
+        status = rocblaslt_status_success;
+    }
+    catch(const std::exception& e)
+    {
+        log_error(__func__, e.what());
+    }
+    catch(...)
+    {
+        log_error(__func__, "Unknown exception while recording the launch plan.");
+    }
+
+    return status;
+}
+
+rocblaslt_status launchPlanUpdateInputs(rocblaslt_handle                handle,
+                                        std::shared_ptr<void>           planData,
+                                        size_t                          index,
+                                        const rocblaslt::RocGemmInputs& inputs)
+{
+    if(!planData)
+        return rocblaslt_status_not_initialized;
+
+    auto plan = std::static_pointer_cast<TensileLaunchPlan>(planData);
+    if(index >= plan->entries.size())
+        return rocblaslt_status_invalid_value;
+
+    auto& entry  = plan->entries[index];
+    auto  status = updateArgument(handle, entry.gemmType, inputs, entry.gemmData);
+    if(status != rocblaslt_status_success)
+        return status;
+
+    try
+    {
+        // The instance was patched in place; copy its arguments into the plan.
+        auto data    = std::static_pointer_cast<TensileDataGemm>(entry.gemmData);
+        auto adapter = get_library_and_adapter(nullptr, nullptr, plan->device);
+        plan->plan.replace(index, *adapter, data->kernels);
+    }
+    catch(const std::exception& e)
+    {
+        log_error(__func__, e.what());
+        return rocblaslt_status_internal_error;
+    }
+
+    return rocblaslt_status_success;
+}
+
+rocblaslt_status launchPlanRun(std::shared_ptr<void> planData, bool useGraph, hipStream_t stream)
+{
+    if(!planData)
+        return rocblaslt_status_not_initialized;
+
+    auto       plan = std::static_pointer_cast<TensileLaunchPlan>(planData);
+    hipError_t err  = useGraph ? plan->plan.launchGraph(stream) : plan->plan.launch(stream);
+    if(err != hipSuccess)
+    {
+        log_error(__func__, hipGetErrorString(err));
+        return useGraph && stream == nullptr ? rocblaslt_status_invalid_value
+                                             : rocblaslt_status_internal_error;
+    }
+
+    if(benchLogEnabled())
+    {
+        for(auto const& entry : plan->entries)
+        {
+            if(entry.gemmType == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
+            {
+                auto& data = *std::static_pointer_cast<TensileDataGemm>(entry.gemmData);
+                logBench("hipblaslt_ext::LaunchPlan::run", data, data.inputs, data.algoIndex, true);
+            }
+            else
+            {
+                auto& data = *std::static_pointer_cast<TensileDataGroupedGemm>(entry.gemmData);
+                logBench("hipblaslt_ext::LaunchPlan::run", data, data.algoIndex);
+            }
+        }
+    }
+
+    return rocblaslt_status_success;
+}
+
+rocblaslt_status runKernelFromInvocation(rocblaslt_handle       handle,
+                                         rocblaslt::RocGemmType gemmType,
+                                         std::shared_ptr<void>  gemmData,
+                                         hipStream_t            stream)
+{
+    rocblaslt_status status = rocblaslt_status_internal_error;
+    try
+    {
+        std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
+        std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
+        std::shared_ptr<Tensile::Hardware>                                               hardware;
+
+        auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
+
+        if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
+        {
+            std::shared_ptr<TensileDataGemm> data
+                = std::static_pointer_cast<TensileDataGemm>(gemmData);
+            static_cast<void>(adapter->launchKernels(data->kernels, stream, nullptr, nullptr));
+
+            if(benchLogEnabled())
+                logBench("hipblaslt_ext::Gemm::run", *data, data->inputs, data->algoIndex, true);
+        }
+        else if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
+        {
+            std::shared_ptr<TensileDataGroupedGemm> data
+                = std::static_pointer_cast<TensileDataGroupedGemm>(gemmData);
+            if(data->useUserArgs)
+            {
+                log_error(__func__,
+                          "GG is initialized with useUserArgs = true, workspace has no arguments.");
+                return rocblaslt_status_not_initialized;
+            }
+            static_cast<void>(adapter->launchKernels(data->kernels, stream, nullptr, nullptr));
+
+            if(benchLogEnabled())
+                logBench("hipblaslt_ext::GroupedGemm::run", *data, data->algoIndex);
+        }
+        else
+        {
+            return rocblaslt_status_invalid_value;
+        }
+
+        status = rocblaslt_status_success;
+    }
+    catch(const std::exception& e)
+    {
+#if 0
+        std::ostream msg;
+        print_once(msg << "\nrocblaslt error: " << (solution ? "" : "No ")
+                       << "Tensile solution found, but exception thrown for " << prob << e.what());
+#endif
+    }
+    catch(...)
+    {
+#if 0
+        std::ostream msg;
+        print_once(msg << "\nrocblaslt error: " << (solution ? "" : "No ")
+                       << "Tensile solution found, but unknown exception thrown for " << prob);
+#endif
+    }
+
+    return status;
+}
+
+rocblaslt_status getDeviceUserArgumentsValuesFromContractionProblem(rocblaslt_handle       handle,
+                                                                    rocblaslt::RocGemmType gemmType,
+                                                                    std::shared_ptr<void>  gemmData,
+                                                                    void* hostDeviceUserArgs)
+{
+    rocblaslt_status status = rocblaslt_status_internal_error;
+    try
+    {
+        std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
+        std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
+        std::shared_ptr<Tensile::Hardware>                                               hardware;
+
+        auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
+
+        if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
+        {
+            std::shared_ptr<TensileDataGroupedGemm> data
+                = std::static_pointer_cast<TensileDataGroupedGemm>(gemmData);
+            auto  solution = library->getSolutionByIndex(data->algoIndex);
+            auto& problem  = data->problem.gemms[0];
+            if(problem.activationComputeType() == Tensile::DataType::Float)
+            {
+                setDeviceUserArgs(data->problem.gemms,
+                                  data->inputs,
+                                  (Tensile::DeviceUserArguments<float>*)hostDeviceUserArgs);
+            }
+            else
+            {
+                throw std::runtime_error("Currently only supports DeviceUserArguments<float>");
+            }
+        }
+        else
+        {
+            return rocblaslt_status_not_implemented;
+        }
+        status = rocblaslt_status_success;
+    }
+    catch(const std::exception& e)
+    {
+#if 0
+        std::ostream msg;
+        print_once(msg << "\nrocblaslt error: "
+                       << "Is hostDeviceUserArgs not match the size of the problem type? " << prob << e.what());
+#endif
+    }
+    catch(...)
+    {
+#if 0
+        std::ostream msg;
+        print_once(msg << "\nrocblaslt error: "
+                       << "Is hostDeviceUserArgs not match the size of the problem type? " << prob);
+#endif
+    }
+
+    return status;
+}
+
+rocblaslt_status runKernelFromNewDeviceUserArguments(rocblaslt_handle       handle,
+                                                     rocblaslt::RocGemmType gemmType,
+                                                     std::shared_ptr<void>  gemmData,
+                                                     void*                  deviceUserArgs,
+                                                     hipStream_t            stream)
+{
+    rocblaslt_status status = rocblaslt_status_internal_error;
+    try
+    {
+        std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
+        std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
+        std::shared_ptr<Tensile::Hardware>                                               hardware;
 
         auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
 
@@ -1686,6 +2307,10 @@ rocblaslt_status runKernelFromNewDeviceUserArguments(rocblaslt_handle       hand
                 memcpy(arg + 4, &deviceUserArgs, sizeof(void*));
             }
             static_cast<void>(adapter->launchKernels(data->kernels, stream, nullptr, nullptr));
+
+            // Sizes and scalars in the device arguments are not known here.
+            if(benchLogEnabled())
+                logBench("hipblaslt_ext::GroupedGemm::run", *data, data->algoIndex);
         }
         else
         {
@@ -1742,6 +2367,10 @@ rocblaslt_status runKernelFromDeviceUserArguments(rocblaslt_handle             h
             auto kernel = solution->solveGroupedGemmGPU(
                 data->problem.gemms, data->inputs, deviceUserArgs, workspace, stream);
             static_cast<void>(adapter->launchKernels(kernel, stream, nullptr, nullptr));
+
+            // Sizes and scalars in the device arguments are not known here.
+            if(benchLogEnabled())
+                logBench("hipblaslt_ext::GroupedGemm::run", *data, *solutionIndex);
         }
         else
         {
@@ -1775,6 +2404,49 @@ rocblaslt_status runKernelFromDeviceUserArguments(rocblaslt_handle             h
  * rocblaslt_matmul_heuristic_result.                                         *
  ******************************************************************************/
 
+namespace
+{
+    // Puts the limits of a heuristic query on a problem while it is searched,
+    // so that the library skips solutions that break them. The previous values
+    // are restored afterwards so that they do not carry over to running the
+    // problem.
+    class SearchLimitsScope
+    {
+    public:
+        SearchLimitsScope(Tensile::ContractionProblemGemm&      problem,
+                          const rocblaslt_matmul_search_limits& limits)
+            : m_problem(problem)
+            , m_maxGlobalSplitU(problem.maxGlobalSplitU())
+            , m_deterministicMode(problem.deterministicMode())
+        {
+            using TENSOR = Tensile::ContractionProblemGemm::TENSOR;
+            for(auto tensor : {TENSOR::A, TENSOR::B, TENSOR::C, TENSOR::D})
+            {
+                m_minAlignmentBytes[tensor] = problem.minAlignmentBytes(tensor);
+                problem.setMinAlignmentBytes(tensor, limits.min_alignment_bytes[tensor]);
+            }
+            if(limits.max_gsu > 0)
+                problem.setMaxGlobalSplitU(limits.max_gsu);
+            problem.setDeterministicMode(limits.deterministic);
+        }
+
+        ~SearchLimitsScope()
+        {
+            using TENSOR = Tensile::ContractionProblemGemm::TENSOR;
+            for(auto tensor : {TENSOR::A, TENSOR::B, TENSOR::C, TENSOR::D})
+                m_problem.setMinAlignmentBytes(tensor, m_minAlignmentBytes[tensor]);
+            m_problem.setMaxGlobalSplitU(m_maxGlobalSplitU);
+            m_problem.setDeterministicMode(m_deterministicMode);
+        }
+
+    private:
+        Tensile::ContractionProblemGemm& m_problem;
+        std::array<size_t, 4>            m_minAlignmentBytes;
+        size_t                           m_maxGlobalSplitU;
+        bool                             m_deterministicMode;
+    };
+}
+
 void _convertToHeuristicResultArray(
     std::vector<std::shared_ptr<Tensile::ContractionSolution>>& solutions,
     int                                                         requestedAlgoCount,
@@ -1855,27 +2527,166 @@ inline auto getSolutions(
     return solutions;
 }
 
+namespace
+{
+    // Solutions found ahead of time for the problems of heuristic queries,
+    // see exportHeuristicPlan() and loadHeuristicPlan().
+    struct HeuristicPlan
+    {
+        struct Entry
+        {
+            int                                            requestedAlgoCount = 0;
+            std::vector<rocblaslt_matmul_heuristic_result> results;
+        };
+
+        std::string                         arch;
+        int                                 computeUnitCount = 0;
+        std::string                         libraryVersion;
+        std::unordered_map<uint64_t, Entry> entries;
+    };
+
+    constexpr char HeuristicPlanMagic[] = "hipblaslt-heuristic-plan 1";
+
+    // Whether getSolutions() may put the original kernels first for inputs
+    template <typename T>
+    bool fallbackInputs(const T& inputs)
+    {
+        if constexpr(std::is_same<T, Tensile::ContractionInputs>::value)
+            return inputs.scaleAlphaVec == nullptr && inputs.bias == nullptr
+                   && inputs.e == nullptr;
+        else
+            return inputs.scaleAlphaVec == nullptr && inputs.bias == nullptr
+                   && inputs.E == nullptr;
+    }
+
+    // Identifies a problem in a heuristic plan, once its workspace size and
+    // search limits are set. It covers what sameSolutions() compares.
+    uint64_t planKey(Tensile::ContractionProblemGemm const& problem, bool fallback)
+    {
+        return Tensile::hash_combine(problem.fingerprint(),
+                                     problem.activationEnumArg(),
+                                     problem.cEqualsD(),
+                                     problem.biasType(),
+                                     problem.alphaRestriction(),
+                                     problem.betaRestriction(),
+                                     problem.sparseA(),
+                                     fallback);
+    }
+
+    std::string planArch(rocblaslt_handle handle)
+    {
+        std::string gcnArchName(handle->properties.gcnArchName);
+        return gcnArchName.substr(0, gcnArchName.find(':'));
+    }
+
+    // Whether a planned solution is one the search could have returned for
+    // problem. A fallback solution is checked without the epilogue features
+    // that getSolutions() drops for it.
+    bool plannedSolutionFits(
+        Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm> const& library,
+        Tensile::Hardware const&                                               hardware,
+        Tensile::ContractionProblemGemm const&                                 problem,
+        rocblaslt_matmul_heuristic_result const&                               result)
+    {
+        auto solution = library.getSolutionByIndex(*(const int*)result.algo.data);
+        if(!solution || !(*solution->hardwarePredicate)(hardware))
+            return false;
+
+        if(!result.algo.fallback)
+            return (*solution->problemPredicate)(problem)
+                   && solution->fitsSelectionLimits(problem);
+
+        Tensile::ContractionProblemGemm original = problem;
+        original.setUseBias(false);
+        original.setActivationType(Tensile::ActivationType::None);
+        original.setUseScaleAlphaVec(false);
+        original.setUseE(false);
+        return (*solution->problemPredicate)(original) && solution->fitsSelectionLimits(original);
+    }
+
+    // Fills heuristicResultsArray from the plan loaded into handle, if it
+    // holds at least requestedAlgoCount solutions for problem or all that
+    // were found.
+    bool findInHeuristicPlan(
+        rocblaslt_handle                                                       handle,
+        Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm> const& library,
+        Tensile::Hardware const&                                               hardware,
+        Tensile::ContractionProblemGemm const&                                 problem,
+        bool                                                                   fallback,
+        int                                                                    requestedAlgoCount,
+        rocblaslt_matmul_heuristic_result heuristicResultsArray[],
+        int*                              returnAlgoCount,
+        size_t                            maxWorkSpaceBytes)
+    {
+        auto plan = std::static_pointer_cast<HeuristicPlan const>(handle->heuristic_plan);
+        if(!plan)
+            return false;
+
+        auto it = plan->entries.find(planKey(problem, fallback));
+        if(it == plan->entries.end())
+            return false;
+
+        auto const& entry = it->second;
+        if(requestedAlgoCount > entry.requestedAlgoCount
+           && static_cast<int>(entry.results.size()) >= entry.requestedAlgoCount)
+            return false;
+
+        // The key is only a hash of the problem, so a colliding problem falls
+        // back to the search rather than get solutions that do not apply to it.
+        for(auto const& result : entry.results)
+            if(!plannedSolutionFits(library, hardware, problem, result))
+            {
+                log_api(__func__, "planned algos do not fit the problem");
+                return false;
+            }
+
+        *returnAlgoCount = std::min<int>(requestedAlgoCount, entry.results.size());
+        for(int i = 0; i < *returnAlgoCount; i++)
+        {
+            heuristicResultsArray[i]                          = entry.results[i];
+            heuristicResultsArray[i].algo.max_workspace_bytes = maxWorkSpaceBytes;
+        }
+        for(int i = *returnAlgoCount; i < requestedAlgoCount; i++)
+            heuristicResultsArray[i].state = rocblaslt_status_invalid_value;
+
+        log_api(__func__, "planned algos", *returnAlgoCount);
+        return true;
+    }
+} // namespace
+
 template <typename TiA, typename TiB, typename To, typename Tc>
 rocblaslt_status getBestSolutions(RocblasltContractionProblem<TiA, TiB, To, Tc> prob,
                                   rocblaslt_handle                              handle,
                                   std::shared_ptr<void>                         gemmData,
                                   int                                           requestedAlgoCount,
-                                  rocblaslt_matmul_heuristic_result heuristicResultsArray[],
-                                  int*                              returnAlgoCount,
-                                  size_t                            maxWorkSpaceBytes)
+                                  rocblaslt_matmul_heuristic_result     heuristicResultsArray[],
+                                  int*                                  returnAlgoCount,
+                                  size_t                                maxWorkSpaceBytes,
+                                  const rocblaslt_matmul_search_limits& limits)
 {
     std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
     std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
     std::shared_ptr<Tensile::Hardware>                                               hardware;
 
     // auto &adapter =
-    static_cast<void>(get_library_and_adapter(&library, &deviceProp, handle->device));
-
-    hardware = Tensile::hip::GetDevice(*deviceProp);
+    static_cast<void>(get_library_and_adapter(&library, &deviceProp, handle->device, &hardware));
 
     std::shared_ptr<TensileDataGemm> data = std::static_pointer_cast<TensileDataGemm>(gemmData);
     updateTensileProblem(false, prob, data->problem);
 
+    SearchLimitsScope scope(data->problem, limits);
+
+    if(findInHeuristicPlan(handle,
+                           *library,
+                           *hardware,
+                           data->problem,
+                           fallbackInputs(prob),
+                           requestedAlgoCount,
+                           heuristicResultsArray,
+                           returnAlgoCount,
+                           maxWorkSpaceBytes))
+        return rocblaslt_status_success;
+
     int  fallbackSize = 0;
     auto solutions
         = getSolutions(prob, library, hardware, data->problem, requestedAlgoCount, fallbackSize);
@@ -1913,9 +2724,7 @@ rocblaslt_status getAllSolutions(MyProblem&
     std::shared_ptr<Tensile::Hardware>                                               hardware;
 
     // auto &adapter =
-    static_cast<void>(get_library_and_adapter(&library, &deviceProp, handle->device));
-
-    hardware = Tensile::hip::GetDevice(*deviceProp);
+    static_cast<void>(get_library_and_adapter(&library, &deviceProp, handle->device, &hardware));
 
     std::set<std::shared_ptr<Tensile::ContractionSolution>> solutions;
     std::shared_ptr<void>                                   tensile_prob;
@@ -2002,8 +2811,7 @@ rocblaslt_status
     std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
     std::shared_ptr<Tensile::Hardware>                                               hardware;
 
-    auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
-    hardware     = Tensile::hip::GetDevice(*deviceProp);
+    auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device, &hardware);
 
     int i = 0;
     for(auto index : solutionIndex)
@@ -2038,8 +2846,7 @@ rocblaslt_status isSolutionSupported(rocblaslt_handle       handle,
     std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
     std::shared_ptr<Tensile::Hardware>                                               hardware;
 
-    auto adapter          = get_library_and_adapter(&library, &deviceProp, handle->device);
-    hardware              = Tensile::hip::GetDevice(*deviceProp);
+    auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device, &hardware);
     *workspaceSizeInBytes = 0;
 
     int* solutionIndex = (int*)algo->data;
@@ -2259,11 +3066,67 @@ rocblaslt_status isSolutionSupported(rocblaslt_handle              handle,
     return rocblaslt_status_not_implemented;
 }
 
-rocblaslt_status getBestSolutions(rocblaslt_handle       handle,
-                                  rocblaslt::RocGemmType gemmType,
-                                  std::shared_ptr<void>  gemmData,
-                                  const int              workspaceBytes,
-                                  const int              requestedAlgoCount,
+// Finds the solutions for the problem and inputs held by data
+inline void findBestSolutions(
+    rocblaslt_handle                                                                        handle,
+    TensileDataGemm&                                                                        data,
+    const std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>>& library,
+    const std::shared_ptr<Tensile::Hardware>&       hardware,
+    size_t                                          workspaceBytes,
+    const rocblaslt_matmul_search_limits&           limits,
+    int                                             requestedAlgoCount,
+    std::vector<rocblaslt_matmul_heuristic_result>& heuristicResults)
+{
+    data.problem.setWorkspaceSize(workspaceBytes);
+    SearchLimitsScope scope(data.problem, limits);
+
+    int planned = 0;
+    heuristicResults.resize(requestedAlgoCount);
+    if(findInHeuristicPlan(handle,
+                           *library,
+                           *hardware,
+                           data.problem,
+                           fallbackInputs(data.inputs),
+                           requestedAlgoCount,
+                           heuristicResults.data(),
+                           &planned,
+                           workspaceBytes))
+    {
+        heuristicResults.resize(planned);
+        return;
+    }
+
+    int  fallbackSize = 0;
+    auto solutions    = getSolutions(
+        data.inputs, library, hardware, data.problem, requestedAlgoCount, fallbackSize);
+
+    // when there is no solution for xfloat32, fallback comput_type to fp32
+    if(solutions.size() == 0 && data.problem.f32XdlMathOp() == Tensile::DataType::XFloat32)
+    {
+        data.problem.setF32XdlMathOp(Tensile::DataType::Float);
+        solutions = getSolutions(
+            data.inputs, library, hardware, data.problem, requestedAlgoCount, fallbackSize);
+    }
+
+    auto algoCount       = min(requestedAlgoCount, solutions.size());
+    int  returnAlgoCount = 0;
+    heuristicResults.clear();
+    heuristicResults.resize(algoCount);
+    _convertToHeuristicResultArray(solutions,
+                                   algoCount,
+                                   heuristicResults.data(),
+                                   &returnAlgoCount,
+                                   workspaceBytes,
+                                   data.problem,
+                                   fallbackSize);
+}
+
+rocblaslt_status getBestSolutions(rocblaslt_handle                      handle,
+                                  rocblaslt::RocGemmType                gemmType,
+                                  std::shared_ptr<void>                 gemmData,
+                                  const int                             workspaceBytes,
+                                  const rocblaslt_matmul_search_limits& limits,
+                                  const int                             requestedAlgoCount,
                                   std::vector<rocblaslt_matmul_heuristic_result>& heuristicResults)
 {
     std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
@@ -2271,44 +3134,29 @@ rocblaslt_status getBestSolutions(rocblaslt_handle       handle,
     std::shared_ptr<Tensile::Hardware>                                               hardware;
 
     // auto &adapter =
-    static_cast<void>(get_library_and_adapter(&library, &deviceProp, handle->device));
-
-    hardware = Tensile::hip::GetDevice(*deviceProp);
+    static_cast<void>(get_library_and_adapter(&library, &deviceProp, handle->device, &hardware));
 
     if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
     {
         std::shared_ptr<TensileDataGemm> data = std::static_pointer_cast<TensileDataGemm>(gemmData);
-        int                              fallbackSize = 0;
-        auto                             solutions    = getSolutions(
-            data->inputs, library, hardware, data->problem, requestedAlgoCount, fallbackSize);
-
-        // when there is no solution for xfloat32, fallback comput_type to fp32
-        if(solutions.size() == 0 && data->problem.f32XdlMathOp() == Tensile::DataType::XFloat32)
-        {
-            data->problem.setF32XdlMathOp(Tensile::DataType::Float);
-            solutions = getSolutions(
-                data->inputs, library, hardware, data->problem, requestedAlgoCount, fallbackSize);
-        }
-
-        auto algoCount       = min(requestedAlgoCount, solutions.size());
-        int  returnAlgoCount = 0;
-        heuristicResults.clear();
-        heuristicResults.resize(algoCount);
-        _convertToHeuristicResultArray(solutions,
-                                       algoCount,
-                                       heuristicResults.data(),
-                                       &returnAlgoCount,
-                                       workspaceBytes,
-                                       data->problem,
-                                       fallbackSize);
+        findBestSolutions(handle,
+                          *data,
+                          library,
+                          hardware,
+                          workspaceBytes,
+                          limits,
+                          requestedAlgoCount,
+                          heuristicResults);
     }
     else if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
     {
         std::shared_ptr<TensileDataGroupedGemm> data
             = std::static_pointer_cast<TensileDataGroupedGemm>(gemmData);
+        std::vector<std::unique_ptr<SearchLimitsScope>> scopes;
         for(int i = 0; i < data->problem.gemms.size(); i++)
         {
             data->problem.gemms[i].setWorkspaceSize(workspaceBytes);
+            scopes.push_back(std::make_unique<SearchLimitsScope>(data->problem.gemms[i], limits));
         }
 
         // Fallback to original kernels
@@ -2367,6 +3215,446 @@ rocblaslt_status getBestSolutions(rocblaslt_handle       handle,
 
     return rocblaslt_status_success;
 }
+
+template <typename TiA, typename TiB, typename To, typename Tc>
+rocblaslt_status prepareHeuristicQuery(const RocblasltContractionProblem<TiA, TiB, To, Tc>& prob,
+                                       const std::shared_ptr<void>& gemmData,
+                                       std::shared_ptr<void>&       queryData)
+{
+    // getBestSolutions updates the descriptor's problem in place, so the query
+    // starts from a copy of it to get the same solutions.
+    auto data     = std::make_shared<TensileDataGemm>();
+    data->problem = std::static_pointer_cast<TensileDataGemm>(gemmData)->problem;
+    updateTensileProblem(false, prob, data->problem);
+    data->inputs = GetTensileInputs(prob);
+
+    queryData = std::static_pointer_cast<void>(data);
+    return rocblaslt_status_success;
+}
+
+namespace
+{
+    // Shared by all handles; selection is CPU bound, so use every core.
+    rocblaslt::ThreadPool& get_heuristic_pool()
+    {
+        static rocblaslt::ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+        return pool;
+    }
+
+    // Whether two queries are bound to get the same solutions: their Tensile
+    // problems compare equal the way the solution caches compare them, and
+    // they agree on everything else that the solution predicates and the
+    // fallback list of getSolutions look at.
+    bool sameSolutions(TensileDataGemm const& lhs, TensileDataGemm const& rhs)
+    {
+        auto const& a = lhs.problem;
+        auto const& b = rhs.problem;
+
+        auto fallback = [](TensileDataGemm const& data) {
+            return data.inputs.scaleAlphaVec == nullptr && data.inputs.bias == nullptr
+                   && data.inputs.e == nullptr;
+        };
+
+        return a == b && a.activationEnumArg() == b.activationEnumArg()
+               && a.cEqualsD() == b.cEqualsD() && a.biasType() == b.biasType()
+               && a.alphaRestriction() == b.alphaRestriction()
+               && a.betaRestriction() == b.betaRestriction() && a.sparseA() == b.sparseA()
+               && fallback(lhs) == fallback(rhs);
+    }
+} // namespace
+
+rocblaslt_status getBestSolutionsBatched(
+    rocblaslt_handle                                             handle,
+    const std::vector<std::shared_ptr<void>>&                    queryData,
+    int                                                          requestedAlgoCount,
+    size_t                                                       maxWorkSpaceBytes,
+    const rocblaslt_matmul_search_limits&                        limits,
+    std::vector<std::vector<rocblaslt_matmul_heuristic_result>>& heuristicResults)
+{
+    std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
+    std::shared_ptr<Tensile::Hardware>                                               hardware;
+
+    if(!get_library_and_adapter(&library, nullptr, handle->device, &hardware) || !library)
+        return rocblaslt_status_internal_error;
+
+    // Each distinct query is searched once, and the others copy its results.
+    std::vector<size_t>                             distinct(queryData.size());
+    std::vector<size_t>                             searched;
+    std::unordered_map<size_t, std::vector<size_t>> byFingerprint;
+    for(size_t i = 0; i < queryData.size(); i++)
+    {
+        auto const& data   = *std::static_pointer_cast<TensileDataGemm>(queryData[i]);
+        auto&       bucket = byFingerprint[data.problem.fingerprint()];
+        auto        match  = std::find_if(bucket.begin(), bucket.end(), [&](size_t j) {
+            return sameSolutions(data, *std::static_pointer_cast<TensileDataGemm>(queryData[j]));
+        });
+
+        if(match != bucket.end())
+        {
+            distinct[i] = *match;
+        }
+        else
+        {
+            distinct[i] = i;
+            bucket.push_back(i);
+            searched.push_back(i);
+        }
+    }
+
+    log_api(__func__, "problems", queryData.size(), "distinct", searched.size());
+
+    heuristicResults.clear();
+    heuristicResults.resize(queryData.size());
+
+    auto search = [&](size_t i) {
+        findBestSolutions(handle,
+                          *std::static_pointer_cast<TensileDataGemm>(queryData[i]),
+                          library,
+                          hardware,
+                          maxWorkSpaceBytes,
+                          limits,
+                          requestedAlgoCount,
+                          heuristicResults[i]);
+    };
+
+    rocblaslt_status status = rocblaslt_status_success;
+    if(searched.size() == 1)
+    {
+        search(searched[0]);
+    }
+    else
+    {
+        std::vector<std::future<void>> searches;
+        searches.reserve(searched.size());
+        for(auto i : searched)
+            searches.push_back(get_heuristic_pool().submit([&search, i]() { search(i); }));
+
+        for(auto& future : searches)
+        {
+            try
+            {
+                future.get();
+            }
+            catch(std::exception const& e)
+            {
+                log_error(__func__, "search failed", e.what());
+                status = rocblaslt_status_internal_error;
+            }
+            catch(...)
+            {
+                log_error(__func__, "search failed");
+                status = rocblaslt_status_internal_error;
+            }
+        }
+    }
+
+    for(size_t i = 0; i < queryData.size(); i++)
+    {
+        if(distinct[i] != i)
+            heuristicResults[i] = heuristicResults[distinct[i]];
+    }
+
+    return status;
+}
+
+rocblaslt_status exportHeuristicPlan(rocblaslt_handle                          handle,
+                                     const std::vector<std::shared_ptr<void>>& queryData,
+                                     int                                       requestedAlgoCount,
+                                     size_t                                    maxWorkSpaceBytes,
+                                     const rocblaslt_matmul_search_limits&     limits,
+                                     const std::string&                        planFile)
+{
+    std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
+    if(!get_library_and_adapter(&library, nullptr, handle->device) || !library)
+        return rocblaslt_status_internal_error;
+
+    // The keys are taken as the search sees the problems, which it may change.
+    std::vector<uint64_t> keys;
+    keys.reserve(queryData.size());
+    for(auto const& query : queryData)
+    {
+        auto& data = *std::static_pointer_cast<TensileDataGemm>(query);
+        data.problem.setWorkspaceSize(maxWorkSpaceBytes);
+        SearchLimitsScope scope(data.problem, limits);
+        keys.push_back(planKey(data.problem, fallbackInputs(data.inputs)));
+    }
+
+    std::vector<std::vector<rocblaslt_matmul_heuristic_result>> heuristicResults;
+    auto status = getBestSolutionsBatched(
+        handle, queryData, requestedAlgoCount, maxWorkSpaceBytes, limits, heuristicResults);
+    if(status != rocblaslt_status_success)
+        return status;
+
+    // One line per problem: key, requested count, found count, then the
+    // index, fallback flag and workspace size of each solution.
+    std::ofstream out(planFile);
+    out << HeuristicPlanMagic << "\n"
+        << "device " << planArch(handle) << " " << handle->properties.multiProcessorCount << "\n"
+        << "library " << library->version << "\n";
+
+    std::unordered_set<uint64_t> written;
+    for(size_t i = 0; i < keys.size(); i++)
+    {
+        if(!written.insert(keys[i]).second)
+            continue;
+
+        out << std::hex << keys[i] << std::dec << " " << requestedAlgoCount << " "
+            << heuristicResults[i].size();
+        for(auto const& result : heuristicResults[i])
+            out << " " << *(const int*)result.algo.data << " " << result.algo.fallback << " "
+                << result.workspaceSize;
+        out << "\n";
+    }
+
+    out.close();
+    if(!out)
+    {
+        log_error(__func__, "could not write", planFile);
+        return rocblaslt_status_internal_error;
+    }
+
+    log_api(__func__, "planFile", planFile, "problems", written.size());
+    return rocblaslt_status_success;
+}
+
+rocblaslt_status loadHeuristicPlan(rocblaslt_handle handle, const std::string& planFile)
+{
+    std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
+    if(!get_library_and_adapter(&library, nullptr, handle->device) || !library)
+        return rocblaslt_status_internal_error;
+
+    std::ifstream in(planFile);
+    std::string   magic, deviceLine, libraryLine, tag;
+    std::getline(in, magic);
+    std::getline(in, deviceLine);
+    std::getline(in, libraryLine);
+
+    auto               plan = std::make_shared<HeuristicPlan>();
+    std::istringstream device(deviceLine);
+    device >> tag >> plan->arch >> plan->computeUnitCount;
+    if(!in || magic != HeuristicPlanMagic || tag != "device"
+       || libraryLine.compare(0, 8, "library ") != 0)
+    {
+        log_error(__func__, "not a heuristic plan", planFile);
+        return rocblaslt_status_invalid_value;
+    }
+    plan->libraryVersion = libraryLine.substr(8);
+
+    // The solution indices are only valid for the library they were found in.
+    if(plan->arch != planArch(handle)
+       || plan->computeUnitCount != handle->properties.multiProcessorCount
+       || plan->libraryVersion != library->version)
+    {
+        log_error(__func__,
+                  "plan is for another device or library",
+                  plan->arch,
+                  plan->computeUnitCount,
+                  plan->libraryVersion);
+        return rocblaslt_status_invalid_value;
+    }
+
+    for(std::string line; std::getline(in, line);)
+    {
+        if(line.empty())
+            continue;
+
+        std::istringstream   record(line);
+        uint64_t             key   = 0;
+        size_t               count = 0;
+        HeuristicPlan::Entry entry;
+        bool valid = static_cast<bool>(record >> std::hex >> key >> std::dec
+                                       >> entry.requestedAlgoCount >> count)
+                     && entry.requestedAlgoCount > 0
+                     && count <= static_cast<size_t>(entry.requestedAlgoCount);
+
+        entry.results.resize(valid ? count : 0);
+        for(auto& result : entry.results)
+        {
+            int index = 0;
+            memset(result.algo.data, 0, sizeof(result.algo.data));
+            valid = valid
+                    && static_cast<bool>(record >> index >> result.algo.fallback
+                                         >> result.workspaceSize);
+            *(int*)result.algo.data = index;
+        }
+
+        if(!valid)
+        {
+            log_error(__func__, "invalid plan entry", line);
+            return rocblaslt_status_invalid_value;
+        }
+        plan->entries[key] = std::move(entry);
+    }
+
+    log_api(__func__, "planFile", planFile, "problems", plan->entries.size());
+    handle->heuristic_plan = plan;
+    return rocblaslt_status_success;
+}
+
+namespace
+{
+    std::shared_ptr<Tensile::CachingLibrary<Tensile::ContractionProblemGemm>>
+        get_caching_library(rocblaslt_handle handle)
+    {
+        std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
+        static_cast<void>(get_library_and_adapter(&library, nullptr, handle->device));
+        if(!library)
+            return nullptr;
+
+        return std::dynamic_pointer_cast<Tensile::CachingLibrary<Tensile::ContractionProblemGemm>>(
+            library->library);
+    }
+} // namespace
+
+rocblaslt_status getSolutionCacheStatistics(rocblaslt_handle                     handle,
+                                            rocblaslt_solution_cache_statistics& statistics)
+{
+    auto cache = get_caching_library(handle);
+    if(!cache)
+        return rocblaslt_status_not_implemented;
+
+    auto stats           = cache->cacheStatistics();
+    statistics.lookups   = stats.lookups;
+    statistics.hits      = stats.hits;
+    statistics.evictions = stats.evictions;
+    statistics.entries   = stats.entries;
+    statistics.capacity  = stats.capacity;
+
+    return rocblaslt_status_success;
+}
+
+rocblaslt_status setSolutionCacheCapacity(rocblaslt_handle handle, size_t capacity)
+{
+    auto cache = get_caching_library(handle);
+    if(!cache)
+        return rocblaslt_status_not_implemented;
+
+    cache->setCacheCapacity(capacity);
+
+    return rocblaslt_status_success;
+}
+
+namespace
+{
+    // Shared by all handles; loading is mostly file I/O, so a few threads suffice.
+    rocblaslt::ThreadPool& get_preload_pool()
+    {
+        static rocblaslt::ThreadPool pool(
+            std::min<size_t>(4, std::max(1u, std::thread::hardware_concurrency())));
+        return pool;
+    }
+
+    void preload_code_object(Tensile::hip::SolutionAdapter&   adapter,
+                             Tensile::LazyLoadedLibrary const& library)
+    {
+        // A virtual device only needs the sub-library itself
+        if(rocblaslt_internal_get_virtual_device())
+        {
+            log_info(__func__, "not loaded for virtual device", library.codeObjectFile());
+            return;
+        }
+
+        auto err = adapter.loadLazyCodeObjectFile(library.codeObjectFile());
+        if(err != hipSuccess)
+            log_error(__func__, "could not load", library.codeObjectFile());
+    }
+
+    rocblaslt_status preload(rocblaslt_handle                           handle,
+                             std::vector<std::function<void()>> const& selectors,
+                             std::regex const*                          pattern,
+                             bool                                       wait)
+    {
+        std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
+
+        auto adapter = get_library_and_adapter(&library, nullptr, handle->device);
+        if(!adapter || !library)
+            return rocblaslt_status_internal_error;
+
+        std::vector<Tensile::LazyLoadedLibrary const*> lazyLibraries;
+        library->getLazyLoadedLibraries(lazyLibraries);
+
+        // Code objects are loaded onto the current device of the loading thread.
+        int                            device = handle->device;
+        std::vector<std::future<void>> loads;
+        auto&                          pool = get_preload_pool();
+
+        if(pattern)
+        {
+            for(auto lazyLibrary : lazyLibraries)
+            {
+                if(!std::regex_search(lazyLibrary->name(), *pattern))
+                    continue;
+
+                loads.push_back(pool.submit([adapter, lazyLibrary, device]() {
+                    static_cast<void>(hipSetDevice(device));
+                    if(lazyLibrary->load())
+                        preload_code_object(*adapter, *lazyLibrary);
+                }));
+            }
+        }
+
+        for(auto const& selector : selectors)
+        {
+            // The selector looks up solutions for a problem, which loads the
+            // sub-libraries that serve it.
+            loads.push_back(pool.submit([adapter, lazyLibraries, device, selector]() {
+                static_cast<void>(hipSetDevice(device));
+                selector();
+                for(auto lazyLibrary : lazyLibraries)
+                {
+                    if(lazyLibrary->isLoaded())
+                        preload_code_object(*adapter, *lazyLibrary);
+                }
+            }));
+        }
+
+        log_api(__func__, "sub-libraries", lazyLibraries.size(), "tasks", loads.size());
+
+        if(wait)
+        {
+            rocblaslt_status status = rocblaslt_status_success;
+            for(auto& load : loads)
+            {
+                try
+                {
+                    load.get();
+                }
+                catch(std::exception const& e)
+                {
+                    log_error(__func__, "preloading failed", e.what());
+                    status = rocblaslt_status_internal_error;
+                }
+            }
+            return status;
+        }
+
+        return rocblaslt_status_success;
+    }
+} // namespace
+
+rocblaslt_status preloadLibraries(rocblaslt_handle handle, std::string const& pattern, bool wait)
+{
+    std::regex regex;
+    try
+    {
+        regex = std::regex(pattern);
+    }
+    catch(std::regex_error const& e)
+    {
+        log_error(__func__, "invalid pattern", pattern, e.what());
+        return rocblaslt_status_invalid_value;
+    }
+
+    return preload(handle, {}, &regex, wait);
+}
+
+rocblaslt_status preloadLibraries(rocblaslt_handle                          handle,
+                                  std::vector<std::function<void()>> const& selectors,
+                                  bool                                      wait)
+{
+    return preload(handle, selectors, nullptr, wait);
+}
+
 /***************************************************************
  * ! \brief  Initialize rocblaslt for the current HIP device, to *
  * avoid costly startup time at the first call on that device. *
@@ -2383,7 +3671,7 @@ extern "C" void rocblaslt_createialize()
  ******************************************************************************/
 
 // types
-#define CREATEFUNCTION(TiA, TiB, To, Tc)                                                       \
+#define CREATEFUNCTION(TiA, TiB, To, Tc, ...)                                                  \
     template rocblaslt_status runContractionProblem<TiA, TiB, To, Tc>(                         \
         rocblaslt_handle             handle,                                                   \
         const rocblaslt_matmul_algo* algo,                                                     \
@@ -2419,27 +3707,14 @@ extern "C" void rocblaslt_createialize()
         int                                           requestedAlgoCount,                      \
         rocblaslt_matmul_heuristic_result             heuristicResultsArray[],                 \
         int*                                          returnAlgoCount,                         \
-        size_t                                        maxWorkSpaceBytes);
-
-CREATEFUNCTION(float, float, float, float)
-CREATEFUNCTION(double, double, double, double)
-CREATEFUNCTION(rocblaslt_half, rocblaslt_half, rocblaslt_half, float)
-CREATEFUNCTION(rocblaslt_half, rocblaslt_half, float, float)
-CREATEFUNCTION(rocblaslt_bfloat16, rocblaslt_bfloat16, rocblaslt_bfloat16, float)
-CREATEFUNCTION(rocblaslt_f8, rocblaslt_f8, float, float)
-CREATEFUNCTION(rocblaslt_f8, rocblaslt_bf8, float, float)
-CREATEFUNCTION(rocblaslt_bf8, rocblaslt_f8, float, float)
-CREATEFUNCTION(rocblaslt_f8, rocblaslt_f8, rocblaslt_half, float)
-CREATEFUNCTION(rocblaslt_f8, rocblaslt_bf8, rocblaslt_half, float)
-CREATEFUNCTION(rocblaslt_bf8, rocblaslt_f8, rocblaslt_half, float)
-CREATEFUNCTION(rocblasltInt8, rocblasltInt8, int32_t, int32_t)
-CREATEFUNCTION(rocblasltInt8, rocblasltInt8, rocblasltInt8, int32_t)
-CREATEFUNCTION(rocblaslt_f8, rocblaslt_half, rocblaslt_f8, float)
-CREATEFUNCTION(rocblaslt_half, rocblaslt_f8, rocblaslt_f8, float)
-CREATEFUNCTION(rocblaslt_f8, rocblaslt_half, rocblaslt_half, float)
-CREATEFUNCTION(rocblaslt_half, rocblaslt_f8, rocblaslt_half, float)
-CREATEFUNCTION(rocblaslt_f8, rocblaslt_half, float, float)
-CREATEFUNCTION(rocblaslt_half, rocblaslt_f8, float, float)
+        size_t                                        maxWorkSpaceBytes,                       \
+        const rocblaslt_matmul_search_limits&         limits);                                 \
+    template rocblaslt_status prepareHeuristicQuery<TiA, TiB, To, Tc>(                         \
+        const RocblasltContractionProblem<TiA, TiB, To, Tc>& prob,                             \
+        const std::shared_ptr<void>&                         gemmData,                         \
+        std::shared_ptr<void>&                               queryData);
+
+FOR_EACH_GEMM_TYPES(CREATEFUNCTION, )
 
 /***********************************************************************************
  * Whether Tensile has been initialized for at least one device (used for
@@ -24,6 +24,8 @@
  *
  *******************************************************************************/
 #include "utility.hpp"
+#include <iomanip>
+#include <sstream>
 #include <sys/types.h>
 #include <unistd.h>
 LoggerSingleton LoggerSingleton::gInstance;
@@ -39,10 +41,26 @@ uint32_t get_logger_layer_mode()
     return s.env_layer_mode;
 }
 
+rocblaslt::AsyncLogger* get_async_logger()
+{
+    LoggerSingleton& s = LoggerSingleton::getInstance();
+    return s.async_logger.get();
+}
+
+void rocblaslt_log_flush()
+{
+    if(rocblaslt::AsyncLogger* async = get_async_logger())
+        async->flush();
+}
+
 std::string prefix(const char* layer, const char* caller)
 {
-    time_t now   = time(0);
-    tm*    local = localtime(&now);
+    return prefix(layer, caller, time(0));
+}
+
+std::string prefix(const char* layer, const char* caller, time_t now)
+{
+    tm* local = localtime(&now);
 
     std::string             format = "[%d-%02d-%02d %02d:%02d:%02d][HIPBLASLT][%lu][%s][%s]\0";
     std::unique_ptr<char[]> buf(new char[255]);
@@ -188,6 +206,10 @@ const char* rocblaslt_layer_mode2string(rocblaslt_layer_mode layer_mode)
         return "Info";
     case rocblaslt_layer_mode_log_api:
         return "Api";
+    case rocblaslt_layer_mode_log_bench:
+        return "Bench";
+    case rocblaslt_layer_mode_log_profile:
+        return "Profile";
     default:
         return "Invalid";
     }
@@ -281,3 +303,230 @@ std::string rocblaslt_matmul_desc_to_string(rocblaslt_matmul_desc matmul_desc)
                      hipblasltDatatype_to_string(matmul_desc->bias_type));
     return std::string(buf.get());
 }
+
+namespace
+{
+    char hipblas_operation_char(hipblasOperation_t op)
+    {
+        return op == HIPBLAS_OP_T ? 'T' : op == HIPBLAS_OP_C ? 'C' : 'N';
+    }
+
+    // Names of the types in the hipblaslt-bench options and in the YAML test data
+    const char* bench_datatype_string(hipblasltDatatype_t type)
+    {
+        switch(type)
+        {
+        case HIPBLASLT_R_16F:
+            return "f16_r";
+        case HIPBLASLT_R_16B:
+            return "bf16_r";
+        case HIPBLASLT_R_32F:
+            return "f32_r";
+        case HIPBLASLT_R_64F:
+            return "f64_r";
+        case HIPBLASLT_R_8F_E4M3:
+            return "f8_r";
+        case HIPBLASLT_R_8F_E5M2:
+            return "bf8_r";
+        case HIPBLASLT_R_8I:
+            return "i8_r";
+        case HIPBLASLT_R_32I:
+            return "i32_r";
+        default:
+            return "invalid";
+        }
+    }
+
+    const char* bench_compute_type_string(rocblaslt_compute_type type, bool yaml)
+    {
+        switch(type)
+        {
+        case rocblaslt_compute_f32:
+            return yaml ? "c_f32_r" : "f32_r";
+        case rocblaslt_compute_f32_fast_xf32:
+            return yaml ? "c_xf32_r" : "xf32_r";
+        case rocblaslt_compute_f64:
+            return yaml ? "c_f64_r" : "f64_r";
+        case rocblaslt_compute_i32:
+            return yaml ? "c_i32_r" : "i32_r";
+        case rocblaslt_compute_f32_fast_f16:
+            return yaml ? "c_f32_fast_f16_r" : "f32_f16_r";
+        default:
+            return "invalid";
+        }
+    }
+
+    // hipblaslt-bench raises strides below the size of a matrix unless
+    // --any_stride is set, e.g. for broadcast batches with a stride of 0.
+    bool bench_needs_any_stride(rocblaslt_bench_problem const& p)
+    {
+        if(p.batch_count <= 1)
+            return false;
+
+        return p.stride_a < p.lda * (p.transA == HIPBLAS_OP_N ? p.k : p.m)
+               || p.stride_b < p.ldb * (p.transB == HIPBLAS_OP_N ? p.n : p.k)
+               || p.stride_c < p.ldc * p.n || p.stride_d < p.ldd * p.n
+               || (p.use_e && p.stride_e < p.lde * p.n);
+    }
+
+    std::string bench_command(rocblaslt_bench_problem const& p)
+    {
+        std::ostringstream cmd;
+        cmd << std::setprecision(9);
+
+        cmd << "hipblaslt-bench --api_method " << (p.ext ? 2 : 0) << " -m " << p.m << " -n "
+            << p.n << " -k " << p.k << " --lda " << p.lda << " --ldb " << p.ldb << " --ldc "
+            << p.ldc << " --ldd " << p.ldd << " --stride_a " << p.stride_a << " --stride_b "
+            << p.stride_b << " --stride_c " << p.stride_c << " --stride_d " << p.stride_d
+            << " --batch_count " << p.batch_count << " --alpha " << p.alpha << " --beta "
+            << p.beta << " --transA " << hipblas_operation_char(p.transA) << " --transB "
+            << hipblas_operation_char(p.transB) << " --a_type " << bench_datatype_string(p.a_type)
+            << " --b_type " << bench_datatype_string(p.b_type) << " --c_type "
+            << bench_datatype_string(p.c_type) << " --d_type " << bench_datatype_string(p.d_type)
+            << " --compute_type " << bench_compute_type_string(p.compute_type, false)
+            << " --activation_type " << p.activation_type;
+
+        if(p.bias_vector)
+            cmd << " --bias_vector --bias_type " << bench_datatype_string(p.bias_type)
+                << " --bias_source " << p.bias_source;
+        if(p.use_e)
+            cmd << " --use_e --lde " << p.lde << " --stride_e " << p.stride_e;
+        if(p.gradient)
+            cmd << " --gradient";
+        if(p.scaleA)
+            cmd << " --scaleA";
+        if(p.scaleB)
+            cmd << " --scaleB";
+        if(p.scaleC)
+            cmd << " --scaleC";
+        if(p.scaleD)
+            cmd << " --scaleD";
+        if(p.scaleE)
+            cmd << " --scaleE";
+        if(p.scaleAlpha_vector)
+            cmd << " --scaleAlpha_vector";
+        if(p.c_noalias_d)
+            cmd << " --c_noalias_d";
+        if(p.grouped_gemm)
+            cmd << " --grouped_gemm " << p.grouped_gemm;
+        if(bench_needs_any_stride(p))
+            cmd << " --any_stride true";
+        if(p.solution_index >= 0)
+            cmd << " --algo_method 2 --solution_index " << p.solution_index;
+
+        return cmd.str();
+    }
+
+    // Flow style entry of the Tests list of hipblaslt_template.yaml, without the
+    // closing brace so that the profile can append the call count.
+    std::string bench_yaml(rocblaslt_bench_problem const& p)
+    {
+        std::ostringstream yaml;
+        yaml << std::setprecision(9) << std::boolalpha;
+
+        yaml << "- { function: matmul, use_ext: " << p.ext << ", use_ext_setproblem: " << p.ext
+             << ", M: " << p.m << ", N: " << p.n << ", K: " << p.k << ", lda: " << p.lda
+             << ", ldb: " << p.ldb << ", ldc: " << p.ldc << ", ldd: " << p.ldd
+             << ", stride_a: " << p.stride_a << ", stride_b: " << p.stride_b
+             << ", stride_c: " << p.stride_c << ", stride_d: " << p.stride_d
+             << ", batch_count: " << p.batch_count << ", alpha: " << p.alpha
+             << ", beta: " << p.beta << ", transA: " << hipblas_operation_char(p.transA)
+             << ", transB: " << hipblas_operation_char(p.transB)
+             << ", a_type: " << bench_datatype_string(p.a_type)
+             << ", b_type: " << bench_datatype_string(p.b_type)
+             << ", c_type: " << bench_datatype_string(p.c_type)
+             << ", d_type: " << bench_datatype_string(p.d_type)
+             << ", compute_type: " << bench_compute_type_string(p.compute_type, true)
+             << ", activation_type: " << p.activation_type;
+
+        if(p.bias_vector)
+            yaml << ", bias_vector: true, bias_type: " << bench_datatype_string(p.bias_type)
+                 << ", bias_source: " << p.bias_source;
+        if(p.use_e)
+            yaml << ", use_e: true, lde: " << p.lde << ", stride_e: " << p.stride_e;
+        if(p.gradient)
+            yaml << ", gradient: true";
+        if(p.scaleA)
+            yaml << ", scaleA: true";
+        if(p.scaleB)
+            yaml << ", scaleB: true";
+        if(p.scaleC)
+            yaml << ", scaleC: true";
+        if(p.scaleD)
+            yaml << ", scaleD: true";
+        if(p.scaleE)
+            yaml << ", scaleE: true";
+        if(p.scaleAlpha_vector)
+            yaml << ", scaleAlpha_vector: true";
+        if(p.c_noalias_d)
+            yaml << ", c_noalias_d: true";
+        if(p.grouped_gemm)
+            yaml << ", grouped_gemm: " << p.grouped_gemm;
+        if(p.solution_index >= 0)
+            yaml << ", algo_method: 2, solution_index: " << p.solution_index;
+
+        return yaml.str();
+    }
+}
+
+void log_bench(const char* func, std::vector<rocblaslt_bench_problem> const& problems)
+{
+    LoggerSingleton& s = LoggerSingleton::getInstance();
+    if(problems.empty()
+       || !(s.env_layer_mode & (rocblaslt_layer_mode_log_bench | rocblaslt_layer_mode_log_profile)))
+        return;
+
+    std::vector<rocblaslt_bench_problem> logged = problems;
+    if(logged[0].grouped_gemm)
+    {
+        // hipblaslt-bench runs a grouped gemm of copies of a single problem.
+        std::string first = bench_yaml(logged[0]);
+        bool        same  = std::all_of(logged.begin() + 1, logged.end(), [&](auto const& p) {
+            return bench_yaml(p) == first;
+        });
+        if(same)
+        {
+            logged.resize(1);
+            logged[0].grouped_gemm = problems.size();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(s.bench_mutex);
+    for(auto const& problem : logged)
+    {
+        std::string yaml = bench_yaml(problem);
+
+        if(s.env_layer_mode & rocblaslt_layer_mode_log_bench)
+        {
+            if(s.bench_format_yaml)
+                *s.bench_os << yaml << " }" << std::endl;
+            else
+                *s.bench_os << bench_command(problem) << " # " << func << std::endl;
+        }
+
+        if(s.env_layer_mode & rocblaslt_layer_mode_log_profile)
+            s.profile[yaml]++;
+    }
+}
+
+void LoggerSingleton::write_profile()
+{
+    std::lock_guard<std::mutex> lock(bench_mutex);
+    if(profile.empty() || !profile_os)
+        return;
+
+    // Most frequent problems first.
+    std::vector<std::pair<std::string, size_t>> counts(profile.begin(), profile.end());
+    std::stable_sort(counts.begin(), counts.end(), [](auto const& a, auto const& b) {
+        return a.second > b.second;
+    });
+
+    for(auto const& count : counts)
+    {
+        // hipblaslt_gentest.py ignores the count, so the profile can be run
+        // with hipblaslt-bench --yaml.
+        *profile_os << count.first << ", call_count: " << count.second << " }\n";
+    }
+    profile_os->flush();
+    profile.clear();
+}
@@ -24,6 +24,9 @@
 // Predeclare hipblaslt_abort_once() for friend declaration in hipblaslt_ostream.hpp
 static void hipblaslt_abort_once [[noreturn]] ();
 
+// Defined by the rocblaslt backend
+void rocblaslt_log_flush();
+
 #include "hipblaslt_ostream.hpp"
 
 #include <csignal>
@@ -71,6 +74,9 @@ static void hipblaslt_abort_once()
     // Clear the map, stopping all workers
     hipblaslt_internal_ostream::clear_workers();
 
+    // Write the records still queued by the asynchronous logger
+    rocblaslt_log_flush();
+
     // Flush all
     fflush(NULL);
 
@@ -497,7 +497,7 @@ class SizeMapping:
                  'globalAccumulation',
                  'workspaceSizePerElemC',
                  'workspaceSizePerElemBias',
-                 'activationFused', 'CustomKernelName'
+                 'activationFused', 'alignmentBytes', 'CustomKernelName'
                  ]
 
     @classmethod
@@ -522,9 +522,24 @@ class SizeMapping:
                    workspaceSizePerElemC    = d['_WorkspaceSizePerElemC'],
                    workspaceSizePerElemBias = d['_WorkspaceSizePerElemBias'],
                    activationFused          = d['ActivationFused'],
+                   alignmentBytes           = cls.ReadOriginalAlignmentBytes(d),
                    CustomKernelName         = d['CustomKernelName']
                    )
 
+    @classmethod
+    def ReadOriginalAlignmentBytes(cls, d):
+        # Widest global access made to A, B, C and D. Callers that can only
+        # promise a smaller alignment of their buffers skip the solution.
+        if 'GlobalReadVectorWidthA' not in d or 'StoreVectorWidth' not in d:
+            return [0, 0, 0, 0]
+        problemType = d['ProblemType']
+        numBytes = lambda key: DataType(problemType.get(key, problemType['DataType'])).numBytes()
+        rv = [d['GlobalReadVectorWidthA'] * numBytes('DataTypeA'),
+              d['GlobalReadVectorWidthB'] * numBytes('DataTypeB'),
+              d['StoreVectorWidth'] * numBytes('DestDataType'),
+              d['StoreVectorWidth'] * numBytes('DestDataType')]
+        return [max(int(r), 1) for r in rv]
+
     @classmethod
     def ReadOriginalMacroTile(cls, d):
         rv = [1,1,1]
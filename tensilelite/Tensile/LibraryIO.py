@@ -48,6 +48,8 @@ try:
 except ImportError:
     print("Message pack python library not detected. Must use YAML backend instead.")
 
+import struct
+
 
 ###################
 # Writing functions
@@ -58,6 +60,8 @@ def write(filename_noExt, data, format="yaml"):
         writeYAML(filename_noExt + ".yaml", data)
     elif format == "msgpack":
         writeMsgPack(filename_noExt + ".dat", data)
+    elif format == "flat":
+        writeFlat(filename_noExt + ".dat", data)
     else:
         printExit("Unrecognized format {}".format(format))
 
@@ -81,6 +85,104 @@ def writeMsgPack(filename, data):
     with open(filename, "wb") as f:
         msgpack.pack(data, f)
 
+
+class FlatWriter:
+    """
+    Builds the flat library format read by Tensile/flat/FlatLibrary.hpp.
+
+    The file is a header followed by 8-byte aligned tables: nodes (type,
+    count, value), array children (node indices), map entries (key string,
+    node) sorted by key bytes, string references (offset, length) and the
+    string data. Strings are interned, so repeated keys and values such as
+    kernel names are only stored once.
+    """
+    Magic = b"TNSLFLAT"
+    Version = 1
+    HeaderFormat = "<8sII10Q"
+
+    Nil, Bool, Int, UInt, Float, String, Array, Map = range(8)
+
+    def __init__(self):
+        self.nodes = []
+        self.children = []
+        self.entries = []
+        self.strings = {}
+        self.stringData = bytearray()
+        self.stringRefs = []
+
+    def internString(self, value):
+        data = value.encode("utf-8")
+        index = self.strings.get(data)
+        if index is None:
+            index = len(self.stringRefs)
+            self.strings[data] = index
+            self.stringRefs.append((len(self.stringData), len(data)))
+            self.stringData += data
+        return index
+
+    def addNode(self, obj):
+        if obj is None:
+            node = (self.Nil, 0, 0)
+        elif isinstance(obj, bool):
+            node = (self.Bool, 0, int(obj))
+        elif isinstance(obj, int):
+            if obj < 0:
+                node = (self.Int, 0, obj & 0xFFFFFFFFFFFFFFFF)
+            else:
+                node = (self.UInt, 0, obj)
+        elif isinstance(obj, float):
+            node = (self.Float, 0, struct.unpack("<Q", struct.pack("<d", obj))[0])
+        elif isinstance(obj, str):
+            node = (self.String, 0, self.internString(obj))
+        elif isinstance(obj, (list, tuple)):
+            items = [self.addNode(item) for item in obj]
+            node = (self.Array, len(items), len(self.children))
+            self.children += items
+        elif isinstance(obj, dict):
+            # Integer keys are read back as strings, as with msgpack.
+            items = [(str(key).encode("utf-8"), self.addNode(value)) for key, value in obj.items()]
+            items.sort(key=lambda item: item[0])
+            node = (self.Map, len(items), len(self.entries))
+            self.entries += [(self.internString(key.decode("utf-8")), value) for key, value in items]
+        else:
+            raise TypeError("Cannot write {} to a flat library".format(type(obj)))
+
+        self.nodes.append(node)
+        return len(self.nodes) - 1
+
+    def serialize(self, data):
+        root = self.addNode(data)
+
+        tables = [
+            b"".join(struct.pack("<IIQ", *node) for node in self.nodes),
+            struct.pack("<{}I".format(len(self.children)), *self.children),
+            b"".join(struct.pack("<II", *entry) for entry in self.entries),
+            b"".join(struct.pack("<QQ", *ref) for ref in self.stringRefs),
+            bytes(self.stringData)
+        ]
+
+        offset = struct.calcsize(self.HeaderFormat)
+        body = bytearray()
+        locations = []
+        for table in tables:
+            locations.append(offset + len(body))
+            body += table
+            body += bytes(-len(body) % 8)
+
+        header = struct.pack(self.HeaderFormat, self.Magic, self.Version, root,
+                             len(self.nodes), locations[0],
+                             len(self.children), locations[1],
+                             len(self.entries), locations[2],
+                             len(self.stringRefs), locations[3],
+                             len(self.stringData), locations[4])
+        return header + bytes(body)
+
+
+def writeFlat(filename, data):
+    """Writes data to file in the flat (memory-mappable) library format."""
+    with open(filename, "wb") as f:
+        f.write(FlatWriter().serialize(data))
+
 def writeSolutions(filename, problemSizes, biasTypeArgs, activationArgs, solutions, cache=False):
     """Writes solution YAML file."""
 
@@ -292,6 +394,9 @@ def parseLibraryLogicList(data, srcFile="?"):
     if len(data) > 12 and data[12]:
         rv["Library"]["distance"] = data[12]
 
+    if len(data) > 13 and data[13] is not None:
+        rv["ModelRanking"] = data[13]
+
     return rv
 
 
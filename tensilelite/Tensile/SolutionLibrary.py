@@ -102,10 +102,7 @@ class MatchingLibrary:
                 index = row[1][0]
                 value = IndexSolutionLibrary(solutions[index])
                 key = list([row[0][i] for i in keyOrder])
-                if distance == "GridBased":
-                    entry = {"key": key, "index": value}
-                else:
-                    entry = {"key": key, "index": value, "speed": row[1][1]}
+                entry = {"key": key, "index": value, "speed": row[1][1]}
 
                 table.append(entry)
             except KeyError:
@@ -137,6 +134,84 @@ class MatchingLibrary:
         self.distance = distance
 
 
+class ModelRankingLibrary:
+    Tag = "ModelRanking"
+    StateKeys = [("type", "tag"), "library", "indices", "sizes", "maxGridDistance", "calibration"]
+
+    # SIMDs per CU and cycles per pass of a matrix instruction, on the GPUs with matrix cores.
+    SimdsPerCu = 4
+    CyclesPerPass = 4
+
+    @classmethod
+    def MatrixCoreFlops(cls, solutions):
+        """
+        FLOPs per CU per cycle of the fastest matrix instruction of solutions,
+        issued back to back with the number of passes the kernel writer
+        schedules for it. 0 if none of them uses matrix instructions.
+        """
+        rv = 0
+        for s in solutions:
+            d = s.originalSolution
+            if not d.get("EnableMatrixInstruction"):
+                continue
+            problemType = d["ProblemType"]
+            xf32 = d.get("EnableF32XdlMathOp") and problemType["F32XdlMathOp"].isXFloat32()
+            passes = d["MatrixInstM"] // (4 if problemType["SparseA"] or xf32 else 2)
+            flops = 2 * d["MatrixInstM"] * d["MatrixInstN"] * d["MatrixInstK"] * d["MatrixInstB"]
+            rv = max(rv, cls.SimdsPerCu * flops // (passes * cls.CyclesPerPass))
+        return rv
+
+    @classmethod
+    def FromOriginalState(cls, d, architectureName, problemType, libraryData, solutions, library):
+        """
+        Wraps library, built from the table in libraryData, so that sizes far
+        from its table are ranked by the roofline model instead. d holds the
+        optional maxGridDistance and calibration overrides from the logic file.
+        The bandwidth and clock are otherwise those of the GPU the library is
+        loaded on, and the matrix core throughput that of the solutions.
+        """
+        calibration = dict(d.get("calibration", {}))
+        if "flopsPerCuPerCycle" not in calibration:
+            calibration["flopsPerCuPerCycle"] = cls.MatrixCoreFlops(solutions)
+        if not calibration["flopsPerCuPerCycle"]:
+            raise RuntimeError("ModelRanking for {} {} needs a calibrated flopsPerCuPerCycle"
+                               .format(architectureName, problemType.operationIdentifier))
+
+        sizes = []
+        for row in libraryData["table"]:
+            key = row[0]
+            sizes.append(list(key[0:4]) if len(key) > 3 else [key[0], key[1], 1, key[2]])
+
+        return cls(library, list(solutions), sizes, d.get("maxGridDistance", 1.0), calibration)
+
+    @property
+    def tag(self):
+        return self.__class__.Tag
+
+    @property
+    def indices(self):
+        return sorted([s.index for s in self.solutions])
+
+    def merge(self, other):
+        assert self.__class__ == other.__class__ \
+                and self.maxGridDistance == other.maxGridDistance \
+                and self.calibration == other.calibration
+
+        self.library.merge(other.library)
+        self.solutions += other.solutions
+        self.sizes += other.sizes
+
+    def remapSolutionIndices(self, indexMap):
+        self.library.remapSolutionIndices(indexMap)
+
+    def __init__(self, library, solutions, sizes, maxGridDistance, calibration):
+        self.library = library
+        self.solutions = solutions
+        self.sizes = sizes
+        self.maxGridDistance = maxGridDistance
+        self.calibration = calibration
+
+
 class DecisionTreeLibrary:
     Tag = "DecisionTree"
     StateKeys = [("type", "tag"), "features", "trees"]
@@ -335,6 +410,10 @@ class MasterSolutionLibrary:
                     predicate = Properties.Predicate(tag="TruePred")
 
                 matchingLib = MatchingLibrary.FromOriginalState(d["Library"], solutions)
+                if d.get("ModelRanking") is not None:
+                    matchingLib = ModelRankingLibrary.FromOriginalState(
+                        d["ModelRanking"], d["ArchitectureName"], problemType, d["Library"],
+                        solutions, matchingLib)
                 library = PredicateLibrary(tag="Problem")
                 library.rows.append({"predicate": predicate, "library": matchingLib})
 
@@ -125,15 +125,23 @@ namespace Tensile
         {
             static void SolveCPU(ContractionProblemGemm const& contraction,
                                  ContractionInputs const&      inputs,
-                                 size_t                        elementsToValidate);
+                                 size_t                        elementsToValidate,
+                                 bool                          blockedGemm = true);
             static void SolveCPU(ContractionProblemGroupedGemm const& contractions,
                                  ContractionGroupedInputs const&      inputs,
-                                 size_t                               elementsToValidate);
+                                 size_t                               elementsToValidate,
+                                 bool                                 blockedGemm = true);
         };
 
+        /**
+         * Computes D on the CPU. With blockedGemm, plain (batched) GEMMs are
+         * summed tile by tile; otherwise every element is summed on its own,
+         * which gives the same result and is kept to check the tiled path.
+         */
         void SolveCPU(ContractionProblem const* contraction,
                       ProblemInputs const*      inputs,
-                      size_t                    elementsToValidate);
+                      size_t                    elementsToValidate,
+                      bool                      blockedGemm = true);
 
     } // namespace Client
 } // namespace Tensile
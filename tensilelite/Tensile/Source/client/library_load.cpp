@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Measures how long it takes to load solution libraries and how much memory
+// they keep, e.g. to compare the same library written with
+// --library-format=msgpack and --library-format=flat:
+//
+//   tensile_library_load -l msgpack/TensileLibrary_gfx942.dat -l flat/TensileLibrary_gfx942.dat
+
+#include <Tensile/Contractions.hpp>
+#include <Tensile/MasterSolutionLibrary.hpp>
+#include <Tensile/Tensile.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include <unistd.h>
+
+namespace po = boost::program_options;
+
+namespace
+{
+    // Resident set size of this process in bytes, or 0 if unavailable.
+    size_t residentBytes()
+    {
+        std::ifstream statm("/proc/self/statm");
+        size_t        size = 0, resident = 0;
+        if(!(statm >> size >> resident))
+            return 0;
+
+        return resident * sysconf(_SC_PAGESIZE);
+    }
+
+    using Library
+        = Tensile::SolutionLibrary<Tensile::ContractionProblemGemm, Tensile::ContractionSolution>;
+
+    std::shared_ptr<Library> load(std::string const& filename, double& ms)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto library
+            = Tensile::LoadLibraryFile<Tensile::ContractionProblemGemm,
+                                       Tensile::ContractionSolution>(filename);
+        auto end = std::chrono::steady_clock::now();
+
+        ms = std::chrono::duration<double, std::milli>(end - start).count();
+        return library;
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    po::options_description options("Library load benchmark options");
+    // clang-format off
+    options.add_options()
+        ("help,h", "Show help message.")
+        ("library-file,l", po::value<std::vector<std::string>>()->required(),
+                           "Library file to load. May be given several times.")
+        ("iterations,i",   po::value<int>()->default_value(10),
+                           "Number of timed loads per file, after the first.")
+        ;
+    // clang-format on
+
+    po::variables_map args;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, options), args);
+        if(args.count("help"))
+        {
+            std::cout << options << std::endl;
+            return 0;
+        }
+        po::notify(args);
+    }
+    catch(std::exception const& exc)
+    {
+        std::cerr << exc.what() << std::endl << options << std::endl;
+        return 1;
+    }
+
+    auto files      = args["library-file"].as<std::vector<std::string>>();
+    int  iterations = std::max(args["iterations"].as<int>(), 0);
+
+    std::cout << std::setw(12) << "first (ms)" << std::setw(12) << "min (ms)" << std::setw(12)
+              << "mean (ms)" << std::setw(12) << "RSS (KiB)"
+              << "  file" << std::endl;
+
+    int rv = 0;
+    for(auto const& file : files)
+    {
+        // Keep the first library alive so that the memory it holds on to
+        // shows up in the resident set size.
+        size_t rssBefore = residentBytes();
+        double first;
+        auto   library = load(file, first);
+        size_t rssAfter = residentBytes();
+
+        if(!library)
+        {
+            std::cerr << "Failed to load " << file << std::endl;
+            rv = 1;
+            continue;
+        }
+
+        double minimum = first, total = 0;
+        for(int i = 0; i < iterations; i++)
+        {
+            double ms;
+            load(file, ms);
+            minimum = std::min(minimum, ms);
+            total += ms;
+        }
+        double mean = iterations > 0 ? total / iterations : first;
+
+        std::cout << std::fixed << std::setprecision(3) << std::setw(12) << first
+                  << std::setw(12) << minimum << std::setw(12) << mean << std::setw(12)
+                  << (rssAfter > rssBefore ? (rssAfter - rssBefore) / 1024 : 0) << "  " << file
+                  << std::endl;
+    }
+
+    return rv;
+}
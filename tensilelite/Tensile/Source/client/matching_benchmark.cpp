@@ -0,0 +1,488 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Compares the GridBased and GridInterpolated matchers on the GridBased tables
+// of a solution library, e.g. the per-type files of a lazy gfx942 library:
+//
+//   tensile_matching_benchmark -l library/TensileLibrary_Type_HH_..._gfx942.dat
+//
+// Latency is measured on random sizes spread log-uniformly over each table,
+// along with how often both matchers pick the same solution for them.
+// Quality is measured offline: both matchers are built from all but every
+// holdout-stride'th tuned size, and each held out size is then looked up to
+// see whether the matcher picks the solution that won the tuning there.
+//
+// With --check, the k-d tree of GridInterpolated is compared against a linear
+// scan instead, on synthetic points and on the tuned sizes of the tables.
+
+#include <Tensile/ContractionLibrary.hpp>
+#include <Tensile/Contractions.hpp>
+#include <Tensile/MasterSolutionLibrary.hpp>
+#include <Tensile/PlaceholderLibrary.hpp>
+#include <Tensile/Tensile.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace po = boost::program_options;
+
+namespace
+{
+    using Problem  = Tensile::ContractionProblemGemm;
+    using Solution = Tensile::ContractionSolution;
+    using Library  = Tensile::SolutionLibrary<Problem, Solution>;
+    using Element  = std::shared_ptr<Library>;
+    using Key      = std::array<int64_t, 3>;
+
+    template <typename Distance>
+    using Table = Tensile::Matching::
+        DistanceMatchingTable<Key, Problem, Element, std::shared_ptr<Solution>, Distance>;
+
+    using GridBasedTable        = Table<Tensile::Matching::GridBasedDistance<Key>>;
+    using GridInterpolatedTable = Table<Tensile::Matching::GridInterpolatedDistance<Key>>;
+
+    using Tensile::Matching::KdTree;
+
+    // Collects every GridBased table reachable from library, loading
+    // placeholders on the way.
+    void findTables(Element const& library, std::vector<std::shared_ptr<GridBasedTable>>& tables)
+    {
+        if(!library)
+            return;
+
+        if(auto master = std::dynamic_pointer_cast<Tensile::MasterContractionLibrary>(library))
+        {
+            findTables(master->library, tables);
+        }
+        else if(auto hardware
+                = std::dynamic_pointer_cast<Tensile::ContractionHardwareSelectionLibrary>(library))
+        {
+            for(auto const& row : hardware->rows)
+                findTables(row.second, tables);
+        }
+        else if(auto problem
+                = std::dynamic_pointer_cast<Tensile::ContractionProblemSelectionLibrary>(library))
+        {
+            for(auto const& row : problem->rows)
+                findTables(row.second, tables);
+        }
+        else if(auto map
+                = std::dynamic_pointer_cast<Tensile::ContractionProblemMapLibrary>(library))
+        {
+            for(auto const& entry : map->map)
+                findTables(entry.second, tables);
+        }
+        else if(auto ranking
+                = std::dynamic_pointer_cast<Tensile::ContractionModelRankingLibrary>(library))
+        {
+            findTables(ranking->library, tables);
+        }
+        else if(auto placeholder
+                = std::dynamic_pointer_cast<Tensile::PlaceholderLibrary<Problem, Solution>>(
+                    library))
+        {
+            if(placeholder->loadPlaceholderLibrary())
+                findTables(placeholder->library, tables);
+        }
+        else if(auto matching
+                = std::dynamic_pointer_cast<Tensile::ContractionProblemMatchingLibrary>(library))
+        {
+            if(auto table = std::dynamic_pointer_cast<GridBasedTable>(matching->table))
+                tables.push_back(table);
+        }
+    }
+
+    // The leaves of a GridBased table are single solutions, so they are
+    // compared without having to build a problem.
+    std::shared_ptr<Solution> leafSolution(Element const& element)
+    {
+        auto single = std::dynamic_pointer_cast<Tensile::SingleContractionLibrary>(element);
+        return single ? single->solution : nullptr;
+    }
+
+    template <typename MyTable>
+    std::shared_ptr<MyTable> makeTable(std::vector<typename MyTable::Entry> entries)
+    {
+        auto table   = std::make_shared<MyTable>();
+        table->table = std::move(entries);
+        table->buildIndex();
+        return table;
+    }
+
+    template <typename MyTable>
+    double lookupNs(MyTable const&                          table,
+                    std::vector<Key> const&                 queries,
+                    std::vector<std::shared_ptr<Solution>>& picks)
+    {
+        picks.clear();
+        picks.reserve(queries.size());
+
+        auto start = std::chrono::steady_clock::now();
+        for(auto const& query : queries)
+            picks.push_back(std::get<0>(table.findBestKeyMatch(query, leafSolution)));
+        auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count()
+               / std::max<size_t>(queries.size(), 1);
+    }
+
+    template <typename MyTable>
+    size_t heldOutHits(MyTable const&                                     table,
+                       std::vector<typename GridBasedTable::Entry> const& heldOut)
+    {
+        size_t hits = 0;
+        for(auto const& entry : heldOut)
+        {
+            auto solution = std::get<0>(table.findBestKeyMatch(entry.key, leafSolution));
+            if(solution && solution == leafSolution(entry.value))
+                hits++;
+        }
+        return hits;
+    }
+
+    struct Totals
+    {
+        size_t entries       = 0;
+        size_t queries       = 0;
+        double gridNs        = 0;
+        double interpNs      = 0;
+        size_t agreed        = 0;
+        size_t heldOut       = 0;
+        size_t gridHits      = 0;
+        size_t interpHits    = 0;
+        size_t interpMissing = 0;
+    };
+
+    void benchmarkTable(GridBasedTable const& grid,
+                        size_t                queryCount,
+                        size_t                holdoutStride,
+                        std::mt19937_64&      rng,
+                        Totals&               totals)
+    {
+        auto const& entries = grid.table;
+        if(entries.empty())
+            return;
+
+        std::array<double, 3> lo, hi;
+        lo.fill(std::numeric_limits<double>::max());
+        hi.fill(0);
+        for(auto const& entry : entries)
+        {
+            for(size_t i = 0; i < lo.size(); i++)
+            {
+                double c = std::log2(std::max<int64_t>(entry.key[i], 1));
+                lo[i]    = std::min(lo[i], c);
+                hi[i]    = std::max(hi[i], c);
+            }
+        }
+
+        std::vector<Key> queries(queryCount);
+        for(auto& query : queries)
+        {
+            for(size_t i = 0; i < query.size(); i++)
+            {
+                std::uniform_real_distribution<double> dist(lo[i], hi[i] + 1);
+                query[i] = static_cast<int64_t>(std::exp2(dist(rng)));
+            }
+        }
+
+        auto interp = makeTable<GridInterpolatedTable>(entries);
+
+        std::vector<std::shared_ptr<Solution>> gridPicks, interpPicks;
+        totals.gridNs += lookupNs(grid, queries, gridPicks) * queries.size();
+        totals.interpNs += lookupNs(*interp, queries, interpPicks) * queries.size();
+        totals.entries += entries.size();
+        totals.queries += queries.size();
+
+        for(size_t i = 0; i < queries.size(); i++)
+        {
+            if(gridPicks[i] == interpPicks[i])
+                totals.agreed++;
+            else if(gridPicks[i] && !interpPicks[i])
+                totals.interpMissing++;
+        }
+
+        if(holdoutStride < 2 || entries.size() < holdoutStride)
+            return;
+
+        std::vector<typename GridBasedTable::Entry> kept, heldOut;
+        for(size_t i = 0; i < entries.size(); i++)
+        {
+            bool duplicate = i > 0 && entries[i - 1].key == entries[i].key;
+            if(i % holdoutStride == holdoutStride - 1 && !duplicate)
+                heldOut.push_back(entries[i]);
+            else
+                kept.push_back(entries[i]);
+        }
+
+        totals.heldOut += heldOut.size();
+        totals.gridHits += heldOutHits(*makeTable<GridBasedTable>(kept), heldOut);
+        totals.interpHits += heldOutHits(*makeTable<GridInterpolatedTable>(kept), heldOut);
+    }
+
+    // The first k of all points sorted by distance to query, then by index,
+    // which is what KdTree::nearest returns.
+    std::vector<KdTree::Neighbor> linearNearest(std::vector<double> const& points,
+                                                size_t                     dims,
+                                                double const*              query,
+                                                size_t                     k)
+    {
+        std::vector<KdTree::Neighbor> all;
+        for(size_t p = 0; p < points.size() / dims; p++)
+        {
+            double distance = 0.0;
+            for(size_t d = 0; d < dims; d++)
+            {
+                double delta = query[d] - points[p * dims + d];
+                distance += delta * delta;
+            }
+            all.emplace_back(distance, static_cast<uint32_t>(p));
+        }
+
+        std::sort(all.begin(), all.end());
+        all.resize(std::min(k, all.size()));
+        return all;
+    }
+
+    // Returns the number of queries for which the tree and a linear scan
+    // disagree, for k below, at and above the leaf size and the point count.
+    size_t checkKdTree(std::vector<double> const& points,
+                       size_t                     dims,
+                       std::vector<double> const& queries)
+    {
+        KdTree tree;
+        tree.build(points, dims);
+
+        size_t count    = points.size() / dims;
+        size_t failures = 0;
+
+        std::vector<KdTree::Neighbor> nearest;
+        for(size_t k : {size_t(1), size_t(3), size_t(8), size_t(9), count, count + 5})
+        {
+            for(size_t q = 0; q + dims <= queries.size(); q += dims)
+            {
+                tree.nearest(&queries[q], k, nearest);
+                if(nearest != linearNearest(points, dims, &queries[q], k))
+                    failures++;
+            }
+        }
+
+        return failures;
+    }
+
+    // Random points, and points on a small integer grid where most distances
+    // tie, each also with every point repeated. They are queried at random
+    // points and at the points themselves.
+    size_t checkKdTree(std::mt19937_64& rng)
+    {
+        std::uniform_real_distribution<double> real(0, 4);
+        std::uniform_int_distribution<int>     integer(0, 4);
+        std::uniform_int_distribution<int>     halves(0, 8);
+
+        size_t failures = 0;
+        for(size_t dims = 1; dims <= 4; dims++)
+        {
+            for(size_t count : {0, 1, 8, 9, 100, 1000})
+            {
+                for(bool grid : {false, true})
+                {
+                    std::vector<double> points(count * dims);
+                    for(auto& c : points)
+                        c = grid ? integer(rng) : real(rng);
+
+                    for(size_t copies : {1, 3})
+                    {
+                        std::vector<double> repeated;
+                        for(size_t i = 0; i < copies; i++)
+                            repeated.insert(repeated.end(), points.begin(), points.end());
+
+                        std::vector<double> queries(
+                            points.begin(), points.begin() + std::min(points.size(), 64 * dims));
+                        for(size_t i = 0; i < 64 * dims; i++)
+                            queries.push_back(grid ? halves(rng) / 2.0 : real(rng));
+
+                        failures += checkKdTree(repeated, dims, queries);
+                    }
+                }
+            }
+        }
+
+        return failures;
+    }
+
+    // The index GridInterpolated builds over table, queried at its tuned
+    // sizes and halfway between neighbouring ones.
+    size_t checkKdTree(GridBasedTable const& table)
+    {
+        if(table.table.empty())
+            return 0;
+
+        size_t              dims = table.table.front().key.size();
+        std::vector<double> points;
+        for(auto const& entry : table.table)
+        {
+            for(size_t i = 0; i < dims; i++)
+                points.push_back(
+                    Tensile::Matching::GridInterpolatedDistance<Key>::coordinate(entry.key[i]));
+        }
+
+        std::vector<double> queries(points.begin(),
+                                    points.begin() + std::min(points.size(), 256 * dims));
+        for(size_t i = dims; i < std::min(points.size(), 256 * dims); i++)
+            queries.push_back((points[i - dims] + points[i]) / 2);
+
+        return checkKdTree(points, dims, queries);
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    po::options_description options("Matching benchmark options");
+    // clang-format off
+    options.add_options()
+        ("help,h", "Show help message.")
+        ("library-file,l",  po::value<std::vector<std::string>>(),
+                            "Library file to load. May be given several times.")
+        ("queries,q",       po::value<size_t>()->default_value(10000),
+                            "Number of timed lookups per table.")
+        ("holdout-stride",  po::value<size_t>()->default_value(4),
+                            "Every n'th tuned size is held out to measure selection quality. "
+                            "0 disables the measurement.")
+        ("seed",            po::value<unsigned>()->default_value(0),
+                            "Seed for the random lookup sizes.")
+        ("check",           "Check the k-d tree against a linear scan instead of benchmarking.")
+        ;
+    // clang-format on
+
+    po::variables_map args;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, options), args);
+        if(args.count("help"))
+        {
+            std::cout << options << std::endl;
+            return 0;
+        }
+        po::notify(args);
+        if(!args.count("library-file") && !args.count("check"))
+            throw std::runtime_error("the option '--library-file' is required but missing");
+    }
+    catch(std::exception const& exc)
+    {
+        std::cerr << exc.what() << std::endl << options << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> files;
+    if(args.count("library-file"))
+        files = args["library-file"].as<std::vector<std::string>>();
+
+    size_t queryCount    = args["queries"].as<size_t>();
+    size_t holdoutStride = args["holdout-stride"].as<size_t>();
+
+    std::mt19937_64 rng(args["seed"].as<unsigned>());
+
+    if(args.count("check"))
+    {
+        size_t failures = checkKdTree(rng);
+        std::cout << failures << " k-d tree mismatches on synthetic points" << std::endl;
+
+        for(auto const& file : files)
+        {
+            auto library = Tensile::LoadLibraryFile<Problem, Solution>(file);
+            if(!library)
+            {
+                std::cerr << "Failed to load " << file << std::endl;
+                return 1;
+            }
+
+            std::vector<std::shared_ptr<GridBasedTable>> tables;
+            findTables(library, tables);
+
+            size_t tableFailures = 0;
+            for(auto const& table : tables)
+                tableFailures += checkKdTree(*table);
+            std::cout << tableFailures << " k-d tree mismatches on " << tables.size()
+                      << " tables of " << file << std::endl;
+            failures += tableFailures;
+        }
+
+        return failures ? 1 : 0;
+    }
+
+    std::cout << std::setw(8) << "tables" << std::setw(10) << "entries" << std::setw(14)
+              << "grid (ns)" << std::setw(14) << "interp (ns)" << std::setw(10) << "agree%"
+              << std::setw(10) << "held out"
+              << std::setw(12) << "grid hit%" << std::setw(12) << "interp hit%"
+              << "  file" << std::endl;
+
+    int rv = 0;
+    for(auto const& file : files)
+    {
+        auto library = Tensile::LoadLibraryFile<Problem, Solution>(file);
+        if(!library)
+        {
+            std::cerr << "Failed to load " << file << std::endl;
+            rv = 1;
+            continue;
+        }
+
+        std::vector<std::shared_ptr<GridBasedTable>> tables;
+        findTables(library, tables);
+
+        Totals totals;
+        for(auto const& table : tables)
+            benchmarkTable(*table, queryCount, holdoutStride, rng, totals);
+
+        auto perLookup = [&](double ns) { return totals.queries ? ns / totals.queries : 0.0; };
+        auto agreeRate = totals.queries ? 100.0 * totals.agreed / totals.queries : 0.0;
+        auto hitRate   = [&](size_t hits) {
+            return totals.heldOut ? 100.0 * hits / totals.heldOut : 0.0;
+        };
+
+        std::cout << std::fixed << std::setprecision(1) << std::setw(8) << tables.size()
+                  << std::setw(10) << totals.entries << std::setw(14) << perLookup(totals.gridNs)
+                  << std::setw(14) << perLookup(totals.interpNs) << std::setw(10) << agreeRate
+                  << std::setw(10) << totals.heldOut << std::setw(12) << hitRate(totals.gridHits)
+                  << std::setw(12) << hitRate(totals.interpHits) << "  " << file << std::endl;
+
+        if(totals.interpMissing > 0)
+        {
+            std::cerr << totals.interpMissing
+                      << " lookups found a solution with GridBased but not GridInterpolated"
+                      << std::endl;
+            rv = 1;
+        }
+    }
+
+    return rv;
+}
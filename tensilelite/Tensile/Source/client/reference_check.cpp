@@ -0,0 +1,184 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Checks that the reference solution gives bitwise the same D when plain
+// GEMMs are summed tile by tile as when every element is summed on its own:
+//
+//   tensile_reference_check
+//
+// Both are run on the same random A, B and C, for each data type the client
+// was built with, each transpose of A and B and sizes that leave partial
+// tiles in every dimension. Exits with 1 if any element of D differs.
+
+#include <Reference.hpp>
+#include <TypedId.hpp>
+
+#include <Tensile/ContractionProblem.hpp>
+
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    using Problem = Tensile::ContractionProblemGemm;
+
+    template <typename T>
+    std::vector<T> randomValues(size_t count, std::mt19937& rng)
+    {
+        std::uniform_int_distribution<int>    ints(-3, 3);
+        std::uniform_real_distribution<float> reals(-1.0f, 1.0f);
+
+        std::vector<T> values(count);
+        for(auto& value : values)
+        {
+            if constexpr(std::is_integral<T>())
+                value = static_cast<T>(ints(rng));
+            else
+                value = static_cast<T>(reals(rng));
+        }
+        return values;
+    }
+
+    // Solves every problem both ways and returns the number of problems for
+    // which D differs.
+    template <typename Typed>
+    size_t checkType(bool highPrecisionAccumulate, std::mt19937& rng)
+    {
+        using AType     = typename Typed::AType;
+        using BType     = typename Typed::BType;
+        using CType     = typename Typed::CType;
+        using DType     = typename Typed::DType;
+        using AlphaType = typename Typed::AlphaType;
+        using BetaType  = typename Typed::BetaType;
+
+        // Odd sizes, so that the tiles of M, N and K are all partial, and
+        // vectors in M and N.
+        std::vector<std::array<size_t, 4>> const sizes
+            = {{67, 45, 131, 1}, {129, 300, 257, 3}, {1, 513, 77, 2}, {300, 1, 600, 1}};
+
+        size_t mismatches = 0;
+        for(int trans = 0; trans < 4; trans++)
+        {
+            bool transA = trans & 1, transB = trans & 2;
+            for(auto const& size : sizes)
+            {
+                auto [m, n, k, batch] = size;
+
+                auto problem = Problem::GEMM_Strides(transA,
+                                                     transB,
+                                                     Tensile::TypeInfo<AType>::Enum,
+                                                     Tensile::TypeInfo<BType>::Enum,
+                                                     Tensile::TypeInfo<CType>::Enum,
+                                                     Tensile::TypeInfo<DType>::Enum,
+                                                     m,
+                                                     n,
+                                                     k,
+                                                     batch,
+                                                     transA ? k : m,
+                                                     -1,
+                                                     transB ? n : k,
+                                                     -1,
+                                                     m,
+                                                     -1,
+                                                     m,
+                                                     -1,
+                                                     1.0);
+                problem.setAlphaType(Tensile::TypeInfo<AlphaType>::Enum);
+                problem.setBetaType(Tensile::TypeInfo<BetaType>::Enum);
+                problem.setHighPrecisionAccumulate(highPrecisionAccumulate);
+
+                auto a = randomValues<AType>(problem.a().totalAllocatedElements(), rng);
+                auto b = randomValues<BType>(problem.b().totalAllocatedElements(), rng);
+                auto c = randomValues<CType>(problem.c().totalAllocatedElements(), rng);
+
+                size_t const        dElements = problem.d().totalAllocatedElements();
+                std::vector<DType>  blocked(dElements), elementwise(dElements);
+                std::vector<DType>* outputs[] = {&blocked, &elementwise};
+
+                for(auto* d : outputs)
+                {
+                    Tensile::ContractionInputs inputs;
+                    inputs.a = a.data();
+                    inputs.b = b.data();
+                    inputs.c = c.data();
+                    inputs.d = d->data();
+                    if constexpr(std::is_integral<AlphaType>())
+                    {
+                        inputs.alpha = static_cast<AlphaType>(2);
+                        inputs.beta  = static_cast<BetaType>(3);
+                    }
+                    else
+                    {
+                        inputs.alpha = static_cast<AlphaType>(1.5);
+                        inputs.beta  = static_cast<BetaType>(0.5);
+                    }
+
+                    Tensile::Client::SolveCPU(&problem, &inputs, 0, d == &blocked);
+                }
+
+                if(std::memcmp(blocked.data(), elementwise.data(), dElements * sizeof(DType))
+                   != 0)
+                {
+                    std::cerr << "D differs for " << problem << std::endl;
+                    mismatches++;
+                }
+            }
+        }
+        return mismatches;
+    }
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    std::mt19937 rng(0);
+    size_t       mismatches = 0;
+
+    mismatches += checkType<Tensile::TypedGemm_S_S_S>(false, rng);
+    mismatches += checkType<Tensile::TypedGemm_D_D_D>(false, rng);
+    mismatches += checkType<Tensile::TypedGemm_I8_I32_I32>(false, rng);
+#ifdef TENSILE_USE_HALF
+    mismatches += checkType<Tensile::TypedGemm_H_H_S>(true, rng);
+#endif
+#ifdef TENSILE_USE_BF16
+    mismatches += checkType<Tensile::TypedGemm_B_B_S>(true, rng);
+#endif
+#ifdef TENSILE_USE_FP8_BF8
+    mismatches += checkType<Tensile::TypedGemm_F8_S_S>(true, rng);
+#endif
+
+    if(mismatches > 0)
+    {
+        std::cerr << mismatches << " problems differ" << std::endl;
+        return 1;
+    }
+
+    std::cout << "The tiled and element by element reference solutions agree." << std::endl;
+    return 0;
+}
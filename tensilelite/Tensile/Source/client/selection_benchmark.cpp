@@ -0,0 +1,687 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Measures how long solution selection takes for a set of representative
+// GEMM problems, and how much of it goes into evaluating the predicates of
+// the solutions that were loaded on the way:
+//
+//   TENSILE_COMPILE_PREDICATES=0 tensile_selection_benchmark -l TensileLibrary_gfx942.dat
+//   TENSILE_COMPILE_PREDICATES=1 tensile_selection_benchmark -l TensileLibrary_gfx942.dat
+//
+// The predicates of a loaded library are compiled unless
+// TENSILE_COMPILE_PREDICATES=0 is set, so running with both settings compares
+// the two for findTopSolutions. The predicate columns always compare the
+// compiled predicates with the trees they were compiled from.
+//
+// Every run also checks that the compiled problem and hardware predicates of
+// each loaded solution give the same result as their trees, and exits with 1
+// if one doesn't. --check only does the checks, without timing anything, and
+// also checks the lookups that only serve to make selection faster:
+//
+//   - the row index of problem selection libraries, of the library and of a
+//     synthetic one with mixed and unkeyed rows, against checking every row,
+//   - solutions by index, including those of lazily loaded sub-libraries,
+//     against the solution map,
+//   - findTopSolutions and findTopSolutionsGroupedGemm of lazily loaded
+//     sub-libraries against those of the library they load,
+//   - the roofline model of ModelRanking libraries against projections
+//     worked out by hand.
+
+#include <Tensile/AMDGPU.hpp>
+#include <Tensile/ContractionLibrary.hpp>
+#include <Tensile/ContractionProblemPredicates.hpp>
+#include <Tensile/Contractions.hpp>
+#include <Tensile/Debug.hpp>
+#include <Tensile/MasterSolutionLibrary.hpp>
+#include <Tensile/ModelRankingLibrary.hpp>
+#include <Tensile/PlaceholderLibrary.hpp>
+#include <Tensile/Tensile.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+namespace
+{
+    using Problem   = Tensile::ContractionProblemGemm;
+    using Solution  = Tensile::ContractionSolution;
+    using Library   = Tensile::SolutionLibrary<Problem, Solution>;
+    using Predicate = Tensile::Predicates::Predicate<Problem>;
+
+    struct Types
+    {
+        Tensile::DataType a, b, cd, compute;
+    };
+
+    std::vector<Problem> makeProblems(Types const& types)
+    {
+        // Square, skinny and odd sized problems, as seen from the frameworks.
+        std::vector<std::array<size_t, 4>> const sizes = {{128, 128, 128, 1},
+                                                          {1024, 1024, 1024, 1},
+                                                          {4096, 4096, 4096, 1},
+                                                          {8192, 1, 8192, 1},
+                                                          {1, 4096, 4096, 1},
+                                                          {1000, 1000, 1000, 1},
+                                                          {3072, 768, 1024, 4},
+                                                          {127, 255, 511, 8}};
+
+        std::vector<Problem> problems;
+        for(int trans = 0; trans < 4; trans++)
+        {
+            bool transA = trans & 1, transB = trans & 2;
+            for(auto const& size : sizes)
+            {
+                auto [m, n, k, batch] = size;
+
+                auto problem = Problem::GEMM_Strides(transA,
+                                                     transB,
+                                                     types.a,
+                                                     types.b,
+                                                     types.cd,
+                                                     types.cd,
+                                                     m,
+                                                     n,
+                                                     k,
+                                                     batch,
+                                                     transA ? k : m,
+                                                     -1,
+                                                     transB ? n : k,
+                                                     -1,
+                                                     m,
+                                                     -1,
+                                                     m,
+                                                     -1,
+                                                     0.0);
+                problem.setComputeInputType(types.a);
+                problem.setAlphaType(types.compute);
+                problem.setBetaType(types.compute);
+                problem.setHighPrecisionAccumulate(
+                    Tensile::DataTypeInfo::Get(types.compute).elementSize
+                    > Tensile::DataTypeInfo::Get(types.a).elementSize);
+                problems.push_back(problem);
+            }
+        }
+        return problems;
+    }
+
+    template <typename F>
+    double timeNs(int iterations, F&& f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < iterations; i++)
+            f();
+        auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    }
+
+    // Evaluates the problem predicate of every solution, either as compiled or
+    // as the tree it was compiled from, and returns how many of them hold.
+    size_t countMatches(std::vector<std::shared_ptr<Predicate>> const& predicates,
+                        Problem const&                                 problem)
+    {
+        size_t matches = 0;
+        for(auto const& predicate : predicates)
+            matches += (*predicate)(problem);
+        return matches;
+    }
+
+    // Compares the compiled predicate of each solution with its tree for obj,
+    // printing the solutions for which they disagree. Returns the number of
+    // those solutions.
+    template <typename Member, typename Object>
+    size_t checkPredicates(std::vector<std::shared_ptr<Solution>> const& solutions,
+                           Member                                        member,
+                           Object const&                                 obj,
+                           std::string const&                            description)
+    {
+        size_t mismatches = 0;
+        for(auto const& solution : solutions)
+        {
+            auto const& compiled = solution.get()->*member;
+            if(!compiled)
+                continue;
+
+            bool rv = (*compiled)(obj);
+            if(rv != (*Tensile::Predicates::Uncompiled(compiled))(obj))
+            {
+                std::cerr << "Solution " << solution->index << " (" << solution->name()
+                          << "): compiled predicate gives " << rv << ", its tree " << !rv
+                          << " for " << description << std::endl;
+                mismatches++;
+            }
+        }
+        return mismatches;
+    }
+
+    // Calls f on every library reachable from library, loading placeholders on
+    // the way.
+    template <typename F>
+    void forEachLibrary(std::shared_ptr<Library> const& library, F&& f)
+    {
+        if(!library)
+            return;
+
+        f(library);
+
+        if(auto master = std::dynamic_pointer_cast<Tensile::MasterContractionLibrary>(library))
+        {
+            forEachLibrary(master->library, f);
+        }
+        else if(auto hardware
+                = std::dynamic_pointer_cast<Tensile::ContractionHardwareSelectionLibrary>(library))
+        {
+            for(auto const& row : hardware->rows)
+                forEachLibrary(row.second, f);
+        }
+        else if(auto problem
+                = std::dynamic_pointer_cast<Tensile::ContractionProblemSelectionLibrary>(library))
+        {
+            for(auto const& row : problem->rows)
+                forEachLibrary(row.second, f);
+        }
+        else if(auto map
+                = std::dynamic_pointer_cast<Tensile::ContractionProblemMapLibrary>(library))
+        {
+            for(auto const& entry : map->map)
+                forEachLibrary(entry.second, f);
+        }
+        else if(auto ranking
+                = std::dynamic_pointer_cast<Tensile::ContractionModelRankingLibrary>(library))
+        {
+            forEachLibrary(ranking->library, f);
+        }
+        else if(auto placeholder
+                = std::dynamic_pointer_cast<Tensile::PlaceholderLibrary<Problem, Solution>>(
+                    library))
+        {
+            if(placeholder->loadPlaceholderLibrary())
+                forEachLibrary(placeholder->library, f);
+        }
+    }
+
+    // Compares the rows that the index of library finds for each problem with
+    // those found by checking every row.
+    size_t checkRowIndex(Tensile::ContractionProblemSelectionLibrary const& library,
+                         std::vector<Problem> const&                        problems,
+                         Tensile::Hardware const&                           hardware)
+    {
+        size_t mismatches = 0;
+        for(auto const& problem : problems)
+        {
+            std::vector<size_t> expected;
+            for(size_t idx = 0; idx < library.rows.size(); idx++)
+            {
+                if(library.rows[idx].first(problem, hardware))
+                    expected.push_back(idx);
+            }
+
+            if(library.matchingRows(problem, hardware) != expected)
+            {
+                std::cerr << "The row index of a " << library.description()
+                          << " misses or adds rows for " << problem.description() << std::endl;
+                mismatches++;
+            }
+        }
+        return mismatches;
+    }
+
+    // Rows keyed by every subset of the flags below, set and clear, with and
+    // without data types, so with more signatures than the index groups by,
+    // mixed with repeated, always true and unkeyed rows.
+    Tensile::ContractionProblemSelectionLibrary syntheticRows(Types const& types)
+    {
+        using namespace Tensile::Predicates;
+        using namespace Tensile::Predicates::Contraction;
+
+        auto typesEqual   = std::make_shared<TypesEqual>();
+        typesEqual->value = {types.a, types.b, types.cd, types.cd, types.a};
+
+        std::vector<Tensile::ContractionProblemSelectionLibrary::Row> rows;
+        auto addRow = [&](std::shared_ptr<Predicate> predicate) {
+            rows.emplace_back(Tensile::ContractionProblemPredicate(predicate), nullptr);
+        };
+
+        for(int subset = 0; subset < 32; subset++)
+        {
+            for(bool value : {true, false})
+            {
+                std::vector<std::shared_ptr<Predicate>> terms;
+                if(subset & 1)
+                    terms.push_back(std::make_shared<HighPrecisionAccumulateEqual>(value));
+                if(subset & 2)
+                    terms.push_back(std::make_shared<StridedBatchedEqual>(value));
+                if(subset & 4)
+                    terms.push_back(std::make_shared<UseBiasEqual>(!value));
+                if(subset & 8)
+                    terms.push_back(std::make_shared<GroupedGemmEqual>(!value));
+                if(subset & 16)
+                    terms.push_back(typesEqual);
+
+                addRow(Compile<Problem>(std::make_shared<And<Problem>>(terms)));
+                if(subset % 5 == 0)
+                    addRow(std::make_shared<BoundSizeMultiple>(0, 2));
+                if(subset % 7 == 0)
+                    addRow(rows.back().first.value);
+            }
+        }
+
+        return Tensile::ContractionProblemSelectionLibrary(rows);
+    }
+
+    // Looks every solution of the map of master up by index, and indices
+    // around them that it doesn't have.
+    size_t checkSolutionTable(Tensile::MasterContractionLibrary const& master)
+    {
+        size_t mismatches = 0;
+
+        std::map<int, std::shared_ptr<Solution>> solutions;
+        {
+            std::lock_guard<std::mutex> guard(master.solutionsGuard);
+            solutions = master.solutions;
+        }
+
+        for(auto const& entry : solutions)
+        {
+            for(int index : {entry.first - 1, entry.first, entry.first + 1})
+            {
+                auto iter     = solutions.find(index);
+                auto expected = iter == solutions.end() ? nullptr : iter->second;
+                if(master.getSolutionByIndex(index) != expected)
+                {
+                    std::cerr << "getSolutionByIndex(" << index << ") does not give the solution"
+                              << " of the solution map" << std::endl;
+                    mismatches++;
+                }
+            }
+        }
+
+        return mismatches;
+    }
+
+    // PlaceholderLibrary used to find nothing with findTopSolutions and
+    // findTopSolutionsGroupedGemm, so they are checked against those of the
+    // sub-library it loads. found counts the lookups that found solutions.
+    size_t checkTopSolutions(Tensile::PlaceholderLibrary<Problem, Solution> const& placeholder,
+                             std::vector<Problem> const&                           problems,
+                             Tensile::Hardware const&                              hardware,
+                             size_t&                                               found)
+    {
+        if(!placeholder.loadPlaceholderLibrary())
+            return 0;
+
+        size_t mismatches = 0;
+        for(auto const& problem : problems)
+        {
+            auto const& sub = *placeholder.library;
+
+            auto top     = placeholder.findTopSolutions(problem, hardware, 4);
+            auto grouped = placeholder.findTopSolutionsGroupedGemm({problem}, hardware, 4);
+            found += !top.empty() + !grouped.empty();
+
+            if(top != sub.findTopSolutions(problem, hardware, 4)
+               || grouped != sub.findTopSolutionsGroupedGemm({problem}, hardware, 4))
+            {
+                std::cerr << "The placeholder " << placeholder.name() << " does not find the "
+                          << "top solutions of its library for " << problem.description()
+                          << std::endl;
+                mismatches++;
+            }
+        }
+        return mismatches;
+    }
+
+    Problem halfGemm(size_t m, size_t n, size_t k)
+    {
+        auto const half = Tensile::DataType::Half;
+        return Problem::GEMM_Strides(
+            false, false, half, half, half, half, m, n, k, 1, m, -1, k, -1, m, -1, m, -1, 0.0);
+    }
+
+    std::shared_ptr<Solution> tiledSolution(int index, size_t macroTile, size_t globalSplitU)
+    {
+        auto solution                               = std::make_shared<Solution>();
+        solution->index                             = index;
+        solution->problemType.aType                 = Tensile::DataType::Half;
+        solution->problemType.bType                 = Tensile::DataType::Half;
+        solution->problemType.cType                 = Tensile::DataType::Half;
+        solution->problemType.dType                 = Tensile::DataType::Half;
+        solution->problemType.useBeta               = false;
+        solution->sizeMapping.macroTile             = {macroTile, macroTile, 1};
+        solution->sizeMapping.workGroupSize         = {256, 1, 1};
+        solution->sizeMapping.globalSplitU          = globalSplitU;
+        solution->sizeMapping.globalAccumulation    = globalSplitU > 1;
+        solution->sizeMapping.workspaceSizePerElemC = globalSplitU > 1 ? 4 : 0;
+        return solution;
+    }
+
+    // Compares rooflinePerformance with projections worked out by hand, on a
+    // GPU with 256 CUs, and checks that ModelRankingLibrary ranks by it.
+    size_t checkRoofline()
+    {
+        Tensile::AMDGPU gpu(Tensile::AMDGPU::Processor::gfx942, 256, "gfx942");
+        gpu.clockMHz        = 1000.0;
+        gpu.memoryBandwidth = 10000.0;
+
+        Solution::RooflineCalibration calibration;
+        calibration.flopsPerCuPerCycle = 1000.0;
+        calibration.memoryEfficiency   = 1.0;
+        calibration.computeEfficiency  = 1.0;
+        calibration.launchOverhead     = 5.0;
+
+        // With the clock and bandwidth of gpu, and with a slower memory.
+        auto fast            = calibration.resolve(gpu);
+        auto slow            = fast;
+        slow.memoryBandwidth = 1000.0;
+
+        Tensile::AMDGPU uncalibrated(Tensile::AMDGPU::Processor::gfx942, 256, "gfx942");
+
+        struct Case
+        {
+            char const*                   name;
+            Problem                       problem;
+            std::shared_ptr<Solution>     solution;
+            Solution::RooflineCalibration calibration;
+            double                        speedGFlops;
+        };
+
+        // 4096^3 on 256x256 tiles is one tile per CU, with no granularity
+        // loss. 2*4096^3 flops at 256 CUs * 1000 flops * 1 GHz take
+        // 536.870912 us. A and B are read once per tile row and column,
+        // 2 * 4096^3 / 256 * 2 bytes, and D is written once, 4096^2 * 2
+        // bytes: 1107296256 bytes, 110.7296256 us at 10 TB/s, or
+        // 1107.296256 us at 1 TB/s, plus one 5 us launch.
+        //
+        // 1024x1024x16384 on 256x256 tiles with GSU 4 is 16 tiles over
+        // 64 CU groups, a CU granularity of 0.25. That takes 536.870912 us
+        // to compute and, with a quarter of the bandwidth, 1140.850688 us
+        // to move 268435456 bytes of A and B, 8388608 bytes of D written
+        // with atomics and 8388608 bytes of workspace, plus two launches.
+        std::vector<Case> cases = {
+            {"compute bound",
+             halfGemm(4096, 4096, 4096),
+             tiledSolution(0, 256, 1),
+             fast,
+             2.0 * 4096 * 4096 * 4096 / 541.870912e-6 * 1.0e-9},
+            {"memory bound",
+             halfGemm(4096, 4096, 4096),
+             tiledSolution(0, 256, 1),
+             slow,
+             2.0 * 4096 * 4096 * 4096 / 1112.296256e-6 * 1.0e-9},
+            {"GSU",
+             halfGemm(1024, 1024, 16384),
+             tiledSolution(0, 256, 4),
+             slow,
+             2.0 * 1024 * 1024 * 16384 / 1150.850688e-6 * 1.0e-9},
+            {"uncalibrated",
+             halfGemm(4096, 4096, 4096),
+             tiledSolution(0, 256, 1),
+             calibration.resolve(uncalibrated),
+             0.0},
+        };
+
+        size_t mismatches = 0;
+        for(auto const& c : cases)
+        {
+            double speed
+                = c.solution->rooflinePerformance(c.problem, gpu, c.calibration).speedGFlops;
+            if(std::abs(speed - c.speedGFlops) > 1.0e-9 * c.speedGFlops)
+            {
+                std::cerr << "rooflinePerformance, " << c.name << ": " << speed
+                          << " GFlops instead of " << c.speedGFlops << std::endl;
+                mismatches++;
+            }
+        }
+
+        // Smaller tiles read A and B more often, so they rank lower when
+        // memory bound, and nothing is ranked without a calibration.
+        Tensile::ModelRankingLibrary<Problem> ranking;
+        ranking.calibration                 = calibration;
+        ranking.calibration.memoryBandwidth = 1000.0;
+        for(auto const& solution : {tiledSolution(0, 64, 1), tiledSolution(1, 256, 1)})
+            ranking.solutions[solution->index] = solution;
+
+        double fitness = -1.0;
+        auto   problem = halfGemm(4096, 4096, 4096);
+        auto   top     = ranking.findTopSolutions(problem, gpu, 2);
+        auto   best    = ranking.findBestSolution(problem, gpu, &fitness);
+        if(top.size() != 2 || top[0]->index != 1 || top[1]->index != 0 || best != top[0]
+           || fitness < 0.0 || !ranking.findTopSolutions(problem, uncalibrated, 2).empty())
+        {
+            std::cerr << "ModelRankingLibrary does not rank by rooflinePerformance" << std::endl;
+            mismatches++;
+        }
+
+        auto grouped = ranking.findTopSolutionsGroupedGemm(
+            {problem, halfGemm(1024, 1024, 1024)}, gpu, 2);
+        if(grouped != top)
+        {
+            std::cerr << "ModelRankingLibrary does not rank grouped GEMMs by rooflinePerformance"
+                      << std::endl;
+            mismatches++;
+        }
+
+        return mismatches;
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    po::options_description options("Selection benchmark options");
+    // clang-format off
+    options.add_options()
+        ("help,h", "Show help message.")
+        ("library-file,l", po::value<std::string>()->required(), "Library file to load.")
+        ("architecture",   po::value<std::string>()->default_value("gfx942"),
+                           "Architecture to select solutions for.")
+        ("cu-count",       po::value<int>()->default_value(304), "Number of compute units.")
+        ("type-a",         po::value<Tensile::DataType>()->default_value(Tensile::DataType::Half),
+                           "Data type of A and of the compute input.")
+        ("type-b",         po::value<Tensile::DataType>()->default_value(Tensile::DataType::Half),
+                           "Data type of B.")
+        ("type-cd",        po::value<Tensile::DataType>()->default_value(Tensile::DataType::Half),
+                           "Data type of C and D.")
+        ("type-compute",   po::value<Tensile::DataType>()->default_value(Tensile::DataType::Float),
+                           "Data type of alpha, beta and the accumulation.")
+        ("solutions,n",    po::value<int>()->default_value(1),
+                           "Number of solutions to ask findTopSolutions for.")
+        ("iterations,i",   po::value<int>()->default_value(100),
+                           "Number of timed calls per problem.")
+        ("check",          "Only check the compiled predicates against their trees.")
+        ;
+    // clang-format on
+
+    po::variables_map args;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, options), args);
+        if(args.count("help"))
+        {
+            std::cout << options << std::endl;
+            return 0;
+        }
+        po::notify(args);
+    }
+    catch(std::exception const& exc)
+    {
+        std::cerr << exc.what() << std::endl << options << std::endl;
+        return 1;
+    }
+
+    auto file         = args["library-file"].as<std::string>();
+    auto architecture = args["architecture"].as<std::string>();
+    int  numSolutions = args["solutions"].as<int>();
+    int  iterations   = std::max(args["iterations"].as<int>(), 1);
+    bool check        = args.count("check") > 0;
+
+    Types types{args["type-a"].as<Tensile::DataType>(),
+                args["type-b"].as<Tensile::DataType>(),
+                args["type-cd"].as<Tensile::DataType>(),
+                args["type-compute"].as<Tensile::DataType>()};
+
+    Tensile::AMDGPU hardware(Tensile::AMDGPU::toProcessor(architecture),
+                             args["cu-count"].as<int>(),
+                             architecture);
+
+    auto library = Tensile::LoadLibraryFile<Problem, Solution>(file);
+    if(!library)
+    {
+        std::cerr << "Failed to load " << file << std::endl;
+        return 1;
+    }
+
+    std::cout << "Predicates are "
+              << (Tensile::Debug::Instance().compilePredicates() ? "compiled" : "not compiled")
+              << " at load." << std::endl;
+
+    auto problems = makeProblems(types);
+
+    // The first call loads any placeholder libraries a problem needs, so it
+    // is not timed.
+    std::vector<double> selectNs;
+    std::vector<size_t> found;
+    for(auto const& problem : problems)
+    {
+        found.push_back(library->findTopSolutions(problem, hardware, numSolutions).size());
+        if(!check)
+            selectNs.push_back(timeNs(iterations, [&]() {
+                library->findTopSolutions(problem, hardware, numSolutions);
+            }));
+    }
+
+    std::vector<std::shared_ptr<Solution>>  solutions;
+    std::vector<std::shared_ptr<Predicate>> compiled, source;
+    if(auto master = std::dynamic_pointer_cast<Tensile::MasterContractionLibrary>(library))
+    {
+        for(auto const& entry : master->solutions)
+        {
+            solutions.push_back(entry.second);
+            compiled.push_back(entry.second->problemPredicate);
+            source.push_back(Tensile::Predicates::Uncompiled(entry.second->problemPredicate));
+        }
+    }
+
+    size_t mismatches
+        = checkPredicates(solutions, &Solution::hardwarePredicate, hardware, architecture);
+    for(auto const& problem : problems)
+        mismatches += checkPredicates(
+            solutions, &Solution::problemPredicate, problem, problem.description());
+
+    if(check)
+    {
+        std::cout << "Checked the predicates of " << solutions.size() << " solutions on "
+                  << problems.size() << " problems: " << mismatches << " mismatches."
+                  << std::endl;
+
+        // The synthetic rows are also checked on problems of other types.
+        auto otherTypes = makeProblems({Tensile::DataType::Float,
+                                        Tensile::DataType::Float,
+                                        Tensile::DataType::Float,
+                                        Tensile::DataType::Float});
+        auto checked    = problems;
+        checked.insert(checked.end(), otherTypes.begin(), otherTypes.end());
+        for(size_t i = 0; i < checked.size(); i += 2)
+            checked[i].setHighPrecisionAccumulate(!checked[i].highPrecisionAccumulate());
+
+        size_t indexMismatches = checkRowIndex(syntheticRows(types), checked, hardware);
+        size_t rowLibraries    = 0;
+        forEachLibrary(library, [&](std::shared_ptr<Library> const& sub) {
+            if(auto rows
+               = std::dynamic_pointer_cast<Tensile::ContractionProblemSelectionLibrary>(sub))
+            {
+                indexMismatches += checkRowIndex(*rows, checked, hardware);
+                rowLibraries++;
+            }
+        });
+        std::cout << "Checked the row index of " << rowLibraries
+                  << " problem selection libraries and a synthetic one: " << indexMismatches
+                  << " mismatches." << std::endl;
+
+        size_t lookupMismatches = 0, found = 0;
+        forEachLibrary(library, [&](std::shared_ptr<Library> const& sub) {
+            if(auto placeholder
+               = std::dynamic_pointer_cast<Tensile::PlaceholderLibrary<Problem, Solution>>(sub))
+                lookupMismatches += checkTopSolutions(*placeholder, checked, hardware, found);
+        });
+        // After the loop above, so that every sub-library is loaded.
+        if(auto master = std::dynamic_pointer_cast<Tensile::MasterContractionLibrary>(library))
+            lookupMismatches += checkSolutionTable(*master);
+        std::cout << "Checked the solution lookups: " << lookupMismatches << " mismatches, "
+                  << found << " top solution lookups through placeholders found solutions."
+                  << std::endl;
+
+        size_t modelMismatches = checkRoofline();
+        std::cout << "Checked the roofline model: " << modelMismatches << " mismatches."
+                  << std::endl;
+
+        return mismatches + indexMismatches + lookupMismatches + modelMismatches != 0;
+    }
+
+    std::cout << std::setw(6) << "trans" << std::setw(20) << "size" << std::setw(8) << "found"
+              << std::setw(14) << "select (ns)" << std::setw(12) << "matching" << std::setw(16)
+              << "compiled (ns)" << std::setw(14) << "tree (ns)" << std::endl;
+
+    int    rv            = mismatches != 0;
+    double selectTotal   = 0;
+    double compiledTotal = 0;
+    double sourceTotal   = 0;
+    for(size_t i = 0; i < problems.size(); i++)
+    {
+        auto const& problem = problems[i];
+
+        size_t matches = countMatches(compiled, problem);
+
+        double compiledNs = timeNs(iterations, [&]() { countMatches(compiled, problem); });
+        double sourceNs   = timeNs(iterations, [&]() { countMatches(source, problem); });
+
+        selectTotal += selectNs[i];
+        compiledTotal += compiledNs;
+        sourceTotal += sourceNs;
+
+        std::ostringstream trans, size;
+        trans << (problem.transA() ? "T" : "N") << (problem.transB() ? "T" : "N");
+        size << problem.freeSizeA(0) << "x" << problem.freeSizeB(0) << "x"
+             << problem.boundSize(0) << "x" << problem.batchSize(0);
+
+        std::cout << std::fixed << std::setprecision(1) << std::setw(6) << trans.str()
+                  << std::setw(20) << size.str() << std::setw(8) << found[i] << std::setw(14)
+                  << selectNs[i] << std::setw(12) << matches << std::setw(16) << compiledNs
+                  << std::setw(14) << sourceNs << std::endl;
+    }
+
+    auto mean = [&](double total) { return total / std::max<size_t>(problems.size(), 1); };
+    std::cout << std::setw(6) << "mean" << std::setw(42) << mean(selectTotal) << std::setw(28)
+              << mean(compiledTotal) << std::setw(14) << mean(sourceTotal) << "  ("
+              << compiled.size() << " solutions loaded)" << std::endl;
+
+    return rv;
+}
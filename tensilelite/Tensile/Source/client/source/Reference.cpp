@@ -62,11 +62,8 @@ namespace Tensile
             throw std::runtime_error(msg.c_str());
         }
 
-        template <typename Accumulator,
-                  typename MathOpAccum = Accumulator,
-                  typename TypeL,
-                  typename TypeR>
-        inline Accumulator multiply(TypeL l, TypeR r)
+        template <typename Accumulator, typename MathOpAccum, typename TypeL, typename TypeR>
+        struct MultiplyTypes
         {
             /* Transform the data type from TypeL/TypeR to Accumulator if TypeL!=ACC or TypeR!=ACC, but filter out cases, I8/I32/I32 and I8x4/I32/I32
              *
@@ -75,7 +72,7 @@ namespace Tensile
              * 2. Alpha x rC :  (Alpha!=ACC or rC!=ACC)
              * 3. Beta x C : (Beta!=ACC or C!=ACC)
             */
-            constexpr bool needAccumCast
+            constexpr static bool needAccumCast
                 = !(std::is_same<TypeL, Accumulator>() && std::is_same<TypeR, Accumulator>())
                   && !std::is_same<TypeL, Int8>() //case I8/I32/I32, I8 be implicitly cast to int.
                   && !std::is_same<TypeL, Int8x4>(); //case I8x4/I32/I32, I8x4 overloading the op*.
@@ -83,12 +80,35 @@ namespace Tensile
             using LMultT = std::conditional_t<needAccumCast, Accumulator, TypeL>;
             using RMultT = std::conditional_t<needAccumCast, Accumulator, TypeR>;
 
-            constexpr bool needMathOpAccumCast = !std::is_same<Accumulator, MathOpAccum>();
+            constexpr static bool needMathOpAccumCast = !std::is_same<Accumulator, MathOpAccum>();
             using LMathOpMultT = std::conditional_t<needMathOpAccumCast, MathOpAccum, LMultT>;
             using RMathOpMultT = std::conditional_t<needMathOpAccumCast, MathOpAccum, RMultT>;
 
-            return static_cast<Accumulator>(static_cast<LMultT>(static_cast<LMathOpMultT>(l))
-                                            * static_cast<RMultT>(static_cast<RMathOpMultT>(r)));
+            // The operands as they are multiplied.
+            inline static LMultT Left(TypeL l)
+            {
+                return static_cast<LMultT>(static_cast<LMathOpMultT>(l));
+            }
+
+            inline static RMultT Right(TypeR r)
+            {
+                return static_cast<RMultT>(static_cast<RMathOpMultT>(r));
+            }
+
+            inline static Accumulator Product(LMultT l, RMultT r)
+            {
+                return static_cast<Accumulator>(l * r);
+            }
+        };
+
+        template <typename Accumulator,
+                  typename MathOpAccum = Accumulator,
+                  typename TypeL,
+                  typename TypeR>
+        inline Accumulator multiply(TypeL l, TypeR r)
+        {
+            using Types = MultiplyTypes<Accumulator, MathOpAccum, TypeL, TypeR>;
+            return Types::Product(Types::Left(l), Types::Right(r));
         }
 
         template <typename Accumulator, typename Type>
@@ -554,11 +574,211 @@ namespace Tensile
             throw std::runtime_error("Unsupported input type.");
         }
 
+        /**
+ * Adds the products of packed mb x kb A (stored by k, then m) and kb x nb B
+ * (stored by k, then n) to the mb x nb sums, in k order. Blocks of MR x NR
+ * sums are kept in registers.
+ */
+        template <typename Types, typename Accumulator>
+        void MultiplyPackedCPU(typename Types::LMultT const* aPack,
+                               typename Types::RMultT const* bPack,
+                               Accumulator*                  sums,
+                               size_t                        mb,
+                               size_t                        nb,
+                               size_t                        kb)
+        {
+            constexpr size_t MR = 4, NR = 16;
+
+            for(size_t i0 = 0; i0 < mb; i0 += MR)
+            {
+                for(size_t j0 = 0; j0 < nb; j0 += NR)
+                {
+                    auto* tileSums = sums + i0 * nb + j0;
+
+                    if(i0 + MR > mb || j0 + NR > nb)
+                    {
+                        size_t const ib = std::min(MR, mb - i0);
+                        size_t const jb = std::min(NR, nb - j0);
+                        for(size_t k = 0; k < kb; k++)
+                            for(size_t i = 0; i < ib; i++)
+                                for(size_t j = 0; j < jb; j++)
+                                    tileSums[i * nb + j] += Types::Product(
+                                        aPack[k * mb + i0 + i], bPack[k * nb + j0 + j]);
+                        continue;
+                    }
+
+                    Accumulator acc[MR][NR];
+                    for(size_t i = 0; i < MR; i++)
+                        for(size_t j = 0; j < NR; j++)
+                            acc[i][j] = tileSums[i * nb + j];
+
+                    for(size_t k = 0; k < kb; k++)
+                    {
+                        auto const* aK = aPack + k * mb + i0;
+                        auto const* bK = bPack + k * nb + j0;
+                        for(size_t i = 0; i < MR; i++)
+                        {
+#pragma omp simd
+                            for(size_t j = 0; j < NR; j++)
+                                acc[i][j] += Types::Product(aK[i], bK[j]);
+                        }
+                    }
+
+                    for(size_t i = 0; i < MR; i++)
+                        for(size_t j = 0; j < NR; j++)
+                            tileSums[i * nb + j] = acc[i][j];
+                }
+            }
+        }
+
+        /**
+ * Whether the sums of D can be computed by BlockedSumsCPU: contractions with
+ * one free index in each of A and B, one bound index and at most one batch
+ * index, of real inputs.
+ */
+        template <typename Inputs>
+        bool IsBlockedGemm(ContractionProblemGemm const& problem)
+        {
+            using AType = typename Inputs::AType;
+            using BType = typename Inputs::BType;
+
+            if constexpr(std::is_same<AType, Int8x4>() || std::is_same<BType, Int8x4>()
+                         || TypeInfo<AType>::IsComplex || TypeInfo<BType>::IsComplex)
+            {
+                return false;
+            }
+            else
+            {
+                auto const& boundIndices = problem.boundIndices();
+
+                return problem.freeIndicesA().size() == 1 && problem.freeIndicesB().size() == 1
+                       && boundIndices.size() == 1 && problem.batchIndices().size() <= 1
+                       && !boundIndices[0].aMirror && !boundIndices[0].bMirror;
+            }
+        }
+
+        /**
+ * Computes the sum over the bound index of every element of D, for the
+ * contractions accepted by IsBlockedGemm, and passes each one to
+ * store(dNum, sum) as soon as its tile is done. Tiles of A and B are packed
+ * into per thread buffers of the types that multiply() converts them to, and
+ * each tile of D is accumulated in registers.
+ *
+ * Each element is still summed in bound index order, one product at a time,
+ * so the sums are the same as those of the element by element loop in
+ * SolveCPU.
+ *
+ * The tiles are shared out with an orphaned omp for, so this must be called
+ * by every thread of a parallel region.
+ */
+        template <typename Inputs, typename Accumulator, typename MathOpAccum, typename Store>
+        void BlockedSumsCPU(ContractionProblemGemm const& problem,
+                            ContractionInputs const&      inputs,
+                            Store&&                       store)
+        {
+            using AType = typename Inputs::AType;
+            using BType = typename Inputs::BType;
+
+            if constexpr(!std::is_same<AType, Int8x4>() && !std::is_same<BType, Int8x4>()
+                         && !TypeInfo<AType>::IsComplex && !TypeInfo<BType>::IsComplex)
+            {
+                using Types = MultiplyTypes<Accumulator, MathOpAccum, AType, BType>;
+                using LType = typename Types::LMultT;
+                using RType = typename Types::RMultT;
+
+                auto const& freeIndicesA = problem.freeIndicesA();
+                auto const& freeIndicesB = problem.freeIndicesB();
+                auto const& batchIndices = problem.batchIndices();
+                auto const& boundIndices = problem.boundIndices();
+
+                auto const& a = problem.a();
+                auto const& b = problem.b();
+                auto const& d = problem.d();
+
+                // Strides of the element numbers of D, as used by SolveCPU.
+                std::vector<size_t> dStrides(d.dimensions(), 1);
+                for(size_t i = 1; i < dStrides.size(); i++)
+                    dStrides[i] = dStrides[i - 1] * d.sizes()[i - 1];
+
+                size_t const M       = problem.freeSizeA(0);
+                size_t const N       = problem.freeSizeB(0);
+                size_t const K       = problem.boundSize(0);
+                size_t const batches = batchIndices.empty() ? 1 : problem.batchSize(0);
+
+                size_t const aStrideM = a.strides()[freeIndicesA[0].i];
+                size_t const aStrideK = a.strides()[boundIndices[0].a];
+                size_t const bStrideN = b.strides()[freeIndicesB[0].i];
+                size_t const bStrideK = b.strides()[boundIndices[0].b];
+                size_t const dStrideM = dStrides[freeIndicesA[0].d];
+                size_t const dStrideN = dStrides[freeIndicesB[0].d];
+
+                size_t aStrideBatch = 0, bStrideBatch = 0, dStrideBatch = 0;
+                if(!batchIndices.empty())
+                {
+                    aStrideBatch = a.strides()[batchIndices[0].a];
+                    bStrideBatch = b.strides()[batchIndices[0].b];
+                    dStrideBatch = dStrides[batchIndices[0].d];
+                }
+
+                // MC x KC of A and KC x NC of B are packed at a time.
+                constexpr size_t MC = 64, NC = 256, KC = 256;
+
+                size_t const tilesM = CeilDivide(M, MC);
+                size_t const tilesN = CeilDivide(N, NC);
+
+                AType const* aPtr = (AType const*)inputs.a;
+                BType const* bPtr = (BType const*)inputs.b;
+
+                std::vector<LType>       aPack(MC * KC);
+                std::vector<RType>       bPack(KC * NC);
+                std::vector<Accumulator> sums(MC * NC);
+
+#pragma omp for schedule(dynamic)
+                for(size_t tile = 0; tile < batches * tilesM * tilesN; tile++)
+                {
+                    size_t const batch = tile / (tilesM * tilesN);
+                    size_t const m0    = (tile / tilesN % tilesM) * MC;
+                    size_t const n0    = tile % tilesN * NC;
+                    size_t const mb    = std::min(MC, M - m0);
+                    size_t const nb    = std::min(NC, N - n0);
+
+                    auto const* aTile = aPtr + batch * aStrideBatch + m0 * aStrideM;
+                    auto const* bTile = bPtr + batch * bStrideBatch + n0 * bStrideN;
+
+                    std::fill(sums.begin(), sums.end(), static_cast<Accumulator>(0));
+
+                    for(size_t k0 = 0; k0 < K; k0 += KC)
+                    {
+                        size_t const kb = std::min(KC, K - k0);
+
+                        for(size_t k = 0; k < kb; k++)
+                        {
+                            auto const* aK = aTile + (k0 + k) * aStrideK;
+                            auto const* bK = bTile + (k0 + k) * bStrideK;
+                            for(size_t i = 0; i < mb; i++)
+                                aPack[k * mb + i] = Types::Left(aK[i * aStrideM]);
+                            for(size_t j = 0; j < nb; j++)
+                                bPack[k * nb + j] = Types::Right(bK[j * bStrideN]);
+                        }
+
+                        MultiplyPackedCPU<Types>(
+                            aPack.data(), bPack.data(), sums.data(), mb, nb, kb);
+                    }
+
+                    size_t const dTile = batch * dStrideBatch + m0 * dStrideM + n0 * dStrideN;
+                    for(size_t i = 0; i < mb; i++)
+                        for(size_t j = 0; j < nb; j++)
+                            store(dTile + i * dStrideM + j * dStrideN, sums[i * nb + j]);
+                }
+            }
+        }
+
         template <typename Inputs, typename Accumulator, typename MathOpAccum>
         void ReferenceSolution<Inputs, Accumulator, MathOpAccum>::SolveCPU(
             ContractionProblemGemm const& problem,
             ContractionInputs const&      inputs,
-            size_t                        elementsToValidate)
+            size_t                        elementsToValidate,
+            bool                          blockedGemm)
         {
             Accumulator* ws                   = nullptr;
             size_t       validationStrideGemm = 1;
@@ -640,199 +860,236 @@ namespace Tensile
                 }
             }
 
+            // The sums are computed tile by tile when every element is validated
+            // and the contraction is a plain (batched) GEMM.
+            bool const blocked = blockedGemm && validationStrideGemm == 1
+                                 && std::get<typename Inputs::AlphaType>(inputs.alpha)
+                                        != static_cast<typename Inputs::AlphaType>(0)
+                                 && IsBlockedGemm<Inputs>(problem);
+
+            std::vector<Accumulator> actArgs;
+            for(int i = 0; i < inputs.activationArgs.size(); i++)
+                actArgs.push_back(constVariantCast<Accumulator>(inputs.activationArgs[i]));
+
+            // Every element sets all the coordinates it uses, so each thread
+            // only needs one copy of them.
+            std::vector<int64_t> aCoord(a.dimensions());
+            std::vector<int64_t> bCoord(b.dimensions());
+            std::vector<int64_t> cCoord(c.dimensions());
+            std::vector<int64_t> dCoord(d.dimensions());
+            std::vector<int64_t> biasCoord(bias.dimensions());
+            std::vector<int64_t> bound(problem.boundIndices().size());
+
             // gemm
-#pragma omp parallel for
-            for(size_t dNum = 0; dNum < d.totalLogicalElements(); dNum += validationStrideGemm)
+#pragma omp parallel firstprivate(aCoord, bCoord, cCoord, dCoord, biasCoord, bound)
             {
-                std::vector<int64_t> aCoord(a.dimensions());
-                std::vector<int64_t> bCoord(b.dimensions());
-                std::vector<int64_t> cCoord(c.dimensions());
-                std::vector<int64_t> dCoord(d.dimensions());
-                std::vector<int64_t> biasCoord(bias.dimensions());
-                CoordNumbered(
-                    dNum, dCoord.begin(), dCoord.end(), d.sizes().begin(), d.sizes().end());
+                // Computes the element dNum of D, from its sum over the bound
+                // indices if there is one.
+                auto solveElement = [&](size_t dNum, Accumulator const* sum) {
+                    CoordNumbered(
+                        dNum, dCoord.begin(), dCoord.end(), d.sizes().begin(), d.sizes().end());
 
-                for(size_t i = 0; i < problem.batchIndices().size(); i++)
-                {
-                    auto const& idx   = problem.batchIndices()[i];
-                    size_t      coord = dCoord[idx.d];
-
-                    aCoord[idx.a] = coord;
-                    bCoord[idx.b] = coord;
-                    cCoord[idx.c] = coord;
-                    if(biasCoord.size() > 2)
-                        biasCoord[2] = coord;
-                }
+                    for(size_t i = 0; i < problem.batchIndices().size(); i++)
+                    {
+                        auto const& idx   = problem.batchIndices()[i];
+                        size_t      coord = dCoord[idx.d];
+
+                        aCoord[idx.a] = coord;
+                        bCoord[idx.b] = coord;
+                        cCoord[idx.c] = coord;
+                        if(biasCoord.size() > 2)
+                            biasCoord[2] = coord;
+                    }
 
-                for(size_t i = 0; i < problem.freeIndices().size(); i++)
-                {
-                    auto const& idx   = problem.freeIndices()[i];
-                    size_t      coord = dCoord[idx.d];
+                    for(size_t i = 0; i < problem.freeIndices().size(); i++)
+                    {
+                        auto const& idx   = problem.freeIndices()[i];
+                        size_t      coord = dCoord[idx.d];
 
-                    cCoord[idx.c] = coord;
+                        cCoord[idx.c] = coord;
 
-                    if(idx.isA)
-                        aCoord[idx.i] = coord;
-                    else
-                        bCoord[idx.i] = coord;
-                }
+                        if(idx.isA)
+                            aCoord[idx.i] = coord;
+                        else
+                            bCoord[idx.i] = coord;
+                    }
 
-                Accumulator value(0);
+                    Accumulator value(0);
 
-                // Check short-circuit for alpha = 0
-                if(std::get<typename Inputs::AlphaType>(inputs.alpha)
-                   != static_cast<typename Inputs::AlphaType>(0))
-                {
-                    for(size_t boundNum = 0; boundNum < boundCount; boundNum++)
+                    if(sum != nullptr)
+                    {
+                        value = *sum;
+                    }
+                    // Check short-circuit for alpha = 0
+                    else if(std::get<typename Inputs::AlphaType>(inputs.alpha)
+                            != static_cast<typename Inputs::AlphaType>(0))
                     {
-                        std::vector<int64_t> bound(problem.boundIndices().size());
-                        CoordNumbered(boundNum,
-                                      bound.begin() + 1,
-                                      bound.end(),
-                                      boundSize.begin() + 1,
-                                      boundSize.end());
-
-                        for(int i = 1; i < bound.size(); i++)
+                        for(size_t boundNum = 0; boundNum < boundCount; boundNum++)
                         {
-                            aCoord[boundIndices[i].a] = bound[i];
-                            bCoord[boundIndices[i].b] = bound[i];
-
-                            if(problem.boundIndices()[i].aMirror)
-                                aCoord[boundIndices[i].a]
-                                    = boundSize[i] - aCoord[boundIndices[i].a] - 1;
-                            if(problem.boundIndices()[i].bMirror)
-                                bCoord[boundIndices[i].b]
-                                    = boundSize[i] - bCoord[boundIndices[i].b] - 1;
+                            CoordNumbered(boundNum,
+                                          bound.begin() + 1,
+                                          bound.end(),
+                                          boundSize.begin() + 1,
+                                          boundSize.end());
+
+                            for(int i = 1; i < bound.size(); i++)
+                            {
+                                aCoord[boundIndices[i].a] = bound[i];
+                                bCoord[boundIndices[i].b] = bound[i];
+
+                                if(problem.boundIndices()[i].aMirror)
+                                    aCoord[boundIndices[i].a]
+                                        = boundSize[i] - aCoord[boundIndices[i].a] - 1;
+                                if(problem.boundIndices()[i].bMirror)
+                                    bCoord[boundIndices[i].b]
+                                        = boundSize[i] - bCoord[boundIndices[i].b] - 1;
+                            }
+
+                            size_t aIndex = a.index(aCoord);
+                            size_t bIndex = b.index(bCoord);
+
+                            auto aStride = problem.a().strides()[boundIndices[0].a];
+                            auto bStride = problem.b().strides()[boundIndices[0].b];
+
+                            // innermost bound calculation:
+                            for(size_t i = 0; i < boundSize[0]; i++)
+                            {
+                                size_t aI = problem.boundIndices()[0].aMirror
+                                                ? (boundSize[0] - i - 1)
+                                                : i;
+                                size_t bI = problem.boundIndices()[0].bMirror
+                                                ? (boundSize[0] - i - 1)
+                                                : i;
+
+                                typename Inputs::AType aVal(0);
+                                typename Inputs::BType bVal(0);
+                                aVal = Transform<typename Inputs::AType>::Input(
+                                    aPtr[aIndex + (aI * aStride)], aConjugate);
+                                bVal = Transform<typename Inputs::BType>::Input(
+                                    bPtr[bIndex + (bI * bStride)], bConjugate);
+
+                                value += multiply<Accumulator, MathOpAccum>(aVal, bVal);
+                            }
                         }
+                    }
 
-                        size_t aIndex = a.index(aCoord);
-                        size_t bIndex = b.index(bCoord);
+                    auto cIndex = c.index(cCoord);
+                    auto dIndex = d.index(dCoord);
 
-                        auto aStride = problem.a().strides()[boundIndices[0].a];
-                        auto bStride = problem.b().strides()[boundIndices[0].b];
+                    // Ensure zero*nan returns zero
+                    Accumulator alpha = constVariantCast<Accumulator>(inputs.alpha);
+                    Accumulator beta  = constVariantCast<Accumulator>(inputs.beta);
+                    auto        zero  = static_cast<Accumulator>(0);
 
-                        // innermost bound calculation:
-                        for(size_t i = 0; i < boundSize[0]; i++)
-                        {
-                            size_t aI
-                                = problem.boundIndices()[0].aMirror ? (boundSize[0] - i - 1) : i;
-                            size_t bI
-                                = problem.boundIndices()[0].bMirror ? (boundSize[0] - i - 1) : i;
-
-                            typename Inputs::AType aVal(0);
-                            typename Inputs::BType bVal(0);
-                            aVal = Transform<typename Inputs::AType>::Input(
-                                aPtr[aIndex + (aI * aStride)], aConjugate);
-                            bVal = Transform<typename Inputs::BType>::Input(
-                                bPtr[bIndex + (bI * bStride)], bConjugate);
-
-                            value += multiply<Accumulator, MathOpAccum>(aVal, bVal);
-                        }
+                    if(problem.useScaleAB())
+                    {
+                        Accumulator scaleA = GetValue<Accumulator>(
+                            problem.alphaType(), inputs.scaleA, 0, aConjugate);
+                        Accumulator scaleB = GetValue<Accumulator>(
+                            problem.alphaType(), inputs.scaleB, 0, aConjugate);
+                        alpha *= scaleA * scaleB;
                     }
-                }
-
-                auto cIndex = c.index(cCoord);
-                auto dIndex = d.index(dCoord);
 
-                // Ensure zero*nan returns zero
-                Accumulator alpha = constVariantCast<Accumulator>(inputs.alpha);
-                Accumulator beta  = constVariantCast<Accumulator>(inputs.beta);
-                auto        zero  = static_cast<Accumulator>(0);
+                    auto resultD = multiply<Accumulator>(alpha, value);
 
-                if(problem.useScaleAB())
-                {
-                    Accumulator scaleA
-                        = GetValue<Accumulator>(problem.alphaType(), inputs.scaleA, 0, aConjugate);
-                    Accumulator scaleB
-                        = GetValue<Accumulator>(problem.alphaType(), inputs.scaleB, 0, aConjugate);
-                    alpha *= scaleA * scaleB;
-                }
+                    if(problem.useScaleAlphaVec())
+                    {
+                        int         pos           = int(dNum % problem.d().sizes()[0]);
+                        Accumulator scaleAlphaVec = GetValue<Accumulator>(
+                            problem.alphaType(), inputs.scaleAlphaVec, pos, aConjugate);
+                        resultD *= scaleAlphaVec;
+                    }
 
-                auto resultD = multiply<Accumulator>(alpha, value);
+                    if(beta != zero)
+                    {
+                        Accumulator cValue = multiply<Accumulator>(beta, cPtr[cIndex]);
+                        if(problem.useScaleCD())
+                        {
+                            Accumulator scaleC = GetValue<Accumulator>(
+                                problem.betaType(), inputs.scaleC, 0, aConjugate);
+                            cValue *= scaleC;
+                        }
 
-                if(problem.useScaleAlphaVec())
-                {
-                    int         pos           = int(dNum % problem.d().sizes()[0]);
-                    Accumulator scaleAlphaVec = GetValue<Accumulator>(
-                        problem.alphaType(), inputs.scaleAlphaVec, pos, aConjugate);
-                    resultD *= scaleAlphaVec;
-                }
+                        resultD += cValue;
+                    }
 
-                if(beta != zero)
-                {
-                    Accumulator cValue = multiply<Accumulator>(beta, cPtr[cIndex]);
-                    if(problem.useScaleCD())
+                    // bias
+                    if(problem.useBias() && inputs.bias && !problem.useGradient())
                     {
-                        Accumulator scaleC
-                            = GetValue<Accumulator>(problem.betaType(), inputs.scaleC, 0, aConjugate);
-                        cValue *= scaleC;
+                        auto        biasIndex = problem.bias().index(biasCoord);
+                        int         pos       = int(dNum % problem.d().sizes()[0]) + biasIndex;
+                        Accumulator bias      = GetValue<Accumulator>(
+                            problem.biasType(), inputs.bias, pos, aConjugate);
+                        resultD += bias;
                     }
-
-                    resultD += cValue;
-                }
-
-                // bias
-                if(problem.useBias() && inputs.bias && !problem.useGradient())
-                {
-                    auto        biasIndex = problem.bias().index(biasCoord);
-                    int         pos       = int(dNum % problem.d().sizes()[0]) + biasIndex;
-                    Accumulator bias
-                        = GetValue<Accumulator>(problem.biasType(), inputs.bias, pos, aConjugate);
-                    resultD += bias;
-                }
-                // E
-                if(problem.useE() && !problem.useGradient())
-                {
-                    typename Inputs::BetaType* ePtr = (typename Inputs::BetaType*)inputs.e;
-                    auto                       eIndex
-                        = problem.tensors()[ContractionProblemGemm::TENSOR::E].index(dCoord);
-                    ePtr[eIndex] = SaturateCast<typename Inputs::BetaType>(resultD);
-                }
-                // Activation adds here
-                std::vector<Accumulator> actArgs;
-                for(int i = 0; i < inputs.activationArgs.size(); i++)
-                    actArgs.push_back(constVariantCast<Accumulator>(inputs.activationArgs[i]));
-                if(problem.useGradient() && problem.activationType() != ActivationType::None
-                   && problem.activationEnumArg() != ActivationType::None)
-                {
-                    Accumulator dataE = static_cast<Accumulator>(0);
-                    if(problem.useE())
+                    // E
+                    if(problem.useE() && !problem.useGradient())
                     {
                         typename Inputs::BetaType* ePtr = (typename Inputs::BetaType*)inputs.e;
                         auto                       eIndex
                             = problem.tensors()[ContractionProblemGemm::TENSOR::E].index(dCoord);
-                        dataE = GetValue<Accumulator>(
-                            problem.betaType(), inputs.e, eIndex, aConjugate);
+                        ePtr[eIndex] = SaturateCast<typename Inputs::BetaType>(resultD);
+                    }
+                    // Activation adds here
+                    if(problem.useGradient() && problem.activationType() != ActivationType::None
+                       && problem.activationEnumArg() != ActivationType::None)
+                    {
+                        Accumulator dataE = static_cast<Accumulator>(0);
+                        if(problem.useE())
+                        {
+                            typename Inputs::BetaType* ePtr = (typename Inputs::BetaType*)inputs.e;
+                            auto eIndex = problem.tensors()[ContractionProblemGemm::TENSOR::E]
+                                              .index(dCoord);
+                            dataE = GetValue<Accumulator>(
+                                problem.betaType(), inputs.e, eIndex, aConjugate);
+                        }
+                        dataE = Activation(
+                            problem.activationType(), dataE, problem.activationEnumArg(), actArgs);
+                        resultD *= dataE;
+                    }
+                    else
+                    {
+                        resultD = Activation(problem.activationType(),
+                                             resultD,
+                                             problem.activationEnumArg(),
+                                             actArgs);
                     }
-                    dataE = Activation(
-                        problem.activationType(), dataE, problem.activationEnumArg(), actArgs);
-                    resultD *= dataE;
-                }
-                else
-                {
-                    resultD = Activation(
-                        problem.activationType(), resultD, problem.activationEnumArg(), actArgs);
-                }
 
-                if(problem.useScaleDVec())
-                {
-                    int         pos       = int(dNum % problem.d().sizes()[0]);
-                    Accumulator scaleDVec = GetValue<Accumulator>(
-                        problem.alphaType(), inputs.scaleDVec, pos, aConjugate);
-                    resultD *= scaleDVec;
-                }
-                if(problem.useScaleCD())
+                    if(problem.useScaleDVec())
+                    {
+                        int         pos       = int(dNum % problem.d().sizes()[0]);
+                        Accumulator scaleDVec = GetValue<Accumulator>(
+                            problem.alphaType(), inputs.scaleDVec, pos, aConjugate);
+                        resultD *= scaleDVec;
+                    }
+                    if(problem.useScaleCD())
+                    {
+                        Accumulator scaleD = GetValue<Accumulator>(
+                            problem.betaType(), inputs.scaleD, 0, aConjugate);
+                        resultD *= scaleD;
+                    }
+                    if(problem.useBias() && problem.useGradient()
+                       && (problem.biasSrc() == ContractionProblemGemm::D))
+                    {
+                        ws[dIndex] = resultD;
+                    }
+                    dPtr[dIndex] = SaturateCast<typename Inputs::DType>(resultD);
+                };
+
+                if(blocked)
                 {
-                    Accumulator scaleD
-                        = GetValue<Accumulator>(problem.betaType(), inputs.scaleD, 0, aConjugate);
-                    resultD *= scaleD;
+                    BlockedSumsCPU<Inputs, Accumulator, MathOpAccum>(
+                        problem, inputs, [&](size_t dNum, Accumulator sum) {
+                            solveElement(dNum, &sum);
+                        });
                 }
-                if(problem.useBias() && problem.useGradient()
-                   && (problem.biasSrc() == ContractionProblemGemm::D))
+                else
                 {
-                    ws[dIndex] = resultD;
+#pragma omp for
+                    for(size_t dNum = 0; dNum < d.totalLogicalElements();
+                        dNum += validationStrideGemm)
+                        solveElement(dNum, nullptr);
                 }
-                dPtr[dIndex] = SaturateCast<typename Inputs::DType>(resultD);
             }
 
             if(problem.useGradient() && problem.useBias())
@@ -882,12 +1139,13 @@ namespace Tensile
         void ReferenceSolution<Inputs, Accumulator, MathOpAccum>::SolveCPU(
             ContractionProblemGroupedGemm const& problem,
             ContractionGroupedInputs const&      inputs,
-            size_t                               elementsToValidate)
+            size_t                               elementsToValidate,
+            bool                                 blockedGemm)
         {
             for(int idx = 0; idx < problem.gemms.size(); idx++)
             {
                 ReferenceSolution<Inputs, Accumulator, MathOpAccum>::SolveCPU(
-                    problem.gemms[idx], inputs.grouped[idx], elementsToValidate);
+                    problem.gemms[idx], inputs.grouped[idx], elementsToValidate, blockedGemm);
             }
         }
 
@@ -938,7 +1196,8 @@ namespace Tensile
         void SolveCPUTemplates(uint32_t const& contractionInputsTypeId,
                                Problem const&  problem,
                                Inputs const&   inputs,
-                               size_t          elementsToValidate)
+                               size_t          elementsToValidate,
+                               bool            blockedGemm)
         {
             bool isHPA = false;
             if constexpr(std::is_same<ContractionProblemGemm, Problem>::value)
@@ -956,25 +1215,25 @@ namespace Tensile
             {
                 if(problem.f32XdlMathOp() == DataType::XFloat32)
                     return ReferenceSolution<TypedGemm_S_S_S, float, XFloat32>::SolveCPU(
-                        problem, inputs, elementsToValidate);
+                        problem, inputs, elementsToValidate, blockedGemm);
                 else
                     return ReferenceSolution<TypedGemm_S_S_S>::SolveCPU(
-                        problem, inputs, elementsToValidate);
+                        problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_D_D_D::TypeId():
             {
                 return ReferenceSolution<TypedGemm_D_D_D>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_C_C_C::TypeId():
             {
                 return ReferenceSolution<TypedGemm_C_C_C>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_Z_Z_Z::TypeId():
             {
                 return ReferenceSolution<TypedGemm_Z_Z_Z>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
 #ifdef TENSILE_USE_HALF
             case TypedGemm_H_H_H::TypeId():
@@ -982,69 +1241,69 @@ namespace Tensile
                 if(isHPA)
                 {
                     return ReferenceSolution<TypedGemm_H_H_H, float>::SolveCPU(
-                        problem, inputs, elementsToValidate);
+                        problem, inputs, elementsToValidate, blockedGemm);
                 }
                 else
                 {
                     return ReferenceSolution<TypedGemm_H_H_H>::SolveCPU(
-                        problem, inputs, elementsToValidate);
+                        problem, inputs, elementsToValidate, blockedGemm);
                 }
             }
             case TypedGemm_H_S_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_H_S_S>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_H_H_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_H_H_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_SH_H_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_SH_H_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_HS_H_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_HS_H_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
 #endif // TENSILE_USE_HALF
             case TypedGemm_I8x4_I32_I32::TypeId():
             {
                 return ReferenceSolution<TypedGemm_I8x4_I32_I32>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_I32_I32_I32::TypeId():
             {
                 return ReferenceSolution<TypedGemm_I32_I32_I32>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_I8_I8_I32::TypeId():
             {
                 return ReferenceSolution<TypedGemm_I8_I8_I32, int32_t>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_I8_I32_I32::TypeId():
             {
                 return ReferenceSolution<TypedGemm_I8_I32_I32>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_I8_I32_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_I8_I32_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_I8_I8_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_I8_I8_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_I8_H_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_I8_H_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
 #ifdef TENSILE_USE_BF16
             case TypedGemm_B_B_S::TypeId():
@@ -1052,117 +1311,117 @@ namespace Tensile
                 if(isHPA)
                 {
                     return ReferenceSolution<TypedGemm_B_B_S, float>::SolveCPU(
-                        problem, inputs, elementsToValidate);
+                        problem, inputs, elementsToValidate, blockedGemm);
                 }
                 else
                 {
                     return ReferenceSolution<TypedGemm_B_B_S>::SolveCPU(
-                        problem, inputs, elementsToValidate);
+                        problem, inputs, elementsToValidate, blockedGemm);
                 }
             }
             case TypedGemm_B_S_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_B_S_S>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
 #endif // TENSILE_USE_BF16
 #ifdef TENSILE_USE_FP8_BF8
             case TypedGemm_F8_S_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_F8_S_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_F8_H_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_F8_H_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_F8_F8_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_F8_F8_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_B8_S_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_B8_S_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_B8_B8_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_B8_B8_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             // hybrid
             case TypedGemm_F8B8_S_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_F8B8_S_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_F8B8_H_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_F8B8_H_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_F8B8_F8_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_F8B8_F8_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_B8F8_S_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_B8F8_S_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_B8F8_H_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_B8F8_H_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_B8F8_B8_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_B8F8_B8_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_F8B8_B8_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_F8B8_B8_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_B8F8_F8_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_B8F8_F8_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
 #ifdef TENSILE_USE_HALF
             case TypedGemm_HF8_S_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_HF8_S_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_F8H_S_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_F8H_S_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_HF8_H_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_HF8_H_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_F8H_H_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_F8H_H_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_HF8_FP8_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_HF8_FP8_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
             case TypedGemm_F8H_FP8_S::TypeId():
             {
                 return ReferenceSolution<TypedGemm_F8H_FP8_S, float>::SolveCPU(
-                    problem, inputs, elementsToValidate);
+                    problem, inputs, elementsToValidate, blockedGemm);
             }
 #endif // TENSILE_USE_HALF
 #endif // TENSILE_USE_FP8_BF8
@@ -1175,7 +1434,8 @@ namespace Tensile
 
         void SolveCPU(ContractionProblem const* problem,
                       ProblemInputs const*      inputs,
-                      size_t                    elementsToValidate)
+                      size_t                    elementsToValidate,
+                      bool                      blockedGemm)
         {
             if(auto groupedProblem = dynamic_cast<ContractionProblemGroupedGemm const*>(problem))
             {
@@ -1183,8 +1443,11 @@ namespace Tensile
                 {
                     auto contractionInputsTypeId
                         = getInputContractionInputsTypeId(groupedProblem->gemms[0]);
-                    SolveCPUTemplates(
-                        contractionInputsTypeId, *groupedProblem, *refInput, elementsToValidate);
+                    SolveCPUTemplates(contractionInputsTypeId,
+                                      *groupedProblem,
+                                      *refInput,
+                                      elementsToValidate,
+                                      blockedGemm);
                 }
                 else
                     throw std::runtime_error("Unable to cast input to ContractionGroupedInputs.");
@@ -1194,8 +1457,11 @@ namespace Tensile
                 if(auto refInput = dynamic_cast<ContractionInputs const*>(inputs))
                 {
                     auto contractionInputsTypeId = getInputContractionInputsTypeId(*gemmProblem);
-                    SolveCPUTemplates(
-                        contractionInputsTypeId, *gemmProblem, *refInput, elementsToValidate);
+                    SolveCPUTemplates(contractionInputsTypeId,
+                                      *gemmProblem,
+                                      *refInput,
+                                      elementsToValidate,
+                                      blockedGemm);
                 }
                 else
                     throw std::runtime_error("Unable to cast input to ContractionInputs.");
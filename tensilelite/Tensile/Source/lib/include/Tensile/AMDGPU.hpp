@@ -184,6 +184,8 @@ namespace Tensile
         int         wavefrontSize    = 64;
         int         simdPerCu        = 4;
         int         computeUnitCount = 0;
+        double      clockMHz         = 0.0; //! Peak engine clock, 0 if unknown
+        double      memoryBandwidth  = 0.0; //! Peak memory bandwidth in GB/s, 0 if unknown
         std::string deviceName;
 
         virtual bool   runsKernelTargeting(Processor p) const;
@@ -26,131 +26,245 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <memory>
 #include <shared_mutex>
+#include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include <Tensile/ContractionProblem.hpp>
+#include <Tensile/PersistentSolutionCache.hpp>
 #include <Tensile/SolutionLibrary.hpp>
 
+#include <Tensile/SingleSolutionLibrary.hpp>
+
 #include <Tensile/AMDGPU_Detail.hpp>
 #include <Tensile/ContractionProblem_Detail.hpp>
 #include <Tensile/TensorDescriptor_Detail.hpp>
 
 namespace Tensile
 {
-    template <typename Value, typename Key, typename... Keys>
-    struct MultiLevelMap
+    /**
+     * Snapshot of the counters of one or more CacheMaps.
+     */
+    struct CacheStatistics
     {
-        using type = typename MultiLevelMap<std::unordered_map<Key, Value>, Keys...>::type;
-    };
+        int64_t lookups   = 0;
+        int64_t hits      = 0;
+        int64_t evictions = 0;
+        size_t  entries   = 0;
+        size_t  capacity  = 0; //! 0 if unbounded
 
-    template <typename Value, typename Key>
-    struct MultiLevelMap<Value, Key>
-    {
-        using type = std::unordered_map<Key, Value>;
+        CacheStatistics& operator+=(CacheStatistics const& rhs)
+        {
+            lookups += rhs.lookups;
+            hits += rhs.hits;
+            evictions += rhs.evictions;
+            entries += rhs.entries;
+            capacity += rhs.capacity;
+            return *this;
+        }
     };
 
     /**
-     * Thread-safe multi-valued cache.
+     * Thread-safe, bounded multi-valued cache.
      *
-     * Note that due to a quirk with templates, the order of the keys in find() and add() is *opposite* of that in the type.
+     * Entries are spread over NumShards shards by key hash, each with its own
+     * lock, so that threads looking up different problems rarely contend.
+     * Lookups only take a shared lock. Once a shard is full, adding an entry
+     * evicts one that has not been hit since the clock hand last passed it
+     * (CLOCK approximation of LRU). A capacity of 0 means unbounded.
      *
      * e.g.
      *
-     *     CacheMap<int, float, std::string> myCache
-     *     myCache.find("foo", 1.4); // great
-     *     myCache.find(1.4, "foo"); // error!
+     *     CacheMap<int, std::string, float> myCache(-1);
+     *     myCache.add(4, "foo", 1.4f);
+     *     myCache.find("foo", 1.4f); // 4
      */
     template <typename Value, typename... Keys>
     class CacheMap
     {
-        using Map = typename MultiLevelMap<Value, Keys...>::type;
-
     public:
-        CacheMap(Value const& nullValue)
+        static constexpr size_t NumShards = 16;
+
+        CacheMap(Value const& nullValue, size_t capacity = 0)
             : m_nullValue(nullValue)
             , m_lookupEfficiency(Debug::Instance().printLookupEfficiency())
-            , m_lookups(0)
-            , m_hits(0)
-
         {
+            setCapacity(capacity);
         }
 
         ~CacheMap()
         {
             if(m_lookupEfficiency)
-                std::cout << "CacheMap: " << m_hits << "/" << m_lookups << " cache hits"
-                          << std::endl;
+            {
+                auto stats = statistics();
+                std::cout << "CacheMap: " << stats.hits << "/" << stats.lookups
+                          << " cache hits, " << stats.evictions << " evictions" << std::endl;
+            }
         }
 
         template <typename... Ks>
         Value find(Ks const&... keys)
         {
-            std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+            size_t hash  = hash_combine(keys...);
+            auto&  shard = m_shards[hash % NumShards];
 
-            auto rv = find_impl(m_map, keys...);
+            std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+            shard.lookups.fetch_add(1, std::memory_order_relaxed);
 
-            if(m_lookupEfficiency)
-            {
-                m_lookups++;
-                if(rv != m_nullValue)
-                    m_hits++;
-            }
+            Entry* entry = shard.find(hash, keys...);
+            if(!entry)
+                return m_nullValue;
 
-            return rv;
+            shard.hits.fetch_add(1, std::memory_order_relaxed);
+            if(!entry->referenced.load(std::memory_order_relaxed))
+                entry->referenced.store(true, std::memory_order_relaxed);
+
+            return entry->value;
         }
 
         template <typename... Ks>
-        void add(Value const& value, Ks const&... ks)
+        void add(Value const& value, Ks const&... keys)
         {
-            std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+            size_t hash  = hash_combine(keys...);
+            auto&  shard = m_shards[hash % NumShards];
 
-            add_impl(m_map, value, ks...);
-        }
+            std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
 
-    private:
-        template <typename SubMap, typename K>
-        Value find_impl(SubMap const& map, K const& key)
-        {
-            auto iter = map.find(key);
+            if(shard.find(hash, keys...))
+                return;
 
-            if(iter == map.end())
-                return m_nullValue;
+            if(shard.bounded && shard.capacity == 0)
+                return;
+
+            auto   owned = std::make_unique<Entry>(hash, value, keys...);
+            Entry* entry = owned.get();
+            shard.index.emplace(hash, std::move(owned));
 
-            return iter->second;
+            if(shard.bounded && shard.ring.size() >= shard.capacity)
+                shard.ring[shard.evict()] = entry;
+            else
+                shard.ring.push_back(entry);
         }
 
-        template <typename SubMap, typename K, typename... Ks>
-        Value find_impl(SubMap const& map, K const& key, Ks const&... ks)
+        /**
+         * Sets the number of entries, split between the shards so that their
+         * capacities add up to \p capacity: each shard holds
+         * \p capacity / NumShards entries, one more for the first
+         * \p capacity % NumShards shards, and evicts once it is full, even if
+         * other shards are not. Shrinking the cache evicts entries immediately.
+         */
+        void setCapacity(size_t capacity)
         {
-            auto iter = map.find(key);
+            for(size_t i = 0; i < NumShards; i++)
+            {
+                auto&                                    shard = m_shards[i];
+                std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+
+                shard.bounded  = capacity != 0;
+                shard.capacity = capacity / NumShards + (i < capacity % NumShards ? 1 : 0);
+                while(shard.bounded && shard.ring.size() > shard.capacity)
+                {
+                    size_t slot = shard.evict();
+                    shard.ring.erase(shard.ring.begin() + slot);
+                    if(shard.hand >= shard.ring.size())
+                        shard.hand = 0;
+                }
+            }
+        }
 
-            if(iter == map.end())
-                return m_nullValue;
+        CacheStatistics statistics() const
+        {
+            CacheStatistics rv;
+            for(auto& shard : m_shards)
+            {
+                std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
 
-            return find_impl(iter->second, ks...);
+                rv.lookups += shard.lookups.load(std::memory_order_relaxed);
+                rv.hits += shard.hits.load(std::memory_order_relaxed);
+                rv.evictions += shard.evictions.load(std::memory_order_relaxed);
+                rv.entries += shard.ring.size();
+                rv.capacity += shard.capacity;
+            }
+
+            return rv;
         }
 
-        template <typename SubMap, typename K>
-        void add_impl(SubMap& map, Value const& value, K const& key)
+    private:
+        struct Entry
         {
-            map.emplace(key, value);
-        }
+            template <typename... Ks>
+            Entry(size_t hash, Value const& value, Ks const&... keys)
+                : hash(hash)
+                , keys(keys...)
+                , value(value)
+            {
+            }
 
-        template <typename SubMap, typename K, typename... Ks>
-        void add_impl(SubMap& map, Value const& value, K const& key, Ks const&... ks)
+            size_t              hash;
+            std::tuple<Keys...> keys;
+            Value               value;
+            std::atomic<bool>   referenced{false};
+        };
+
+        struct alignas(64) Shard
         {
-            add_impl(map[key], value, ks...);
-        }
+            template <typename... Ks>
+            Entry* find(size_t hash, Ks const&... keys) const
+            {
+                auto range = index.equal_range(hash);
+                for(auto iter = range.first; iter != range.second; iter++)
+                {
+                    if(iter->second->keys == std::tie(keys...))
+                        return iter->second.get();
+                }
+
+                return nullptr;
+            }
 
-        Map                     m_map;
-        std::shared_timed_mutex m_mutex;
-        Value                   m_nullValue;
+            // Advances the clock hand to an unreferenced entry, drops it from the
+            // index and returns its slot in the ring. Caller holds the lock.
+            size_t evict()
+            {
+                while(ring[hand]->referenced.exchange(false, std::memory_order_relaxed))
+                    hand = (hand + 1) % ring.size();
+
+                size_t slot   = hand;
+                Entry* victim = ring[slot];
+                auto   range  = index.equal_range(victim->hash);
+                for(auto iter = range.first; iter != range.second; iter++)
+                {
+                    if(iter->second.get() == victim)
+                    {
+                        index.erase(iter);
+                        break;
+                    }
+                }
+
+                hand = (hand + 1) % ring.size();
+                evictions.fetch_add(1, std::memory_order_relaxed);
+
+                return slot;
+            }
 
-        bool                 m_lookupEfficiency;
-        std::atomic<int64_t> m_lookups;
-        std::atomic<int64_t> m_hits;
+            mutable std::shared_timed_mutex                         mutex;
+            std::unordered_multimap<size_t, std::unique_ptr<Entry>> index;
+            std::vector<Entry*>                                     ring;
+            size_t                                                  hand     = 0;
+            size_t                                                  capacity = 0;
+            bool                                                    bounded  = false;
+
+            std::atomic<int64_t> lookups{0};
+            std::atomic<int64_t> hits{0};
+            std::atomic<int64_t> evictions{0};
+        };
+
+        std::array<Shard, NumShards> m_shards;
+        Value                        m_nullValue;
+        bool                         m_lookupEfficiency;
     };
 
     template <typename MyProblem, typename MySolution = typename MyProblem::Solution>
@@ -158,17 +272,57 @@ namespace Tensile
     {
     public:
         using Library = SolutionLibrary<MyProblem, MySolution>;
-        using Cache  = CacheMap<std::tuple<std::shared_ptr<MySolution>, double>, AMDGPU, MyProblem>;
-        using Caches = CacheMap<SolutionVector<MySolution>, AMDGPU, MyProblem>;
+        using Cache  = CacheMap<std::tuple<std::shared_ptr<MySolution>, double>, MyProblem, AMDGPU>;
+        using Caches = CacheMap<SolutionVector<MySolution>, MyProblem, AMDGPU>;
         using CachesGroupedGemm
-            = CacheMap<SolutionVector<MySolution>, AMDGPU, std::vector<MyProblem>>;
+            = CacheMap<SolutionVector<MySolution>, std::vector<MyProblem>, AMDGPU>;
 
         CachingLibrary(std::shared_ptr<Library> subLibrary)
             : m_subLibrary(subLibrary)
-            , m_cache(std::make_tuple(nullptr, std::numeric_limits<double>::max()))
-            , m_caches(SolutionVector<MySolution>{})
-            , m_cachesGroupedGemm(SolutionVector<MySolution>{})
+            , m_cache(std::make_tuple(nullptr, std::numeric_limits<double>::max()),
+                      Debug::Instance().getSolutionCacheCapacity())
+            , m_caches(SolutionVector<MySolution>{}, Debug::Instance().getSolutionCacheCapacity())
+            , m_cachesGroupedGemm(SolutionVector<MySolution>{},
+                                  Debug::Instance().getSolutionCacheCapacity())
+        {
+        }
+
+        /**
+         * Limits each of the solution caches to \p capacity entries (0 for
+         * unbounded), split evenly between its shards (see
+         * CacheMap::setCapacity()), evicting entries if they are already larger.
+         */
+        void setCacheCapacity(size_t capacity)
+        {
+            m_cache.setCapacity(capacity);
+            m_caches.setCapacity(capacity);
+            m_cachesGroupedGemm.setCapacity(capacity);
+        }
+
+        /**
+         * Backs the findTopSolutions caches with \p cache, so that results
+         * survive across processes. Must be set before the library is used
+         * concurrently; pass nullptr to detach.
+         */
+        void setPersistentCache(std::shared_ptr<PersistentSolutionCache> cache)
+        {
+            m_persistentCache = std::move(cache);
+        }
+
+        std::shared_ptr<PersistentSolutionCache> persistentCache() const
+        {
+            return m_persistentCache;
+        }
+
+        //! Combined live counters of all solution caches, with the capacity of each.
+        CacheStatistics cacheStatistics() const
         {
+            CacheStatistics rv       = m_cache.statistics();
+            size_t          capacity = rv.capacity;
+            rv += m_caches.statistics();
+            rv += m_cachesGroupedGemm.statistics();
+            rv.capacity = capacity;
+            return rv;
         }
 
         virtual std::shared_ptr<MySolution> getSolutionByIndex(MyProblem const& problem,
@@ -247,6 +401,12 @@ namespace Tensile
             return m_subLibrary;
         }
 
+        virtual void
+            getLazyLoadedLibraries(std::vector<LazyLoadedLibrary const*>& libraries) const override
+        {
+            m_subLibrary->getLazyLoadedLibraries(libraries);
+        }
+
         virtual SolutionVector<MySolution> findTopSolutions(MyProblem const& problem,
                                                             Hardware const&  hardware,
                                                             int numSolutions) const override
@@ -260,9 +420,25 @@ namespace Tensile
                 if(solutions.size() != 0)
                     return solutions;
 
+                uint64_t key = 0;
+                if(m_persistentCache)
+                {
+                    key       = hash_combine(problem, amdgpu);
+                    solutions = findInPersistentCache(key, problem, hardware);
+                    if(solutions.size() != 0)
+                    {
+                        m_caches.add(solutions, problem, amdgpu);
+                        return solutions;
+                    }
+                }
+
                 solutions = m_subLibrary->findTopSolutions(problem, hardware, numSolutions);
                 if(solutions.size() != 0)
+                {
                     m_caches.add(solutions, problem, amdgpu);
+                    if(m_persistentCache)
+                        m_persistentCache->add(key, solutionIndices(solutions));
+                }
 
                 return solutions;
             }
@@ -287,10 +463,28 @@ namespace Tensile
                 if(solutions.size() != 0)
                     return solutions;
 
+                uint64_t key = 0;
+                if(m_persistentCache)
+                {
+                    // Tagged so that a single-problem group does not share its
+                    // key with the plain GEMM.
+                    key       = hash_combine(problems, amdgpu, std::string("GroupedGemm"));
+                    solutions = findInPersistentCache(key, problems, hardware);
+                    if(solutions.size() != 0)
+                    {
+                        m_cachesGroupedGemm.add(solutions, problems, amdgpu);
+                        return solutions;
+                    }
+                }
+
                 solutions
                     = m_subLibrary->findTopSolutionsGroupedGemm(problems, hardware, numSolutions);
                 if(solutions.size() != 0)
+                {
                     m_cachesGroupedGemm.add(solutions, problems, amdgpu);
+                    if(m_persistentCache)
+                        m_persistentCache->add(key, solutionIndices(solutions));
+                }
 
                 return solutions;
             }
@@ -302,10 +496,56 @@ namespace Tensile
         }
 
     private:
-        std::shared_ptr<Library>  m_subLibrary;
-        mutable Cache             m_cache;
-        mutable Caches            m_caches;
-        mutable CachesGroupedGemm m_cachesGroupedGemm;
+        static std::vector<int> solutionIndices(SolutionVector<MySolution> const& solutions)
+        {
+            std::vector<int> rv;
+            rv.reserve(solutions.size());
+            for(auto const& solution : solutions)
+                rv.push_back(solution->index);
+            return rv;
+        }
+
+        /**
+         * Resolves the solution indices stored for \p key. The solutions are
+         * checked against the problem(s) and hardware the same way the search
+         * would, and the entry is treated as a miss if any of them is stale.
+         */
+        template <typename Problems>
+        SolutionVector<MySolution> findInPersistentCache(uint64_t        key,
+                                                         Problems const& problems,
+                                                         Hardware const& hardware) const
+        {
+            std::vector<int> indices;
+            if(!m_persistentCache->find(key, indices))
+                return SolutionVector<MySolution>();
+
+            MyProblem const* problem;
+            if constexpr(std::is_same<Problems, MyProblem>::value)
+                problem = &problems;
+            else
+                problem = &problems[0];
+
+            SolutionVector<MySolution> rv;
+            rv.reserve(indices.size());
+            for(int index : indices)
+            {
+                auto solution = m_subLibrary->getSolutionByIndex(*problem, hardware, index);
+                if(!solution
+                   || !SingleSolutionLibrary<MyProblem, MySolution>(solution).findBestSolution(
+                       problems, hardware))
+                    return SolutionVector<MySolution>();
+
+                rv.push_back(solution);
+            }
+
+            return rv;
+        }
+
+        std::shared_ptr<Library>                 m_subLibrary;
+        mutable Cache                            m_cache;
+        mutable Caches                           m_caches;
+        mutable CachesGroupedGemm                m_cachesGroupedGemm;
+        std::shared_ptr<PersistentSolutionCache> m_persistentCache;
     };
 
 #if 0
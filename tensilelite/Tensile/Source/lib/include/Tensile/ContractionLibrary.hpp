@@ -33,6 +33,7 @@
 #include <Tensile/MapLibrary.hpp>
 #include <Tensile/MasterSolutionLibrary.hpp>
 #include <Tensile/MatchingLibrary.hpp>
+#include <Tensile/ModelRankingLibrary.hpp>
 #include <Tensile/SingleSolutionLibrary.hpp>
 #include <Tensile/SolutionLibrary.hpp>
 
@@ -54,4 +55,6 @@ namespace Tensile
     using ContractionProblemPredicate = ProblemPredicate<ContractionProblemGemm>;
     using ContractionGranularitySelectionLibrary
         = GranularitySelectionLibrary<ContractionProblemGemm, ContractionSolution>;
+    using ContractionModelRankingLibrary
+        = ModelRankingLibrary<ContractionProblemGemm, ContractionSolution>;
 } // namespace Tensile
@@ -91,6 +91,7 @@ namespace Tensile
         void setWorkspaceSize(size_t size)
         {
             m_workspaceSize = size;
+            updateFingerprint();
         }
 
         size_t workspaceSize() const
@@ -111,6 +112,7 @@ namespace Tensile
         void setF32XdlMathOp(DataType value)
         {
             m_f32XdlMathOp = value;
+            updateFingerprint();
         }
 
         DataType f32XdlMathOp() const
@@ -121,6 +123,7 @@ namespace Tensile
         void setComputeInputType(DataType value)
         {
             m_computeInputType = value;
+            updateFingerprint();
         }
 
         DataType computeInputType() const
@@ -140,6 +143,11 @@ namespace Tensile
 
     protected:
         friend class ContractionProblemGemm;
+
+        // Called by the setters above so that subclasses can keep a
+        // precomputed hash of the problem in sync.
+        virtual void updateFingerprint() {}
+
         std::vector<TensorDescriptor> m_tensors;
         std::vector<std::string>      m_names;
 
@@ -192,7 +200,48 @@ namespace Tensile
         using Inputs   = ContractionInputs;
 
         ContractionProblemGemm()
-            : ContractionProblem(ContractionProblemGemm::TENSOR::TENSOR_COUNT){};
+            : ContractionProblem(ContractionProblemGemm::TENSOR::TENSOR_COUNT)
+        {
+            updateFingerprint();
+        }
+
+        /**
+   * The properties that solution selection depends on, other than the
+   * A/B/C/D tensors and the operation identifier, packed into a few words
+   * so that comparing two problems is cheap.
+   */
+        struct Key
+        {
+            /// Bits of `flags`
+            enum Flag : uint32_t
+            {
+                HighPrecisionAccumulate = 1u << 0,
+                DeterministicMode       = 1u << 1,
+                StridedBatched          = 1u << 2,
+                GroupedGemm             = 1u << 3,
+                Fp16AltImpl             = 1u << 4,
+                ActivationNoGuard       = 1u << 5,
+                UseGradient             = 1u << 6,
+                UseBias                 = 1u << 7,
+                UseE                    = 1u << 8,
+                UseScaleAB              = 1u << 9,
+                UseScaleCD              = 1u << 10,
+                UseScaleDVec            = 1u << 11,
+                UseScaleAlphaVec        = 1u << 12
+            };
+
+            size_t                workspaceSize         = 0;
+            size_t                maxGlobalSplitU       = 0;
+            std::array<size_t, 4> minAlignmentBytes     = {};
+            uint32_t              flags                 = 0;
+            DataType              computeInputType      = DataType::None;
+            DataType              activationComputeType = DataType::None;
+            DataType              f32XdlMathOp          = DataType::None;
+            ActivationType        activationType        = ActivationType::None;
+            KernelLanguage        kernelLanguage        = KernelLanguage::Any;
+            PerformanceMetric     performanceMetric     = PerformanceMetric::Auto;
+            TENSOR                biasSrc               = TENSOR::D;
+        };
 
         /**
    * Represents a pair of free indices in a tensor contraction.
@@ -515,31 +564,37 @@ namespace Tensile
         void setUseE(bool useE)
         {
             m_useE = useE;
+            updateFingerprint();
         }
 
         void setUseBias(bool useBias)
         {
             m_useBias = useBias;
+            updateFingerprint();
         }
 
         void setUseScaleAB(bool useScaleAB)
         {
             m_useScaleAB = useScaleAB;
+            updateFingerprint();
         }
 
         void setUseScaleCD(bool useScaleCD)
         {
             m_useScaleCD = useScaleCD;
+            updateFingerprint();
         }
 
         void setUseScaleDVec(bool useScaleDVec)
         {
             m_useScaleDVec = useScaleDVec;
+            updateFingerprint();
         }
 
         void setUseScaleAlphaVec(bool useScaleAlphaVec)
         {
             m_useScaleAlphaVec = useScaleAlphaVec;
+            updateFingerprint();
         }
 
         bool useE() const
@@ -594,6 +649,7 @@ namespace Tensile
         {
             m_biasType = type;
             m_biasSrc  = src;
+            updateFingerprint();
             if(type != DataType::None && m_useBias)
             {
                 size_t batchIdx = 2;
@@ -709,6 +765,7 @@ namespace Tensile
         void setStridedBatched(bool value)
         {
             m_stridedBatched = value;
+            updateFingerprint();
         }
 
         bool stridedBatched() const
@@ -719,6 +776,7 @@ namespace Tensile
         void setGroupedGemm(bool value)
         {
             m_groupedGemm = value;
+            updateFingerprint();
         }
 
         bool groupedGemm() const
@@ -729,6 +787,7 @@ namespace Tensile
         void setHighPrecisionAccumulate(bool value)
         {
             m_highPrecisionAccumulate = value;
+            updateFingerprint();
         }
 
         bool highPrecisionAccumulate() const
@@ -750,6 +809,7 @@ namespace Tensile
         void setKernelLanguage(KernelLanguage value)
         {
             m_kernelLanguage = value;
+            updateFingerprint();
         }
         KernelLanguage kernelLanguage() const
         {
@@ -759,6 +819,7 @@ namespace Tensile
         void setPerformanceMetric(PerformanceMetric value)
         {
             m_performanceMetric = value;
+            updateFingerprint();
         }
 
         PerformanceMetric performanceMetric() const
@@ -770,15 +831,48 @@ namespace Tensile
         void setDeterministicMode(bool value)
         {
             m_deterministicMode = value;
+            updateFingerprint();
         }
         bool deterministicMode() const
         {
             return m_deterministicMode;
         }
 
+        /**
+   * Solutions that split the summation into more than `value` parts are not
+   * selected.
+   */
+        void setMaxGlobalSplitU(size_t value)
+        {
+            m_maxGlobalSplitU = value;
+            updateFingerprint();
+        }
+
+        size_t maxGlobalSplitU() const
+        {
+            return m_maxGlobalSplitU;
+        }
+
+        /**
+   * The pointers and leading dimensions of `tensor` (A, B, C or D) are
+   * promised to be aligned to `bytes`. Solutions that access it in wider units are not
+   * selected.
+   */
+        void setMinAlignmentBytes(TENSOR tensor, size_t bytes)
+        {
+            m_minAlignmentBytes[tensor] = bytes;
+            updateFingerprint();
+        }
+
+        size_t minAlignmentBytes(TENSOR tensor) const
+        {
+            return m_minAlignmentBytes[tensor];
+        }
+
         void setFp16AltImpl(bool value)
         {
             m_fp16AltImpl = value;
+            updateFingerprint();
         }
 
         bool fp16AltImpl() const
@@ -789,6 +883,7 @@ namespace Tensile
         void setUseGradient(bool value)
         {
             m_useGradient = value;
+            updateFingerprint();
         }
 
         bool useGradient() const
@@ -799,6 +894,7 @@ namespace Tensile
         void setActivationType(ActivationType activationtype)
         {
             m_activationType = activationtype;
+            updateFingerprint();
         }
 
         ActivationType activationType() const
@@ -809,6 +905,7 @@ namespace Tensile
         void setActivationComputeType(DataType value)
         {
             m_activationComputeType = value;
+            updateFingerprint();
         }
 
         DataType activationComputeType() const
@@ -819,6 +916,7 @@ namespace Tensile
         void setActivationNoGuard(bool value)
         {
             m_activationNoGuard = value;
+            updateFingerprint();
         }
 
         bool activationNoGuard() const
@@ -968,6 +1066,31 @@ namespace Tensile
             return m_eligibleForPK;
         }
 
+        virtual void resetTensor(int                           idx,
+                                 DataType                      type,
+                                 std::initializer_list<size_t> sizes,
+                                 std::initializer_list<size_t> strides) override
+        {
+            ContractionProblem::resetTensor(idx, type, sizes, strides);
+            if(idx <= ContractionProblemGemm::TENSOR::D)
+                updateTensorFingerprint(idx);
+        }
+
+        Key const& key() const
+        {
+            return m_key;
+        }
+
+        /**
+   * Hash of everything the problem is compared on: key(),
+   * operationIdentifier() and the A/B/C/D tensors. Kept up to date by
+   * the setters, so hashing a problem costs nothing.
+   */
+        size_t fingerprint() const
+        {
+            return m_fingerprint;
+        }
+
         virtual std::vector<ConstantDescriptor> const constants() const
         {
             std::vector<ConstantDescriptor> c = {{"alpha", m_alphaType}, {"beta", m_betaType}};
@@ -1040,6 +1163,12 @@ namespace Tensile
         KernelLanguage    m_kernelLanguage    = KernelLanguage::Any;
         PerformanceMetric m_performanceMetric = PerformanceMetric::DeviceEfficiency;
 
+        size_t                m_maxGlobalSplitU = std::numeric_limits<size_t>::max();
+        std::array<size_t, 4> m_minAlignmentBytes{std::numeric_limits<size_t>::max(),
+                                                  std::numeric_limits<size_t>::max(),
+                                                  std::numeric_limits<size_t>::max(),
+                                                  std::numeric_limits<size_t>::max()};
+
         DataType m_alphaType         = DataType::None; // if not assigned, will follow d-type
         DataType m_betaType          = DataType::None; // for bwd-compatible
         DataType m_biasType          = DataType::None;
@@ -1081,6 +1210,14 @@ namespace Tensile
 
         TensorDescriptor m_tensor_compressed;
 
+        Key                   m_key;
+        std::array<size_t, 4> m_tensorHashes            = {};
+        size_t                m_operationIdentifierHash = 0;
+        size_t                m_fingerprint             = 0;
+
+        virtual void updateFingerprint() override;
+        void         updateTensorFingerprint(int idx);
+
         void normalize();
         void normalizeSparseA();
 
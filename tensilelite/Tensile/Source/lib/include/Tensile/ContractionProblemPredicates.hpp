@@ -2049,6 +2049,136 @@ namespace Tensile
             };
         } // namespace Contraction
 
+        /**
+ * The problem type flags of a compiled problem predicate are compared with
+ * one mask against ContractionProblemGemm::key(), and the data types
+ * directly, rather than through one virtual call per term.
+ */
+        template <>
+        struct CompiledChecks<ContractionProblemGemm>
+        {
+            using Key = ContractionProblemGemm::Key;
+
+            uint32_t                flagsMask  = 0;
+            uint32_t                flags      = 0;
+            bool                    never      = false;
+            bool                    checkTypes = false;
+            std::array<DataType, 5> types;
+
+            bool absorb(Predicate<ContractionProblemGemm> const& term)
+            {
+                using namespace Contraction;
+
+                if(dynamic_cast<Fp16AltImpl const*>(&term))
+                {
+                    requireFlag(Key::Fp16AltImpl, true);
+                    return true;
+                }
+
+                if(auto const* typesEqual = dynamic_cast<TypesEqual const*>(&term))
+                {
+                    if(checkTypes)
+                        return false;
+
+                    checkTypes = true;
+                    types      = typesEqual->value;
+                    return true;
+                }
+
+                return absorbFlag<HighPrecisionAccumulateEqual>(term, Key::HighPrecisionAccumulate)
+                       || absorbFlag<DeterministicModeEqual>(term, Key::DeterministicMode)
+                       || absorbFlag<StridedBatchedEqual>(term, Key::StridedBatched)
+                       || absorbFlag<GroupedGemmEqual>(term, Key::GroupedGemm)
+                       || absorbFlag<ActivationNoGuardEqual>(term, Key::ActivationNoGuard)
+                       || absorbFlag<UseGradientEqual>(term, Key::UseGradient)
+                       || absorbFlag<UseBiasEqual>(term, Key::UseBias)
+                       || absorbFlag<UseEEqual>(term, Key::UseE)
+                       || absorbFlag<UseScaleABEqual>(term, Key::UseScaleAB)
+                       || absorbFlag<UseScaleCDEqual>(term, Key::UseScaleCD)
+                       || absorbFlag<UseScaleDVecEqual>(term, Key::UseScaleDVec)
+                       || absorbFlag<UseScaleAlphaVecEqual>(term, Key::UseScaleAlphaVec);
+            }
+
+            bool operator()(ContractionProblemGemm const& problem) const
+            {
+                if(never || (problem.key().flags & flagsMask) != flags)
+                    return false;
+
+                return !checkTypes
+                       || (problem.a().dataType() == types[0] && problem.b().dataType() == types[1]
+                           && problem.c().dataType() == types[2]
+                           && problem.d().dataType() == types[3]
+                           && problem.computeInputType() == types[4]);
+            }
+
+            /**
+   * The key packs the required flags into the low 24 bits and, when types
+   * are checked, the five data types into the next 40 bits. The signature
+   * is the flag mask, plus bit 32 when types are checked.
+   */
+            bool dispatchKey(uint64_t& signature, uint64_t& key) const
+            {
+                if(never || flagsMask >= (1u << 24))
+                    return false;
+
+                signature = flagsMask;
+                key       = flags;
+
+                if(checkTypes)
+                {
+                    signature |= uint64_t(1) << 32;
+                    key |= PackTypes(types[0], types[1], types[2], types[3], types[4]);
+                }
+
+                return true;
+            }
+
+            static uint64_t DispatchKey(ContractionProblemGemm const& problem, uint64_t signature)
+            {
+                uint64_t key = problem.key().flags & static_cast<uint32_t>(signature);
+
+                if(signature >> 32)
+                    key |= PackTypes(problem.a().dataType(),
+                                     problem.b().dataType(),
+                                     problem.c().dataType(),
+                                     problem.d().dataType(),
+                                     problem.computeInputType());
+
+                return key;
+            }
+
+        private:
+            static uint64_t PackTypes(DataType a, DataType b, DataType c, DataType d, DataType ci)
+            {
+                uint64_t rv = 0;
+                for(DataType t : {ci, d, c, b, a})
+                    rv = (rv << 8) | static_cast<uint8_t>(t);
+
+                return rv << 24;
+            }
+
+            template <typename Term>
+            bool absorbFlag(Predicate<ContractionProblemGemm> const& term, uint32_t flag)
+            {
+                auto const* typed = dynamic_cast<Term const*>(&term);
+                if(!typed)
+                    return false;
+
+                requireFlag(flag, typed->value);
+                return true;
+            }
+
+            void requireFlag(uint32_t flag, bool value)
+            {
+                // Two terms that want the flag both set and clear can never match.
+                if((flagsMask & flag) && ((flags & flag) != 0) != value)
+                    never = true;
+
+                flagsMask |= flag;
+                flags = value ? (flags | flag) : (flags & ~flag);
+            }
+        };
+
         /**
  * @}
  */
@@ -78,6 +78,42 @@ namespace Tensile
         }
     };
 
+    template <>
+    struct Comparison<ContractionProblemGemm::Key>
+    {
+        enum
+        {
+            implemented = true
+        };
+
+        static int compare(ContractionProblemGemm::Key const& lhs,
+                           ContractionProblemGemm::Key const& rhs)
+        {
+            return LexicographicCompare(lhs.flags,
+                                        rhs.flags,
+                                        lhs.workspaceSize,
+                                        rhs.workspaceSize,
+                                        lhs.maxGlobalSplitU,
+                                        rhs.maxGlobalSplitU,
+                                        lhs.minAlignmentBytes,
+                                        rhs.minAlignmentBytes,
+                                        lhs.computeInputType,
+                                        rhs.computeInputType,
+                                        lhs.activationComputeType,
+                                        rhs.activationComputeType,
+                                        lhs.f32XdlMathOp,
+                                        rhs.f32XdlMathOp,
+                                        lhs.activationType,
+                                        rhs.activationType,
+                                        lhs.kernelLanguage,
+                                        rhs.kernelLanguage,
+                                        lhs.performanceMetric,
+                                        rhs.performanceMetric,
+                                        lhs.biasSrc,
+                                        rhs.biasSrc);
+        }
+    };
+
     template <>
     struct Comparison<ContractionProblemGemm>
     {
@@ -86,16 +122,16 @@ namespace Tensile
             implemented = true
         };
 
+        // The fingerprint goes first so that unequal problems are nearly
+        // always told apart without looking at the tensors.
         static int compare(ContractionProblemGemm const& lhs, ContractionProblemGemm const& rhs)
         {
-            return LexicographicCompare(lhs.operationIdentifier(),
+            return LexicographicCompare(lhs.fingerprint(),
+                                        rhs.fingerprint(),
+                                        lhs.key(),
+                                        rhs.key(),
+                                        lhs.operationIdentifier(),
                                         rhs.operationIdentifier(),
-                                        lhs.highPrecisionAccumulate(),
-                                        rhs.highPrecisionAccumulate(),
-                                        lhs.kernelLanguage(),
-                                        rhs.kernelLanguage(),
-                                        lhs.deterministicMode(),
-                                        rhs.deterministicMode(),
                                         lhs.a(),
                                         rhs.a(),
                                         lhs.b(),
@@ -103,80 +139,41 @@ namespace Tensile
                                         lhs.c(),
                                         rhs.c(),
                                         lhs.d(),
-                                        rhs.d(),
-                                        lhs.computeInputType(),
-                                        rhs.computeInputType(),
-                                        lhs.workspaceSize(),
-                                        rhs.workspaceSize(),
-                                        lhs.stridedBatched(),
-                                        rhs.stridedBatched(),
-                                        lhs.groupedGemm(),
-                                        rhs.groupedGemm(),
-                                        lhs.performanceMetric(),
-                                        rhs.performanceMetric(),
-                                        lhs.fp16AltImpl(),
-                                        rhs.fp16AltImpl(),
-                                        lhs.activationType(),
-                                        rhs.activationType(),
-                                        lhs.activationComputeType(),
-                                        rhs.activationComputeType(),
-                                        lhs.activationNoGuard(),
-                                        rhs.activationNoGuard(),
-                                        lhs.useGradient(),
-                                        rhs.useGradient(),
-                                        lhs.useBias(),
-                                        rhs.useBias(),
-                                        lhs.biasSrc(),
-                                        rhs.biasSrc(),
-                                        lhs.useE(),
-                                        rhs.useE(),
-                                        lhs.useScaleAB(),
-                                        rhs.useScaleAB(),
-                                        lhs.useScaleCD(),
-                                        rhs.useScaleCD(),
-                                        lhs.useScaleDVec(),
-                                        rhs.useScaleDVec(),
-                                        lhs.useScaleAlphaVec(),
-                                        rhs.useScaleAlphaVec(),
-                                        lhs.f32XdlMathOp(),
-                                        rhs.f32XdlMathOp());
+                                        rhs.d());
         }
     };
 } // namespace Tensile
 
 namespace std
 {
+    template <>
+    struct hash<Tensile::ContractionProblemGemm::Key>
+    {
+        inline size_t operator()(Tensile::ContractionProblemGemm::Key const& key) const
+        {
+            return Tensile::hash_combine(key.workspaceSize,
+                                         key.maxGlobalSplitU,
+                                         key.minAlignmentBytes[0],
+                                         key.minAlignmentBytes[1],
+                                         key.minAlignmentBytes[2],
+                                         key.minAlignmentBytes[3],
+                                         key.flags,
+                                         key.computeInputType,
+                                         key.activationComputeType,
+                                         key.f32XdlMathOp,
+                                         key.activationType,
+                                         key.kernelLanguage,
+                                         key.performanceMetric,
+                                         key.biasSrc);
+        }
+    };
+
     template <>
     struct hash<Tensile::ContractionProblemGemm>
     {
         inline size_t operator()(Tensile::ContractionProblemGemm const& problem) const
         {
-            return Tensile::hash_combine(problem.operationIdentifier(),
-                                         problem.a(),
-                                         problem.b(),
-                                         problem.c(),
-                                         problem.d(),
-                                         problem.computeInputType(),
-                                         problem.highPrecisionAccumulate(),
-                                         problem.kernelLanguage(),
-                                         problem.deterministicMode(),
-                                         problem.workspaceSize(),
-                                         problem.stridedBatched(),
-                                         problem.groupedGemm(),
-                                         problem.performanceMetric(),
-                                         problem.fp16AltImpl(),
-                                         problem.activationType(),
-                                         problem.activationComputeType(),
-                                         problem.activationNoGuard(),
-                                         problem.useGradient(),
-                                         problem.useBias(),
-                                         problem.biasSrc(),
-                                         problem.useE(),
-                                         problem.useScaleAB(),
-                                         problem.useScaleCD(),
-                                         problem.useScaleDVec(),
-                                         problem.useScaleAlphaVec(),
-                                         problem.f32XdlMathOp());
+            return problem.fingerprint();
         }
     };
 
@@ -185,37 +182,9 @@ namespace std
     {
         inline size_t operator()(std::vector<Tensile::ContractionProblemGemm> const& problems) const
         {
-            size_t hash = 0;
-            for(int idx = 0; idx < problems.size(); idx++)
-            {
-                auto problem = problems[idx];
-                hash += Tensile::hash_combine(problem.operationIdentifier(),
-                                              problem.a(),
-                                              problem.b(),
-                                              problem.c(),
-                                              problem.d(),
-                                              problem.computeInputType(),
-                                              problem.highPrecisionAccumulate(),
-                                              problem.kernelLanguage(),
-                                              problem.deterministicMode(),
-                                              problem.workspaceSize(),
-                                              problem.stridedBatched(),
-                                              problem.groupedGemm(),
-                                              problem.performanceMetric(),
-                                              problem.fp16AltImpl(),
-                                              problem.activationType(),
-                                              problem.activationComputeType(),
-                                              problem.activationNoGuard(),
-                                              problem.useGradient(),
-                                              problem.useBias(),
-                                              problem.biasSrc(),
-                                              problem.useE(),
-                                              problem.useScaleAB(),
-                                              problem.useScaleCD(),
-                                              problem.useScaleDVec(),
-                                              problem.useScaleAlphaVec(),
-                                              problem.f32XdlMathOp());
-            }
+            size_t hash = problems.size();
+            for(auto const& problem : problems)
+                hash = Tensile::combine_hashes(problem.fingerprint(), hash);
             return hash;
         }
     };
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <limits>
 #include <memory>
@@ -42,6 +43,11 @@
 
 namespace Tensile
 {
+    namespace hip
+    {
+        class ArgumentRing;
+    }
+
     template <typename TAct>
     struct DeviceUserArguments
     {
@@ -189,6 +195,29 @@ namespace Tensile
             StaticPerformanceModel staticModel;
         };
 
+        /**
+         * Per-architecture parameters of the roofline model used by
+         * rooflinePerformance(). The CU count is taken from the hardware, and
+         * so are the bandwidth and clock unless they are set.
+         */
+        struct RooflineCalibration
+        {
+            double memoryBandwidth    = 0.0; //! Peak memory bandwidth in GB/s, 0 for the hardware's
+            double clockMHz           = 0.0; //! 0 for the hardware's
+            double flopsPerCuPerCycle = 0.0; //! Matrix core throughput for this type
+            double memoryEfficiency   = 0.8; //! Of peak, above 1 when caches serve re-reads
+            double computeEfficiency  = 0.8; //! Fraction of the peak throughput reached
+            double launchOverhead     = 5.0; //! Per kernel launch, in microseconds
+
+            //! With the bandwidth and clock of hardware where they are not set.
+            RooflineCalibration resolve(Hardware const& hardware) const;
+
+            bool complete() const
+            {
+                return memoryBandwidth > 0.0 && clockMHz > 0.0 && flopsPerCuPerCycle > 0.0;
+            }
+        };
+
         struct TAMetricProblemScore
         {
             Granularities granularites;
@@ -209,6 +238,23 @@ namespace Tensile
         size_t requiredWorkspaceSizeGroupedGemm(std::vector<Problem> const& problems) const;
         size_t requiredHostSizeGroupedGemmSingle(Problem const& problem) const;
 
+        /**
+   * Whether the solution fits the limits that the caller put on the search:
+   * the workspace it provides, the largest global split-U and the alignment
+   * of A, B, C and D.
+   */
+        bool fitsSelectionLimits(Problem const& problem) const;
+
+        /**
+   * The M, N, K and number of batches of a problem, with the free and batch
+   * indices packed the way this solution packs them.
+   */
+        void modelSizes(Problem const& problem,
+                        double&        M,
+                        double&        N,
+                        double&        K,
+                        double&        NumBatches) const;
+
         static float computeGranularity(float x);
 
         Granularities computeGranularities(
@@ -243,6 +289,16 @@ namespace Tensile
         ProjectedPerformance projectedPerformance(Problem const&  problem,
                                                   Hardware const& hardware) const;
 
+        /**
+   * Calculate the projected performance as the slower of the time to move the
+   * data and the time to compute it, after granularity loss and GSU. The
+   * calibration is used as is, see RooflineCalibration::resolve(); the
+   * projection is 0 when it is not complete.
+   */
+        ProjectedPerformance rooflinePerformance(Problem const&             problem,
+                                                 Hardware const&            hardware,
+                                                 RooflineCalibration const& calibration) const;
+
         /**
    * Generate a set of kernel calls to solve a particular problem.
    */
@@ -256,6 +312,34 @@ namespace Tensile
         virtual std::vector<KernelInvocation>
             solve(Problem const& problem, Inputs const& inputs, Hardware const& hardware) const;
 
+        /**
+         * Rewrites the data pointers, alpha and beta in kernels returned by
+         * solve(problem, previous, ...), instead of building them again.
+         * Returns false and leaves the kernels untouched if solve() would not
+         * accept the new inputs or would build different kernels for them,
+         * e.g. when a pointer changes between null and non-null.
+         */
+        bool updateInputs(std::vector<KernelInvocation>& kernels,
+                          Problem const&                 problem,
+                          Inputs const&                  previous,
+                          Inputs const&                  inputs) const;
+
+        /**
+         * Rewrites the arguments that solveGroupedGemm(problems, previous, ...)
+         * copied to inputs.ws for the gemms whose pointers, alpha or beta
+         * differ from previous. Only those gemms are encoded again and only
+         * their entries are copied, on stream, through a slot of argumentRing.
+         * The indices of the rewritten gemms are returned in updated. Returns
+         * false and copies nothing if solveGroupedGemm() would not accept the
+         * new inputs or would build different kernels for them.
+         */
+        bool updateGroupedGemmInputs(std::vector<Problem> const& problems,
+                                     GroupedInputs const&        previous,
+                                     GroupedInputs const&        inputs,
+                                     hip::ArgumentRing&          argumentRing,
+                                     hipStream_t                 stream,
+                                     std::vector<size_t>&        updated) const;
+
         virtual std::vector<KernelInvocation> solveGroupedGemm(std::vector<Problem> const& problems,
                                                                GroupedInputs const&        inputs,
                                                                Hardware const&             hardware,
@@ -263,6 +347,16 @@ namespace Tensile
                                                                size_t      hipHostMemorySize,
                                                                hipStream_t stream) const;
 
+        // Stages the arguments in a slot of argumentRing, which is fenced on stream
+        // after the copy to the workspace so that it is not reused while the copy
+        // is still in flight.
+        virtual std::vector<KernelInvocation>
+            solveGroupedGemm(std::vector<Problem> const& problems,
+                             GroupedInputs const&        inputs,
+                             Hardware const&             hardware,
+                             hip::ArgumentRing&          argumentRing,
+                             hipStream_t                 stream) const;
+
         // The problems and inputs are passed by device memory
         virtual std::vector<KernelInvocation>
             solveGroupedGemmGPU(std::vector<Problem> const& problems,
@@ -294,6 +388,12 @@ namespace Tensile
 
         virtual void relaseDeviceUserArgs(void* dUA, void* dUAHost);
 
+        // True if the kernels built for previous can take inputs by only
+        // rewriting their pointers, alpha and beta.
+        bool canUpdateInputs(Problem const& problem,
+                             Inputs const&  previous,
+                             Inputs const&  inputs) const;
+
         template <bool T_Debug, bool insertKernelArgs, typename KA>
         void singleCallArgs(Problem const&           problem,
                             ContractionInputs const& inputs,
@@ -408,6 +508,9 @@ namespace Tensile
 
             bool activationFused = true;
 
+            //! Widest global access the kernel makes to A, B, C and D in bytes, 0 if unknown.
+            std::array<size_t, 4> alignmentBytes = {};
+
             std::string customKernelName;
         };
 
@@ -459,6 +562,9 @@ namespace Tensile
         std::string                  kernelName;
         std::string                  solutionName;
         ThreadSafeValue<std::string> codeObjectFilename;
+        //! Launch handles for kernelName, filled in by the adapters on first launch.
+        std::shared_ptr<KernelHandleCache> kernelHandleCache
+            = std::make_shared<KernelHandleCache>();
         bool                         debugKernel   = false;
         bool                         kernelArgsLog = false;
 
@@ -80,18 +80,26 @@ namespace Tensile
 
         int getGridbasedTopSols() const;
 
+        // Maximum number of entries in each solution cache, 0 for unbounded
+        size_t getSolutionCacheCapacity() const;
+
+        // Flatten solution and library predicates when a library is loaded
+        bool compilePredicates() const;
+
     private:
         friend LazySingleton<Debug>;
 
         int         m_value;
         int         m_value2;
-        bool        m_naivePropertySearch = false;
-        bool        m_debugSelection      = false;
-        bool        m_experimentSelection = false;
-        int         m_solution_index      = -1;
-        std::string m_metric              = "";
-        int         m_gridbasedTopSols    = 1;
-        bool        m_benchmark           = false;
+        bool        m_naivePropertySearch   = false;
+        bool        m_debugSelection        = false;
+        bool        m_experimentSelection   = false;
+        int         m_solution_index        = -1;
+        std::string m_metric                = "";
+        int         m_gridbasedTopSols      = 1;
+        bool        m_benchmark             = false;
+        size_t      m_solutionCacheCapacity = 0;
+        bool        m_compilePredicates     = true;
 
         Debug();
     };
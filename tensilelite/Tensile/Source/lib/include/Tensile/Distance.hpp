@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
 namespace Tensile
@@ -393,6 +394,59 @@ namespace Tensile
             }
         };
 
+        /**
+         * Euclidean distance between the log2 of the sizes, so that a size is
+         * as close to half of it as to twice it. Tables using it select by
+         * interpolating between the nearest tuned sizes instead of taking the
+         * closest one.
+         */
+        template <typename Key>
+        struct GridInterpolatedDistance : public Distance<Key>
+        {
+            enum
+            {
+                HasIndex = false,
+                HasValue = false
+            };
+
+            static std::string Type()
+            {
+                return "GridInterpolated";
+            }
+            virtual std::string type() const override
+            {
+                return Type();
+            }
+
+            static inline double coordinate(double size)
+            {
+                return std::log2(std::max(size, 1.0));
+            }
+
+            inline double operator()(Key const& p1, Key const& p2) const
+            {
+                double distance = 0.0;
+
+                for(int i = 0; i < p1.size(); i++)
+                {
+                    double di = coordinate(p1[i]) - coordinate(p2[i]);
+                    distance += di * di;
+                }
+
+                return distance;
+            }
+
+            inline bool improvementPossible(Key const& p1,
+                                            Key const& p2,
+                                            size_t     idx,
+                                            double     bestDistance) const
+            {
+                double di = coordinate(p1[idx]) - coordinate(p2[idx]);
+
+                return di * di < bestDistance;
+            }
+        };
+
         /**
  * @}
  */
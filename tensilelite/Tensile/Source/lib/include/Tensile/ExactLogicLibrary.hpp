@@ -27,9 +27,14 @@
 #pragma once
 
 #include <Tensile/Debug.hpp>
+#include <Tensile/PerfectHashMap.hpp>
 #include <Tensile/Predicates.hpp>
 #include <Tensile/SolutionLibrary.hpp>
 
+#include <algorithm>
+#include <array>
+#include <map>
+
 namespace Tensile
 {
     /**
@@ -41,6 +46,30 @@ namespace Tensile
     template <typename MyProblem, typename MySolution, typename MyPredicate>
     using LibraryRow = std::pair<MyPredicate, LibraryEntry<MyProblem, MySolution>>;
 
+    /**
+ * Narrows down the rows of an ExactLogicLibrary that a problem has to be
+ * checked against. The generic version does not, and every row is checked.
+ */
+    template <typename MyProblem, typename MyPredicate>
+    struct ExactLogicRowIndex
+    {
+        template <typename Rows>
+        void build(Rows const& rows)
+        {
+        }
+
+        /**
+         * Calls visit(idx) on the index of each row that problem may match,
+         * in row order, until it returns true. Returns false, without calling
+         * visit, if every row has to be checked.
+         */
+        template <typename Visit>
+        bool forEachCandidate(MyProblem const& problem, Visit&& visit) const
+        {
+            return false;
+        }
+    };
+
     /**
  * Represents a set of sub-libraries, each with associated predicates. It
  * should be placed in order of best to worst solutions. We assume the best
@@ -59,11 +88,33 @@ namespace Tensile
         ExactLogicLibrary(std::initializer_list<Row> init)
             : rows(init)
         {
+            buildIndex();
         }
 
         ExactLogicLibrary(std::vector<Row> const& init)
             : rows(init)
         {
+            buildIndex();
+        }
+
+        /**
+         * Must be called again whenever rows are changed, before the library
+         * is searched.
+         */
+        void buildIndex()
+        {
+            rowIndex.build(rows);
+        }
+
+        //! The indices of the rows that match problem, in row order.
+        std::vector<size_t> matchingRows(MyProblem const& problem, Hardware const& hardware) const
+        {
+            std::vector<size_t> rv;
+            forEachMatchingRow(problem, hardware, [&](Row const& row) {
+                rv.push_back(&row - rows.data());
+                return false;
+            });
+            return rv;
         }
 
         virtual std::shared_ptr<MySolution> getSolutionByIndex(MyProblem const& problem,
@@ -72,15 +123,10 @@ namespace Tensile
         {
             std::shared_ptr<MySolution> rv;
 
-            for(auto const& row : rows)
-            {
-                if(row.first(problem, hardware))
-                {
-                    rv = row.second->getSolutionByIndex(problem, hardware, index);
-                    if(rv)
-                        return rv;
-                }
-            }
+            forEachMatchingRow(problem, hardware, [&](Row const& row) {
+                rv = row.second->getSolutionByIndex(problem, hardware, index);
+                return rv != nullptr;
+            });
 
             return rv;
         }
@@ -92,15 +138,10 @@ namespace Tensile
         {
             std::shared_ptr<MySolution> rv;
 
-            for(auto const& row : rows)
-            {
-                if(row.first(problem, hardware))
-                {
-                    rv = row.second->findBestSolution(problem, hardware, fitness);
-                    if(rv)
-                        return rv;
-                }
-            }
+            forEachMatchingRow(problem, hardware, [&](Row const& row) {
+                rv = row.second->findBestSolution(problem, hardware, fitness);
+                return rv != nullptr;
+            });
 
             return rv;
         }
@@ -157,17 +198,12 @@ namespace Tensile
         {
             SolutionVector<MySolution> rv, solutions;
 
-            for(auto const& row : rows)
-            {
-                if(row.first(problem, hardware))
-                {
-                    solutions
-                        = row.second->findTopSolutions(problem, hardware, numSolutions - rv.size());
-                    rv.insert(std::end(rv), std::begin(solutions), std::end(solutions));
-                    if(rv.size() == numSolutions)
-                        return rv;
-                }
-            }
+            forEachMatchingRow(problem, hardware, [&](Row const& row) {
+                solutions
+                    = row.second->findTopSolutions(problem, hardware, numSolutions - rv.size());
+                rv.insert(std::end(rv), std::begin(solutions), std::end(solutions));
+                return rv.size() == numSolutions;
+            });
 
             return rv;
         }
@@ -179,20 +215,48 @@ namespace Tensile
         {
             SolutionVector<MySolution> rv, solutions;
 
+            forEachMatchingRow(problems[0], hardware, [&](Row const& row) {
+                solutions = row.second->findTopSolutionsGroupedGemm(
+                    problems, hardware, numSolutions - rv.size());
+                rv.insert(std::end(rv), std::begin(solutions), std::end(solutions));
+                return rv.size() == numSolutions;
+            });
+
+            return rv;
+        }
+
+        virtual void
+            getLazyLoadedLibraries(std::vector<LazyLoadedLibrary const*>& libraries) const override
+        {
+            for(auto const& row : rows)
+                row.second->getLazyLoadedLibraries(libraries);
+        }
+
+    private:
+        /**
+         * Calls visit on each row matching problem, in row order, until it
+         * returns true. Only the rows the index can't rule out are checked.
+         */
+        template <typename Visit>
+        void forEachMatchingRow(MyProblem const& problem,
+                                Hardware const&  hardware,
+                                Visit&&          visit) const
+        {
+            bool indexed = rowIndex.forEachCandidate(problem, [&](size_t idx) {
+                auto const& row = rows[idx];
+                return row.first(problem, hardware) && visit(row);
+            });
+            if(indexed)
+                return;
+
             for(auto const& row : rows)
             {
-                if(row.first(problems[0], hardware))
-                {
-                    solutions = row.second->findTopSolutionsGroupedGemm(
-                        problems, hardware, numSolutions - rv.size());
-                    rv.insert(std::end(rv), std::begin(solutions), std::end(solutions));
-                    if(rv.size() == numSolutions)
-                        return rv;
-                }
+                if(row.first(problem, hardware) && visit(row))
+                    return;
             }
-
-            return rv;
         }
+
+        ExactLogicRowIndex<MyProblem, MyPredicate> rowIndex;
     };
 
     struct HardwarePredicate
@@ -272,6 +336,108 @@ namespace Tensile
         }
     };
 
+    /**
+ * Looks rows up by the problem type their compiled predicates require, so
+ * that a problem is only checked against the rows of its own type. Rows are
+ * grouped by the signature of their key, and each group is looked up with a
+ * perfect hash of the key the problem has under that signature. Rows whose
+ * predicates can't be keyed are checked for every problem. Rows that are
+ * looked up are still checked in full, and in their original order, so the
+ * first matching row is the same as without the index.
+ */
+    template <typename MyProblem>
+    struct ExactLogicRowIndex<MyProblem, ProblemPredicate<MyProblem>>
+    {
+        //! Rows with further signatures are rare, and are treated as unkeyed.
+        static constexpr size_t MaxSignatures = 8;
+
+        template <typename Rows>
+        void build(Rows const& rows)
+        {
+            groups.clear();
+            unkeyed.clear();
+
+            std::vector<uint64_t>                                  signatures;
+            std::vector<std::map<uint64_t, std::vector<uint32_t>>> keyed;
+
+            for(size_t idx = 0; idx < rows.size(); idx++)
+            {
+                auto const* compiled = dynamic_cast<Predicates::Compiled<MyProblem> const*>(
+                    rows[idx].first.value.get());
+
+                uint64_t signature = 0, key = 0;
+                bool     isKeyed = compiled && compiled->dispatchKey(signature, key);
+
+                size_t group = std::find(signatures.begin(), signatures.end(), signature)
+                               - signatures.begin();
+                if(isKeyed && group == signatures.size() && group < MaxSignatures)
+                {
+                    signatures.push_back(signature);
+                    keyed.emplace_back();
+                }
+
+                if(isKeyed && group < signatures.size())
+                    keyed[group][key].push_back(idx);
+                else
+                    unkeyed.push_back(idx);
+            }
+
+            groups.resize(signatures.size());
+            for(size_t group = 0; group < signatures.size(); group++)
+            {
+                groups[group].signature = signatures[group];
+                groups[group].rows.build({keyed[group].begin(), keyed[group].end()});
+            }
+        }
+
+        template <typename Visit>
+        bool forEachCandidate(MyProblem const& problem, Visit&& visit) const
+        {
+            // Every row is evaluated when the evaluation is being printed.
+            if(groups.empty() || Debug::Instance().printPredicateEvaluation())
+                return false;
+
+            // The unkeyed rows and those of the key of problem in each group,
+            // merged back into row order.
+            using Range = std::pair<uint32_t const*, uint32_t const*>;
+            std::array<Range, MaxSignatures + 1> ranges;
+            size_t                               count = 0;
+
+            ranges[count++] = {unkeyed.data(), unkeyed.data() + unkeyed.size()};
+            for(auto const& group : groups)
+            {
+                auto const* rows = group.rows.find(
+                    Predicates::CompiledChecks<MyProblem>::DispatchKey(problem, group.signature));
+                if(rows)
+                    ranges[count++] = {rows->data(), rows->data() + rows->size()};
+            }
+
+            while(true)
+            {
+                Range* next = nullptr;
+                for(size_t i = 0; i < count; i++)
+                {
+                    if(ranges[i].first != ranges[i].second
+                       && (!next || *ranges[i].first < *next->first))
+                        next = &ranges[i];
+                }
+
+                if(!next || visit(*next->first++))
+                    return true;
+            }
+        }
+
+    private:
+        struct Group
+        {
+            uint64_t                              signature = 0;
+            PerfectHashMap<std::vector<uint32_t>> rows;
+        };
+
+        std::vector<Group>    groups;
+        std::vector<uint32_t> unkeyed;
+    };
+
     template <typename MyProblem, typename MySolution>
     struct ProblemSelectionLibrary
         : public ExactLogicLibrary<MyProblem, MySolution, ProblemPredicate<MyProblem>>
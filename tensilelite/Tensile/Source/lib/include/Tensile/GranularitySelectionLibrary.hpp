@@ -119,7 +119,8 @@ namespace Tensile
                     std::cout << std::endl;
                 }
 
-                if((*rv->problemPredicate)(problem) && (*rv->hardwarePredicate)(hardware))
+                if((*rv->problemPredicate)(problem) && rv->fitsSelectionLimits(problem)
+                   && (*rv->hardwarePredicate)(hardware))
                 {
                     return rv;
                 }
@@ -145,6 +146,7 @@ namespace Tensile
                 if(myPerformance > bestPerformance)
                 {
                     if((*row.second->problemPredicate)(problem)
+                       && row.second->fitsSelectionLimits(problem)
                        && (*row.second->hardwarePredicate)(hardware))
                     {
                         bestPerformance = myPerformance;
@@ -246,7 +248,8 @@ namespace Tensile
                         {
                             auto problem = problems[idx];
                             problem.setWorkspaceSizeGroupedGemm(ws);
-                            if(!(*row.second->problemPredicate)(problem))
+                            if(!(*row.second->problemPredicate)(problem)
+                               || !row.second->fitsSelectionLimits(problem))
                                 useSolution = false;
                         }
                     }
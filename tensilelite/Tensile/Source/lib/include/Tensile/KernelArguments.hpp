@@ -64,7 +64,7 @@ namespace Tensile
                 m_currentLocation = m_vec_data.size();
                 return;
             }
-            else if(startPos + size < m_dataSize)
+            else if(startPos + size <= m_dataSize)
             {
                 // We don't insert 0 here because we'll copy data later.
                 // Adding this API is to compatible with vector insert.
@@ -131,6 +131,30 @@ namespace Tensile
         std::vector<T> m_vec_data;
     };
 
+    /**
+     * Kernel arguments that hold a data pointer or scalar of the inputs, and
+     * can be rewritten with KernelArguments::rebind once the arguments have
+     * been built, as long as the problem does not change.
+     */
+    enum class KernelArgumentBinding : uint8_t
+    {
+        A,
+        B,
+        C,
+        D,
+        E,
+        Bias,
+        ScaleA,
+        ScaleB,
+        ScaleC,
+        ScaleD,
+        ScaleAlphaVec,
+        ScaleDVec,
+        Alpha,
+        Beta,
+        Count
+    };
+
     class TENSILE_API KernelArguments
     {
     public:
@@ -146,6 +170,22 @@ namespace Tensile
         template <typename T>
         void append(std::string const& name, T value);
 
+        // Appends an argument that can later be rewritten with rebind().
+        template <typename T>
+        void append(std::string const& name, T value, KernelArgumentBinding binding);
+
+        void append(std::string const&     name,
+                    ConstantVariant const& value,
+                    DataType               type,
+                    KernelArgumentBinding  binding);
+
+        /**
+         * Overwrites every argument appended with the given binding. Returns
+         * false if there is none.
+         */
+        bool rebind(KernelArgumentBinding binding, void const* pointer);
+        bool rebind(KernelArgumentBinding binding, ConstantVariant const& value);
+
         template <typename T>
         void appendUnbound(std::string const& name);
 
@@ -224,8 +264,17 @@ namespace Tensile
         template <typename T>
         void writeValue(size_t offset, T value);
 
+        struct BoundArg
+        {
+            KernelArgumentBinding binding;
+            DataType              type; // DataType::None for pointers
+            size_t                offset;
+        };
+
         KernelArgumentsContainer<uint8_t> m_data;
 
+        std::vector<BoundArg> m_boundArgs;
+
         std::vector<std::string>             m_names;
         std::unordered_map<std::string, Arg> m_argRecords;
         std::unordered_map<std::string, int> m_argNameCounter;
@@ -286,6 +335,26 @@ namespace Tensile
         append(name, value, true);
     }
 
+    template <typename T>
+    inline void KernelArguments::append(std::string const&    name,
+                                        T                     value,
+                                        KernelArgumentBinding binding)
+    {
+        static_assert(std::is_pointer<T>::value, "Only pointers are bound without a DataType.");
+
+        m_boundArgs.push_back({binding, DataType::None, m_data.size()});
+        append(name, value, true);
+    }
+
+    inline void KernelArguments::append(std::string const&     name,
+                                        ConstantVariant const& value,
+                                        DataType               type,
+                                        KernelArgumentBinding  binding)
+    {
+        m_boundArgs.push_back({binding, type, m_data.size()});
+        append(name, value, type);
+    }
+
     template <typename T>
     inline void KernelArguments::appendUnbound(std::string const& name)
     {
@@ -467,6 +536,20 @@ namespace Tensile
             counter += sizeof(value);
         }
 
+        template <typename T>
+        inline void append(std::string const& name, T value, KernelArgumentBinding binding)
+        {
+            append(name, value);
+        }
+
+        inline void append(std::string const&     name,
+                           ConstantVariant const& value,
+                           DataType               type,
+                           KernelArgumentBinding  binding)
+        {
+            append(name, value, type);
+        }
+
         template <typename T>
         inline void appendUnbound(std::string const& name)
         {
@@ -211,5 +211,15 @@ namespace Tensile
 
             return library->findTopSolutionsGroupedGemm(problems, hardware, numSolutions);
         }
+
+        virtual void
+            getLazyLoadedLibraries(std::vector<LazyLoadedLibrary const*>& libraries) const override
+        {
+            for(auto const& pair : map)
+            {
+                if(pair.second)
+                    pair.second->getLazyLoadedLibraries(libraries);
+            }
+        }
     };
 } // namespace Tensile
@@ -26,9 +26,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <Tensile/Debug.hpp>
 #include <Tensile/SolutionLibrary.hpp>
@@ -43,14 +46,124 @@ namespace Tensile
     template <typename MySolution>
     using SolutionMap = std::map<int, std::shared_ptr<MySolution>>;
 
+    /**
+ * \ingroup SolutionLibrary
+ *
+ * Solutions stored by index for lookups that take constant time. It is
+ * filled in once, when a library is loaded, and is read without locking
+ * after that.
+ */
+    template <typename MySolution>
+    class SolutionTable
+    {
+    public:
+        void assign(SolutionMap<MySolution> const& solutions)
+        {
+            m_solutions.clear();
+            if(solutions.empty())
+                return;
+
+            m_firstIndex = solutions.begin()->first;
+            m_solutions.resize(solutions.rbegin()->first - m_firstIndex + 1);
+            for(auto const& pair : solutions)
+                m_solutions[pair.first - m_firstIndex] = pair.second;
+        }
+
+        //! Returns nullptr if there is no solution with this index.
+        std::shared_ptr<MySolution> find(int index) const
+        {
+            if(index < m_firstIndex || index - m_firstIndex >= int(m_solutions.size()))
+                return std::shared_ptr<MySolution>();
+
+            return m_solutions[index - m_firstIndex];
+        }
+
+    private:
+        int                                      m_firstIndex = 0;
+        std::vector<std::shared_ptr<MySolution>> m_solutions;
+    };
+
+    /**
+ * \ingroup SolutionLibrary
+ *
+ * The solutions that lazily loaded sub-libraries add to the solution map of
+ * the master library, by index. A slot is set once, while the map is locked,
+ * to the entry of the map, which is never erased or moved, so lookups don't
+ * lock. Indices from Capacity on are only found in the map.
+ */
+    template <typename MySolution>
+    class LazySolutionTable
+    {
+    public:
+        static constexpr int ChunkBits  = 12;
+        static constexpr int ChunkSize  = 1 << ChunkBits;
+        static constexpr int ChunkCount = 1 << 10;
+        static constexpr int Capacity   = ChunkSize * ChunkCount;
+
+        //! Whether find() gives the answer for index, rather than the map.
+        static bool covers(int index)
+        {
+            return index >= 0 && index < Capacity;
+        }
+
+        //! Called with the map locked; entry must be the entry of index in it.
+        void publish(int index, std::shared_ptr<MySolution> const& entry)
+        {
+            if(!covers(index))
+                return;
+
+            // The chunks are only allocated by the master library that
+            // lazily loads sub-libraries.
+            if(!m_chunks.load(std::memory_order_relaxed))
+            {
+                m_chunkStorage.reset(new std::atomic<Slot*>[ChunkCount]());
+                m_chunks.store(m_chunkStorage.get(), std::memory_order_release);
+            }
+
+            auto& chunk = m_chunkStorage[index >> ChunkBits];
+            if(!chunk.load(std::memory_order_relaxed))
+            {
+                m_slotStorage.emplace_back(new Slot[ChunkSize]());
+                chunk.store(m_slotStorage.back().get(), std::memory_order_release);
+            }
+
+            auto& slot = chunk.load(std::memory_order_relaxed)[index & (ChunkSize - 1)];
+            if(!slot.load(std::memory_order_relaxed))
+                slot.store(&entry, std::memory_order_release);
+        }
+
+        //! Returns nullptr if no sub-library with a solution of index is loaded.
+        std::shared_ptr<MySolution> find(int index) const
+        {
+            auto const* chunks = m_chunks.load(std::memory_order_acquire);
+            if(!covers(index) || !chunks)
+                return std::shared_ptr<MySolution>();
+
+            Slot const* chunk = chunks[index >> ChunkBits].load(std::memory_order_acquire);
+            if(!chunk)
+                return std::shared_ptr<MySolution>();
+
+            auto const* entry = chunk[index & (ChunkSize - 1)].load(std::memory_order_acquire);
+            return entry ? *entry : std::shared_ptr<MySolution>();
+        }
+
+    private:
+        using Slot = std::atomic<std::shared_ptr<MySolution> const*>;
+
+        std::atomic<std::atomic<Slot*>*>      m_chunks{nullptr};
+        std::unique_ptr<std::atomic<Slot*>[]> m_chunkStorage;
+        std::vector<std::unique_ptr<Slot[]>>  m_slotStorage;
+    };
+
     template <typename MySolution>
     struct LibraryIOContext
     {
         std::string                  filename;
         std::vector<LazyLoadingInit> preloaded;
         // If lazy loading is used, this may be updated in const functions
-        SolutionMap<MySolution>* solutions;
-        std::mutex*              solutionsGuard;
+        SolutionMap<MySolution>*       solutions;
+        std::mutex*                    solutionsGuard;
+        LazySolutionTable<MySolution>* lazySolutions;
     };
 
     /**
@@ -86,20 +199,56 @@ namespace Tensile
 
         std::shared_ptr<SolutionLibrary<MyProblem, MySolution>> library;
         SolutionMap<MySolution>                                 solutions;
-        std::string                                             version;
-        mutable std::mutex                                      solutionsGuard;
+        // The solutions loaded with this library. Those of lazily loaded
+        // sub-libraries are only added to the map.
+        SolutionTable<MySolution> solutionTable;
+        // Those that lazily loaded sub-libraries added to the map.
+        LazySolutionTable<MySolution> lazySolutions;
+        std::string                   version;
+        mutable std::mutex            solutionsGuard;
 
         MasterSolutionLibrary() = default;
 
+        /**
+         * Looks index up in solutionTable, then in the sub-libraries, then in
+         * lazySolutions. Only indices that lazySolutions does not cover are
+         * looked up in the solution map, which has to be locked while
+         * sub-libraries may be adding to it.
+         */
+        std::shared_ptr<MySolution> findSolution(MyProblem const* problem,
+                                                 Hardware const*  hardware,
+                                                 const int        index) const
+        {
+            if(auto solution = solutionTable.find(index))
+                return solution;
+
+            if(problem && hardware && library)
+            {
+                auto solution = library->getSolutionByIndex(*problem, *hardware, index);
+                if(solution)
+                    return solution;
+            }
+
+            if(LazySolutionTable<MySolution>::covers(index))
+                return lazySolutions.find(index);
+
+            std::lock_guard<std::mutex> guard(solutionsGuard);
+            auto                        iter = solutions.find(index);
+            if(iter == solutions.end())
+                return std::shared_ptr<MySolution>();
+
+            return iter->second;
+        }
+
         virtual std::shared_ptr<MySolution> getSolutionByIndex(MyProblem const& problem,
                                                                Hardware const&  hardware,
                                                                const int index) const override
         {
-            if(index >= solutions.size())
+            auto solution = findSolution(&problem, &hardware, index);
+            if(!solution)
             {
                 return std::shared_ptr<MySolution>();
             }
-            auto solution = solutions.at(index);
             if(solution->requiredHostWorkspaceSizePerProblem == static_cast<size_t>(-1))
             {
                 solution->requiredHostWorkspaceSizePerProblem
@@ -110,11 +259,11 @@ namespace Tensile
 
         virtual std::shared_ptr<MySolution> getSolutionByIndex(const int index) const override
         {
-            if(index >= solutions.size())
+            auto solution = findSolution(nullptr, nullptr, index);
+            if(!solution)
             {
                 return std::shared_ptr<MySolution>();
             }
-            auto solution = solutions.at(index);
             if(solution->requiredHostWorkspaceSizePerProblem == static_cast<size_t>(-1))
             {
                 auto problem
@@ -232,6 +381,12 @@ namespace Tensile
         {
             return library->findTopSolutionsGroupedGemm(problems, hardware, numSolutions);
         }
+
+        virtual void
+            getLazyLoadedLibraries(std::vector<LazyLoadedLibrary const*>& libraries) const override
+        {
+            library->getLazyLoadedLibraries(libraries);
+        }
     };
 
 } // namespace Tensile
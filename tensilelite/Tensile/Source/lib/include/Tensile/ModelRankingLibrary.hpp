@@ -0,0 +1,376 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <vector>
+
+#include <Tensile/Debug.hpp>
+#include <Tensile/SolutionLibrary.hpp>
+#include <Tensile/Utils.hpp>
+
+namespace Tensile
+{
+    /**
+     * \ingroup SolutionLibrary
+     *
+     * Defers to a library of benchmarked sizes when the problem is close to
+     * one of them. Further away, nearest-neighbour picks are often far from
+     * the best kernel, so every solution whose predicates accept the problem
+     * is instead ranked by a roofline model of its tile, GSU and the target
+     * GPU. The model takes the bandwidth and clock from the GPU and the
+     * matrix core throughput from the library file, which can also set the
+     * former.
+     */
+    template <typename MyProblem, typename MySolution = typename MyProblem::Solution>
+    struct ModelRankingLibrary : public SolutionLibrary<MyProblem, MySolution>
+    {
+        using Element     = std::shared_ptr<SolutionLibrary<MyProblem, MySolution>>;
+        using Calibration = typename MySolution::RooflineCalibration;
+        //! log2 of M, N, batch and K
+        using GridPoint = std::array<double, 4>;
+
+        Element                                    library;
+        std::map<int, std::shared_ptr<MySolution>> solutions;
+        std::vector<GridPoint>                     grid;
+        //! Distance from the grid, in powers of two, up to which library is used.
+        double      maxGridDistance = 1.0;
+        Calibration calibration;
+
+        static std::string Type()
+        {
+            return "ModelRanking";
+        }
+        virtual std::string type() const override
+        {
+            return Type();
+        }
+        virtual std::string description() const override
+        {
+            return concatenate(type(),
+                               ": ",
+                               solutions.size(),
+                               " solution(s), ",
+                               grid.size(),
+                               " grid point(s), max distance ",
+                               maxGridDistance);
+        }
+
+        static GridPoint gridPoint(double M, double N, double NumBatches, double K)
+        {
+            return {std::log2(std::max(M, 1.0)),
+                    std::log2(std::max(N, 1.0)),
+                    std::log2(std::max(NumBatches, 1.0)),
+                    std::log2(std::max(K, 1.0))};
+        }
+
+        double gridDistance(MyProblem const& problem) const
+        {
+            GridPoint point = gridPoint(problem.freeSizeA(0),
+                                        problem.freeSizeB(0),
+                                        problem.batchSize(0),
+                                        problem.boundSize(0));
+
+            double bestDistance = std::numeric_limits<double>::max();
+            for(auto const& tuned : grid)
+            {
+                double distance = 0.0;
+                for(size_t i = 0; i < point.size(); i++)
+                    distance += (point[i] - tuned[i]) * (point[i] - tuned[i]);
+                bestDistance = std::min(bestDistance, distance);
+            }
+
+            return std::sqrt(bestDistance);
+        }
+
+        /**
+         * Whether problem is far enough from the grid to be ranked by the
+         * model. distance is set to its distance from the grid.
+         */
+        bool useModel(MyProblem const& problem, double& distance) const
+        {
+            distance = gridDistance(problem);
+            if(Debug::Instance().printPropertyEvaluation())
+                std::cout << "Distance from the tuned grid: " << distance << std::endl;
+
+            return library == nullptr || distance > maxGridDistance;
+        }
+
+        /**
+         * Returns up to numSolutions solutions, fastest projected first.
+         * speed(solution, calibration) returns the projected GFlops of a
+         * solution, or a negative value if it cannot run the problem. Nothing
+         * is returned if the calibration is incomplete on hardware.
+         */
+        template <typename Speed>
+        SolutionVector<MySolution>
+            rankBySpeed(Hardware const& hardware, int numSolutions, Speed&& speed) const
+        {
+            const bool debug = Debug::Instance().printPropertyEvaluation();
+
+            Calibration resolved = calibration.resolve(hardware);
+            if(!resolved.complete())
+            {
+                if(debug)
+                    std::cout << "The roofline model is not calibrated for this hardware."
+                              << std::endl;
+                return SolutionVector<MySolution>();
+            }
+
+            std::vector<std::pair<double, std::shared_ptr<MySolution>>> ranked;
+            ranked.reserve(solutions.size());
+
+            for(auto const& row : solutions)
+            {
+                if(!(*row.second->hardwarePredicate)(hardware))
+                    continue;
+
+                double gflops = speed(*row.second, resolved);
+                if(gflops < 0.0)
+                    continue;
+
+                if(debug)
+                    std::cout << row.second->description() << ": " << gflops << std::endl;
+
+                ranked.emplace_back(gflops, row.second);
+            }
+
+            size_t count = std::min<size_t>(std::max(numSolutions, 0), ranked.size());
+            std::partial_sort(ranked.begin(),
+                              ranked.begin() + count,
+                              ranked.end(),
+                              [](auto const& a, auto const& b) {
+                                  return a.first > b.first
+                                         || (a.first == b.first
+                                             && a.second->index < b.second->index);
+                              });
+
+            SolutionVector<MySolution> rv;
+            rv.reserve(count);
+            for(size_t i = 0; i < count; i++)
+                rv.push_back(ranked[i].second);
+
+            return rv;
+        }
+
+        SolutionVector<MySolution> rankSolutions(MyProblem const& problem,
+                                                 Hardware const&  hardware,
+                                                 int              numSolutions) const
+        {
+            return rankBySpeed(
+                hardware, numSolutions, [&](MySolution const& solution, Calibration const& c) {
+                    if(!(*solution.problemPredicate)(problem)
+                       || !solution.fitsSelectionLimits(problem))
+                        return -1.0;
+                    return solution.rooflinePerformance(problem, hardware, c).speedGFlops;
+                });
+        }
+
+        /**
+         * Ranks the solutions that can run every problem of a grouped GEMM by
+         * the total time of the problems, each projected as if run alone.
+         */
+        SolutionVector<MySolution> rankSolutions(std::vector<MyProblem> const& problems,
+                                                 Hardware const&               hardware,
+                                                 int                           numSolutions) const
+        {
+            return rankBySpeed(
+                hardware, numSolutions, [&](MySolution const& solution, Calibration const& c) {
+                    size_t ws = solution.requiredWorkspaceSizeGroupedGemm(problems);
+
+                    double flops = 0.0, seconds = 0.0;
+                    for(auto problem : problems)
+                    {
+                        problem.setWorkspaceSizeGroupedGemm(ws);
+                        if(!(*solution.problemPredicate)(problem)
+                           || !solution.fitsSelectionLimits(problem))
+                            return -1.0;
+
+                        double gflops
+                            = solution.rooflinePerformance(problem, hardware, c).speedGFlops;
+                        if(gflops > 0.0)
+                        {
+                            flops += problem.flopCount();
+                            seconds += problem.flopCount() / (gflops * 1.0e9);
+                        }
+                    }
+
+                    return seconds > 0.0 ? flops / seconds * 1.0e-9 : 0.0;
+                });
+        }
+
+        virtual std::shared_ptr<MySolution> getSolutionByIndex(MyProblem const& problem,
+                                                               Hardware const&  hardware,
+                                                               const int index) const override
+        {
+            auto iter = solutions.find(index);
+            if(iter != solutions.end())
+                return iter->second;
+
+            if(library != nullptr)
+                return library->getSolutionByIndex(problem, hardware, index);
+
+            return std::shared_ptr<MySolution>();
+        }
+
+        /**
+         * On the model path, fitness is set to the distance of the problem
+         * from the tuned grid, in powers of two, rather than to the distance
+         * the matching library would report.
+         */
+        virtual std::shared_ptr<MySolution> findBestSolution(MyProblem const& problem,
+                                                             Hardware const&  hardware,
+                                                             double*          fitness
+                                                             = nullptr) const override
+        {
+            double distance;
+            if(useModel(problem, distance))
+            {
+                auto ranked = rankSolutions(problem, hardware, 1);
+                if(!ranked.empty())
+                {
+                    if(fitness)
+                        *fitness = distance;
+                    return ranked.front();
+                }
+            }
+
+            if(library != nullptr)
+                return library->findBestSolution(problem, hardware, fitness);
+
+            return std::shared_ptr<MySolution>();
+        }
+
+        /**
+         * Grouped GEMMs are matched on their first problem, as by the
+         * matching library.
+         */
+        virtual std::shared_ptr<MySolution> findBestSolution(std::vector<MyProblem> const& problems,
+                                                             Hardware const&               hardware,
+                                                             double*                       fitness
+                                                             = nullptr) const override
+        {
+            double distance;
+            if(!problems.empty() && useModel(problems[0], distance))
+            {
+                auto ranked = rankSolutions(problems, hardware, 1);
+                if(!ranked.empty())
+                {
+                    if(fitness)
+                        *fitness = distance;
+                    return ranked.front();
+                }
+            }
+
+            if(library != nullptr)
+                return library->findBestSolution(problems, hardware, fitness);
+
+            return std::shared_ptr<MySolution>();
+        }
+
+        virtual SolutionSet<MySolution>
+            findAllSolutions(MyProblem const&          problem,
+                             Hardware const&           hardware,
+                             SolutionLibrarySearchType searchType
+                             = SolutionLibrarySearchType::DEFAULT) const override
+        {
+            SolutionSet<MySolution> rv;
+            if(library != nullptr)
+                rv = library->findAllSolutions(problem, hardware, searchType);
+
+            for(auto const& row : solutions)
+            {
+                if(softwarePredicate(searchType, *(row.second), problem)
+                   && (*row.second->hardwarePredicate)(hardware))
+                    rv.insert(row.second);
+            }
+
+            return rv;
+        }
+
+        virtual SolutionSet<MySolution>
+            findAllSolutionsGroupedGemm(std::vector<MyProblem> const& problems,
+                                        Hardware const&               hardware,
+                                        SolutionLibrarySearchType     searchType
+                                        = SolutionLibrarySearchType::DEFAULT) const override
+        {
+            if(library != nullptr)
+                return library->findAllSolutionsGroupedGemm(problems, hardware, searchType);
+
+            return SolutionSet<MySolution>();
+        }
+
+        virtual SolutionVector<MySolution> findTopSolutions(MyProblem const& problem,
+                                                            Hardware const&  hardware,
+                                                            int numSolutions) const override
+        {
+            double distance;
+            if(useModel(problem, distance))
+            {
+                auto ranked = rankSolutions(problem, hardware, numSolutions);
+                if(!ranked.empty())
+                    return ranked;
+            }
+
+            if(library != nullptr)
+                return library->findTopSolutions(problem, hardware, numSolutions);
+
+            return SolutionVector<MySolution>();
+        }
+
+        virtual SolutionVector<MySolution>
+            findTopSolutionsGroupedGemm(std::vector<MyProblem> const& problems,
+                                        Hardware const&               hardware,
+                                        int                           numSolutions) const override
+        {
+            double distance;
+            if(!problems.empty() && useModel(problems[0], distance))
+            {
+                auto ranked = rankSolutions(problems, hardware, numSolutions);
+                if(!ranked.empty())
+                    return ranked;
+            }
+
+            if(library != nullptr)
+                return library->findTopSolutionsGroupedGemm(problems, hardware, numSolutions);
+
+            return SolutionVector<MySolution>();
+        }
+
+        virtual void
+            getLazyLoadedLibraries(std::vector<LazyLoadedLibrary const*>& libraries) const override
+        {
+            if(library != nullptr)
+                library->getLazyLoadedLibraries(libraries);
+        }
+    };
+} // namespace Tensile
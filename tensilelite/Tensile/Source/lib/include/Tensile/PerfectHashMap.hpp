@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Tensile
+{
+    /**
+     * Map from a fixed set of 64-bit keys, built once. The multiplier of the
+     * hash is searched for when the map is built so that no two keys share a
+     * slot, so a lookup is a multiplication, a shift and one key comparison.
+     */
+    template <typename Value>
+    class PerfectHashMap
+    {
+    public:
+        //! The keys of entries must be distinct.
+        void build(std::vector<std::pair<uint64_t, Value>> entries)
+        {
+            m_keys.clear();
+            m_slots.clear();
+            m_values.clear();
+            if(entries.empty())
+                return;
+
+            // Keys that are the same collide for every multiplier.
+            std::vector<uint64_t> keys;
+            keys.reserve(entries.size());
+            for(auto const& entry : entries)
+                keys.push_back(entry.first);
+            std::sort(keys.begin(), keys.end());
+            if(std::adjacent_find(keys.begin(), keys.end()) != keys.end())
+                throw std::invalid_argument("PerfectHashMap: duplicate keys.");
+
+            // At most half full, so a collision free multiplier is found after
+            // a few tries. If not, the table grows.
+            m_bits = 1;
+            while((size_t(1) << m_bits) < 2 * entries.size())
+                m_bits++;
+
+            uint64_t seed = 0;
+            while(true)
+            {
+                for(int attempt = 0; attempt < 32; attempt++)
+                {
+                    m_multiplier = mix(seed++) | 1;
+                    if(tryBuild(entries))
+                    {
+                        m_values.reserve(entries.size());
+                        for(auto& entry : entries)
+                            m_values.push_back(std::move(entry.second));
+                        return;
+                    }
+                }
+                m_bits++;
+            }
+        }
+
+        //! Returns nullptr if key is not in the map.
+        Value const* find(uint64_t key) const
+        {
+            if(m_slots.empty())
+                return nullptr;
+
+            size_t slot = slotOf(key);
+            if(m_slots[slot] < 0 || m_keys[slot] != key)
+                return nullptr;
+
+            return &m_values[m_slots[slot]];
+        }
+
+        size_t size() const
+        {
+            return m_values.size();
+        }
+
+        bool empty() const
+        {
+            return m_values.empty();
+        }
+
+    private:
+        size_t slotOf(uint64_t key) const
+        {
+            return (key * m_multiplier) >> (64 - m_bits);
+        }
+
+        bool tryBuild(std::vector<std::pair<uint64_t, Value>> const& entries)
+        {
+            m_keys.assign(size_t(1) << m_bits, 0);
+            m_slots.assign(size_t(1) << m_bits, -1);
+
+            for(size_t i = 0; i < entries.size(); i++)
+            {
+                size_t slot = slotOf(entries[i].first);
+                if(m_slots[slot] >= 0)
+                    return false;
+
+                m_keys[slot]  = entries[i].first;
+                m_slots[slot] = static_cast<int32_t>(i);
+            }
+
+            return true;
+        }
+
+        //! splitmix64, for well spread multipliers.
+        static uint64_t mix(uint64_t x)
+        {
+            x += 0x9e3779b97f4a7c15ull;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+            return x ^ (x >> 31);
+        }
+
+        uint64_t              m_multiplier = 1;
+        int                   m_bits       = 1;
+        std::vector<uint64_t> m_keys;
+        std::vector<int32_t>  m_slots;
+        std::vector<Value>    m_values;
+    };
+} // namespace Tensile
@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Tensile/Macros.hpp>
+
+namespace Tensile
+{
+    /**
+     * On-disk cache of heuristic results, so that the solution search for a
+     * problem only has to be done once across process runs.
+     *
+     * Maps a 64-bit problem key (see CachingLibrary) to the ordered list of
+     * solution indices that findTopSolutions returned for it. The file is
+     * stamped with a key derived from the library version and the names, sizes
+     * and modification times of the library file and of its lazily loaded
+     * sub-library files; a file written against a different library is
+     * ignored and replaced on the next flush(), as is a truncated or corrupt
+     * file.
+     *
+     * Lookups are served from the records read at construction plus the
+     * entries added since. New entries are written back by flush(), which the
+     * destructor calls. The file is replaced atomically, so concurrent
+     * processes sharing a cache file only ever lose each other's updates.
+     */
+    class TENSILE_API PersistentSolutionCache
+    {
+    public:
+        /**
+         * @param cacheFile    Path of the cache file. Need not exist.
+         * @param libraryFile  Path of the library the cached indices refer to.
+         * @param version      Version string of that library.
+         */
+        PersistentSolutionCache(std::string const& cacheFile,
+                                std::string const& libraryFile,
+                                std::string const& version);
+        ~PersistentSolutionCache();
+
+        PersistentSolutionCache(PersistentSolutionCache const&)            = delete;
+        PersistentSolutionCache& operator=(PersistentSolutionCache const&) = delete;
+
+        /**
+         * Looks up the solution indices stored for \p key.
+         *
+         * @return false if there is no entry.
+         */
+        bool find(uint64_t key, std::vector<int>& indices) const;
+
+        void add(uint64_t key, std::vector<int> const& indices);
+
+        /**
+         * Writes the cache to disk if entries were added since it was read or
+         * last flushed.
+         *
+         * @return false if the file could not be written.
+         */
+        bool flush();
+
+        //! Number of entries, including those not yet flushed.
+        size_t size() const;
+
+        std::string const& filename() const
+        {
+            return m_cacheFile;
+        }
+
+        uint64_t libraryKey() const
+        {
+            return m_libraryKey;
+        }
+
+        static uint64_t LibraryKey(std::string const& libraryFile, std::string const& version);
+
+    private:
+        struct Record
+        {
+            uint64_t key;
+            uint32_t offset;
+            uint32_t count;
+        };
+
+        void read();
+
+        Record const* findRecord(uint64_t key) const;
+
+        std::string m_cacheFile;
+        uint64_t    m_libraryKey;
+
+        mutable std::shared_timed_mutex m_mutex;
+
+        // Sorted by key; offsets index into m_indices.
+        std::vector<Record>                            m_records;
+        std::vector<int32_t>                           m_indices;
+        std::unordered_map<uint64_t, std::vector<int>> m_pending;
+    };
+} // namespace Tensile
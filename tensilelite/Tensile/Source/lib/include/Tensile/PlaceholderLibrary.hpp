@@ -31,6 +31,7 @@
 #include <Tensile/Tensile.hpp>
 
 #include <algorithm>
+#include <atomic>
 
 namespace Tensile
 {
@@ -54,40 +55,81 @@ namespace Tensile
     }
 
     template <typename MyProblem, typename MySolution = typename MyProblem::Solution>
-    struct PlaceholderLibrary : public SolutionLibrary<MyProblem, MySolution>
+    struct PlaceholderLibrary : public SolutionLibrary<MyProblem, MySolution>,
+                                public LazyLoadedLibrary
     {
         mutable std::shared_ptr<SolutionLibrary<MyProblem, MySolution>> library;
+        mutable SolutionMap<MySolution>                                 solutions;
+        mutable SolutionTable<MySolution>                               solutionTable;
         mutable SolutionMap<MySolution>*                                masterSolutions;
         mutable std::mutex*                                             solutionsGuard;
+        mutable LazySolutionTable<MySolution>*                          masterLazySolutions;
         mutable std::mutex                                              lazyLoadingGuard;
-        std::string                                                     filePrefix;
-        std::string                                                     suffix;
-        std::string                                                     libraryDirectory;
+        // Set once library and solutions are filled in; they are not modified after.
+        mutable std::atomic<bool> loaded{false};
+        std::string               filePrefix;
+        std::string               suffix;
+        std::string               libraryDirectory;
 
         PlaceholderLibrary() = default;
 
+        /**
+         * Loads the sub-library on first use. Once it is loaded this does not
+         * lock, so lookups in loaded sub-libraries are never held up by
+         * another sub-library being loaded.
+         *
+         * @return false if the sub-library could not be loaded.
+         */
         bool loadPlaceholderLibrary() const
         {
+            if(loaded.load(std::memory_order_acquire))
+                return true;
+
             std::lock_guard<std::mutex> lock(lazyLoadingGuard);
             // If condition in case two threads got into this function
-            if(!library)
+            if(!loaded.load(std::memory_order_relaxed))
             {
                 auto newLibrary = LoadLibraryFile<MyProblem, MySolution>(
                     (libraryDirectory + "/" + filePrefix + suffix).c_str());
                 auto mLibrary
                     = static_cast<MasterSolutionLibrary<MyProblem, MySolution>*>(newLibrary.get());
-                library = mLibrary->library;
-                std::lock_guard<std::mutex> lock(*solutionsGuard);
-                masterSolutions->insert(mLibrary->solutions.begin(), mLibrary->solutions.end());
-
-                return mLibrary;
+                if(!mLibrary)
+                    return false;
+
+                solutions     = mLibrary->solutions;
+                solutionTable = mLibrary->solutionTable;
+                library       = mLibrary->library;
+                {
+                    std::lock_guard<std::mutex> lock(*solutionsGuard);
+                    for(auto const& entry : mLibrary->solutions)
+                    {
+                        auto inserted = masterSolutions->insert(entry);
+                        masterLazySolutions->publish(entry.first, inserted.first->second);
+                    }
+                }
+
+                loaded.store(true, std::memory_order_release);
             }
 
-            return false;
+            return true;
         }
 
-        std::string getCodeObjectFileName(Hardware const&   hardware,
-                                          MySolution const& solution) const
+        virtual std::string const& name() const override
+        {
+            return filePrefix;
+        }
+
+        virtual bool isLoaded() const override
+        {
+            return loaded.load(std::memory_order_acquire);
+        }
+
+        virtual bool load() const override
+        {
+            return loadPlaceholderLibrary();
+        }
+
+        virtual std::string codeObjectFile() const override
         {
             std::string coFileDependency = filePrefix;
             coFileDependency += std::string(".co");
@@ -95,17 +137,32 @@ namespace Tensile
             return coFileDependency;
         }
 
+        virtual void
+            getLazyLoadedLibraries(std::vector<LazyLoadedLibrary const*>& libraries) const override
+        {
+            libraries.push_back(this);
+        }
+
+        std::string getCodeObjectFileName(Hardware const&   hardware,
+                                          MySolution const& solution) const
+        {
+            return codeObjectFile();
+        }
+
         virtual std::shared_ptr<MySolution> getSolutionByIndex(MyProblem const& problem,
                                                                Hardware const&  hardware,
                                                                const int index) const override
         {
-            if(!library)
-                loadPlaceholderLibrary();
+            if(!loadPlaceholderLibrary())
+                return std::shared_ptr<MySolution>();
 
-            auto solution = library->getSolutionByIndex(problem, hardware, index);
+            // Every solution of the sub-library is in its solution table, so
+            // there is no need to search the sub-library for the index.
+            auto solution = solutionTable.find(index);
+            if(!solution)
+                return solution;
 
-            if(solution)
-                solution->codeObjectFilename = getCodeObjectFileName(hardware, *solution);
+            solution->codeObjectFilename = getCodeObjectFileName(hardware, *solution);
 
             return solution;
         }
@@ -115,8 +172,8 @@ namespace Tensile
                                                              double*          fitness
                                                              = nullptr) const override
         {
-            if(!library)
-                loadPlaceholderLibrary();
+            if(!loadPlaceholderLibrary())
+                return std::shared_ptr<MySolution>();
 
             auto solution = library->findBestSolution(problem, hardware, fitness);
 
@@ -138,10 +195,8 @@ namespace Tensile
                              SolutionLibrarySearchType searchType
                              = SolutionLibrarySearchType::DEFAULT) const override
         {
-            if(!library)
-            {
-                loadPlaceholderLibrary();
-            }
+            if(!loadPlaceholderLibrary())
+                return SolutionSet<MySolution>();
 
             auto solutions = library->findAllSolutions(problem, hardware, searchType);
 
@@ -159,12 +214,46 @@ namespace Tensile
                                         SolutionLibrarySearchType     searchType
                                         = SolutionLibrarySearchType::DEFAULT) const override
         {
-            if(!library)
+            if(!loadPlaceholderLibrary())
+                return SolutionSet<MySolution>();
+
+            auto solutions = library->findAllSolutionsGroupedGemm(problems, hardware, searchType);
+
+            for(auto& solution : solutions)
             {
-                loadPlaceholderLibrary();
+                solution->codeObjectFilename = getCodeObjectFileName(hardware, *solution);
             }
 
-            auto solutions = library->findAllSolutionsGroupedGemm(problems, hardware, searchType);
+            return solutions;
+        }
+
+        virtual SolutionVector<MySolution> findTopSolutions(MyProblem const& problem,
+                                                            Hardware const&  hardware,
+                                                            int numSolutions) const override
+        {
+            if(!loadPlaceholderLibrary())
+                return SolutionVector<MySolution>();
+
+            auto solutions = library->findTopSolutions(problem, hardware, numSolutions);
+
+            for(auto& solution : solutions)
+            {
+                solution->codeObjectFilename = getCodeObjectFileName(hardware, *solution);
+            }
+
+            return solutions;
+        }
+
+        virtual SolutionVector<MySolution>
+            findTopSolutionsGroupedGemm(std::vector<MyProblem> const& problems,
+                                        Hardware const&               hardware,
+                                        int                           numSolutions) const override
+        {
+            if(!loadPlaceholderLibrary())
+                return SolutionVector<MySolution>();
+
+            auto solutions
+                = library->findTopSolutionsGroupedGemm(problems, hardware, numSolutions);
 
             for(auto& solution : solutions)
             {
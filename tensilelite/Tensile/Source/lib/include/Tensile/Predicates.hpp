@@ -27,6 +27,8 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -328,6 +330,171 @@ namespace Tensile
             }
         };
 
+        /**
+ * @brief Checks that a Compiled predicate does on its own instead of
+ * evaluating the terms they were taken from.
+ *
+ * Specialized for object types that have cheap ways of checking several
+ * terms at once, e.g. a bitmask of problem type flags. The generic version
+ * takes no terms.
+ */
+        template <typename Object>
+        struct CompiledChecks
+        {
+            /**
+   * Takes over the check done by a term, returning false if it can't.
+   */
+            bool absorb(Predicate<Object> const&)
+            {
+                return false;
+            }
+
+            bool operator()(Object const&) const
+            {
+                return true;
+            }
+
+            /**
+   * Sets key to a value that every object passing these checks has under
+   * signature, returning false if the checks can't be expressed that way.
+   * Predicates with the same signature can be looked up by key instead of
+   * being evaluated one by one.
+   */
+            bool dispatchKey(uint64_t& signature, uint64_t& key) const
+            {
+                return false;
+            }
+
+            //! The key of obj under a signature set by dispatchKey().
+            static uint64_t DispatchKey(Object const& obj, uint64_t signature)
+            {
+                return 0;
+            }
+        };
+
+        /**
+ * @brief A predicate tree flattened for fast evaluation.
+ *
+ * Nested `And` terms are flattened into one list, `TruePred` terms are
+ * dropped, and the terms that CompiledChecks can take over are removed from
+ * the list. The remaining terms are evaluated in order without going through
+ * the tree. Printing and debug evaluation use the original tree.
+ */
+        template <typename Object>
+        class Compiled : public Predicate<Object>
+        {
+        public:
+            explicit Compiled(std::shared_ptr<Predicate<Object>> source)
+                : m_source(std::move(source))
+            {
+                flatten(*m_source);
+            }
+
+            virtual std::string type() const override
+            {
+                return m_source->type();
+            }
+
+            virtual std::string toString() const override
+            {
+                return m_source->toString();
+            }
+
+            virtual bool operator()(Object const& obj) const override
+            {
+                if(m_false || !m_checks(obj))
+                    return false;
+
+                for(auto const* term : m_terms)
+                {
+                    if(!(*term)(obj))
+                        return false;
+                }
+
+                return true;
+            }
+
+            virtual bool debugEval(Object const& obj, std::ostream& stream) const override
+            {
+                return m_source->debugEval(obj, stream);
+            }
+
+            std::shared_ptr<Predicate<Object>> const& source() const
+            {
+                return m_source;
+            }
+
+            //! Number of terms that are still evaluated one by one.
+            size_t termCount() const
+            {
+                return m_terms.size();
+            }
+
+            //! See CompiledChecks::dispatchKey().
+            bool dispatchKey(uint64_t& signature, uint64_t& key) const
+            {
+                return !m_false && m_checks.dispatchKey(signature, key);
+            }
+
+        private:
+            void flatten(Predicate<Object> const& pred)
+            {
+                if(auto const* conjunction = dynamic_cast<And<Object> const*>(&pred))
+                {
+                    for(auto const& term : conjunction->value)
+                        flatten(*term);
+                }
+                else if(dynamic_cast<True<Object> const*>(&pred))
+                {
+                }
+                else if(dynamic_cast<False<Object> const*>(&pred))
+                {
+                    m_false = true;
+                }
+                else if(!m_checks.absorb(pred))
+                {
+                    m_terms.push_back(&pred);
+                }
+            }
+
+            std::shared_ptr<Predicate<Object>>    m_source; //< Owns the terms
+            CompiledChecks<Object>                m_checks;
+            std::vector<Predicate<Object> const*> m_terms;
+            bool                                  m_false = false;
+        };
+
+        /**
+ * Returns pred compiled into a Compiled predicate, or pred itself if
+ * compiling would not make it any cheaper to evaluate.
+ */
+        template <typename Object>
+        std::shared_ptr<Predicate<Object>> Compile(std::shared_ptr<Predicate<Object>> const& pred)
+        {
+            if(!pred || std::dynamic_pointer_cast<Compiled<Object>>(pred))
+                return pred;
+
+            auto compiled = std::make_shared<Compiled<Object>>(pred);
+
+            if(!std::dynamic_pointer_cast<And<Object>>(pred) && compiled->termCount() == 1)
+                return pred;
+
+            return compiled;
+        }
+
+        /**
+ * Returns the predicate that pred was compiled from, or pred itself if it
+ * was not compiled.
+ */
+        template <typename Object>
+        std::shared_ptr<Predicate<Object>>
+            Uncompiled(std::shared_ptr<Predicate<Object>> const& pred)
+        {
+            if(auto compiled = std::dynamic_pointer_cast<Compiled<Object>>(pred))
+                return compiled->source();
+
+            return pred;
+        }
+
         /**
  * @}
  */
@@ -31,12 +31,14 @@
 #include <iomanip>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include <Tensile/Debug.hpp>
 #include <Tensile/Distance.hpp>
 #include <Tensile/ProblemKey.hpp>
 #include <Tensile/Properties.hpp>
+#include <Tensile/SpatialIndex.hpp>
 #include <Tensile/Utils.hpp>
 
 namespace Tensile
@@ -62,7 +64,7 @@ namespace Tensile
         {
             Key    key;
             Value  value;
-            double speed;
+            double speed = 0.0;
         };
 
         template <typename Object, typename Value, typename ReturnValue>
@@ -222,12 +224,12 @@ namespace Tensile
                         {
                             model_K = iter->key[2];
                         }
-                        double nextDistance = theMatch->computeTAMScore(object,
-                                                                        hardware,
-                                                                        (double)model_M,
-                                                                        (double)model_N,
-                                                                        (double)model_K,
-                                                                        (double)model_NumBatches);
+                        double nextDistance = nextMatch->computeTAMScore(object,
+                                                                         hardware,
+                                                                         (double)model_M,
+                                                                         (double)model_N,
+                                                                         (double)model_K,
+                                                                         (double)model_NumBatches);
 
                         if(nextDistance < bestDistance)
                         {
@@ -242,6 +244,12 @@ namespace Tensile
                 return bestMatch;
             }
 
+            /**
+             * Called once the table has been loaded and sorted, for tables
+             * that search through an index built over it.
+             */
+            void buildIndex() {}
+
             virtual std::vector<Value> matchesInOrder(Object const& object) const override
             {
                 return keyMatchesInOrder(
@@ -764,7 +772,6 @@ namespace Tensile
 
                 ptrdiff_t count = 0;
                 bool      Debug = T_Debug;
-                std::cout << std::setprecision(2) << std::fixed;
 
                 auto compM = [&count, Debug](Entry const& e, long const M) {
                     if(Debug)
@@ -1011,5 +1018,218 @@ namespace Tensile
                 return bestmatches;
             }
         };
+
+        /**
+         * Specialization of DistanceMatchingTable for GridInterpolated Distance. The nearest
+         * tuned sizes are found through a k-d tree over the log2 of the keys, and the solution
+         * is picked by interpolating between them rather than taken from the closest one.
+         */
+        template <typename Key, typename Object, typename Value, typename ReturnValue>
+        struct DistanceMatchingTable<Key,
+                                     Object,
+                                     Value,
+                                     ReturnValue,
+                                     Matching::GridInterpolatedDistance<Key>>
+            : public DistanceMatchingCommon<Key,
+                                            Object,
+                                            Value,
+                                            ReturnValue,
+                                            Matching::GridInterpolatedDistance<Key>>
+        {
+            using Base                     = MatchingTable<Object, Value, ReturnValue>;
+            using Entry                    = MatchingTableEntry<Key, Value>;
+            using Transform                = typename Base::Transform;
+            using Properties               = typename Base::Properties;
+            using GridInterpolatedDistance = Matching::GridInterpolatedDistance<Key>;
+            using Common                   = DistanceMatchingCommon<Key,
+                                                  Object,
+                                                  Value,
+                                                  ReturnValue,
+                                                  Matching::GridInterpolatedDistance<Key>>;
+            using Common::distance;
+            using Common::nullValue;
+            using Common::table;
+
+            //! Number of tuned sizes interpolated between.
+            size_t neighbors = 8;
+
+            DistanceMatchingTable(ReturnValue nullValue = ReturnValue())
+                : Common(nullValue)
+            {
+            }
+
+            DistanceMatchingTable(Properties const& properties,
+                                  ReturnValue       nullValue = ReturnValue())
+                : Common(properties, nullValue)
+            {
+            }
+
+            DistanceMatchingTable(GridInterpolatedDistance const& distance,
+                                  Properties const&               properties,
+                                  ReturnValue                     nullValue = ReturnValue())
+                : Common(distance, properties, nullValue)
+            {
+            }
+
+            void buildIndex()
+            {
+                size_t dims = table.empty() ? 1 : table.front().key.size();
+
+                std::vector<double> points;
+                points.reserve(table.size() * dims);
+                for(auto const& entry : table)
+                {
+                    for(size_t i = 0; i < dims; i++)
+                        points.push_back(GridInterpolatedDistance::coordinate(entry.key[i]));
+                }
+
+                index.build(std::move(points), dims);
+            }
+
+            std::tuple<ReturnValue, double> findBestKeyMatch(Key const& key,
+                                                             Transform  transform) const
+            {
+                double                   fitness   = std::numeric_limits<double>::max();
+                std::vector<ReturnValue> solutions = rankKeyMatches(key, transform, 1, &fitness);
+                ReturnValue              solution  = this->nullValue;
+                if(solutions.size() > 0)
+                    solution = solutions[0];
+                return std::make_tuple(solution, fitness);
+            }
+
+            std::vector<ReturnValue>
+                findTopKeyMatch(Key const& key, Transform transform, int numSolutions) const
+            {
+                return rankKeyMatches(key, transform, numSolutions, nullptr);
+            }
+
+            /**
+             * Scores each solution among the nearest tuned sizes by the sum of the
+             * inverse distances of the sizes it was tuned for, times its speed at
+             * those sizes interpolated in log space. If fewer than numSolutions
+             * solutions accept the problem, the search widens and the solutions
+             * found further out are ranked after the others, so that the first
+             * result does not depend on numSolutions. fitness is set to distance()
+             * from the nearest tuned size.
+             */
+            std::vector<ReturnValue> rankKeyMatches(Key const& key,
+                                                    Transform  transform,
+                                                    int        numSolutions,
+                                                    double*    fitness) const
+            {
+                const bool debug = Debug::Instance().printPropertyEvaluation();
+
+                std::vector<ReturnValue> rv;
+                if(table.empty() || index.size() != table.size() || numSolutions <= 0)
+                    return rv;
+                const size_t count = numSolutions;
+
+                std::vector<double> point(index.dimensions());
+                for(size_t i = 0; i < point.size(); i++)
+                    point[i] = GridInterpolatedDistance::coordinate(key[i]);
+
+                struct Candidate
+                {
+                    ReturnValue solution;
+                    bool        nearby      = true; //! Among the first neighbors sizes
+                    double      weight      = 0.0; //! Summed over all its sizes
+                    double      speedWeight = 0.0; //! Summed over sizes with a speed
+                    double      logSpeed    = 0.0; //! Weighted sum of log2(speed)
+                    double      score       = 0.0;
+                };
+
+                std::vector<KdTree::Neighbor>           nearest;
+                std::vector<Candidate>                  candidates;
+                std::unordered_map<ReturnValue, size_t> positions;
+                size_t                                  visited = 0;
+
+                size_t k = std::max<size_t>(neighbors, count);
+                while(true)
+                {
+                    visited += index.nearest(point.data(), k, nearest);
+                    candidates.clear();
+                    positions.clear();
+
+                    for(size_t i = 0; i < nearest.size(); i++)
+                    {
+                        auto const& neighbor = nearest[i];
+                        auto const& entry    = table[neighbor.second];
+                        auto        solution = transform(entry.value);
+
+                        if(debug)
+                        {
+                            streamJoin(std::cout, entry.key, ", ");
+                            std::cout << ": " << neighbor.first << ", speed " << entry.speed
+                                      << (solution ? "" : " (no match)") << std::endl;
+                        }
+
+                        if(!solution)
+                            continue;
+
+                        auto inserted = positions.emplace(solution, candidates.size());
+                        if(inserted.second)
+                            candidates.push_back(Candidate{solution, i < neighbors});
+
+                        auto iter = candidates.begin() + inserted.first->second;
+                        if(!inserted.second && iter->nearby && i >= neighbors)
+                            continue;
+
+                        // An exact hit outweighs everything else.
+                        double weight = 1.0 / (std::sqrt(neighbor.first) + 1.0 / 1024);
+                        iter->weight += weight;
+                        if(entry.speed > 0.0)
+                        {
+                            iter->speedWeight += weight;
+                            iter->logSpeed += weight * std::log2(entry.speed);
+                        }
+                    }
+
+                    if(candidates.size() >= count || k >= table.size())
+                        break;
+
+                    k = std::min(k * 2, table.size());
+                }
+
+                for(auto& candidate : candidates)
+                {
+                    candidate.score = candidate.weight;
+                    if(candidate.speedWeight > 0.0)
+                        candidate.score
+                            *= std::exp2(candidate.logSpeed / candidate.speedWeight);
+                }
+
+                std::stable_sort(candidates.begin(),
+                                 candidates.end(),
+                                 [](Candidate const& a, Candidate const& b) {
+                                     return a.nearby != b.nearby ? a.nearby : a.score > b.score;
+                                 });
+
+                for(auto const& candidate : candidates)
+                {
+                    if(rv.size() == count)
+                        break;
+                    rv.push_back(candidate.solution);
+                }
+
+                if(fitness && !nearest.empty())
+                    *fitness = nearest.front().first;
+
+                if(debug || Debug::Instance().printLookupEfficiency())
+                {
+                    double considered = visited;
+                    considered /= table.size();
+                    considered *= 100;
+                    std::cout << "Considered " << visited << "(" << considered << "%) of entries."
+                              << std::endl;
+                }
+
+                if(debug && !rv.empty())
+                    std::cout << "Solution index selected: " << rv[0]->index << std::endl;
+
+                return rv;
+            }
+
+            KdTree index;
+        };
     } // namespace Matching
 } // namespace Tensile
@@ -38,6 +38,7 @@
 #include <Tensile/Serialization/HasTraits.hpp>
 #include <Tensile/Serialization/MLFeatures.hpp>
 #include <Tensile/Serialization/MapLibrary.hpp>
+#include <Tensile/Serialization/ModelRankingLibrary.hpp>
 #include <Tensile/Serialization/Predicates.hpp>
 #include <Tensile/Serialization/Properties.hpp>
 #include <Tensile/Serialization/SolutionLibrary.hpp>
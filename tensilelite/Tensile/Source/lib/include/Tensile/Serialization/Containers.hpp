@@ -190,6 +190,8 @@ namespace Tensile
 
         TENSILE_SERIALIZE_VECTOR(false, std::shared_ptr<Tensile::ContractionSolution>);
 
+        TENSILE_SERIALIZE_VECTOR(true, std::array<size_t, 4>);
+
         template <typename Key, typename Value, typename IO>
         struct SequenceTraits<std::vector<Tensile::Matching::MatchingTableEntry<Key, Value>>, IO>
             : public DefaultSequenceTraits<
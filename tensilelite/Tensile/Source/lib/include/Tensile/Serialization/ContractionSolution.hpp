@@ -28,7 +28,9 @@
 
 #include <functional>
 
+#include <Tensile/ContractionProblemPredicates.hpp>
 #include <Tensile/ContractionSolution.hpp>
+#include <Tensile/Debug.hpp>
 #include <Tensile/Serialization/Base.hpp>
 
 namespace Tensile
@@ -59,6 +61,12 @@ namespace Tensile
                 iot::mapRequired(io, "hardwarePredicate", s.hardwarePredicate);
                 iot::mapRequired(io, "problemPredicate", s.problemPredicate);
 
+                if(!iot::outputting(io) && Debug::Instance().compilePredicates())
+                {
+                    s.hardwarePredicate = Predicates::Compile(s.hardwarePredicate);
+                    s.problemPredicate  = Predicates::Compile(s.problemPredicate);
+                }
+
                 iot::mapRequired(io, "debugKernel", s.debugKernel);
                 iot::mapOptional(io, "libraryLogicIndex", s.libraryLogicIndex);
                 iot::mapOptional(io, "ideals", s.ideals);
@@ -99,6 +107,7 @@ namespace Tensile
                 iot::mapRequired(io, "workspaceSizePerElemBias", s.workspaceSizePerElemBias);
 
                 iot::mapOptional(io, "activationFused", s.activationFused);
+                iot::mapOptional(io, "alignmentBytes", s.alignmentBytes);
 
                 iot::mapOptional(io, "CustomKernelName", s.customKernelName);
             }
@@ -165,6 +174,23 @@ namespace Tensile
             const static bool flow = false;
         };
 
+        template <typename IO>
+        struct MappingTraits<ContractionSolution::RooflineCalibration, IO>
+        {
+            using iot = IOTraits<IO>;
+            static void mapping(IO& io, ContractionSolution::RooflineCalibration& s)
+            {
+                iot::mapOptional(io, "memoryBandwidth", s.memoryBandwidth);
+                iot::mapOptional(io, "clockMHz", s.clockMHz);
+                iot::mapRequired(io, "flopsPerCuPerCycle", s.flopsPerCuPerCycle);
+                iot::mapOptional(io, "memoryEfficiency", s.memoryEfficiency);
+                iot::mapOptional(io, "computeEfficiency", s.computeEfficiency);
+                iot::mapOptional(io, "launchOverhead", s.launchOverhead);
+            }
+
+            const static bool flow = false;
+        };
+
         template <typename IO>
         struct MappingTraits<BufferLoadCheckPacket, IO>
         {
@@ -29,6 +29,7 @@
 #include <Tensile/Serialization/Base.hpp>
 #include <Tensile/Serialization/Predicates.hpp>
 
+#include <Tensile/Debug.hpp>
 #include <Tensile/ExactLogicLibrary.hpp>
 
 namespace Tensile
@@ -44,6 +45,9 @@ namespace Tensile
             static void mapping(IO& io, Library& lib)
             {
                 iot::mapRequired(io, "rows", lib.rows);
+
+                if(!iot::outputting(io))
+                    lib.buildIndex();
             }
 
             const static bool flow = false;
@@ -58,6 +62,9 @@ namespace Tensile
             static void mapping(IO& io, Library& lib)
             {
                 iot::mapRequired(io, "rows", lib.rows);
+
+                if(!iot::outputting(io))
+                    lib.buildIndex();
             }
 
             const static bool flow = false;
@@ -73,6 +80,9 @@ namespace Tensile
             {
                 iot::mapRequired(io, "predicate", row.first.value);
                 iot::mapRequired(io, "library", row.second);
+
+                if(!iot::outputting(io) && Debug::Instance().compilePredicates())
+                    row.first.value = Predicates::Compile(row.first.value);
             }
 
             const static bool flow = false;
@@ -63,6 +63,7 @@ namespace Tensile
                         return e1.key < e2.key || (e1.key == e2.key && e1.speed > e2.speed);
                     };
                     std::sort(table.table.begin(), table.table.end(), comp);
+                    table.buildIndex();
                 }
             }
 
@@ -170,6 +171,11 @@ namespace Tensile
                     success = mappingDistance<Key, Matching::GridBasedDistance<Key>>(
                         io, lib, properties);
                 }
+                else if(distanceType == "GridInterpolated")
+                {
+                    success = mappingDistance<Key, Matching::GridInterpolatedDistance<Key>>(
+                        io, lib, properties);
+                }
                 else
                 {
                     iot::setError(io, concatenate("Unknown distance function", distanceType));
@@ -288,7 +294,9 @@ namespace Tensile
                                     Base::template Pair<Matching::ManhattanDistance<Key>>(),
                                     Base::template Pair<Matching::EuclideanDistance<Key>>(),
                                     Base::template Pair<Matching::RandomDistance<Key>>(),
-                                    Base::template Pair<Matching::GridBasedDistance<Key>>()});
+                                    Base::template Pair<Matching::GridBasedDistance<Key>>(),
+                                    Base::template Pair<
+                                        Matching::GridInterpolatedDistance<Key>>()});
             }
         };
 
@@ -326,5 +334,11 @@ namespace Tensile
             : public AutoMappingTraits<Matching::GridBasedDistance<Key>, IO>
         {
         };
+
+        template <typename Key, typename IO>
+        struct MappingTraits<Matching::GridInterpolatedDistance<Key>, IO>
+            : public AutoMappingTraits<Matching::GridInterpolatedDistance<Key>, IO>
+        {
+        };
     } // namespace Serialization
 } // namespace Tensile
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#pragma once
+
+#include <Tensile/MasterSolutionLibrary.hpp>
+#include <Tensile/ModelRankingLibrary.hpp>
+
+#include <cmath>
+
+namespace Tensile
+{
+    namespace Serialization
+    {
+        template <typename MyProblem, typename MySolution, typename IO>
+        struct MappingTraits<ModelRankingLibrary<MyProblem, MySolution>, IO>
+        {
+            using Library = ModelRankingLibrary<MyProblem, MySolution>;
+
+            using iot = IOTraits<IO>;
+
+            static void mapping(IO& io, Library& lib)
+            {
+                auto ctx = static_cast<LibraryIOContext<MySolution>*>(iot::getContext(io));
+                if(ctx == nullptr)
+                {
+                    iot::setError(io,
+                                  "ModelRankingLibrary requires that context be "
+                                  "set to a SolutionMap.");
+                }
+
+                std::vector<int>                   mappingIndices;
+                std::vector<std::array<size_t, 4>> sizes;
+                if(iot::outputting(io))
+                {
+                    mappingIndices.reserve(lib.solutions.size());
+                    for(auto const& pair : lib.solutions)
+                        mappingIndices.push_back(pair.first);
+
+                    sizes.reserve(lib.grid.size());
+                    for(auto const& point : lib.grid)
+                    {
+                        std::array<size_t, 4> size;
+                        for(size_t i = 0; i < size.size(); i++)
+                            size[i] = std::llround(std::exp2(point[i]));
+                        sizes.push_back(size);
+                    }
+                }
+
+                iot::mapRequired(io, "library", lib.library);
+                iot::mapRequired(io, "indices", mappingIndices);
+                iot::mapRequired(io, "sizes", sizes);
+                iot::mapOptional(io, "maxGridDistance", lib.maxGridDistance);
+                iot::mapRequired(io, "calibration", lib.calibration);
+
+                if(!iot::outputting(io))
+                {
+                    for(int index : mappingIndices)
+                    {
+                        auto slnIter = ctx->solutions->find(index);
+                        if(slnIter == ctx->solutions->end())
+                        {
+                            iot::setError(
+                                io,
+                                concatenate("[ModelRankingLibrary] Invalid solution index: ",
+                                            index));
+                        }
+                        else
+                        {
+                            lib.solutions.insert(std::make_pair(index, slnIter->second));
+                        }
+                    }
+
+                    lib.grid.reserve(sizes.size());
+                    for(auto const& size : sizes)
+                        lib.grid.push_back(Library::gridPoint(size[0], size[1], size[2], size[3]));
+                }
+            }
+        };
+    } // namespace Serialization
+} // namespace Tensile
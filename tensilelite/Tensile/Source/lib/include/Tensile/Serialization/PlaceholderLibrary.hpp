@@ -50,8 +50,9 @@ namespace Tensile
                 if(!iot::outputting(io))
                 {
                     auto ctx = static_cast<LibraryIOContext<MySolution>*>(iot::getContext(io));
-                    lib.masterSolutions = ctx->solutions;
-                    lib.solutionsGuard  = ctx->solutionsGuard;
+                    lib.masterSolutions     = ctx->solutions;
+                    lib.solutionsGuard      = ctx->solutionsGuard;
+                    lib.masterLazySolutions = ctx->lazySolutions;
 
                     //Extract directory where TensileLibrary.dat/yaml file is located
                     lib.libraryDirectory = ctx->filename;
@@ -39,8 +39,25 @@ namespace Tensile
 
         template <typename Object, typename IO>
         struct MappingTraits<std::shared_ptr<Predicates::Predicate<Object>>, IO>
-            : public BaseClassMappingTraits<Predicates::Predicate<Object>, IO, true>
         {
+            using Base = BaseClassMappingTraits<Predicates::Predicate<Object>, IO, true>;
+            using iot  = IOTraits<IO>;
+
+            static void mapping(IO& io, std::shared_ptr<Predicates::Predicate<Object>>& p)
+            {
+                // Compiled predicates are written out as the tree they were compiled from.
+                if(iot::outputting(io))
+                {
+                    auto source = Predicates::Uncompiled(p);
+                    Base::mapping(io, source);
+                }
+                else
+                {
+                    Base::mapping(io, p);
+                }
+            }
+
+            const static bool flow = Base::flow;
         };
 
         /**
@@ -44,6 +44,7 @@
 #include <Tensile/Serialization/GranularitySelectionLibrary.hpp>
 #include <Tensile/Serialization/MapLibrary.hpp>
 #include <Tensile/Serialization/MatchingLibrary.hpp>
+#include <Tensile/Serialization/ModelRankingLibrary.hpp>
 #include <Tensile/Serialization/PlaceholderLibrary.hpp>
 
 namespace Tensile
@@ -78,6 +79,7 @@ namespace Tensile
                      Base::template Pair<ProblemMapLibrary<MyProblem, MySolution>>(),
                      Base::template Pair<ProblemMatchingLibrary<MyProblem, MySolution>>(),
                      Base::template Pair<GranularitySelectionLibrary<MyProblem, MySolution>>(),
+                     Base::template Pair<ModelRankingLibrary<MyProblem, MySolution>>(),
                      Base::template Pair<PlaceholderLibrary<MyProblem, MySolution>>(),
                      Base::template Pair<DecisionTreeLibrary<MyProblem, MySolution>>()});
             }
@@ -158,10 +160,12 @@ namespace Tensile
                 {
                     for(auto const& s : solutions)
                         lib.solutions[s->index] = s;
+                    lib.solutionTable.assign(lib.solutions);
 
                     auto ctx = static_cast<LibraryIOContext<MySolution>*>(iot::getContext(io));
                     ctx->solutions      = &lib.solutions;
                     ctx->solutionsGuard = &lib.solutionsGuard;
+                    ctx->lazySolutions  = &lib.lazySolutions;
                 }
 
                 std::shared_ptr<SolutionLibrary<MyProblem, MySolution>> innerLibrary;
@@ -99,7 +99,8 @@ namespace Tensile
                 }
 
                 if((*solution->hardwarePredicate)(hardware)
-                   && (*solution->problemPredicate)(problem))
+                   && (*solution->problemPredicate)(problem)
+                   && solution->fitsSelectionLimits(problem))
                     return solution;
             }
             else if(debug)
@@ -138,7 +139,8 @@ namespace Tensile
                 {
                     auto problem = problems[idx];
                     problem.setWorkspaceSizeGroupedGemm(ws);
-                    if(!(*solution->problemPredicate)(problem))
+                    if(!(*solution->problemPredicate)(problem)
+                       || !solution->fitsSelectionLimits(problem))
                         return std::shared_ptr<MySolution>();
                 }
 
@@ -221,7 +223,8 @@ namespace Tensile
                     {
                         auto problem = problems[idx];
                         problem.setWorkspaceSizeGroupedGemm(ws);
-                        if(!(*solution->problemPredicate)(problem))
+                        if(!(*solution->problemPredicate)(problem)
+                           || !solution->fitsSelectionLimits(problem))
                             useSolution = false;
                     }
                 }
@@ -73,7 +73,7 @@ namespace Tensile
         switch(searchType)
         {
         case SolutionLibrarySearchType::DEFAULT:
-            return (*solutions.problemPredicate)(problem);
+            return (*solutions.problemPredicate)(problem) && solutions.fitsSelectionLimits(problem);
             break;
         case SolutionLibrarySearchType::GEMM_TYPE_ONLY:
             return isGemmTypeSame(solutions, problem);
@@ -95,6 +95,33 @@ namespace Tensile
     /**
  * \ingroup SolutionLibrary
  *
+ * A sub-library that is only read from disk when it is first needed, along
+ * with the code object holding its kernels. See `PlaceholderLibrary`.
+ */
+    struct TENSILE_API LazyLoadedLibrary
+    {
+        virtual ~LazyLoadedLibrary() = default;
+
+        //! File name of the sub-library, without directory or extension.
+        virtual std::string const& name() const = 0;
+
+        virtual bool isLoaded() const = 0;
+
+        /**
+   * Loads the sub-library unless it already is. Safe to call from several
+   * threads at once.
+   *
+   * @return false if the sub-library could not be loaded.
+   */
+        virtual bool load() const = 0;
+
+        //! File name of the code object, relative to the code object directory.
+        virtual std::string codeObjectFile() const = 0;
+    };
+
+    /**
+ * \ingroup SolutionLibrary
+ *
  * @brief Abstract base class for Library objects that can provide a
  * mapping from `Problem` and `Hardware` objects to Solution objects.
  *
@@ -192,6 +219,14 @@ namespace Tensile
         {
             return SolutionVector<MySolution>();
         }
+
+        /**
+   * Appends every lazily loaded sub-library below this one, whether loaded or
+   * not, so that they can be loaded ahead of use.
+   */
+        virtual void getLazyLoadedLibraries(std::vector<LazyLoadedLibrary const*>& libraries) const
+        {
+        }
     };
 
 } // namespace Tensile
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#pragma once
+
+#include <Tensile/Macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Tensile
+{
+    namespace Matching
+    {
+        /**
+         * \ingroup PropertyMatching
+         *
+         * Balanced k-d tree over a fixed set of points, for k-nearest
+         * neighbour queries in O(log n) on average. The tree is implicit:
+         * each range of the point order is split at its median along the
+         * axis with the largest spread, so no node objects are allocated.
+         */
+        class TENSILE_API KdTree
+        {
+        public:
+            //! Squared distance and index of a point, as given to build().
+            using Neighbor = std::pair<double, uint32_t>;
+
+            KdTree() = default;
+
+            /**
+             * Builds the tree over points, which holds dims coordinates per
+             * point, one point after the other.
+             */
+            void build(std::vector<double> points, size_t dims);
+
+            /**
+             * Replaces neighbors with the (up to) k points nearest to query,
+             * nearest first and the lower index first among equally near
+             * ones, i.e. the first k of all points sorted by Neighbor.
+             * Returns the number of points visited.
+             */
+            size_t nearest(double const* query, size_t k, std::vector<Neighbor>& neighbors) const;
+
+            size_t size() const
+            {
+                return m_order.size();
+            }
+
+            size_t dimensions() const
+            {
+                return m_dims;
+            }
+
+        private:
+            //! Ranges of at most this many points are not split.
+            static constexpr size_t LeafSize = 8;
+
+            void buildRange(size_t begin, size_t end);
+
+            //! Inserts the node at position node of m_order into nearest if it is nearer.
+            void offer(double const*          query,
+                       size_t                 node,
+                       size_t                 k,
+                       std::vector<Neighbor>& nearest) const;
+
+            void search(double const*          query,
+                        size_t                 begin,
+                        size_t                 end,
+                        size_t                 k,
+                        std::vector<Neighbor>& nearest,
+                        size_t&                visited) const;
+
+            //! Only valid while building, before m_points is put in tree order.
+            double coordinate(uint32_t point, size_t axis) const
+            {
+                return m_points[point * m_dims + axis];
+            }
+
+            //! Coordinates of the node at each position of m_order, once built.
+            std::vector<double>   m_points;
+            std::vector<uint32_t> m_order;
+            //! Split axis of the node stored at each position of m_order.
+            std::vector<uint8_t> m_axes;
+            size_t               m_dims = 0;
+        };
+    } // namespace Matching
+} // namespace Tensile
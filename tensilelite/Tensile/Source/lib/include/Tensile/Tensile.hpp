@@ -26,7 +26,10 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <shared_mutex>
@@ -114,6 +117,43 @@ namespace Tensile
 
     /**
  * \ingroup Launching
+ * Launch handles resolved by SolutionAdapters for one kernel. Owned by the
+ * Solution that generates the kernel and shared by all of its invocations so
+ * that, once resolved, a launch needs neither a lock nor a name lookup.
+ * Each adapter writes only its own entry (see SolutionAdapter::handleSlot()).
+ * Slots are reused by later adapters, so an entry is tagged with the adapter
+ * that wrote it and a handle left by a destroyed adapter is never returned.
+ */
+    struct TENSILE_API KernelHandleCache
+    {
+        static constexpr size_t MaxAdapters = 16;
+
+        struct Entry
+        {
+            std::atomic<uint64_t> owner{0};
+            std::atomic<void*>    handle{nullptr};
+        };
+
+        void* find(int slot, uint64_t owner) const
+        {
+            auto const& entry = entries[slot];
+            if(entry.owner.load(std::memory_order_acquire) != owner)
+                return nullptr;
+            return entry.handle.load(std::memory_order_relaxed);
+        }
+
+        void store(int slot, uint64_t owner, void* handle)
+        {
+            auto& entry = entries[slot];
+            entry.handle.store(handle, std::memory_order_relaxed);
+            entry.owner.store(owner, std::memory_order_release);
+        }
+
+        std::array<Entry, MaxAdapters> entries;
+    };
+
+    /**
+ * \ingroup Launching
  * Describes a single kernel invocation including kernel name, launch
  * bounds, and arguments.
  */
@@ -123,6 +163,9 @@ namespace Tensile
         std::string kernelName;
         std::string codeObjectFile; //Code object file kernel is located in
 
+        //! Optional, non-owning. Must outlive the invocation.
+        KernelHandleCache* handleCache = nullptr;
+
         dim3   workGroupSize;
         dim3   numWorkGroups;
         dim3   numWorkItems;
@@ -173,9 +216,30 @@ namespace Tensile
     class TENSILE_API SolutionAdapter
     {
     public:
+        SolutionAdapter();
         virtual ~SolutionAdapter();
 
         virtual std::string name() const = 0;
+
+        /**
+         * Index of this adapter's entry in a KernelHandleCache, or -1 if all
+         * entries are taken by live adapters. The slot is given back when the
+         * adapter is destroyed.
+         */
+        int handleSlot() const
+        {
+            return m_handleSlot;
+        }
+
+        //! Tag of the entries this adapter writes, unique among all adapters.
+        uint64_t handleOwner() const
+        {
+            return m_handleOwner;
+        }
+
+    private:
+        int      m_handleSlot;
+        uint64_t m_handleOwner;
     };
 
 #ifdef TENSILE_DEFAULT_SERIALIZATION
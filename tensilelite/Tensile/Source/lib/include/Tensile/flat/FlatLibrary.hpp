@@ -0,0 +1,541 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+
+#include <Tensile/ContractionLibrary.hpp>
+#include <Tensile/Debug.hpp>
+#include <Tensile/Serialization.hpp>
+
+namespace Tensile
+{
+    namespace Flat
+    {
+        /**
+         * Flat library format, as written by LibraryIO.writeFlat().
+         *
+         * The document tree is stored as a table of fixed-size nodes. Arrays
+         * and maps refer to contiguous ranges of a child table and an entry
+         * table, and all strings (map keys and values) are interned in a
+         * string table. Map entries are sorted by key, so a key lookup is a
+         * binary search over the file contents and nothing has to be parsed
+         * or copied before the library objects are built. All values are
+         * little-endian and every table is 8-byte aligned.
+         */
+        constexpr char     Magic[8] = {'T', 'N', 'S', 'L', 'F', 'L', 'A', 'T'};
+        constexpr uint32_t Version  = 1;
+
+        enum class NodeType : uint32_t
+        {
+            Nil,
+            Bool,
+            Int, //< value holds an int64_t
+            UInt, //< value holds a uint64_t
+            Float, //< value holds the bits of a double
+            String, //< value is an index into the string table
+            Array, //< count children starting at children[value]
+            Map, //< count entries starting at entries[value]
+            Count
+        };
+
+        struct FileHeader
+        {
+            char     magic[8];
+            uint32_t version;
+            uint32_t root;
+            uint64_t nodeCount;
+            uint64_t nodeOffset;
+            uint64_t childCount;
+            uint64_t childOffset;
+            uint64_t entryCount;
+            uint64_t entryOffset;
+            uint64_t stringCount;
+            uint64_t stringOffset;
+            uint64_t stringDataSize;
+            uint64_t stringDataOffset;
+        };
+
+        struct Node
+        {
+            NodeType type;
+            uint32_t count;
+            uint64_t value;
+        };
+
+        struct Entry
+        {
+            uint32_t key; //< index into the string table
+            uint32_t node;
+        };
+
+        struct StringRef
+        {
+            uint64_t offset; //< into the string data
+            uint64_t length;
+        };
+
+        static_assert(sizeof(FileHeader) == 96, "Flat library header layout changed");
+        static_assert(sizeof(Node) == 16, "Flat library node layout changed");
+        static_assert(sizeof(Entry) == 8, "Flat library entry layout changed");
+        static_assert(sizeof(StringRef) == 16, "Flat library string layout changed");
+
+        //! True if the buffer starts like a flat library.
+        inline bool IsFlatLibrary(void const* data, size_t size)
+        {
+            return size >= sizeof(Magic) && memcmp(data, Magic, sizeof(Magic)) == 0;
+        }
+
+        /**
+         * Read-only view of a flat library in memory. Does not own the data.
+         */
+        class Document
+        {
+        public:
+            /**
+             * Checks the header and that every table lies inside the buffer.
+             * Returns an error message, or an empty string on success. The
+             * nodes themselves are checked by check() as they are reached.
+             */
+            std::string open(void const* data, size_t size);
+
+            /**
+             * Checks that a node and the references it holds (its string,
+             * its children or its map keys and values) lie inside the
+             * tables. Returns an error message, or an empty string if the
+             * node may be used.
+             */
+            std::string check(uint32_t index) const;
+
+            uint32_t root() const
+            {
+                return m_header->root;
+            }
+
+            Node const& node(uint32_t index) const
+            {
+                return m_nodes[index];
+            }
+
+            std::string_view string(uint64_t index) const
+            {
+                auto const& ref = m_strings[index];
+                return std::string_view(m_stringData + ref.offset, ref.length);
+            }
+
+            uint32_t child(Node const& array, uint32_t index) const
+            {
+                return m_children[array.value + index];
+            }
+
+            Entry const* entriesBegin(Node const& map) const
+            {
+                return m_entries + map.value;
+            }
+
+            Entry const* entriesEnd(Node const& map) const
+            {
+                return m_entries + map.value + map.count;
+            }
+
+            //! Binary search for key in a map node. Returns false if absent.
+            bool find(Node const& map, std::string_view key, uint32_t& value) const;
+
+        private:
+            FileHeader const* m_header     = nullptr;
+            Node const*       m_nodes      = nullptr;
+            uint32_t const*   m_children   = nullptr;
+            Entry const*      m_entries    = nullptr;
+            StringRef const*  m_strings    = nullptr;
+            char const*       m_stringData = nullptr;
+        };
+
+        char const* ToString(NodeType type);
+    } // namespace Flat
+
+    namespace Serialization
+    {
+        template <typename T>
+        struct is_FlatScalar
+        {
+            static const bool value = std::is_arithmetic<T>::value;
+        };
+
+        template <>
+        struct is_FlatScalar<std::string>
+        {
+            static const bool value = true;
+        };
+
+        /**
+         * Serialization input over a Flat::Document, the counterpart of
+         * MessagePackInput.
+         */
+        struct FlatInput
+        {
+            Flat::Document const*    document;
+            uint32_t                 node;
+            std::vector<std::string> error;
+
+            std::unordered_set<std::string> usedKeys;
+
+            int enumFound = 0;
+
+            void* context = nullptr;
+
+            bool valid = true;
+
+            FlatInput(Flat::Document const* document, uint32_t node, void* context = nullptr)
+                : document(document)
+                , node(node)
+                , context(context)
+            {
+                // Only the nodes that are actually read are checked.
+                auto checkError = document->check(node);
+                if(!checkError.empty())
+                {
+                    addError(checkError);
+                    valid = false;
+                }
+            }
+
+            FlatInput createSubRef(uint32_t otherNode)
+            {
+                return FlatInput(document, otherNode, context);
+            }
+
+            Flat::Node const& value() const
+            {
+                static const Flat::Node nil{Flat::NodeType::Nil, 0, 0};
+                return valid ? document->node(node) : nil;
+            }
+
+            void addError(std::string const& msg)
+            {
+                error.push_back(msg);
+            }
+
+            bool expect(Flat::NodeType type)
+            {
+                if(value().type == type)
+                    return true;
+
+                addError(concatenate("Expected ",
+                                     Flat::ToString(type),
+                                     ", found ",
+                                     Flat::ToString(value().type)));
+                return false;
+            }
+
+            template <typename T>
+            void mapRequired(const char* key, T& obj)
+            {
+                if(!expect(Flat::NodeType::Map))
+                    return;
+
+                uint32_t valueNode;
+                if(document->find(value(), key, valueNode))
+                {
+                    FlatInput subRef = createSubRef(valueNode);
+                    subRef.input(obj);
+                    error.insert(error.end(), subRef.error.begin(), subRef.error.end());
+                    if(Tensile::Debug::Instance().printDataInit())
+                        usedKeys.insert(key);
+                }
+                else
+                {
+                    std::string msg = "Unknown key ";
+                    msg += key;
+                    msg += " (keys: ";
+                    bool first = true;
+                    for(auto entry = document->entriesBegin(value());
+                        entry != document->entriesEnd(value());
+                        entry++)
+                    {
+                        if(!first)
+                            msg += ", ";
+                        msg += document->string(entry->key);
+                        first = false;
+                    }
+                    msg += ")";
+                    addError(msg);
+                }
+            }
+
+            template <typename T>
+            void mapOptional(const char* key, T& obj)
+            {
+                if(!expect(Flat::NodeType::Map))
+                    return;
+
+                uint32_t valueNode;
+                if(document->find(value(), key, valueNode))
+                {
+                    FlatInput subRef = createSubRef(valueNode);
+                    subRef.input(obj);
+                    error.insert(error.end(), subRef.error.begin(), subRef.error.end());
+                    if(Tensile::Debug::Instance().printDataInit())
+                        usedKeys.insert(key);
+                }
+            }
+
+            template <typename T>
+            void input(T& obj)
+            {
+                EmptyContext ctx;
+                input(obj, ctx);
+            }
+
+            void checkUsedKeys()
+            {
+                if(value().type != Flat::NodeType::Map)
+                    return;
+
+                for(auto entry = document->entriesBegin(value());
+                    entry != document->entriesEnd(value());
+                    entry++)
+                {
+                    std::string key(document->string(entry->key));
+                    if(usedKeys.find(key) == usedKeys.end())
+                        addError(concatenate("Error: Unused key ", key));
+                }
+            }
+
+            template <typename T, typename Context>
+            typename std::enable_if<has_MappingTraits<T, FlatInput, Context>::value, void>::type
+                input(T& obj, Context& ctx)
+            {
+                MappingTraits<T, FlatInput, Context>::mapping(*this, obj, ctx);
+
+                if(Tensile::Debug::Instance().printDataInit())
+                    checkUsedKeys();
+            }
+
+            template <typename T, typename Context>
+            typename std::enable_if<has_EmptyMappingTraits<T, FlatInput, Context>::value,
+                                    void>::type
+                input(T& obj, Context& ctx)
+            {
+                MappingTraits<T, FlatInput, Context>::mapping(*this, obj);
+
+                if(Tensile::Debug::Instance().printDataInit())
+                    checkUsedKeys();
+            }
+
+            template <typename T, typename Context>
+            typename std::enable_if<is_FlatScalar<T>::value, void>::type input(T&       obj,
+                                                                               Context& ctx)
+            {
+                convert(obj);
+            }
+
+            template <typename T, typename Context>
+            typename std::enable_if<has_EnumTraits<T, FlatInput>::value, void>::type
+                input(T& obj, Context& ctx)
+            {
+                enumFound = 0;
+                EnumTraits<T, FlatInput>::enumeration(*this, obj);
+
+                if(enumFound != 1)
+                {
+                    std::string s;
+                    convert(s);
+                    addError(concatenate("Enum not found! ", s));
+                }
+            }
+
+            template <typename T, typename Context>
+            typename std::enable_if<has_SequenceTraits<T, FlatInput>::value, void>::type
+                input(T& obj, Context& ctx)
+            {
+                if(!expect(Flat::NodeType::Array))
+                    return;
+
+                auto const& array = value();
+                for(uint32_t i = 0; i < array.count; i++)
+                {
+                    FlatInput subRef = createSubRef(document->child(array, i));
+                    auto&     value  = SequenceTraits<T, FlatInput>::element(*this, obj, i);
+                    subRef.input(value);
+
+                    if(!subRef.error.empty())
+                    {
+                        error.insert(error.end(), subRef.error.begin(), subRef.error.end());
+                        return;
+                    }
+                }
+            }
+
+            // Vectors of plain values have no SequenceTraits of their own.
+            template <typename T, typename Context>
+            typename std::enable_if<!has_SequenceTraits<std::vector<T>, FlatInput>::value,
+                                    void>::type
+                input(std::vector<T>& obj, Context& ctx)
+            {
+                if(!expect(Flat::NodeType::Array))
+                    return;
+
+                auto const& array = value();
+                obj.resize(array.count);
+                for(uint32_t i = 0; i < array.count; i++)
+                {
+                    FlatInput subRef = createSubRef(document->child(array, i));
+                    subRef.input(obj[i]);
+
+                    if(!subRef.error.empty())
+                    {
+                        error.insert(error.end(), subRef.error.begin(), subRef.error.end());
+                        return;
+                    }
+                }
+            }
+
+            template <typename T, typename Context>
+            typename std::enable_if<has_CustomMappingTraits<T, FlatInput>::value, void>::type
+                input(T& obj, Context& ctx)
+            {
+                if(!expect(Flat::NodeType::Map))
+                    return;
+
+                for(auto entry = document->entriesBegin(value());
+                    entry != document->entriesEnd(value());
+                    entry++)
+                {
+                    std::string key(document->string(entry->key));
+                    CustomMappingTraits<T, FlatInput>::inputOne(*this, key, obj);
+                }
+            }
+
+            template <typename T>
+            void enumCase(T& member, const char* key, T value)
+            {
+                if(!expect(Flat::NodeType::String))
+                    return;
+
+                if(document->string(this->value().value) == key)
+                {
+                    enumFound++;
+                    member = value;
+                }
+            }
+
+            void convert(std::string& obj)
+            {
+                if(expect(Flat::NodeType::String))
+                    obj = document->string(value().value);
+            }
+
+            void convert(bool& obj)
+            {
+                if(expect(Flat::NodeType::Bool))
+                    obj = value().value != 0;
+            }
+
+            template <typename T>
+            void convert(T& obj)
+            {
+                static_assert(std::is_arithmetic<T>::value, "Not a number");
+
+                auto const& v = value();
+                switch(v.type)
+                {
+                case Flat::NodeType::Int:
+                {
+                    int64_t i;
+                    memcpy(&i, &v.value, sizeof(i));
+                    obj = static_cast<T>(i);
+                    break;
+                }
+                case Flat::NodeType::UInt:
+                    obj = static_cast<T>(v.value);
+                    break;
+                case Flat::NodeType::Float:
+                {
+                    if(std::is_integral<T>::value)
+                    {
+                        addError("Expected an integer, found Float");
+                        break;
+                    }
+                    double d;
+                    memcpy(&d, &v.value, sizeof(d));
+                    obj = static_cast<T>(d);
+                    break;
+                }
+                default:
+                    addError(concatenate("Expected a number, found ", Flat::ToString(v.type)));
+                }
+            }
+        };
+
+        template <>
+        struct IOTraits<FlatInput>
+        {
+            template <typename T>
+            static void mapRequired(FlatInput& io, const char* key, T& obj)
+            {
+                io.mapRequired(key, obj);
+            }
+
+            template <typename T>
+            static void mapOptional(FlatInput& io, const char* key, T& obj)
+            {
+                io.mapOptional(key, obj);
+            }
+
+            static bool outputting(FlatInput& io)
+            {
+                return false;
+            }
+
+            static void setError(FlatInput& io, std::string const& msg)
+            {
+                io.error.push_back(msg);
+            }
+
+            static void setContext(FlatInput& io, void* ctx)
+            {
+                io.context = ctx;
+            }
+
+            static void* getContext(FlatInput& io)
+            {
+                return io.context;
+            }
+
+            template <typename T>
+            static void enumCase(FlatInput& io, T& member, const char* key, T value)
+            {
+                io.enumCase(member, key, value);
+            }
+        };
+    } // namespace Serialization
+} // namespace Tensile
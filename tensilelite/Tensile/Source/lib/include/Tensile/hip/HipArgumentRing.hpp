@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <Tensile/Macros.hpp>
+#include <hip/hip_runtime.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Tensile
+{
+    namespace hip
+    {
+        /**
+         * Ring of pinned host buffers used to stage kernel arguments for
+         * asynchronous host-to-device copies.
+         *
+         * A slot is handed out by acquire(), filled on the host, and fenced on
+         * the stream that copies it. It is only handed out again once that
+         * copy has completed, so the host never overwrites arguments that are
+         * still being read by an earlier copy.
+         */
+        class TENSILE_API ArgumentRing
+        {
+            struct Buffer;
+
+        public:
+            static constexpr size_t DefaultSlotCount = 8;
+            static constexpr size_t DefaultSlotBytes = 32768;
+
+            /**
+             * Exclusive use of one slot of the ring. The slot goes back to the
+             * ring when this is destroyed.
+             */
+            class TENSILE_API Slot
+            {
+            public:
+                Slot() = default;
+                Slot(Slot&& other) noexcept;
+                Slot& operator=(Slot&& other) noexcept;
+                ~Slot();
+
+                void* data() const
+                {
+                    return m_data;
+                }
+
+                size_t size() const
+                {
+                    return m_size;
+                }
+
+                /**
+                 * Marks the slot as in use by the work queued on stream so
+                 * far, e.g. a hipMemcpyAsync out of it.
+                 */
+                void fence(hipStream_t stream);
+
+            private:
+                friend class ArgumentRing;
+
+                Slot(ArgumentRing* ring, Buffer* buffer);
+
+                void release();
+
+                ArgumentRing* m_ring   = nullptr;
+                Buffer*       m_buffer = nullptr;
+                void*         m_data   = nullptr;
+                size_t        m_size   = 0;
+            };
+
+            explicit ArgumentRing(size_t slotCount = DefaultSlotCount,
+                                  size_t slotBytes = DefaultSlotBytes);
+            ~ArgumentRing();
+
+            ArgumentRing(ArgumentRing const&)            = delete;
+            ArgumentRing& operator=(ArgumentRing const&) = delete;
+
+            /**
+             * Returns the least recently used slot with room for at least
+             * bytes, waiting for its last fence if necessary. A slot is added
+             * if all of them are held by other threads.
+             */
+            Slot acquire(size_t bytes);
+
+            /**
+             * Ring shared by everything running on the given device.
+             */
+            static ArgumentRing& ForDevice(int device);
+
+        private:
+            struct Buffer
+            {
+                void*      data   = nullptr;
+                size_t     size   = 0;
+                hipEvent_t event  = nullptr;
+                bool       fenced = false;
+                bool       held   = false;
+            };
+
+            void release(Buffer* buffer);
+
+            std::mutex                           m_mutex;
+            std::vector<std::unique_ptr<Buffer>> m_buffers;
+            size_t                               m_next = 0;
+            size_t                               m_slotBytes;
+        };
+    }
+}
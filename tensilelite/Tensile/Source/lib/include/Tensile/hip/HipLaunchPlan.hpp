@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#pragma once
+
+#include <Tensile/KernelArguments.hpp>
+#include <Tensile/Macros.hpp>
+#include <Tensile/Tensile.hpp>
+#include <hip/hip_runtime.h>
+
+#include <vector>
+
+namespace Tensile
+{
+    namespace hip
+    {
+        class SolutionAdapter;
+
+        /**
+         * Fixed sequence of kernel launches recorded from the KernelInvocations
+         * of one or more solutions.
+         *
+         * Kernel functions are resolved once when a group of invocations is
+         * added, so launch() does no lookups, validation or allocation and only
+         * enqueues the kernels. This also makes it safe to call while the
+         * stream is being captured into a graph. launchGraph() captures the
+         * sequence itself and replays it, capturing again after the arguments
+         * have changed.
+         */
+        class TENSILE_API LaunchPlan
+        {
+        public:
+            struct Launch
+            {
+                hipFunction_t   function = nullptr;
+                dim3            numWorkItems;
+                dim3            workGroupSize;
+                size_t          sharedMemBytes = 0;
+                KernelArguments args;
+            };
+
+            LaunchPlan() = default;
+            ~LaunchPlan();
+
+            LaunchPlan(LaunchPlan const&)            = delete;
+            LaunchPlan& operator=(LaunchPlan const&) = delete;
+
+            /**
+             * Appends kernels as a new group and returns its index, resolving
+             * their functions through adapter.
+             */
+            size_t append(SolutionAdapter& adapter, std::vector<KernelInvocation> const& kernels);
+
+            /**
+             * Appends already resolved launches as a new group and returns its
+             * index.
+             */
+            size_t append(std::vector<Launch> launches);
+
+            /**
+             * Replaces the launches of a group, e.g. after the kernels it was
+             * recorded from have been solved again.
+             */
+            void replace(size_t                               group,
+                         SolutionAdapter&                     adapter,
+                         std::vector<KernelInvocation> const& kernels);
+
+            /**
+             * Overwrites the arguments of every launch in group appended with
+             * the given binding. Returns false if there is none.
+             */
+            bool rebind(size_t group, KernelArgumentBinding binding, void const* pointer);
+            bool rebind(size_t group, KernelArgumentBinding binding, ConstantVariant const& value);
+
+            size_t groups() const
+            {
+                return m_groups.size();
+            }
+
+            std::vector<Launch> const& launches(size_t group) const;
+
+            /**
+             * Enqueues every launch of every group on stream, in order.
+             */
+            hipError_t launch(hipStream_t stream) const;
+
+            /**
+             * Replays the plan as a graph, capturing it on stream first if it
+             * has not been captured yet or has changed since. stream must not
+             * be the null stream.
+             */
+            hipError_t launchGraph(hipStream_t stream);
+
+        private:
+            std::vector<Launch> resolve(SolutionAdapter&                     adapter,
+                                        std::vector<KernelInvocation> const& kernels);
+
+            void resetGraph();
+
+            std::vector<std::vector<Launch>> m_groups;
+            hipGraphExec_t                   m_graphExec = nullptr;
+        };
+    }
+}
@@ -29,6 +29,7 @@
 #include <Tensile/AMDGPU.hpp>
 #include <Tensile/Tensile.hpp>
 #include <hip/hip_runtime.h>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <mutex>
@@ -54,6 +55,14 @@ namespace Tensile
 
             hipError_t initializeLazyLoading(std::string architecture, std::string codeObjectDir);
 
+            /**
+             * Loads a code object from the lazy loading directory, trying its
+             * xnack variants, unless it has already been loaded. Concurrent
+             * calls for the same file load it only once, and do not block
+             * launches of kernels that are already loaded.
+             */
+            hipError_t loadLazyCodeObjectFile(std::string const& codeObjectFile);
+
             hipError_t loadCodeObject(const void* image);
 
             hipError_t loadCodeObjectBytes(std::vector<uint8_t> const& bytes);
@@ -81,6 +90,12 @@ namespace Tensile
 
             hipError_t initKernel(std::string const& name);
 
+            /**
+             * Looks up the function that launchKernel() would launch for
+             * kernel, loading its code object if needed.
+             */
+            hipError_t resolveKernel(hipFunction_t& rv, KernelInvocation const& kernel);
+
         private:
             hipError_t getKernel(hipFunction_t& rv, std::string const& name);
 
@@ -96,6 +111,9 @@ namespace Tensile
             std::vector<std::string>        m_loadedModuleNames;
             std::unordered_set<std::string> m_loadedCOFiles;
 
+            // Held while a lazily loaded code object is being loaded.
+            std::unordered_map<std::string, std::shared_ptr<std::mutex>> m_loadingCOFiles;
+
             friend std::ostream& operator<<(std::ostream& stream, SolutionAdapter const& adapter);
         };
 
@@ -573,6 +573,9 @@ namespace Tensile
             = TensorDescriptor("scaleAlphaVec");
         gemm.m_tensors[ContractionProblemGemm::TENSOR::METADATA] = TensorDescriptor("metadata");
         gemm.m_tensor_compressed                                 = TensorDescriptor("compressed");
+        for(int idx = ContractionProblemGemm::TENSOR::A; idx <= ContractionProblemGemm::TENSOR::D;
+            idx++)
+            gemm.updateTensorFingerprint(idx);
         return gemm;
     }
 
@@ -838,6 +841,56 @@ namespace Tensile
                                          [](const ContractionProblemGemm::FreeIndex& fi) {
                                              return fi.c == 0 /*idx0*/;
                                          });
+
+        m_operationIdentifierHash = std::hash<std::string>()(m_operationIdentifier);
+        for(int idx = ContractionProblemGemm::TENSOR::A; idx <= ContractionProblemGemm::TENSOR::D;
+            idx++)
+            m_tensorHashes[idx] = std::hash<TensorDescriptor>()(m_tensors[idx]);
+        updateFingerprint();
+    }
+
+    void ContractionProblemGemm::updateTensorFingerprint(int idx)
+    {
+        m_tensorHashes[idx] = std::hash<TensorDescriptor>()(m_tensors[idx]);
+        updateFingerprint();
+    }
+
+    void ContractionProblemGemm::updateFingerprint()
+    {
+        m_key.workspaceSize     = m_workspaceSize;
+        m_key.maxGlobalSplitU   = m_maxGlobalSplitU;
+        m_key.minAlignmentBytes = m_minAlignmentBytes;
+
+        // clang-format off
+        m_key.flags = (m_highPrecisionAccumulate ? Key::HighPrecisionAccumulate : 0)
+                    | (m_deterministicMode       ? Key::DeterministicMode       : 0)
+                    | (m_stridedBatched          ? Key::StridedBatched          : 0)
+                    | (m_groupedGemm             ? Key::GroupedGemm             : 0)
+                    | (m_fp16AltImpl             ? Key::Fp16AltImpl             : 0)
+                    | (m_activationNoGuard       ? Key::ActivationNoGuard       : 0)
+                    | (m_useGradient             ? Key::UseGradient             : 0)
+                    | (m_useBias                 ? Key::UseBias                 : 0)
+                    | (m_useE                    ? Key::UseE                    : 0)
+                    | (m_useScaleAB              ? Key::UseScaleAB              : 0)
+                    | (m_useScaleCD              ? Key::UseScaleCD              : 0)
+                    | (m_useScaleDVec            ? Key::UseScaleDVec            : 0)
+                    | (m_useScaleAlphaVec        ? Key::UseScaleAlphaVec        : 0);
+        // clang-format on
+
+        m_key.computeInputType      = m_computeInputType;
+        m_key.activationComputeType = m_activationComputeType;
+        m_key.f32XdlMathOp          = m_f32XdlMathOp;
+        m_key.activationType        = m_activationType;
+        m_key.kernelLanguage        = m_kernelLanguage;
+        m_key.performanceMetric     = performanceMetric();
+        m_key.biasSrc               = m_biasSrc;
+
+        m_fingerprint = combine_hashes(std::hash<Key>()(m_key),
+                                       m_operationIdentifierHash,
+                                       m_tensorHashes[ContractionProblemGemm::TENSOR::A],
+                                       m_tensorHashes[ContractionProblemGemm::TENSOR::B],
+                                       m_tensorHashes[ContractionProblemGemm::TENSOR::C],
+                                       m_tensorHashes[ContractionProblemGemm::TENSOR::D]);
     }
 
     void ContractionProblemGemm::normalizeSparseA()
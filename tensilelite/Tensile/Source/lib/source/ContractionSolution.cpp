@@ -26,6 +26,7 @@
 
 #include <Tensile/ContractionSolution.hpp>
 
+#include <Tensile/hip/HipArgumentRing.hpp>
 #include <Tensile/hip/HipUtils.hpp>
 
 #include <Tensile/AMDGPU.hpp>
@@ -539,7 +540,7 @@ namespace Tensile
             args.template append<void const*>("ws_d", (uint8_t*)inputs.ws + workspaceOffsetInByte);
             if(sizeMapping.customKernelName != "")
             {
-                args.template append<void const*>("c", inputs.c);
+                args.template append<void const*>("c", inputs.c, KernelArgumentBinding::C);
             }
             else
             {
@@ -549,8 +550,8 @@ namespace Tensile
         }
         else if(problemType.stridedBatched)
         {
-            args.template append<void const*>("d", inputs.d);
-            args.template append<void const*>("c", inputs.c);
+            args.template append<void const*>("d", inputs.d, KernelArgumentBinding::D);
+            args.template append<void const*>("c", inputs.c, KernelArgumentBinding::C);
         }
         else
         {
@@ -560,8 +561,8 @@ namespace Tensile
 
         if(problemType.stridedBatched)
         {
-            args.template append<void const*>("a", inputs.a);
-            args.template append<void const*>("b", inputs.b);
+            args.template append<void const*>("a", inputs.a, KernelArgumentBinding::A);
+            args.template append<void const*>("b", inputs.b, KernelArgumentBinding::B);
         }
         else
         {
@@ -620,18 +621,18 @@ namespace Tensile
 
         if((sizeMapping.globalAccumulation == 2) && (sizeMapping.customKernelName != ""))
         {
-            args.template append<void const*>("dstD", inputs.d);
+            args.template append<void const*>("dstD", inputs.d, KernelArgumentBinding::D);
         }
 
-        args.append("alpha", inputs.alpha, problem.alphaType());
+        args.append("alpha", inputs.alpha, problem.alphaType(), KernelArgumentBinding::Alpha);
         if(problem.alphaType() == DataType::Half)
-            args.append("alpha_2", inputs.alpha, problem.alphaType());
+            args.append("alpha_2", inputs.alpha, problem.alphaType(), KernelArgumentBinding::Alpha);
 
         if(problemType.useBeta)
         {
-            args.append("beta", inputs.beta, problem.betaType());
+            args.append("beta", inputs.beta, problem.betaType(), KernelArgumentBinding::Beta);
             if(problem.betaType() == DataType::Half)
-                args.append("beta_2", inputs.beta, problem.betaType());
+                args.append("beta_2", inputs.beta, problem.betaType(), KernelArgumentBinding::Beta);
         }
 
         if constexpr(insertKernelArgs)
@@ -641,25 +642,31 @@ namespace Tensile
            && ((sizeMapping.globalSplitU == 1)
                || (sizeMapping.customKernelName != ""))) //kernel input data
         {
-            args.template append<void const*>("scaleDVec", inputs.scaleDVec);
+            args.template append<void const*>(
+                "scaleDVec", inputs.scaleDVec, KernelArgumentBinding::ScaleDVec);
         }
 
         if(problemType.useScaleAB && (sizeMapping.globalSplitU == 1)) //kernel input data
         {
-            args.template append<void const*>("scaleA", inputs.scaleA);
-            args.template append<void const*>("scaleB", inputs.scaleB);
+            args.template append<void const*>(
+                "scaleA", inputs.scaleA, KernelArgumentBinding::ScaleA);
+            args.template append<void const*>(
+                "scaleB", inputs.scaleB, KernelArgumentBinding::ScaleB);
         }
         if(problemType.useScaleCD && (sizeMapping.globalSplitU == 1)) //kernel input data
         {
-            args.template append<void const*>("scaleC", inputs.scaleC);
-            args.template append<void const*>("scaleD", inputs.scaleD);
+            args.template append<void const*>(
+                "scaleC", inputs.scaleC, KernelArgumentBinding::ScaleC);
+            args.template append<void const*>(
+                "scaleD", inputs.scaleD, KernelArgumentBinding::ScaleD);
         }
 
         if(problemType.useScaleAlphaVec
            && ((sizeMapping.globalSplitU == 1)
                || (sizeMapping.customKernelName != ""))) //kernel input data
         {
-            args.template append<void const*>("scaleAlphaVec", inputs.scaleAlphaVec);
+            args.template append<void const*>(
+                "scaleAlphaVec", inputs.scaleAlphaVec, KernelArgumentBinding::ScaleAlphaVec);
         }
 
         bool runActivation = false;
@@ -678,7 +685,8 @@ namespace Tensile
             {
                 if(problemType.stridedBatched)
                 {
-                    args.template append<void const*>("bias", inputs.bias);
+                    args.template append<void const*>(
+                        "bias", inputs.bias, KernelArgumentBinding::Bias);
                 }
                 else
                 {
@@ -701,7 +709,7 @@ namespace Tensile
 
         if(problemType.useE)
         {
-            args.template append<void*>("e", inputs.e);
+            args.template append<void*>("e", inputs.e, KernelArgumentBinding::E);
             for(size_t i = startStrideCD; i < e.dimensions(); i++)
                 args.template append<uint32_t>(concatenate_if<T_Debug>("strideE", i),
                                                e.strides()[i]);
@@ -819,6 +827,7 @@ namespace Tensile
         }
 
         rv.codeObjectFile = codeObjectFilename.load();
+        rv.handleCache    = kernelHandleCache.get();
 
         return rv;
     }
@@ -943,6 +952,7 @@ namespace Tensile
             rv.args.append<uint32_t>("skipWgTableGen", 0);
             kernelArgs<T_Debug>(rv.args);
             rv.codeObjectFile = codeObjectFilename.load();
+            rv.handleCache    = kernelHandleCache.get();
         }
 
         return rv;
@@ -989,12 +999,12 @@ namespace Tensile
         if(sizeMapping.globalAccumulation)
             rv.args.append<void*>("WS", inputs.ws);
         else if(problemType.stridedBatched)
-            rv.args.append<void*>("D", inputs.d);
+            rv.args.append<void*>("D", inputs.d, KernelArgumentBinding::D);
         else
             rv.args.append<void const* const*>("batchD", inputs.batchD);
 
         if(problemType.stridedBatched)
-            rv.args.append<void const*>("C", inputs.c);
+            rv.args.append<void const*>("C", inputs.c, KernelArgumentBinding::C);
         else
             rv.args.append<void const* const*>("batchC", inputs.batchC);
 
@@ -1003,29 +1013,31 @@ namespace Tensile
            && (!problemType.useGradient))
         {
             if(problemType.stridedBatched)
-                rv.args.append<void const*>("bias", inputs.bias);
+                rv.args.append<void const*>("bias", inputs.bias, KernelArgumentBinding::Bias);
             else
                 rv.args.append<void const* const*>("batchBias", inputs.batchBias);
         }
         if(problemType.useScaleAB && sizeMapping.globalAccumulation == 0)
         {
-            rv.args.append<void const*>("scaleA", inputs.scaleA);
-            rv.args.append<void const*>("scaleB", inputs.scaleB);
+            rv.args.append<void const*>("scaleA", inputs.scaleA, KernelArgumentBinding::ScaleA);
+            rv.args.append<void const*>("scaleB", inputs.scaleB, KernelArgumentBinding::ScaleB);
         }
         if(problemType.useScaleCD && sizeMapping.globalAccumulation == 0)
         {
-            rv.args.append<void const*>("scaleC", inputs.scaleC);
-            rv.args.append<void const*>("scaleD", inputs.scaleD);
+            rv.args.append<void const*>("scaleC", inputs.scaleC, KernelArgumentBinding::ScaleC);
+            rv.args.append<void const*>("scaleD", inputs.scaleD, KernelArgumentBinding::ScaleD);
         }
         if(problemType.useScaleDVec
            && (sizeMapping.globalAccumulation == 0 || (sizeMapping.customKernelName != "")))
         {
-            rv.args.append<void const*>("scaleDVec", inputs.scaleDVec);
+            rv.args.append<void const*>(
+                "scaleDVec", inputs.scaleDVec, KernelArgumentBinding::ScaleDVec);
         }
         if(problemType.useScaleAlphaVec
            && (sizeMapping.globalAccumulation == 0 || (sizeMapping.customKernelName != "")))
         {
-            rv.args.append<void const*>("scaleAlphaVec", inputs.scaleAlphaVec);
+            rv.args.append<void const*>(
+                "scaleAlphaVec", inputs.scaleAlphaVec, KernelArgumentBinding::ScaleAlphaVec);
         }
 
         if(sizeMapping.globalAccumulation)
@@ -1064,7 +1076,7 @@ namespace Tensile
             idx++;
         }
 
-        rv.args.append("beta", inputs.beta, problem.betaType());
+        rv.args.append("beta", inputs.beta, problem.betaType(), KernelArgumentBinding::Beta);
 
         //Pass along code object dependency
         rv.codeObjectFile = codeObjectFilename.load();
@@ -1137,20 +1149,20 @@ namespace Tensile
         if(problemType.useE)
         {
             if(problemType.stridedBatched)
-                args.template append<void*>("E", inputs.e);
+                args.template append<void*>("E", inputs.e, KernelArgumentBinding::E);
             else
                 args.template append<void const* const*>("batchE", 0);
         }
 
         if(problemType.stridedBatched)
-            args.template append<void*>("D", inputs.d);
+            args.template append<void*>("D", inputs.d, KernelArgumentBinding::D);
         else
             args.template append<void const* const*>("batchD", inputs.batchD);
 
         args.template append<void*>("WS", (uint8_t*)inputs.ws + workspaceOffsetInByte);
 
         if(problemType.stridedBatched)
-            args.template append<void const*>("C", inputs.c);
+            args.template append<void const*>("C", inputs.c, KernelArgumentBinding::C);
         else
             args.template append<void const* const*>("batchC", inputs.batchC);
 
@@ -1160,7 +1172,8 @@ namespace Tensile
             if(!problemType.useGradient)
             {
                 if(problemType.stridedBatched)
-                    args.template append<void const*>("bias", inputs.bias);
+                    args.template append<void const*>(
+                        "bias", inputs.bias, KernelArgumentBinding::Bias);
                 else
                     args.template append<void const* const*>("batchBias", inputs.batchBias);
                 useBias = true;
@@ -1173,7 +1186,9 @@ namespace Tensile
                        || it == ContractionProblemGemm::TENSOR::B)
                     {
                         if(problemType.stridedBatched)
-                            args.template append<void*>("bias", const_cast<void*>(inputs.bias));
+                            args.template append<void*>("bias",
+                                                        const_cast<void*>(inputs.bias),
+                                                        KernelArgumentBinding::Bias);
                         else
                             args.template append<void**>("batchBias",
                                                          const_cast<void**>(inputs.batchBias));
@@ -1186,30 +1201,36 @@ namespace Tensile
 
         if(problemType.useScaleAB) // GSU dep
         {
-            args.template append<void const*>("scaleA", inputs.scaleA);
-            args.template append<void const*>("scaleB", inputs.scaleB);
+            args.template append<void const*>(
+                "scaleA", inputs.scaleA, KernelArgumentBinding::ScaleA);
+            args.template append<void const*>(
+                "scaleB", inputs.scaleB, KernelArgumentBinding::ScaleB);
         }
         if(problemType.useScaleCD) // GSU dep
         {
-            args.template append<void const*>("scaleC", inputs.scaleC);
-            args.template append<void const*>("scaleD", inputs.scaleD);
+            args.template append<void const*>(
+                "scaleC", inputs.scaleC, KernelArgumentBinding::ScaleC);
+            args.template append<void const*>(
+                "scaleD", inputs.scaleD, KernelArgumentBinding::ScaleD);
         }
         if(problemType.useScaleDVec) // GSU dep
         {
-            args.template append<void const*>("scaleDVec", inputs.scaleDVec);
+            args.template append<void const*>(
+                "scaleDVec", inputs.scaleDVec, KernelArgumentBinding::ScaleDVec);
         }
         if(problemType.useScaleAlphaVec) // GSU dep
         {
-            args.template append<void const*>("scaleAlphaVec", inputs.scaleAlphaVec);
+            args.template append<void const*>(
+                "scaleAlphaVec", inputs.scaleAlphaVec, KernelArgumentBinding::ScaleAlphaVec);
         }
 
         if(sizeMapping.globalAccumulation == 2)
-            args.append("alpha", inputs.alpha, problem.alphaType());
+            args.append("alpha", inputs.alpha, problem.alphaType(), KernelArgumentBinding::Alpha);
         else
             args.append("alpha", 1.0f, problem.betaType());
 
         if(sizeMapping.globalAccumulation == 2 and problemType.useBeta)
-            args.append("beta", inputs.beta, problem.betaType());
+            args.append("beta", inputs.beta, problem.betaType(), KernelArgumentBinding::Beta);
         else
             args.append("beta", 0.0f, problem.betaType());
 
@@ -1672,7 +1693,7 @@ namespace Tensile
         rv.numWorkItems.z = rv.workGroupSize.z * rv.numWorkGroups.z;
 
         if(problemType.stridedBatched)
-            rv.args.append<void*>("D", inputs.d);
+            rv.args.append<void*>("D", inputs.d, KernelArgumentBinding::D);
         else
             rv.args.append<void const* const*>("batchD", inputs.batchD);
 
@@ -1808,7 +1829,7 @@ namespace Tensile
 
         // FIXME: Need to check the formula for batch > 1
         rv.args.append<void*>("WS", inputs.ws);
-        rv.args.append<void const*>("bias", inputs.bias);
+        rv.args.append<void const*>("bias", inputs.bias, KernelArgumentBinding::Bias);
         for(size_t i = 0; i < 2; i++)
         {
             rv.args.append<uint32_t>(concatenate_if<T_Debug>("size_", i), problem.d().sizes()[i]);
@@ -2026,6 +2047,220 @@ namespace Tensile
         return rv;
     }
 
+    bool ContractionSolution::canUpdateInputs(Problem const& problem,
+                                              Inputs const&  previous,
+                                              Inputs const&  inputs) const
+    {
+        // The workspace layout, batched pointer arrays and activation
+        // arguments are part of what solve() builds, not rebindable inputs.
+        if(inputs.ws != previous.ws || inputs.batchA != previous.batchA
+           || inputs.batchB != previous.batchB || inputs.batchC != previous.batchC
+           || inputs.batchD != previous.batchD || inputs.batchBias != previous.batchBias
+           || inputs.metadata != previous.metadata
+           || inputs.activationArgs != previous.activationArgs)
+            return false;
+
+        // Null pointers select different kernels or arguments in solve().
+        auto sameNullness = [](void const* lhs, void const* rhs) {
+            return (lhs == nullptr) == (rhs == nullptr);
+        };
+        if(!sameNullness(inputs.a, previous.a) || !sameNullness(inputs.b, previous.b)
+           || !sameNullness(inputs.c, previous.c) || !sameNullness(inputs.d, previous.d)
+           || !sameNullness(inputs.e, previous.e) || !sameNullness(inputs.bias, previous.bias)
+           || !sameNullness(inputs.scaleA, previous.scaleA)
+           || !sameNullness(inputs.scaleB, previous.scaleB)
+           || !sameNullness(inputs.scaleC, previous.scaleC)
+           || !sameNullness(inputs.scaleD, previous.scaleD)
+           || !sameNullness(inputs.scaleAlphaVec, previous.scaleAlphaVec)
+           || !sameNullness(inputs.scaleDVec, previous.scaleDVec))
+            return false;
+
+        // Leave the checks solve() makes on the new values to solve().
+        if(inputs.alpha.index() != previous.alpha.index()
+           || inputs.beta.index() != previous.beta.index())
+            return false;
+
+        if(problem.alphaRestriction() != ScalarValue::Any
+           && problem.alphaRestriction() != toScalarValueEnum(inputs.alpha))
+            return false;
+
+        if(problem.betaRestriction() != ScalarValue::Any
+           && problem.betaRestriction() != toScalarValueEnum(inputs.beta))
+            return false;
+
+        if(problem.cEqualsD() && inputs.c != inputs.d)
+            return false;
+
+        if((inputs.a == nullptr || inputs.b == nullptr) && !CompareValue(inputs.alpha, (double)0))
+            return false;
+
+        return true;
+    }
+
+    bool ContractionSolution::updateInputs(std::vector<KernelInvocation>& kernels,
+                                           Problem const&                 problem,
+                                           Inputs const&                  previous,
+                                           Inputs const&                  inputs) const
+    {
+        if(!canUpdateInputs(problem, previous, inputs))
+            return false;
+
+        for(auto& kernel : kernels)
+        {
+            auto& args = kernel.args;
+            args.rebind(KernelArgumentBinding::A, inputs.a);
+            args.rebind(KernelArgumentBinding::B, inputs.b);
+            args.rebind(KernelArgumentBinding::C, inputs.c);
+            args.rebind(KernelArgumentBinding::D, inputs.d);
+            args.rebind(KernelArgumentBinding::E, inputs.e);
+            args.rebind(KernelArgumentBinding::Bias, inputs.bias);
+            args.rebind(KernelArgumentBinding::ScaleA, inputs.scaleA);
+            args.rebind(KernelArgumentBinding::ScaleB, inputs.scaleB);
+            args.rebind(KernelArgumentBinding::ScaleC, inputs.scaleC);
+            args.rebind(KernelArgumentBinding::ScaleD, inputs.scaleD);
+            args.rebind(KernelArgumentBinding::ScaleAlphaVec, inputs.scaleAlphaVec);
+            args.rebind(KernelArgumentBinding::ScaleDVec, inputs.scaleDVec);
+            args.rebind(KernelArgumentBinding::Alpha, inputs.alpha);
+            args.rebind(KernelArgumentBinding::Beta, inputs.beta);
+        }
+
+        return true;
+    }
+
+    bool ContractionSolution::updateGroupedGemmInputs(std::vector<Problem> const& problems,
+                                                      GroupedInputs const&        previous,
+                                                      GroupedInputs const&        inputs,
+                                                      hip::ArgumentRing&          argumentRing,
+                                                      hipStream_t                 stream,
+                                                      std::vector<size_t>&        updated) const
+    {
+        updated.clear();
+
+        if(inputs.ws != previous.ws || inputs.grouped.size() != problems.size()
+           || previous.grouped.size() != problems.size())
+            return false;
+
+        auto sameValue = [](ConstantVariant const& lhs, ConstantVariant const& rhs) {
+            return lhs.index() == rhs.index() && std::visit(
+                       [&rhs](auto const& value) {
+                           auto const& other = std::get<std::decay_t<decltype(value)>>(rhs);
+                           return memcmp(&value, &other, sizeof(value)) == 0;
+                       },
+                       lhs);
+        };
+
+        for(size_t idx = 0; idx < problems.size(); idx++)
+        {
+            auto const& before = previous.grouped[idx];
+            auto const& after  = inputs.grouped[idx];
+            if(after.ws != before.ws || !canUpdateInputs(problems[idx], before, after))
+                return false;
+
+            if(after.a != before.a || after.b != before.b || after.c != before.c
+               || after.d != before.d || after.e != before.e || after.bias != before.bias
+               || after.scaleA != before.scaleA || after.scaleB != before.scaleB
+               || after.scaleC != before.scaleC || after.scaleD != before.scaleD
+               || after.scaleAlphaVec != before.scaleAlphaVec || after.scaleDVec != before.scaleDVec
+               || !sameValue(after.alpha, before.alpha) || !sameValue(after.beta, before.beta))
+                updated.push_back(idx);
+        }
+
+        if(updated.empty())
+            return true;
+
+        // The buffer holds a uint32_t per gemm followed by the arguments of
+        // each gemm in turn, and then the same again for the output conversion
+        // kernel. The entries are located from the sizes of the ones before
+        // them, which only depend on the problems.
+        struct Entry
+        {
+            size_t   offset;
+            size_t   size;
+            size_t   gemm;
+            uint32_t workspaceOffsetInByte;
+            bool     conversion;
+        };
+        std::vector<Entry> entries;
+        size_t             totalSize = 0;
+
+        bool   conversion = (sizeMapping.customKernelName == "") && sizeMapping.globalAccumulation;
+        size_t offset     = 0;
+        for(int pass = 0; pass < (conversion ? 2 : 1); pass++)
+        {
+            offset += problems.size() * sizeof(uint32_t);
+
+            uint32_t workspaceOffsetInByte
+                = this->requiredHostWorkspaceSizePerProblem * problems.size();
+            auto next = updated.begin();
+            for(size_t idx = 0; idx < problems.size(); idx++)
+            {
+                auto counter = KernelArgumentsCounter();
+                if(pass == 0)
+                    singleCallArgs<false, false>(
+                        problems[idx], inputs.grouped[idx], workspaceOffsetInByte, counter);
+                else
+                    outputConversionCallArgs<false>(
+                        problems[idx], inputs.grouped[idx], workspaceOffsetInByte, counter);
+
+                if(next != updated.end() && *next == idx)
+                {
+                    entries.push_back(
+                        {offset, counter.size(), idx, workspaceOffsetInByte, pass == 1});
+                    totalSize += counter.size();
+                    next++;
+                }
+
+                offset += counter.size();
+                workspaceOffsetInByte += requiredWorkspaceSize(problems[idx]);
+            }
+        }
+
+        auto     slot   = argumentRing.acquire(totalSize);
+        uint8_t* host   = static_cast<uint8_t*>(slot.data());
+        uint8_t* d_args = (uint8_t*)inputs.ws;
+
+        // Entries of neighbouring gemms are copied together.
+        size_t copyOffset = 0;
+        size_t copySize   = 0;
+        auto   flush      = [&]() {
+            if(copySize)
+                HIP_CHECK_EXC(hipMemcpyAsync(d_args + copyOffset,
+                                             host - copySize,
+                                             copySize,
+                                             hipMemcpyHostToDevice,
+                                             stream));
+        };
+
+        for(auto const& entry : entries)
+        {
+            auto args = KernelArguments(false);
+            args.useExternalPointer(host, entry.size);
+            auto const& problem = problems[entry.gemm];
+            if(entry.conversion)
+                outputConversionCallArgs<false>(
+                    problem, inputs.grouped[entry.gemm], entry.workspaceOffsetInByte, args);
+            else
+                singleCallArgs<false, false>(
+                    problem, inputs.grouped[entry.gemm], entry.workspaceOffsetInByte, args);
+
+            if(args.size() != entry.size)
+                throw std::runtime_error("Grouped gemm arguments changed size.");
+
+            if(copyOffset + copySize != entry.offset)
+            {
+                flush();
+                copyOffset = entry.offset;
+                copySize   = 0;
+            }
+            host += entry.size;
+            copySize += entry.size;
+        }
+        flush();
+        slot.fence(stream);
+
+        return true;
+    }
+
     std::vector<KernelInvocation> ContractionSolution::solveGroupedGemm(
         std::vector<ContractionSolution::Problem> const& problems,
         ContractionSolution::GroupedInputs const&        inputs,
@@ -2034,6 +2269,16 @@ namespace Tensile
         size_t                                           hipHostMemorySize,
         hipStream_t                                      stream) const
     {
+        // Staging the arguments in pageable memory would make the copy below
+        // synchronous, so borrow a pinned slot instead.
+        if(!hipHostMemory)
+        {
+            int device;
+            HIP_CHECK_EXC(hipGetDevice(&device));
+            return solveGroupedGemm(
+                problems, inputs, hardware, hip::ArgumentRing::ForDevice(device), stream);
+        }
+
         if(Debug::Instance().printWinningKernelName())
             std::cout << "Running kernel: " << this->KernelName() << std::endl;
 
@@ -2112,10 +2357,7 @@ namespace Tensile
 
         std::vector<KernelInvocation> rv;
         auto                          h_args = KernelArguments(debug);
-        if(hipHostMemory)
-        {
-            h_args.useExternalPointer(hipHostMemory, hipHostMemorySize);
-        }
+        h_args.useExternalPointer(hipHostMemory, hipHostMemorySize);
         h_args.reserve(32768, 8192);
 
         // if(sizeMapping.globalSplitU > 1 && sizeMapping.globalAccumulation != 2)
@@ -2151,13 +2393,30 @@ namespace Tensile
             std::cout << h_args;
         }
 
-        if(hipHostMemory && hipHostMemorySize < h_args.size())
+        if(hipHostMemorySize < h_args.size())
             throw std::runtime_error("Insufficient host memory size.");
 
-        uint8_t*    d_args = (uint8_t*)inputs.ws;
-        const void* tmpMem = hipHostMemory ? hipHostMemory : h_args.data();
+        uint8_t* d_args = (uint8_t*)inputs.ws;
         HIP_CHECK_EXC(hipMemcpyAsync(
-            d_args, tmpMem, h_args.size() * sizeof(uint8_t), hipMemcpyHostToDevice, stream));
+            d_args, hipHostMemory, h_args.size() * sizeof(uint8_t), hipMemcpyHostToDevice, stream));
+
+        return rv;
+    }
+
+    std::vector<KernelInvocation>
+        ContractionSolution::solveGroupedGemm(std::vector<Problem> const& problems,
+                                              GroupedInputs const&        inputs,
+                                              Hardware const&             hardware,
+                                              hip::ArgumentRing&          argumentRing,
+                                              hipStream_t                 stream) const
+    {
+        size_t sizePerProblem = requiredHostWorkspaceSizePerProblem;
+        if(sizePerProblem == static_cast<size_t>(-1))
+            sizePerProblem = requiredHostSizeGroupedGemmSingle(problems[0]);
+
+        auto slot = argumentRing.acquire(sizePerProblem * problems.size());
+        auto rv   = solveGroupedGemm(problems, inputs, hardware, slot.data(), slot.size(), stream);
+        slot.fence(stream);
 
         return rv;
     }
@@ -2320,6 +2579,26 @@ namespace Tensile
         return size;
     }
 
+    bool ContractionSolution::fitsSelectionLimits(Problem const& problem) const
+    {
+        if(!problem.groupedGemm() && requiredWorkspaceSize(problem) > problem.workspaceSize())
+            return false;
+
+        if(std::max<size_t>(sizeMapping.globalSplitU, 1) > problem.maxGlobalSplitU())
+            return false;
+
+        for(auto tensor : {ContractionProblemGemm::TENSOR::A,
+                           ContractionProblemGemm::TENSOR::B,
+                           ContractionProblemGemm::TENSOR::C,
+                           ContractionProblemGemm::TENSOR::D})
+        {
+            if(sizeMapping.alignmentBytes[tensor] > problem.minAlignmentBytes(tensor))
+                return false;
+        }
+
+        return true;
+    }
+
     size_t ContractionSolution::requiredWorkspaceSizeGroupedGemm(
         std::vector<Problem> const& problems) const
     {
@@ -2440,13 +2719,11 @@ namespace Tensile
         return granularities;
     }
 
-    ContractionSolution::ProjectedPerformance
-        ContractionSolution::projectedPerformance(Problem const&  problem,
-                                                  Hardware const& hardware) const
+    void ContractionSolution::modelSizes(
+        Problem const& problem, double& M, double& N, double& K, double& NumBatches) const
     {
-        ProjectedPerformance pp;
-
-        double M = 1.0, N = 1.0;
+        M = 1.0;
+        N = 1.0;
         if(problem.freeIndicesA().size() > 1 || sizeMapping.packBatchDims & 0x1)
         {
             std::vector<size_t> packedIndices
@@ -2467,13 +2744,23 @@ namespace Tensile
         else
             N = problem.freeSizeB(0);
 
-        double NumBatches = 1;
+        NumBatches = 1;
         if(sizeMapping.packBatchDims == 0)
         {
             for(size_t i = 0; i < problem.batchIndices().size(); i++)
                 NumBatches *= problem.batchSize(i);
         }
-        double K = problem.boundSize(0); // TODO - fix for multiple summations
+        K = problem.boundSize(0); // TODO - fix for multiple summations
+    }
+
+    ContractionSolution::ProjectedPerformance
+        ContractionSolution::projectedPerformance(Problem const&  problem,
+                                                  Hardware const& hardware) const
+    {
+        ProjectedPerformance pp;
+
+        double M, N, K, NumBatches;
+        modelSizes(problem, M, N, K, NumBatches);
 
         pp.granularities = ContractionSolution::computeGranularities(hardware, M, N, K, NumBatches);
 
@@ -2510,6 +2797,76 @@ namespace Tensile
         return pp;
     }
 
+    ContractionSolution::RooflineCalibration
+        ContractionSolution::RooflineCalibration::resolve(Hardware const& hardware) const
+    {
+        RooflineCalibration rv = *this;
+
+        AMDGPU const* pAMDGPU = dynamic_cast<AMDGPU const*>(&hardware);
+        if(pAMDGPU != nullptr)
+        {
+            if(rv.memoryBandwidth <= 0.0)
+                rv.memoryBandwidth = pAMDGPU->memoryBandwidth;
+            if(rv.clockMHz <= 0.0)
+                rv.clockMHz = pAMDGPU->clockMHz;
+        }
+
+        return rv;
+    }
+
+    ContractionSolution::ProjectedPerformance
+        ContractionSolution::rooflinePerformance(Problem const&             problem,
+                                                 Hardware const&            hardware,
+                                                 RooflineCalibration const& calibration) const
+    {
+        ProjectedPerformance pp;
+
+        double M, N, K, NumBatches;
+        modelSizes(problem, M, N, K, NumBatches);
+
+        pp.granularities = ContractionSolution::computeGranularities(hardware, M, N, K, NumBatches);
+
+        double MT0          = pp.granularities.MT0;
+        double MT1          = pp.granularities.MT1;
+        double NumCUs       = pp.granularities.CUs;
+        double GlobalSplitU = std::max(pp.granularities.GSU, 1.0);
+
+        pp.staticModel = staticPerformanceModel(
+            M, N, K, NumBatches, MT0, MT1, NumCUs, pp.granularities.totalGranularity, GlobalSplitU);
+        pp.CUs = NumCUs;
+
+        double flops = 2.0 * M * N * K * NumBatches;
+        if(flops == 0.0 || pp.granularities.totalGranularity <= 0.0 || !calibration.complete())
+            return pp;
+
+        // Tile and CU granularity loss leave part of the machine idle, which
+        // lowers the compute roof and, once there are fewer tiles than CUs,
+        // also the bandwidth that the active CUs can pull.
+        double peakFlops   = NumCUs * calibration.flopsPerCuPerCycle * calibration.clockMHz
+                           * 1.0e6 * calibration.computeEfficiency;
+        double computeTime = flops / (peakFlops * pp.granularities.totalGranularity);
+
+        double bytes   = pp.staticModel.memReadBytes + pp.staticModel.memWriteBytesD;
+        double kernels = 1.0;
+        if(GlobalSplitU > 1 && sizeMapping.globalAccumulation)
+        {
+            // Partial results go through the workspace and a separate
+            // reduction kernel instead of atomics.
+            bytes += 2.0 * problem.d().totalLogicalElements() * sizeMapping.workspaceSizePerElemC;
+            kernels += 1.0;
+        }
+        double bandwidth  = calibration.memoryBandwidth * 1.0e9 * calibration.memoryEfficiency
+                           * std::min(1.0, pp.granularities.tilesPerCu);
+        double memoryTime = bytes / bandwidth;
+
+        double time = std::max(computeTime, memoryTime)
+                      + kernels * calibration.launchOverhead * 1.0e-6;
+
+        pp.speedGFlops = flops / time * 1.0e-9;
+
+        return pp;
+    }
+
     ContractionSolution::TAMetricProblemScore ContractionSolution::computeProblemScore(
         Hardware const& hardware, double M, double N, double K, double NumBatches) const
     {
@@ -2577,34 +2934,8 @@ namespace Tensile
                                                 double          model_K,
                                                 double          model_NumBatches) const
     {
-        double M = 1.0, N = 1.0;
-        if(problem.freeIndicesA().size() > 1 || sizeMapping.packBatchDims & 0x1)
-        {
-            std::vector<size_t> packedIndices
-                = generatePackedIndicesA(problem, sizeMapping.packBatchDims);
-            for(auto pi = packedIndices.begin(); pi != packedIndices.end(); pi++)
-                M *= problem.a().sizes()[*pi];
-        }
-        else
-            M = problem.freeSizeA(0);
-
-        if(problem.freeIndicesB().size() > 1 || sizeMapping.packBatchDims & 0x2)
-        {
-            std::vector<size_t> packedIndices
-                = generatePackedIndicesB(problem, sizeMapping.packBatchDims);
-            for(auto pi = packedIndices.begin(); pi != packedIndices.end(); pi++)
-                N *= problem.b().sizes()[*pi];
-        }
-        else
-            N = problem.freeSizeB(0);
-
-        double NumBatches = 1;
-        if(sizeMapping.packBatchDims == 0)
-        {
-            for(size_t i = 0; i < problem.batchIndices().size(); i++)
-                NumBatches *= problem.batchSize(i);
-        }
-        double K = problem.boundSize(0); // TODO - fix for multiple summations
+        double M, N, K, NumBatches;
+        modelSizes(problem, M, N, K, NumBatches);
 
         ContractionSolution::TAMetricProblemScore pp
             = computeProblemScore(hardware, M, N, K, NumBatches);
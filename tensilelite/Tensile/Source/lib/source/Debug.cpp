@@ -145,6 +145,16 @@ namespace Tensile
         return m_gridbasedTopSols;
     }
 
+    size_t Debug::getSolutionCacheCapacity() const
+    {
+        return m_solutionCacheCapacity;
+    }
+
+    bool Debug::compilePredicates() const
+    {
+        return m_compilePredicates;
+    }
+
     Debug::Debug()
         : m_value(DEBUG_SM)
         , m_value2(DEBUG_SM2)
@@ -184,6 +194,14 @@ namespace Tensile
         const char* tensile_benchmark = std::getenv("TENSILE_BENCHMARK");
         if(tensile_benchmark)
             m_benchmark = strtol(tensile_benchmark, nullptr, 0) != 0;
+
+        const char* solution_cache_size = std::getenv("TENSILE_SOLUTION_CACHE_SIZE");
+        if(solution_cache_size)
+            m_solutionCacheCapacity = strtoull(solution_cache_size, nullptr, 0);
+
+        const char* compile_predicates = std::getenv("TENSILE_COMPILE_PREDICATES");
+        if(compile_predicates)
+            m_compilePredicates = strtol(compile_predicates, nullptr, 0) != 0;
     }
 
 } // namespace Tensile
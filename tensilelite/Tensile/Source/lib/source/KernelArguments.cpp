@@ -112,6 +112,61 @@ namespace Tensile
         return true;
     }
 
+    bool KernelArguments::rebind(KernelArgumentBinding binding, void const* pointer)
+    {
+        bool found = false;
+        for(auto const& arg : m_boundArgs)
+        {
+            if(arg.binding != binding)
+                continue;
+
+            if(arg.type != DataType::None)
+                throw std::runtime_error("Rebinding a scalar argument with a pointer.");
+
+            writeValue(arg.offset, pointer);
+            found = true;
+        }
+
+        return found;
+    }
+
+    bool KernelArguments::rebind(KernelArgumentBinding binding, ConstantVariant const& value)
+    {
+        bool found = false;
+        for(auto const& arg : m_boundArgs)
+        {
+            if(arg.binding != binding)
+                continue;
+
+            switch(arg.type)
+            {
+            case DataType::Float:
+                writeValue(arg.offset, *std::get_if<float>(&value));
+                break;
+            case DataType::Double:
+                writeValue(arg.offset, *std::get_if<double>(&value));
+                break;
+            case DataType::Half:
+                writeValue(arg.offset, *std::get_if<Half>(&value));
+                break;
+            case DataType::Int32:
+                writeValue(arg.offset, *std::get_if<int32_t>(&value));
+                break;
+            case DataType::BFloat16:
+                writeValue(arg.offset, *std::get_if<BFloat16>(&value));
+                break;
+            case DataType::Int8:
+                writeValue(arg.offset, *std::get_if<int8_t>(&value));
+                break;
+            default:
+                throw std::runtime_error("Unsupported ConstantVariant rebind type.");
+            }
+            found = true;
+        }
+
+        return found;
+    }
+
     void const* KernelArguments::data() const
     {
         if(!isFullyBound())
@@ -0,0 +1,342 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <Tensile/PersistentSolutionCache.hpp>
+
+#include <Tensile/Comparison.hpp>
+#include <Tensile/Debug.hpp>
+#include <Tensile/Utils.hpp>
+
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+namespace Tensile
+{
+    namespace
+    {
+        // Bump when the layout below changes.
+        constexpr char Magic[8] = {'T', 'N', 'S', 'L', 'S', 'C', '0', '1'};
+
+        // File layout: Header, Header::recordCount records sorted by key, then
+        // Header::indexCount int32_t solution indices.
+        struct Header
+        {
+            char     magic[8];
+            uint64_t libraryKey;
+            uint64_t recordCount;
+            uint64_t indexCount;
+        };
+
+        using Entries = std::map<uint64_t, std::vector<int>>;
+
+        int processId()
+        {
+#ifdef _WIN32
+            return _getpid();
+#else
+            return getpid();
+#endif
+        }
+
+        template <typename Record>
+        bool readFile(std::string const&    filename,
+                      uint64_t              libraryKey,
+                      std::vector<Record>&  records,
+                      std::vector<int32_t>& indices)
+        {
+            std::ifstream in(filename, std::ios::in | std::ios::binary);
+            if(!in)
+                return false;
+
+            in.seekg(0, std::ios::end);
+            auto fileSize = in.tellg();
+            in.seekg(0, std::ios::beg);
+            if(fileSize < std::streamoff(sizeof(Header)))
+                return false;
+
+            Header header;
+            if(!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+                return false;
+
+            if(memcmp(header.magic, Magic, sizeof(Magic)) != 0
+               || header.libraryKey != libraryKey)
+                return false;
+
+            // The counts must describe exactly the rest of the file, so that a
+            // truncated or corrupt file is rejected before anything is allocated.
+            uint64_t payload = uint64_t(fileSize) - sizeof(Header);
+            if(header.recordCount > payload / sizeof(Record))
+                return false;
+            uint64_t indexBytes = payload - header.recordCount * sizeof(Record);
+            if(indexBytes % sizeof(int32_t) != 0
+               || header.indexCount != indexBytes / sizeof(int32_t))
+                return false;
+
+            std::vector<Record>  newRecords(header.recordCount);
+            std::vector<int32_t> newIndices(header.indexCount);
+
+            in.read(reinterpret_cast<char*>(newRecords.data()),
+                    newRecords.size() * sizeof(Record));
+            in.read(reinterpret_cast<char*>(newIndices.data()),
+                    newIndices.size() * sizeof(int32_t));
+            if(!in)
+                return false;
+
+            for(auto const& record : newRecords)
+            {
+                if(uint64_t(record.offset) + record.count > newIndices.size())
+                    return false;
+            }
+
+            records = std::move(newRecords);
+            indices = std::move(newIndices);
+            return true;
+        }
+
+        template <typename Record>
+        void collect(Entries&                    entries,
+                     std::vector<Record> const&  records,
+                     std::vector<int32_t> const& indices)
+        {
+            for(auto const& record : records)
+            {
+                auto begin = indices.begin() + record.offset;
+                entries[record.key].assign(begin, begin + record.count);
+            }
+        }
+    } // namespace
+
+    PersistentSolutionCache::PersistentSolutionCache(std::string const& cacheFile,
+                                                     std::string const& libraryFile,
+                                                     std::string const& version)
+        : m_cacheFile(cacheFile)
+        , m_libraryKey(LibraryKey(libraryFile, version))
+    {
+        read();
+    }
+
+    PersistentSolutionCache::~PersistentSolutionCache()
+    {
+        flush();
+    }
+
+    uint64_t PersistentSolutionCache::LibraryKey(std::string const& libraryFile,
+                                                 std::string const& version)
+    {
+        // Problem keys are std::hash values, so the hash implementation is
+        // part of what the stored entries depend on.
+        size_t rv = hash_combine(version, std::string("TensilePersistentSolutionCache"));
+
+        auto addFile = [&rv](std::string const& name, std::string const& path) {
+            struct stat info;
+            if(stat(path.c_str(), &info) == 0)
+                rv = hash_combine(rv, name, int64_t(info.st_size), int64_t(info.st_mtime));
+        };
+        addFile(libraryFile, libraryFile);
+
+#ifndef _WIN32
+        // Lazily loaded sub-libraries are separate files next to the library,
+        // named after it and with the same extension, and the indices refer
+        // to their solutions as well.
+        size_t      slash     = libraryFile.rfind('/');
+        std::string directory = slash == std::string::npos ? "." : libraryFile.substr(0, slash);
+        std::string base = slash == std::string::npos ? libraryFile : libraryFile.substr(slash + 1);
+        size_t      dot  = base.rfind('.');
+        if(dot != std::string::npos)
+        {
+            std::string prefix    = base.substr(0, dot);
+            std::string extension = base.substr(dot);
+
+            std::vector<std::string> names;
+            if(DIR* dir = opendir(directory.c_str()))
+            {
+                while(dirent* entry = readdir(dir))
+                {
+                    std::string name(entry->d_name);
+                    if(name != base && name.size() > prefix.size() + extension.size()
+                       && name.compare(0, prefix.size(), prefix) == 0
+                       && name.compare(name.size() - extension.size(), extension.size(), extension)
+                              == 0)
+                        names.push_back(name);
+                }
+                closedir(dir);
+            }
+
+            std::sort(names.begin(), names.end());
+            for(auto const& name : names)
+                addFile(name, directory + "/" + name);
+        }
+#endif
+
+        return rv;
+    }
+
+    void PersistentSolutionCache::read()
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+
+        if(!readFile(m_cacheFile, m_libraryKey, m_records, m_indices))
+        {
+            m_records.clear();
+            m_indices.clear();
+        }
+
+        if(Debug::Instance().printLookupEfficiency())
+            std::cout << "PersistentSolutionCache: read " << m_records.size() << " entries from "
+                      << m_cacheFile << std::endl;
+    }
+
+    PersistentSolutionCache::Record const* PersistentSolutionCache::findRecord(uint64_t key) const
+    {
+        auto iter = std::lower_bound(m_records.begin(),
+                                     m_records.end(),
+                                     key,
+                                     [](Record const& record, uint64_t key) {
+                                         return record.key < key;
+                                     });
+
+        if(iter == m_records.end() || iter->key != key)
+            return nullptr;
+
+        return &*iter;
+    }
+
+    bool PersistentSolutionCache::find(uint64_t key, std::vector<int>& indices) const
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+
+        if(auto record = findRecord(key))
+        {
+            auto begin = m_indices.begin() + record->offset;
+            indices.assign(begin, begin + record->count);
+            return true;
+        }
+
+        auto iter = m_pending.find(key);
+        if(iter == m_pending.end())
+            return false;
+
+        indices = iter->second;
+        return true;
+    }
+
+    void PersistentSolutionCache::add(uint64_t key, std::vector<int> const& indices)
+    {
+        if(indices.empty())
+            return;
+
+        std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+
+        if(findRecord(key))
+            return;
+
+        m_pending.emplace(key, indices);
+    }
+
+    size_t PersistentSolutionCache::size() const
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+
+        return m_records.size() + m_pending.size();
+    }
+
+    bool PersistentSolutionCache::flush()
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+
+        if(m_pending.empty())
+            return true;
+
+        // Pick up whatever other processes have written since we read the file.
+        Entries              entries;
+        std::vector<Record>  diskRecords;
+        std::vector<int32_t> diskIndices;
+        if(readFile(m_cacheFile, m_libraryKey, diskRecords, diskIndices))
+            collect(entries, diskRecords, diskIndices);
+        collect(entries, m_records, m_indices);
+        for(auto const& pending : m_pending)
+            entries[pending.first] = pending.second;
+
+        std::vector<Record>  records;
+        std::vector<int32_t> indices;
+        records.reserve(entries.size());
+        for(auto const& entry : entries)
+        {
+            records.push_back(
+                {entry.first, uint32_t(indices.size()), uint32_t(entry.second.size())});
+            indices.insert(indices.end(), entry.second.begin(), entry.second.end());
+        }
+
+        Header header;
+        memcpy(header.magic, Magic, sizeof(Magic));
+        header.libraryKey  = m_libraryKey;
+        header.recordCount = records.size();
+        header.indexCount  = indices.size();
+
+        // Write to a temporary file and rename it over the old one so that
+        // readers never see a partially written cache.
+        std::string tmpFile = concatenate(m_cacheFile, ".", processId(), ".tmp");
+        {
+            std::ofstream out(tmpFile, std::ios::out | std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+            out.write(reinterpret_cast<char const*>(records.data()),
+                      records.size() * sizeof(Record));
+            out.write(reinterpret_cast<char const*>(indices.data()),
+                      indices.size() * sizeof(int32_t));
+            if(!out)
+            {
+                out.close();
+                std::remove(tmpFile.c_str());
+                return false;
+            }
+        }
+
+        if(std::rename(tmpFile.c_str(), m_cacheFile.c_str()) != 0)
+        {
+            std::remove(tmpFile.c_str());
+            return false;
+        }
+
+        m_records = std::move(records);
+        m_indices = std::move(indices);
+        m_pending.clear();
+
+        return true;
+    }
+} // namespace Tensile
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <Tensile/SpatialIndex.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace Tensile
+{
+    namespace Matching
+    {
+        void KdTree::build(std::vector<double> points, size_t dims)
+        {
+            if(dims == 0 || dims > 255 || points.size() % dims != 0)
+                throw std::invalid_argument("KdTree: invalid point dimensions.");
+
+            m_dims   = dims;
+            m_points = std::move(points);
+
+            m_order.resize(m_points.size() / m_dims);
+            std::iota(m_order.begin(), m_order.end(), 0);
+            m_axes.assign(m_order.size(), 0);
+
+            buildRange(0, m_order.size());
+
+            // Store the points in tree order so that a search reads them
+            // front to back rather than all over the place.
+            std::vector<double> ordered(m_points.size());
+            for(size_t i = 0; i < m_order.size(); i++)
+            {
+                std::copy_n(
+                    m_points.begin() + m_order[i] * m_dims, m_dims, ordered.begin() + i * m_dims);
+            }
+            m_points = std::move(ordered);
+        }
+
+        void KdTree::buildRange(size_t begin, size_t end)
+        {
+            if(end - begin <= LeafSize)
+                return;
+
+            // Tuned sizes are gridded much more densely in some dimensions
+            // than in others, so split where the points are most spread out.
+            size_t axis   = 0;
+            double spread = -1.0;
+            for(size_t d = 0; d < m_dims; d++)
+            {
+                auto bounds = std::minmax_element(
+                    m_order.begin() + begin,
+                    m_order.begin() + end,
+                    [&](uint32_t a, uint32_t b) { return coordinate(a, d) < coordinate(b, d); });
+
+                double mySpread = coordinate(*bounds.second, d) - coordinate(*bounds.first, d);
+                if(mySpread > spread)
+                {
+                    spread = mySpread;
+                    axis   = d;
+                }
+            }
+
+            size_t mid = begin + (end - begin) / 2;
+            std::nth_element(
+                m_order.begin() + begin,
+                m_order.begin() + mid,
+                m_order.begin() + end,
+                [&](uint32_t a, uint32_t b) { return coordinate(a, axis) < coordinate(b, axis); });
+            m_axes[mid] = axis;
+
+            buildRange(begin, mid);
+            buildRange(mid + 1, end);
+        }
+
+        size_t KdTree::nearest(double const*          query,
+                               size_t                 k,
+                               std::vector<Neighbor>& neighbors) const
+        {
+            neighbors.clear();
+
+            size_t visited = 0;
+            if(k == 0 || m_order.empty())
+                return visited;
+
+            neighbors.reserve(std::min(k, m_order.size()));
+            search(query, 0, m_order.size(), k, neighbors, visited);
+
+            return visited;
+        }
+
+        void KdTree::offer(double const*          query,
+                           size_t                 node,
+                           size_t                 k,
+                           std::vector<Neighbor>& nearest) const
+        {
+            double const* coords   = &m_points[node * m_dims];
+            double        distance = 0.0;
+            for(size_t d = 0; d < m_dims; d++)
+            {
+                double delta = query[d] - coords[d];
+                distance += delta * delta;
+            }
+
+            // Ties go to the lower index, so that the result does not depend
+            // on the shape of the tree.
+            Neighbor neighbor(distance, m_order[node]);
+            if(nearest.size() == k)
+            {
+                if(!(neighbor < nearest.back()))
+                    return;
+                nearest.pop_back();
+            }
+
+            // k is small, so an insertion into the sorted list beats a heap.
+            nearest.insert(std::upper_bound(nearest.begin(), nearest.end(), neighbor), neighbor);
+        }
+
+        void KdTree::search(double const*          query,
+                            size_t                 begin,
+                            size_t                 end,
+                            size_t                 k,
+                            std::vector<Neighbor>& nearest,
+                            size_t&                visited) const
+        {
+            // Small ranges are scanned rather than split further, which is
+            // cheaper than the branching of a descent this close to the leaves.
+            if(end - begin <= LeafSize)
+            {
+                for(size_t i = begin; i < end; i++)
+                    offer(query, i, k, nearest);
+                visited += end - begin;
+                return;
+            }
+
+            size_t mid = begin + (end - begin) / 2;
+            offer(query, mid, k, nearest);
+            visited++;
+
+            double const* coords = &m_points[mid * m_dims];
+
+            size_t axis  = m_axes[mid];
+            double delta = query[axis] - coords[axis];
+
+            bool leftFirst = delta < 0.0;
+            if(leftFirst)
+                search(query, begin, mid, k, nearest, visited);
+            else
+                search(query, mid + 1, end, k, nearest, visited);
+
+            // The other side can only hold nearer points if the splitting
+            // plane is not further than the current k-th neighbour, which a
+            // point on the plane with a lower index would still replace.
+            if(nearest.size() < k || delta * delta <= nearest.back().first)
+            {
+                if(leftFirst)
+                    search(query, mid + 1, end, k, nearest, visited);
+                else
+                    search(query, begin, mid, k, nearest, visited);
+            }
+        }
+    } // namespace Matching
+} // namespace Tensile
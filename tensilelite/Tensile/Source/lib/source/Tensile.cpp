@@ -29,7 +29,13 @@
 #include <Tensile/ContractionProblem.hpp>
 #include <Tensile/ContractionSolution.hpp>
 
+#include <iostream>
+#include <mutex>
+#include <vector>
+
 #ifdef TENSILE_DEFAULT_SERIALIZATION
+#include <Tensile/flat/Loading.hpp>
+
 #ifdef TENSILE_YAML
 #include <Tensile/llvm/Loading.hpp>
 #endif
@@ -46,7 +52,63 @@ namespace Tensile
     TENSILE_API Hardware::Hardware()                = default;
     TENSILE_API Hardware::~Hardware()               = default;
     TENSILE_API Solution::~Solution()               = default;
-    TENSILE_API SolutionAdapter::~SolutionAdapter() = default;
+
+    namespace
+    {
+        // The KernelHandleCache slots that no live adapter holds.
+        struct HandleSlots
+        {
+            std::mutex       mutex;
+            std::vector<int> free;
+            int              next   = 0;
+            bool             warned = false;
+        };
+
+        HandleSlots& handleSlots()
+        {
+            static HandleSlots slots;
+            return slots;
+        }
+    }
+
+    TENSILE_API SolutionAdapter::SolutionAdapter()
+    {
+        static std::atomic<uint64_t> nextOwner(1);
+        m_handleOwner = nextOwner.fetch_add(1, std::memory_order_relaxed);
+
+        auto&                       slots = handleSlots();
+        std::lock_guard<std::mutex> lock(slots.mutex);
+        if(!slots.free.empty())
+        {
+            m_handleSlot = slots.free.back();
+            slots.free.pop_back();
+        }
+        else if(slots.next < static_cast<int>(KernelHandleCache::MaxAdapters))
+        {
+            m_handleSlot = slots.next++;
+        }
+        else
+        {
+            m_handleSlot = -1;
+            if(!slots.warned)
+            {
+                slots.warned = true;
+                std::cerr << "Tensile: more than " << KernelHandleCache::MaxAdapters
+                          << " live solution adapters, kernel handles are not cached for the"
+                          << " others." << std::endl;
+            }
+        }
+    }
+
+    TENSILE_API SolutionAdapter::~SolutionAdapter()
+    {
+        if(m_handleSlot < 0)
+            return;
+
+        auto&                       slots = handleSlots();
+        std::lock_guard<std::mutex> lock(slots.mutex);
+        slots.free.push_back(m_handleSlot);
+    }
 
 #ifdef TENSILE_DEFAULT_SERIALIZATION
     template <typename MyProblem, typename MySolution>
@@ -63,6 +125,10 @@ namespace Tensile
     {
         std::shared_ptr<SolutionLibrary<MyProblem, MySolution>> rv;
 
+        rv = FlatLoadLibraryFile<MyProblem, MySolution>(filename, preloaded);
+        if(rv)
+            return rv;
+
 #ifdef TENSILE_MSGPACK
         rv = MessagePackLoadLibraryFile<MyProblem, MySolution>(filename, preloaded);
         if(rv)
@@ -85,6 +151,10 @@ namespace Tensile
     {
         std::shared_ptr<SolutionLibrary<MyProblem, MySolution>> rv;
 
+        rv = FlatLoadLibraryData<MyProblem, MySolution>(data);
+        if(rv)
+            return rv;
+
 #ifdef TENSILE_MSGPACK
         rv = MessagePackLoadLibraryData<MyProblem, MySolution>(data);
         if(rv)
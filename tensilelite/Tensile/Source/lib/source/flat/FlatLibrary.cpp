@@ -0,0 +1,351 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <Tensile/flat/FlatLibrary.hpp>
+
+#include <Tensile/flat/Loading.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Tensile
+{
+    namespace Flat
+    {
+        namespace
+        {
+            bool HasFlatMagic(std::string const& filename)
+            {
+                std::ifstream in(filename, std::ios::in | std::ios::binary);
+                char          magic[sizeof(Magic)];
+                return in.read(magic, sizeof(magic)) && IsFlatLibrary(magic, sizeof(magic));
+            }
+
+            bool tableFits(uint64_t offset, uint64_t count, uint64_t elementSize, size_t size)
+            {
+                if(offset % 8 != 0 || offset > size)
+                    return false;
+
+                return count <= (size - offset) / elementSize;
+            }
+
+            /**
+             * Read-only view of a whole file. Maps the file where mmap is
+             * available so that only the pages actually used by the library
+             * are read from disk.
+             */
+            class MappedFile
+            {
+            public:
+                explicit MappedFile(std::string const& filename)
+                {
+#ifndef _WIN32
+                    int fd = ::open(filename.c_str(), O_RDONLY);
+                    if(fd < 0)
+                        return;
+
+                    struct stat info;
+                    if(fstat(fd, &info) == 0 && info.st_size > 0)
+                    {
+                        void* addr = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                        if(addr != MAP_FAILED)
+                        {
+                            m_data = addr;
+                            m_size = info.st_size;
+                        }
+                    }
+
+                    ::close(fd);
+#else
+                    std::ifstream in(filename, std::ios::in | std::ios::binary | std::ios::ate);
+                    if(!in.is_open())
+                        return;
+
+                    m_buffer.resize(in.tellg());
+                    in.seekg(0);
+                    if(in.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size()))
+                    {
+                        m_data = m_buffer.data();
+                        m_size = m_buffer.size();
+                    }
+#endif
+                }
+
+                ~MappedFile()
+                {
+#ifndef _WIN32
+                    if(m_data)
+                        munmap(m_data, m_size);
+#endif
+                }
+
+                MappedFile(MappedFile const&)            = delete;
+                MappedFile& operator=(MappedFile const&) = delete;
+
+                void const* data() const
+                {
+                    return m_data;
+                }
+
+                size_t size() const
+                {
+                    return m_size;
+                }
+
+            private:
+                void*  m_data = nullptr;
+                size_t m_size = 0;
+#ifdef _WIN32
+                std::vector<uint64_t> m_buffer;
+#endif
+            };
+        } // namespace
+
+        char const* ToString(NodeType type)
+        {
+            switch(type)
+            {
+            case NodeType::Nil:
+                return "Nil";
+            case NodeType::Bool:
+                return "Bool";
+            case NodeType::Int:
+                return "Int";
+            case NodeType::UInt:
+                return "UInt";
+            case NodeType::Float:
+                return "Float";
+            case NodeType::String:
+                return "String";
+            case NodeType::Array:
+                return "Array";
+            case NodeType::Map:
+                return "Map";
+
+            case NodeType::Count:
+            default:;
+            }
+            return "Invalid";
+        }
+
+        std::string Document::open(void const* data, size_t size)
+        {
+            if(reinterpret_cast<uintptr_t>(data) % alignof(uint64_t) != 0)
+                return "Misaligned buffer";
+
+            if(size < sizeof(FileHeader) || !IsFlatLibrary(data, size))
+                return "Not a flat library";
+
+            auto header = static_cast<FileHeader const*>(data);
+            if(header->version != Version)
+                return concatenate("Unsupported version ", header->version);
+
+            if(!tableFits(header->nodeOffset, header->nodeCount, sizeof(Node), size)
+               || !tableFits(header->childOffset, header->childCount, sizeof(uint32_t), size)
+               || !tableFits(header->entryOffset, header->entryCount, sizeof(Entry), size)
+               || !tableFits(header->stringOffset, header->stringCount, sizeof(StringRef), size)
+               || !tableFits(header->stringDataOffset, header->stringDataSize, 1, size))
+                return "Truncated file";
+
+            if(header->root >= header->nodeCount)
+                return "Invalid root node";
+
+            auto base    = static_cast<char const*>(data);
+            m_header     = header;
+            m_nodes      = reinterpret_cast<Node const*>(base + header->nodeOffset);
+            m_children   = reinterpret_cast<uint32_t const*>(base + header->childOffset);
+            m_entries    = reinterpret_cast<Entry const*>(base + header->entryOffset);
+            m_strings    = reinterpret_cast<StringRef const*>(base + header->stringOffset);
+            m_stringData = base + header->stringDataOffset;
+
+            return "";
+        }
+
+        std::string Document::check(uint32_t index) const
+        {
+            if(index >= m_header->nodeCount)
+                return "Invalid node reference";
+
+            auto checkString = [this](uint64_t string) {
+                if(string >= m_header->stringCount)
+                    return false;
+
+                auto const& ref = m_strings[string];
+                return ref.offset <= m_header->stringDataSize
+                       && ref.length <= m_header->stringDataSize - ref.offset;
+            };
+
+            auto const& node = m_nodes[index];
+            switch(node.type)
+            {
+            case NodeType::String:
+                if(!checkString(node.value))
+                    return "Invalid string reference";
+                break;
+            case NodeType::Array:
+                if(node.value > m_header->childCount
+                   || node.count > m_header->childCount - node.value)
+                    return "Invalid array";
+                for(uint32_t i = 0; i < node.count; i++)
+                {
+                    if(m_children[node.value + i] >= m_header->nodeCount)
+                        return "Invalid node reference";
+                }
+                break;
+            case NodeType::Map:
+                if(node.value > m_header->entryCount
+                   || node.count > m_header->entryCount - node.value)
+                    return "Invalid map";
+                for(uint32_t i = 0; i < node.count; i++)
+                {
+                    auto const& entry = m_entries[node.value + i];
+                    if(!checkString(entry.key) || entry.node >= m_header->nodeCount)
+                        return "Invalid map entry";
+                }
+                break;
+            case NodeType::Nil:
+            case NodeType::Bool:
+            case NodeType::Int:
+            case NodeType::UInt:
+            case NodeType::Float:
+                break;
+            default:
+                return "Invalid node type";
+            }
+
+            return "";
+        }
+
+        bool Document::find(Node const& map, std::string_view key, uint32_t& value) const
+        {
+            auto begin = entriesBegin(map);
+            auto end   = entriesEnd(map);
+
+            auto iter = std::lower_bound(begin, end, key, [this](Entry const& entry, auto key) {
+                return string(entry.key) < key;
+            });
+
+            if(iter == end || string(iter->key) != key)
+                return false;
+
+            value = iter->node;
+            return true;
+        }
+
+        template <typename MyProblem, typename MySolution>
+        std::shared_ptr<SolutionLibrary<MyProblem, MySolution>>
+            LoadLibrary(void const*                         data,
+                        size_t                              size,
+                        std::string const&                  filename,
+                        const std::vector<LazyLoadingInit>& preloaded)
+        {
+            try
+            {
+                Document document;
+                auto     openError = document.open(data, size);
+                if(!openError.empty())
+                    throw std::runtime_error(openError);
+
+                std::shared_ptr<MasterSolutionLibrary<MyProblem, MySolution>> rv;
+
+                LibraryIOContext<MySolution> context{filename, preloaded, nullptr};
+                Serialization::FlatInput     fin(&document, document.root(), &context);
+
+                Serialization::PointerMappingTraits<Tensile::MasterContractionLibrary,
+                                                    Serialization::FlatInput>::mapping(fin, rv);
+
+                if(!fin.error.empty())
+                {
+                    std::ostringstream msg;
+                    msg << "Error loading flat data:\n";
+                    for(auto const& err : fin.error)
+                        msg << err << std::endl;
+
+                    throw std::runtime_error(msg.str());
+                }
+
+                return rv;
+            }
+            catch(std::runtime_error const& exc)
+            {
+                if(Debug::Instance().printDataInit())
+                    std::cout << "Error loading " << filename << " (flat):\n"
+                              << exc.what() << std::endl;
+
+                return nullptr;
+            }
+        }
+    } // namespace Flat
+
+    template <typename MyProblem, typename MySolution>
+    std::shared_ptr<SolutionLibrary<MyProblem, MySolution>>
+        FlatLoadLibraryFile(std::string const&                  filename,
+                            const std::vector<LazyLoadingInit>& preloaded)
+    {
+        // Leave other formats to the other loaders without mapping them.
+        if(!Flat::HasFlatMagic(filename))
+            return nullptr;
+
+        Flat::MappedFile file(filename);
+        if(!Flat::IsFlatLibrary(file.data(), file.size()))
+            return nullptr;
+
+        // Everything is copied out of the mapping while the library is built,
+        // so it can be released as soon as this returns.
+        return Flat::LoadLibrary<MyProblem, MySolution>(
+            file.data(), file.size(), filename, preloaded);
+    }
+
+    template <typename MyProblem, typename MySolution>
+    std::shared_ptr<SolutionLibrary<MyProblem, MySolution>>
+        FlatLoadLibraryData(std::vector<uint8_t> const& data)
+    {
+        if(!Flat::IsFlatLibrary(data.data(), data.size()))
+            return nullptr;
+
+        if(reinterpret_cast<uintptr_t>(data.data()) % alignof(uint64_t) == 0)
+            return Flat::LoadLibrary<MyProblem, MySolution>(data.data(), data.size(), "", {});
+
+        std::vector<uint64_t> aligned((data.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        memcpy(aligned.data(), data.data(), data.size());
+        return Flat::LoadLibrary<MyProblem, MySolution>(aligned.data(), data.size(), "", {});
+    }
+
+    template std::shared_ptr<SolutionLibrary<ContractionProblemGemm, ContractionSolution>>
+        FlatLoadLibraryFile<ContractionProblemGemm, ContractionSolution>(
+            std::string const& filename, const std::vector<LazyLoadingInit>& preloaded);
+
+    template std::shared_ptr<SolutionLibrary<ContractionProblemGemm, ContractionSolution>>
+        FlatLoadLibraryData<ContractionProblemGemm, ContractionSolution>(
+            std::vector<uint8_t> const& data);
+}
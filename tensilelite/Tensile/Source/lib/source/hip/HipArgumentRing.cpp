@@ -0,0 +1,205 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <Tensile/hip/HipArgumentRing.hpp>
+#include <Tensile/hip/HipUtils.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace Tensile
+{
+    namespace hip
+    {
+        ArgumentRing::Slot::Slot(ArgumentRing* ring, Buffer* buffer)
+            : m_ring(ring)
+            , m_buffer(buffer)
+            , m_data(buffer->data)
+            , m_size(buffer->size)
+        {
+        }
+
+        ArgumentRing::Slot::Slot(Slot&& other) noexcept
+            : m_ring(other.m_ring)
+            , m_buffer(other.m_buffer)
+            , m_data(other.m_data)
+            , m_size(other.m_size)
+        {
+            other.m_ring   = nullptr;
+            other.m_buffer = nullptr;
+        }
+
+        ArgumentRing::Slot& ArgumentRing::Slot::operator=(Slot&& other) noexcept
+        {
+            if(this != &other)
+            {
+                release();
+                m_ring         = other.m_ring;
+                m_buffer       = other.m_buffer;
+                m_data         = other.m_data;
+                m_size         = other.m_size;
+                other.m_ring   = nullptr;
+                other.m_buffer = nullptr;
+            }
+            return *this;
+        }
+
+        ArgumentRing::Slot::~Slot()
+        {
+            release();
+        }
+
+        void ArgumentRing::Slot::fence(hipStream_t stream)
+        {
+            if(!m_buffer)
+                throw std::runtime_error("Fencing an empty argument slot.");
+
+            // The buffer is only touched by the thread holding it, so no lock
+            // is needed here.
+            if(!m_buffer->event)
+                HIP_CHECK_EXC(hipEventCreateWithFlags(&m_buffer->event, hipEventDisableTiming));
+
+            HIP_CHECK_EXC(hipEventRecord(m_buffer->event, stream));
+            m_buffer->fenced = true;
+        }
+
+        void ArgumentRing::Slot::release()
+        {
+            if(m_ring)
+                m_ring->release(m_buffer);
+
+            m_ring   = nullptr;
+            m_buffer = nullptr;
+        }
+
+        ArgumentRing::ArgumentRing(size_t slotCount, size_t slotBytes)
+            : m_slotBytes(slotBytes)
+        {
+            // Pinned memory is only allocated once a slot is first used.
+            m_buffers.reserve(std::max<size_t>(slotCount, 1));
+            for(size_t i = 0; i < std::max<size_t>(slotCount, 1); i++)
+                m_buffers.push_back(std::make_unique<Buffer>());
+        }
+
+        ArgumentRing::~ArgumentRing()
+        {
+            for(auto& buffer : m_buffers)
+            {
+                if(buffer->fenced)
+                    static_cast<void>(hipEventSynchronize(buffer->event));
+                if(buffer->event)
+                    static_cast<void>(hipEventDestroy(buffer->event));
+                if(buffer->data)
+                    static_cast<void>(hipHostFree(buffer->data));
+            }
+        }
+
+        ArgumentRing::Slot ArgumentRing::acquire(size_t bytes)
+        {
+            Buffer* buffer = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                size_t count = m_buffers.size();
+                size_t index = count;
+                for(size_t i = 0; i < count; i++)
+                {
+                    size_t candidate = (m_next + i) % count;
+                    if(!m_buffers[candidate]->held)
+                    {
+                        index = candidate;
+                        break;
+                    }
+                }
+
+                if(index == count)
+                    m_buffers.push_back(std::make_unique<Buffer>());
+
+                buffer       = m_buffers[index].get();
+                buffer->held = true;
+                m_next       = (index + 1) % m_buffers.size();
+            }
+
+            // Waiting and allocating happen outside the lock so that other
+            // threads can keep using the remaining slots.
+            try
+            {
+                if(buffer->fenced)
+                {
+                    HIP_CHECK_EXC(hipEventSynchronize(buffer->event));
+                    buffer->fenced = false;
+                }
+
+                if(buffer->size < bytes || !buffer->data)
+                {
+                    constexpr size_t pageBytes = 4096;
+
+                    size_t size = std::max({bytes, m_slotBytes, buffer->size * 2});
+                    size        = (size + pageBytes - 1) / pageBytes * pageBytes;
+
+                    if(buffer->data)
+                    {
+                        HIP_CHECK_EXC(hipHostFree(buffer->data));
+                        buffer->data = nullptr;
+                        buffer->size = 0;
+                    }
+
+                    HIP_CHECK_EXC(hipHostMalloc(&buffer->data, size, hipHostMallocDefault));
+                    buffer->size = size;
+                }
+            }
+            catch(...)
+            {
+                release(buffer);
+                throw;
+            }
+
+            return Slot(this, buffer);
+        }
+
+        void ArgumentRing::release(Buffer* buffer)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            buffer->held = false;
+        }
+
+        ArgumentRing& ArgumentRing::ForDevice(int device)
+        {
+            static std::mutex mutex;
+            // Never destroyed: freeing pinned memory from a static destructor
+            // may run after the HIP runtime has shut down.
+            static auto* rings = new std::unordered_map<int, std::unique_ptr<ArgumentRing>>();
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto& ring = (*rings)[device];
+            if(!ring)
+                ring = std::make_unique<ArgumentRing>();
+
+            return *ring;
+        }
+    }
+}
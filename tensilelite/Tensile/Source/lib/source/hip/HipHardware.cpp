@@ -38,6 +38,9 @@ namespace Tensile
                      std::string(prop.name))
             , properties(prop)
         {
+            // The clocks are in kHz, and memory transfers twice per clock.
+            clockMHz        = prop.clockRate / 1000.0;
+            memoryBandwidth = 2.0 * prop.memoryClockRate * (prop.memoryBusWidth / 8.0) / 1.0e6;
         }
 
         std::string HipAMDGPU::archName() const
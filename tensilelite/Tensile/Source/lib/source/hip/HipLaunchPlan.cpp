@@ -0,0 +1,182 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <Tensile/hip/HipLaunchPlan.hpp>
+#include <Tensile/hip/HipSolutionAdapter.hpp>
+#include <Tensile/hip/HipUtils.hpp>
+
+namespace Tensile
+{
+    namespace hip
+    {
+        LaunchPlan::~LaunchPlan()
+        {
+            resetGraph();
+        }
+
+        std::vector<LaunchPlan::Launch>
+            LaunchPlan::resolve(SolutionAdapter&                     adapter,
+                                std::vector<KernelInvocation> const& kernels)
+        {
+            std::vector<Launch> launches;
+            launches.reserve(kernels.size());
+            for(auto const& kernel : kernels)
+            {
+                Launch launch;
+                HIP_CHECK_EXC(adapter.resolveKernel(launch.function, kernel));
+                launch.numWorkItems   = kernel.numWorkItems;
+                launch.workGroupSize  = kernel.workGroupSize;
+                launch.sharedMemBytes = kernel.sharedMemBytes;
+                launch.args           = kernel.args;
+                launches.push_back(std::move(launch));
+            }
+            return launches;
+        }
+
+        size_t LaunchPlan::append(SolutionAdapter&                     adapter,
+                                  std::vector<KernelInvocation> const& kernels)
+        {
+            return append(resolve(adapter, kernels));
+        }
+
+        size_t LaunchPlan::append(std::vector<Launch> launches)
+        {
+            resetGraph();
+            m_groups.push_back(std::move(launches));
+            return m_groups.size() - 1;
+        }
+
+        void LaunchPlan::replace(size_t                               group,
+                                 SolutionAdapter&                     adapter,
+                                 std::vector<KernelInvocation> const& kernels)
+        {
+            auto launches = resolve(adapter, kernels);
+            resetGraph();
+            m_groups.at(group) = std::move(launches);
+        }
+
+        bool LaunchPlan::rebind(size_t group, KernelArgumentBinding binding, void const* pointer)
+        {
+            bool found = false;
+            for(auto& launch : m_groups.at(group))
+                found = launch.args.rebind(binding, pointer) || found;
+
+            if(found)
+                resetGraph();
+            return found;
+        }
+
+        bool LaunchPlan::rebind(size_t                 group,
+                                KernelArgumentBinding  binding,
+                                ConstantVariant const& value)
+        {
+            bool found = false;
+            for(auto& launch : m_groups.at(group))
+                found = launch.args.rebind(binding, value) || found;
+
+            if(found)
+                resetGraph();
+            return found;
+        }
+
+        std::vector<LaunchPlan::Launch> const& LaunchPlan::launches(size_t group) const
+        {
+            return m_groups.at(group);
+        }
+
+        hipError_t LaunchPlan::launch(hipStream_t stream) const
+        {
+            for(auto const& group : m_groups)
+            {
+                for(auto const& launch : group)
+                {
+                    void*  kernelArgs = const_cast<void*>(launch.args.data());
+                    size_t argsSize   = launch.args.size();
+
+                    void* hipLaunchParams[] = {HIP_LAUNCH_PARAM_BUFFER_POINTER,
+                                               kernelArgs,
+                                               HIP_LAUNCH_PARAM_BUFFER_SIZE,
+                                               &argsSize,
+                                               HIP_LAUNCH_PARAM_END};
+
+                    HIP_CHECK_RETURN(hipExtModuleLaunchKernel(launch.function,
+                                                              launch.numWorkItems.x,
+                                                              launch.numWorkItems.y,
+                                                              launch.numWorkItems.z,
+                                                              launch.workGroupSize.x,
+                                                              launch.workGroupSize.y,
+                                                              launch.workGroupSize.z,
+                                                              launch.sharedMemBytes,
+                                                              stream,
+                                                              nullptr,
+                                                              (void**)&hipLaunchParams,
+                                                              nullptr,
+                                                              nullptr));
+                }
+            }
+            return hipSuccess;
+        }
+
+        hipError_t LaunchPlan::launchGraph(hipStream_t stream)
+        {
+            if(stream == nullptr)
+                return hipErrorInvalidValue;
+
+            if(m_graphExec == nullptr)
+            {
+                // The arguments are copied into the graph when it is captured,
+                // so any change to them needs a new capture.
+                hipGraph_t graph = nullptr;
+                HIP_CHECK_RETURN(hipStreamBeginCapture(stream, hipStreamCaptureModeThreadLocal));
+
+                hipError_t err = launch(stream);
+                hipError_t end = hipStreamEndCapture(stream, &graph);
+                if(err == hipSuccess)
+                    err = end;
+                if(err == hipSuccess)
+                    err = hipGraphInstantiate(&m_graphExec, graph, nullptr, nullptr, 0);
+                if(graph != nullptr)
+                    static_cast<void>(hipGraphDestroy(graph));
+
+                if(err != hipSuccess)
+                {
+                    m_graphExec = nullptr;
+                    return err;
+                }
+            }
+
+            return hipGraphLaunch(m_graphExec, stream);
+        }
+
+        void LaunchPlan::resetGraph()
+        {
+            if(m_graphExec != nullptr)
+                static_cast<void>(hipGraphExecDestroy(m_graphExec));
+            m_graphExec = nullptr;
+        }
+    }
+}
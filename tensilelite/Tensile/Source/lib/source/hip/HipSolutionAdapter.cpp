@@ -254,43 +254,85 @@ namespace Tensile
             return hipSuccess;
         }
 
+        hipError_t SolutionAdapter::loadLazyCodeObjectFile(std::string const& codeObjectFile)
+        {
+            std::string key = removeXnack(codeObjectFile);
+
+            std::shared_ptr<std::mutex> loading;
+            {
+                std::lock_guard<std::mutex> guard(m_access);
+                if(m_loadedCOFiles.find(key) != m_loadedCOFiles.end())
+                    return hipSuccess;
+
+                auto& entry = m_loadingCOFiles[key];
+                if(!entry)
+                    entry = std::make_shared<std::mutex>();
+                loading = entry;
+            }
+
+            // Only threads wanting this same file wait here; m_access is not held
+            // while the file is read.
+            std::lock_guard<std::mutex> loadingGuard(*loading);
+
+            m_access.lock();
+            bool        loaded        = m_loadedCOFiles.find(key) != m_loadedCOFiles.end();
+            std::string codeObjectDir = m_codeObjectDirectory;
+            m_access.unlock();
+
+            if(loaded)
+                return hipSuccess;
+
+            //Try other xnack versions
+            size_t     loc = codeObjectFile.rfind('.');
+            hipError_t err = hipErrorFileNotFound;
+
+            for(auto ver : {"", "-xnack-", "-xnack+"})
+            {
+                std::string modifiedCOName = codeObjectFile;
+                modifiedCOName.insert(loc, ver);
+                err = loadCodeObjectFile(codeObjectDir + modifiedCOName);
+
+                if(err == hipSuccess)
+                    break;
+            }
+
+            return err;
+        }
+
         hipError_t SolutionAdapter::launchKernel(KernelInvocation const& kernel)
         {
             return launchKernel(kernel, nullptr, nullptr, nullptr);
         }
 
+        hipError_t SolutionAdapter::resolveKernel(hipFunction_t&          rv,
+                                                  KernelInvocation const& kernel)
+        {
+            // Steady state: the handle was resolved by an earlier launch, so the code object
+            // is loaded and no lookup is needed.
+            rv       = nullptr;
+            int slot = handleSlot();
+            if(kernel.handleCache != nullptr && slot >= 0)
+                rv = static_cast<hipFunction_t>(kernel.handleCache->find(slot, handleOwner()));
+
+            if(rv != nullptr)
+                return hipSuccess;
+
+            //If required code object file hasn't yet been loaded, load it now
+            if(!kernel.codeObjectFile.empty())
+                loadLazyCodeObjectFile(kernel.codeObjectFile);
+
+            HIP_CHECK_RETURN(getKernel(rv, kernel.kernelName));
+            if(kernel.handleCache != nullptr && slot >= 0)
+                kernel.handleCache->store(slot, handleOwner(), rv);
+
+            return hipSuccess;
+        }
+
         hipError_t SolutionAdapter::launchKernel(KernelInvocation const& kernel,
                                                  hipStream_t             stream,
                                                  hipEvent_t              startEvent,
                                                  hipEvent_t              stopEvent)
         {
-            if(!kernel.codeObjectFile.empty())
-            {
-                //If required code object file hasn't yet been loaded, load it now
-                m_access.lock();
-                bool loaded = m_loadedCOFiles.find(removeXnack(kernel.codeObjectFile))
-                              != m_loadedCOFiles.end();
-                std::string codeObjectDir = m_codeObjectDirectory;
-                m_access.unlock();
-
-                if(!loaded)
-                {
-                    //Try other xnack versions
-                    size_t     loc = kernel.codeObjectFile.rfind('.');
-                    hipError_t err;
-
-                    for(auto ver : {"", "-xnack-", "-xnack+"})
-                    {
-                        std::string modifiedCOName = kernel.codeObjectFile;
-                        modifiedCOName.insert(loc, ver);
-                        err = loadCodeObjectFile(codeObjectDir + modifiedCOName);
-
-                        if(err == hipSuccess)
-                            break;
-                    }
-                }
-            }
-
             if(m_debug)
             {
                 std::cout << "Kernel " << kernel.kernelName << std::endl;
@@ -309,7 +351,7 @@ namespace Tensile
             }
 
             hipFunction_t function;
-            HIP_CHECK_RETURN(getKernel(function, kernel.kernelName));
+            HIP_CHECK_RETURN(resolveKernel(function, kernel));
 
             void*  kernelArgs = const_cast<void*>(kernel.args.data());
             size_t argsSize   = kernel.args.size();
@@ -122,7 +122,7 @@ def addCommonArguments(argParser):
         help="kernels and solutions written to individual files")
     argParser.add_argument("--cxx-compiler", dest="CxxCompiler", choices=["hipcc"], \
         action="store", default="hipcc", help="select which compiler to use")
-    argParser.add_argument("--library-format", dest="LibraryFormat", choices=["yaml", "msgpack"], \
+    argParser.add_argument("--library-format", dest="LibraryFormat", choices=["yaml", "msgpack", "flat"], \
         action="store", default="yaml", help="select which library format to use")
     argParser.add_argument("--client-build-path", default=None)
     argParser.add_argument("--client-lock", default=None)
@@ -81,6 +81,40 @@ def worker_lock_path(tmp_path_factory, worker_id):
 
     return tmp_path_factory.getbasetemp().parent / "client_execution.lock"
 
+@pytest.fixture(scope="session")
+def client_tools_dir(pytestconfig, builddir):
+    """
+    Directory of the client and of the tools built with it, such as
+    tensile_selection_benchmark: that of --prebuilt-client, or else of a
+    client built once per session, so that unit tests run by -m unit need no
+    option. Skips if there is no ROCm compiler to build it with.
+    """
+    client = pytestconfig.getoption("--prebuilt-client")
+    if client is not None:
+        return os.path.dirname(client)
+
+    import shutil
+    from Tensile import ClientExecutable
+    from Tensile.Common import globalParameters
+
+    rocmBin = os.path.join(os.environ.get("ROCM_PATH", "/opt/rocm"), "bin")
+    compiler = shutil.which(globalParameters["CxxCompiler"], path=rocmBin) \
+        or shutil.which(globalParameters["CxxCompiler"])
+    if compiler is None:
+        pytest.skip("no {} to build the client tools with, see --prebuilt-client"
+                    .format(globalParameters["CxxCompiler"]))
+
+    env = ClientExecutable.CMakeEnvironment(globalParameters["SourcePath"],
+                                            os.path.join(builddir, "client_tools"),
+                                            CMAKE_BUILD_TYPE="Release",
+                                            TENSILE_USE_MSGPACK="ON",
+                                            TENSILE_USE_LLVM="ON",
+                                            Tensile_LIBRARY_FORMAT="msgpack",
+                                            CMAKE_CXX_COMPILER=compiler)
+    env.generate()
+    env.build()
+    return os.path.dirname(env.builtPath("client", "tensile_client"))
+
 @pytest.fixture
 def tensile_script_path():
     return os.path.join(moddir, 'bin', 'Tensile')
@@ -0,0 +1,66 @@
+################################################################################
+#
+# Copyright (C) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+################################################################################
+
+import glob
+import os
+import shutil
+import subprocess
+import sys
+
+import pytest
+
+testdir = os.path.dirname(os.path.dirname(__file__))
+moddir = os.path.dirname(testdir)
+
+# The gfx942 logic files that hipBLASLt ships, for a library with real predicates.
+logicdir = os.path.join(os.path.dirname(os.path.dirname(moddir)), "library", "src", "amd_detail",
+                        "rocblaslt", "src", "Tensile", "Logic", "asm_full", "aquavanjaram", "gfx942")
+
+def test_compiled_predicates(tmpdir, client_tools_dir):
+    """
+    Loads a library of HHS solutions and checks that, for each solution, the
+    compiled problem and hardware predicates give the same result as the
+    trees they were compiled from (tensile_selection_benchmark --check).
+    """
+    benchmark = os.path.join(client_tools_dir, "tensile_selection_benchmark")
+    if not os.path.isfile(benchmark):
+        pytest.skip("{} not found".format(benchmark))
+
+    logicFiles = glob.glob(os.path.join(logicdir, "*", "*_HHS_BH*.yaml"))
+    if not logicFiles:
+        pytest.skip("no logic files in {}".format(logicdir))
+
+    logicPath = tmpdir.mkdir("logic")
+    for logicFile in logicFiles:
+        shutil.copy(logicFile, str(logicPath))
+    outputPath = tmpdir.mkdir("output")
+
+    # Only the library file is needed, not the code objects.
+    subprocess.check_call([sys.executable, os.path.join(moddir, "bin", "TensileCreateLibrary"),
+                           "--architecture=gfx942", "--no-enumerate", "--generate-sources-and-exit",
+                           "--library-format=msgpack", str(logicPath), str(outputPath), "HIP"])
+
+    libraryFile = outputPath.join("library", "TensileLibrary.dat")
+    subprocess.check_call([benchmark, "--check", "--library-file", str(libraryFile),
+                           "--architecture", "gfx942"])
@@ -0,0 +1,41 @@
+################################################################################
+#
+# Copyright (C) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+################################################################################
+
+import os
+import subprocess
+
+import pytest
+
+def test_kd_tree(client_tools_dir):
+    """
+    Checks that the k nearest neighbours found by the k-d tree of the
+    GridInterpolated matcher are those of a linear scan, ties and repeated
+    points included (tensile_matching_benchmark --check).
+    """
+    benchmark = os.path.join(client_tools_dir, "tensile_matching_benchmark")
+    if not os.path.isfile(benchmark):
+        pytest.skip("{} not found".format(benchmark))
+
+    for seed in ["0", "1"]:
+        subprocess.check_call([benchmark, "--check", "--seed", seed])
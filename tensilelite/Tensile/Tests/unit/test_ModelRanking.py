@@ -0,0 +1,98 @@
+################################################################################
+#
+# Copyright (C) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+################################################################################
+
+from types import SimpleNamespace
+
+import pytest
+
+from Tensile.SolutionLibrary import ModelRankingLibrary
+from Tensile.TensileInstructions import DataType
+
+def solution(index, mi=None, sparse=False, xf32=False):
+    state = {"EnableMatrixInstruction": mi is not None,
+             "EnableF32XdlMathOp": xf32,
+             "ProblemType": {"SparseA": sparse, "F32XdlMathOp": DataType("X" if xf32 else "S")}}
+    if mi is not None:
+        state.update(zip(["MatrixInstM", "MatrixInstN", "MatrixInstK", "MatrixInstB"], mi))
+    return SimpleNamespace(index=index, originalSolution=state)
+
+problemType = SimpleNamespace(operationIdentifier="Contraction_l_Ailk_Bljk_Cijk_Dijk")
+
+def test_matrix_core_flops():
+    # 4 SIMDs * 2*M*N*K*B flops / (M/2 passes of 4 cycles)
+    assert ModelRankingLibrary.MatrixCoreFlops([solution(0, [16, 16, 16, 1])]) == 1024
+    assert ModelRankingLibrary.MatrixCoreFlops([solution(0, [32, 32, 8, 1])]) == 1024
+    assert ModelRankingLibrary.MatrixCoreFlops([solution(0, [16, 16, 4, 4])]) == 1024
+    # Sparse and xf32 instructions take M/4 passes.
+    assert ModelRankingLibrary.MatrixCoreFlops([solution(0, [16, 16, 32, 1], sparse=True)]) == 4096
+    assert ModelRankingLibrary.MatrixCoreFlops([solution(0, [32, 32, 4, 1], xf32=True)]) == 1024
+    # The fastest instruction wins, and solutions without one are ignored.
+    assert ModelRankingLibrary.MatrixCoreFlops([solution(0, [16, 16, 16, 1]),
+                                                solution(1, [16, 16, 32, 1], sparse=True),
+                                                solution(2)]) == 4096
+    assert ModelRankingLibrary.MatrixCoreFlops([solution(0)]) == 0
+
+def test_from_original_state_defaults():
+    """
+    Without a calibration in the logic file, only the matrix core throughput
+    is set, so that the bandwidth and clock come from the GPU at run time.
+    """
+    solutions = [solution(0, [16, 16, 16, 1]), solution(1, [32, 32, 8, 1])]
+    libraryData = {"table": [[[128, 256, 512], [0, 10.0]], [[64, 32, 2, 16], [1, 5.0]]]}
+    matching = object()
+
+    lib = ModelRankingLibrary.FromOriginalState({}, "gfx942", problemType, libraryData,
+                                                solutions, matching)
+
+    assert lib.library is matching
+    assert lib.calibration == {"flopsPerCuPerCycle": 1024}
+    assert lib.maxGridDistance == 1.0
+    # Sizes are M, N, batch, K; keys without a batch have a batch of 1.
+    assert lib.sizes == [[128, 256, 1, 512], [64, 32, 2, 16]]
+    assert lib.indices == [0, 1]
+    assert lib.tag == "ModelRanking"
+
+def test_from_original_state_calibrated():
+    solutions = [solution(0, [16, 16, 16, 1])]
+    d = {"maxGridDistance": 2.5,
+         "calibration": {"memoryBandwidth": 5300.0, "clockMHz": 2100, "flopsPerCuPerCycle": 2048,
+                         "launchOverhead": 3.0}}
+
+    lib = ModelRankingLibrary.FromOriginalState(d, "gfx942", problemType, {"table": []},
+                                                solutions, None)
+
+    assert lib.calibration == d["calibration"]
+    assert lib.calibration is not d["calibration"]
+    assert lib.maxGridDistance == 2.5
+
+    # The logic file can calibrate solutions that do not use matrix instructions.
+    d = {"calibration": {"flopsPerCuPerCycle": 256}}
+    lib = ModelRankingLibrary.FromOriginalState(d, "gfx942", problemType, {"table": []},
+                                                [solution(0)], None)
+    assert lib.calibration == {"flopsPerCuPerCycle": 256}
+
+def test_from_original_state_uncalibrated():
+    with pytest.raises(RuntimeError, match="flopsPerCuPerCycle"):
+        ModelRankingLibrary.FromOriginalState({}, "gfx942", problemType, {"table": []},
+                                              [solution(0)], None)